@@ -1,14 +1,14 @@
 /**********************************************************************************
-// App (Cdigo Fonte)
+// App (Código Fonte)
 //
-// Criao:     11 Jan 2020
-// Atualizao: 15 Ago 2021
+// Criação:     11 Jan 2020
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Uma classe abstrata para representar uma aplicao
+// Descrição:   Uma classe abstrata para representar uma aplicação
 //
-//              Todas as aplicaes derivadas da classe App devem
-//              sobrescrever os mtodos Init, Update, Draw e Finalize.
+//              Todas as aplicações derivadas da classe App devem
+//              sobrescrever os métodos Init, Update, Draw e Finalize.
 //
 **********************************************************************************/
 
@@ -16,12 +16,15 @@
 #include "Engine.h"
 
 // -------------------------------------------------------------------------------
-// Inicializao de membros estticos da classe
+// Inicialização de membros estáticos da classe
 
-Graphics* & App::graphics  = Engine::graphics;       // componente grfico 
-Window*   & App::window    = Engine::window;         // janela da aplicao
+Graphics* & App::graphics  = Engine::graphics;       // componente gráfico 
+Window*   & App::window    = Engine::window;         // janela da aplicação
 Input*    & App::input     = Engine::input;          // dispositivos de entrada
-double    & App::frameTime = Engine::frameTime;      // tempo do ltimo quadro
+Scheduler* & App::scheduler = Engine::scheduler;    // agenda de atualizações e quadros
+JobSystem* & App::jobs     = Engine::jobs;          // trabalhos paralelos
+double    & App::frameTime = Engine::frameTime;      // tempo do último quadro
+Rasterizer* & App::rasterizer = Engine::rasterizer;  // renderizador em software
 
 // -------------------------------------------------------------------------------
 
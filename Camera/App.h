@@ -1,14 +1,14 @@
 /**********************************************************************************
-// App (Arquivo de Cabealho)
+// App (Arquivo de Cabeçalho)
 // 
-// Criao:     11 Jan 2020
-// Atualizao: 15 Ago 2021
+// Criação:     11 Jan 2020
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Uma classe abstrata para representar uma aplicao
+// Descrição:   Uma classe abstrata para representar uma aplicação
 //
-//              Todas as aplicaes derivadas da classe App devem
-//              sobrescrever os mtodos Init, Update, Draw e Finalize. 
+//              Todas as aplicações derivadas da classe App devem
+//              sobrescrever os métodos Init, Update, Draw e Finalize. 
 //
 **********************************************************************************/
 
@@ -20,42 +20,48 @@
 #include "Graphics.h"
 #include "Window.h"
 #include "Input.h"
+#include "Rasterizer.h"
+#include "Scheduler.h"
+#include "JobSystem.h"
 
 // ---------------------------------------------------------------------------------
 
 class App
 {
-    // Membros protegidos so privados para o mundo externo mas
-    // pblicos para as classes derivadas, ou seja, as classes
-    // derivadas de App sero capazes de acessar estes membros.
+    // Membros protegidos são privados para o mundo externo mas
+    // públicos para as classes derivadas, ou seja, as classes
+    // derivadas de App serão capazes de acessar estes membros.
 
 protected:
-    static Graphics* & graphics;                // componente grfico
-    static Window*   & window;                  // janela da aplicao
+    static Graphics* & graphics;                // componente gráfico
+    static Window*   & window;                  // janela da aplicação
     static Input*    & input;                   // dispositivos de entrada
-    static double    & frameTime;               // tempo do ltimo quadro
+    static Scheduler* & scheduler;              // agenda de atualizações e quadros
+    static JobSystem* & jobs;                   // trabalhos paralelos (Update e Draw)
+    static double    & frameTime;               // tempo do último quadro
+    static Rasterizer* & rasterizer;            // renderizador em software (sem janela)
 
 public:
     App();                                      // construtor
     virtual ~App();                             // destrutor
 
-    // Estes mtodos so puramente virtuais, isto , devem ser 
+    // Estes métodos são puramente virtuais, isto é, devem ser 
     // implementados em todas as classes derivas de App.
 
-    virtual void Init() = 0;                    // inicializao
-    virtual void Update() = 0;                  // atualizao
-    virtual void Finalize() = 0;                // finalizao    
+    virtual void Init() = 0;                    // inicialização
+    virtual void Update() = 0;                  // atualização
+    virtual void Finalize() = 0;                // finalização    
 
-    // Estes mtodos possuem uma implementao vazia por padro
+    // Estes métodos possuem uma implementação vazia por padrão
     // e apenas um deles deve ser sobrescrito na classe derivada:
-    // - Draw  executado a cada ciclo do lao principal
-    // - Display  chamado apenas uma vez no incio da aplicao
+    // - Draw é executado a cada ciclo do laço principal
+    // - Display é chamado apenas uma vez no início da aplicação
     //   e deve ser chamado manualmente em Update toda vez
     //   que a tela precisar ser redesenhada.
 
     virtual void Draw() {}                      // desenho
-    virtual void Display() {}                   // exibio
-    virtual void OnPause() { Sleep(10); }       // em pausa
+    virtual void Display() {}                   // exibição
+    virtual void OnPause() {}                   // em pausa (o laço espera o próximo evento)
 };
 
 // ---------------------------------------------------------------------------------
@@ -0,0 +1,995 @@
+/**********************************************************************************
+// Bvh (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Hierarquia de volumes envolventes sobre os triângulos de uma
+//              malha, para seleção com o mouse e consultas de raios.
+//
+**********************************************************************************/
+
+#include "Bvh.h"
+#include "Timer.h"
+#include <immintrin.h>                  // SSE
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// nós com mais triângulos que isto dividem a construção entre as threads
+static const uint ParallelThreshold = 16384;
+
+// triângulos por trabalho na contagem das faixas de um nó grande
+static const uint BinGrain = 16384;
+
+// custo relativo da travessia de um nó e do teste de um triângulo
+static const float TraversalCost = 1.0f;
+static const float IntersectCost = 1.0f;
+
+// -------------------------------------------------------------------------------
+
+// caixa alinhada aos eixos usada na construção
+struct BuildBox
+{
+    float min[3];
+    float max[3];
+
+    void Reset()
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            min[i] = FLT_MAX;
+            max[i] = -FLT_MAX;
+        }
+    }
+
+    void Grow(const float * p)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            min[i] = p[i] < min[i] ? p[i] : min[i];
+            max[i] = p[i] > max[i] ? p[i] : max[i];
+        }
+    }
+
+    void Grow(const BuildBox & box)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            min[i] = box.min[i] < min[i] ? box.min[i] : min[i];
+            max[i] = box.max[i] > max[i] ? box.max[i] : max[i];
+        }
+    }
+
+    float Area() const
+    {
+        float dx = max[0] - min[0];
+        float dy = max[1] - min[1];
+        float dz = max[2] - min[2];
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+};
+
+// faixas dos centróides nos três eixos
+struct BuildBins
+{
+    BuildBox box[3][Bvh::Bins];
+    uint count[3][Bvh::Bins];
+
+    void Reset()
+    {
+        for (uint a = 0; a < 3; ++a)
+            for (uint b = 0; b < Bvh::Bins; ++b)
+            {
+                box[a][b].Reset();
+                count[a][b] = 0;
+            }
+    }
+
+    void Merge(const BuildBins & other)
+    {
+        for (uint a = 0; a < 3; ++a)
+            for (uint b = 0; b < Bvh::Bins; ++b)
+            {
+                box[a][b].Grow(other.box[a][b]);
+                count[a][b] += other.count[a][b];
+            }
+    }
+};
+
+// triângulo durante a construção: caixa, centróide e índice original
+struct BuildRef
+{
+    BuildBox box;
+    float center[3];
+    uint id;
+};
+
+// -------------------------------------------------------------------------------
+
+struct Bvh::Builder
+{
+    Bvh & bvh;
+    JobSystem * jobs;
+    vector<BuildRef> refs;              // triângulos, reordenados até a ordem das folhas
+    std::atomic<uint> used;             // nós já reservados
+
+    Builder(Bvh & tree, JobSystem * js) : bvh(tree), jobs(js), used(1) {}
+
+    // faixa de um centróide (a mesma conta na contagem e na partição)
+    static uint Bin(float c, float minimum, float scale)
+    {
+        uint b = uint((c - minimum) * scale);
+        return b < Bins ? b : Bins - 1;
+    }
+
+    void Measure(uint begin, uint end, BuildBox & box, BuildBox & centers);
+    void Count(uint begin, uint end, const BuildBox & centers, BuildBins & bins);
+    void Split(uint index, uint begin, uint end, uint depth, const BuildBox & box, const BuildBox & centers);
+};
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Builder::Measure(uint begin, uint end, BuildBox & box, BuildBox & centers)
+{
+    box.Reset();
+    centers.Reset();
+
+    auto measure = [this](uint first, uint last, BuildBox & b, BuildBox & c)
+    {
+        for (uint i = first; i < last; ++i)
+        {
+            b.Grow(refs[i].box);
+            c.Grow(refs[i].center);
+        }
+    };
+
+    uint count = end - begin;
+    if (!jobs || count <= ParallelThreshold)
+    {
+        measure(begin, end, box, centers);
+        return;
+    }
+
+    // partes medidas em paralelo e depois combinadas
+    uint parts = (count + BinGrain - 1) / BinGrain;
+    vector<BuildBox> partBox(parts);
+    vector<BuildBox> partCenters(parts);
+
+    jobs->ParallelFor(parts, 1, [&](uint first, uint last)
+    {
+        for (uint p = first; p < last; ++p)
+        {
+            partBox[p].Reset();
+            partCenters[p].Reset();
+            uint b = begin + p * BinGrain;
+            uint e = b + BinGrain < end ? b + BinGrain : end;
+            measure(b, e, partBox[p], partCenters[p]);
+        }
+    });
+
+    for (uint p = 0; p < parts; ++p)
+    {
+        box.Grow(partBox[p]);
+        centers.Grow(partCenters[p]);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Builder::Count(uint begin, uint end, const BuildBox & centers, BuildBins & bins)
+{
+    float scale[3];
+    for (uint a = 0; a < 3; ++a)
+    {
+        float extent = centers.max[a] - centers.min[a];
+        scale[a] = extent > 0.0f ? Bins / extent : 0.0f;
+    }
+
+    auto count = [&](uint first, uint last, BuildBins & out)
+    {
+        out.Reset();
+        for (uint i = first; i < last; ++i)
+        {
+            const BuildRef & ref = refs[i];
+            for (uint a = 0; a < 3; ++a)
+            {
+                uint b = Bin(ref.center[a], centers.min[a], scale[a]);
+                out.box[a][b].Grow(ref.box);
+                ++out.count[a][b];
+            }
+        }
+    };
+
+    uint total = end - begin;
+    if (!jobs || total <= ParallelThreshold)
+    {
+        count(begin, end, bins);
+        return;
+    }
+
+    // cada parte conta suas faixas e as contagens são somadas
+    uint parts = (total + BinGrain - 1) / BinGrain;
+    vector<BuildBins> partBins(parts);
+
+    jobs->ParallelFor(parts, 1, [&](uint first, uint last)
+    {
+        for (uint p = first; p < last; ++p)
+        {
+            uint b = begin + p * BinGrain;
+            uint e = b + BinGrain < end ? b + BinGrain : end;
+            count(b, e, partBins[p]);
+        }
+    });
+
+    bins.Reset();
+    for (const BuildBins & part : partBins)
+        bins.Merge(part);
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Builder::Split(uint index, uint begin, uint end, uint depth, const BuildBox & box, const BuildBox & centers)
+{
+    uint count = end - begin;
+    Node & node = bvh.nodes[index];
+
+    node.min = XMFLOAT3(box.min[0], box.min[1], box.min[2]);
+    node.max = XMFLOAT3(box.max[0], box.max[1], box.max[2]);
+    node.first = begin;
+    node.count = count;
+
+    if (count == 1)
+        return;
+
+    // melhor corte entre faixas: soma de área x triângulos dos dois lados
+    uint axis = 0;
+    uint split = 0;
+    float best = FLT_MAX;
+
+    float extent[3];
+    for (uint a = 0; a < 3; ++a)
+        extent[a] = centers.max[a] - centers.min[a];
+
+    if (depth < MaxDepth && (extent[0] > 0.0f || extent[1] > 0.0f || extent[2] > 0.0f))
+    {
+        BuildBins bins;
+        Count(begin, end, centers, bins);
+
+        for (uint a = 0; a < 3; ++a)
+        {
+            if (extent[a] <= 0.0f)
+                continue;
+
+            // custo do lado direito de cada corte, da última faixa para a primeira
+            float rightCost[Bins];
+            BuildBox right;
+            right.Reset();
+            uint rightCount = 0;
+            for (uint b = Bins - 1; b > 0; --b)
+            {
+                right.Grow(bins.box[a][b]);
+                rightCount += bins.count[a][b];
+                rightCost[b] = rightCount ? right.Area() * rightCount : 0.0f;
+            }
+
+            BuildBox left;
+            left.Reset();
+            uint leftCount = 0;
+            for (uint b = 0; b < Bins - 1; ++b)
+            {
+                left.Grow(bins.box[a][b]);
+                leftCount += bins.count[a][b];
+                if (leftCount == 0 || leftCount == count)
+                    continue;
+
+                float cost = left.Area() * leftCount + rightCost[b + 1];
+                if (cost < best)
+                {
+                    best = cost;
+                    axis = a;
+                    split = b + 1;
+                }
+            }
+        }
+    }
+
+    // caixas dos dois lados (dos triângulos e dos centróides)
+    BuildBox leftBox, leftCenters, rightBox, rightCenters;
+    uint half;
+
+    if (best < FLT_MAX)
+    {
+        // folha se o corte não compensa e os triângulos cabem nela
+        float area = box.Area();
+        float splitCost = TraversalCost + (area > 0.0f ? best / area : 0.0f) * IntersectCost;
+        if (splitCost >= count * IntersectCost && count <= MaxLeafSize)
+            return;
+
+        // partição que mede os dois lados ao passar por cada triângulo
+        float minimum = centers.min[axis];
+        float scale = Bins / extent[axis];
+        leftBox.Reset();
+        leftCenters.Reset();
+        rightBox.Reset();
+        rightCenters.Reset();
+
+        uint i = begin;
+        uint j = end;
+        while (i < j)
+        {
+            if (Bin(refs[i].center[axis], minimum, scale) < split)
+            {
+                leftBox.Grow(refs[i].box);
+                leftCenters.Grow(refs[i].center);
+                ++i;
+            }
+            else
+            {
+                std::swap(refs[i], refs[--j]);
+                rightBox.Grow(refs[j].box);
+                rightCenters.Grow(refs[j].center);
+            }
+        }
+        half = i;
+    }
+    else
+    {
+        if (count <= MaxLeafSize)
+            return;
+
+        // sem corte útil (centróides iguais ou árvore funda demais):
+        // divide pela mediana no eixo mais longo
+        axis = extent[1] > extent[axis] ? 1 : axis;
+        axis = extent[2] > extent[axis] ? 2 : axis;
+        half = begin + count / 2;
+        std::nth_element(refs.begin() + begin, refs.begin() + half, refs.begin() + end,
+            [axis](const BuildRef & a, const BuildRef & b) { return a.center[axis] < b.center[axis]; });
+
+        Measure(begin, half, leftBox, leftCenters);
+        Measure(half, end, rightBox, rightCenters);
+    }
+
+    uint children = used.fetch_add(2);
+    node.first = children;
+    node.count = 0;
+
+    // subárvores grandes viram trabalhos independentes
+    if (jobs && count > ParallelThreshold)
+    {
+        jobs->ParallelFor(2, 1, [&](uint first, uint last)
+        {
+            for (uint c = first; c < last; ++c)
+            {
+                if (c == 0)
+                    Split(children, begin, half, depth + 1, leftBox, leftCenters);
+                else
+                    Split(children + 1, half, end, depth + 1, rightBox, rightCenters);
+            }
+        });
+    }
+    else
+    {
+        Split(children, begin, half, depth + 1, leftBox, leftCenters);
+        Split(children + 1, half, end, depth + 1, rightBox, rightCenters);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+string BvhStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << triangles << " triângulos, " << nodes << " nós, " << leaves << " folhas, profundidade "
+         << depth << ", custo SAH " << sahCost << ", " << seconds * 1000.0 << " ms";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+BvhStats Bvh::Build(const XMFLOAT3 * positions, uint vertexCount,
+                    const uint * indices, uint indexCount, JobSystem * jobs)
+{
+    Timer timer;
+    timer.Start();
+
+    Clear();
+
+    BvhStats stats = {};
+    uint count = indexCount / 3;
+    if (count == 0)
+        return stats;
+
+    Builder builder(*this, jobs);
+    builder.refs.resize(count);
+
+    // caixa e centróide de cada triângulo (índices fora da malha usam o vértice 0)
+    auto prepare = [&](uint first, uint last)
+    {
+        for (uint t = first; t < last; ++t)
+        {
+            BuildRef & ref = builder.refs[t];
+            ref.box.Reset();
+            for (uint k = 0; k < 3; ++k)
+            {
+                uint v = indices[3 * t + k];
+                ref.box.Grow(&positions[v < vertexCount ? v : 0].x);
+            }
+
+            for (uint a = 0; a < 3; ++a)
+                ref.center[a] = (ref.box.min[a] + ref.box.max[a]) * 0.5f;
+            ref.id = t;
+        }
+    };
+
+    if (jobs)
+        jobs->ParallelFor(count, BinGrain, prepare);
+    else
+        prepare(0, count);
+
+    BuildBox box, centers;
+    builder.Measure(0, count, box, centers);
+
+    // uma árvore binária com count folhas tem no máximo 2 x count - 1 nós
+    nodes.resize(size_t(count) * 2 - 1);
+    builder.Split(0, 0, count, 0, box, centers);
+    nodes.resize(builder.used);
+    nodes.shrink_to_fit();
+
+    // triângulos na ordem das folhas, como um vértice e duas arestas
+    triangles.resize(count);
+    triangleId.resize(count);
+    auto store = [&](uint first, uint last)
+    {
+        for (uint i = first; i < last; ++i)
+        {
+            triangleId[i] = builder.refs[i].id;
+            const uint * tri = indices + 3 * size_t(triangleId[i]);
+            XMVECTOR a = XMLoadFloat3(&positions[tri[0] < vertexCount ? tri[0] : 0]);
+            XMVECTOR b = XMLoadFloat3(&positions[tri[1] < vertexCount ? tri[1] : 0]);
+            XMVECTOR c = XMLoadFloat3(&positions[tri[2] < vertexCount ? tri[2] : 0]);
+            XMStoreFloat3(&triangles[i].v0, a);
+            XMStoreFloat3(&triangles[i].e1, b - a);
+            XMStoreFloat3(&triangles[i].e2, c - a);
+        }
+    };
+
+    if (jobs)
+        jobs->ParallelFor(count, BinGrain, store);
+    else
+        store(0, count);
+
+    // estatísticas percorrendo a árvore
+    stats.triangles = count;
+    stats.nodes = uint(nodes.size());
+
+    auto area = [](const Node & n)
+    {
+        float dx = n.max.x - n.min.x;
+        float dy = n.max.y - n.min.y;
+        float dz = n.max.z - n.min.z;
+        return 2.0 * (double(dx) * dy + double(dy) * dz + double(dz) * dx);
+    };
+
+    double rootArea = area(nodes[0]);
+    vector<std::pair<uint, uint>> pending = { { 0u, 1u } };
+    while (!pending.empty())
+    {
+        uint index = pending.back().first;
+        uint depth = pending.back().second;
+        pending.pop_back();
+
+        const Node & n = nodes[index];
+        double relative = rootArea > 0.0 ? area(n) / rootArea : 1.0;
+        stats.depth = depth > stats.depth ? depth : stats.depth;
+
+        if (n.count)
+        {
+            ++stats.leaves;
+            stats.sahCost += relative * n.count * IntersectCost;
+        }
+        else
+        {
+            stats.sahCost += relative * TraversalCost;
+            pending.push_back({ n.first, depth + 1 });
+            pending.push_back({ n.first + 1, depth + 1 });
+        }
+    }
+
+    stats.seconds = timer.Elapsed();
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Clear()
+{
+    nodes.clear();
+    triangles.clear();
+    triangleId.clear();
+}
+
+// -------------------------------------------------------------------------------
+// Travessia de um raio
+
+// entrada do raio na caixa antes de tMax (falso se não a atinge)
+static inline bool HitBox(const XMFLOAT3 & bmin, const XMFLOAT3 & bmax,
+                          const float * o, const float * inv, float tMax, float & tNear)
+{
+    const float * lo = &bmin.x;
+    const float * hi = &bmax.x;
+    float t0 = 0.0f;
+    float t1 = tMax;
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        float a = (lo[i] - o[i]) * inv[i];
+        float b = (hi[i] - o[i]) * inv[i];
+        float enter = a < b ? a : b;
+        float leave = a < b ? b : a;
+        t0 = enter > t0 ? enter : t0;
+        t1 = leave < t1 ? leave : t1;
+    }
+
+    tNear = t0;
+    return t0 <= t1;
+}
+
+// -------------------------------------------------------------------------------
+
+RayHit Bvh::Intersect(const Ray & ray, float maxDistance) const
+{
+    RayHit hit = { None, maxDistance, 0.0f, 0.0f };
+    if (nodes.empty())
+        return hit;
+
+    const float * o = &ray.origin.x;
+    const float * d = &ray.direction.x;
+    float inv[3] = { 1.0f / d[0], 1.0f / d[1], 1.0f / d[2] };
+
+    float tNear;
+    if (!HitBox(nodes[0].min, nodes[0].max, o, inv, hit.distance, tNear))
+        return hit;
+
+    // nós adiados com a distância de entrada
+    uint stack[StackSize];
+    float stackNear[StackSize];
+    uint top = 0;
+    uint index = 0;
+    uint found = None;
+
+    for (;;)
+    {
+        const Node & node = nodes[index];
+
+        if (node.count)
+        {
+            // Möller e Trumbore: o mesmo cálculo do pacote de 4 raios
+            for (uint k = node.first; k < node.first + node.count; ++k)
+            {
+                const Triangle & tri = triangles[k];
+                float px = d[1] * tri.e2.z - d[2] * tri.e2.y;
+                float py = d[2] * tri.e2.x - d[0] * tri.e2.z;
+                float pz = d[0] * tri.e2.y - d[1] * tri.e2.x;
+                float det = tri.e1.x * px + tri.e1.y * py + tri.e1.z * pz;
+                if (det == 0.0f)
+                    continue;
+
+                float invDet = 1.0f / det;
+                float sx = o[0] - tri.v0.x;
+                float sy = o[1] - tri.v0.y;
+                float sz = o[2] - tri.v0.z;
+                float u = (sx * px + sy * py + sz * pz) * invDet;
+                if (!(u >= 0.0f && u <= 1.0f))
+                    continue;
+
+                float qx = sy * tri.e1.z - sz * tri.e1.y;
+                float qy = sz * tri.e1.x - sx * tri.e1.z;
+                float qz = sx * tri.e1.y - sy * tri.e1.x;
+                float v = (d[0] * qx + d[1] * qy + d[2] * qz) * invDet;
+                if (!(v >= 0.0f && u + v <= 1.0f))
+                    continue;
+
+                float t = (tri.e2.x * qx + tri.e2.y * qy + tri.e2.z * qz) * invDet;
+                if (t >= 0.0f && t < hit.distance)
+                {
+                    hit.distance = t;
+                    hit.u = u;
+                    hit.v = v;
+                    found = k;
+                }
+            }
+        }
+        else
+        {
+            // desce pelo filho mais próximo e adia o outro
+            float near0, near1;
+            bool hit0 = HitBox(nodes[node.first].min, nodes[node.first].max, o, inv, hit.distance, near0);
+            bool hit1 = HitBox(nodes[node.first + 1].min, nodes[node.first + 1].max, o, inv, hit.distance, near1);
+
+            if (hit0 && hit1)
+            {
+                bool swap = near1 < near0;
+                stack[top] = swap ? node.first : node.first + 1;
+                stackNear[top] = swap ? near0 : near1;
+                ++top;
+                index = swap ? node.first + 1 : node.first;
+                continue;
+            }
+            if (hit0 || hit1)
+            {
+                index = hit0 ? node.first : node.first + 1;
+                continue;
+            }
+        }
+
+        // próximo nó adiado que ainda pode ter algo mais perto
+        while (top > 0 && stackNear[top - 1] >= hit.distance)
+            --top;
+        if (top == 0)
+            break;
+        index = stack[--top];
+    }
+
+    if (found != None)
+        hit.triangle = triangleId[found];
+
+    return hit;
+}
+
+// -------------------------------------------------------------------------------
+// Travessia de um pacote de 4 raios
+
+// máscara dos raios que entram na caixa antes de tMax e suas distâncias de entrada
+static inline int HitBox4(const XMFLOAT3 & bmin, const XMFLOAT3 & bmax,
+                          const __m128 o[3], const __m128 inv[3], __m128 tMax, __m128 & tNear)
+{
+    const float * lo = &bmin.x;
+    const float * hi = &bmax.x;
+    __m128 t0 = _mm_setzero_ps();
+    __m128 t1 = tMax;
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        __m128 a = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(lo[i]), o[i]), inv[i]);
+        __m128 b = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(hi[i]), o[i]), inv[i]);
+        t0 = _mm_max_ps(_mm_min_ps(a, b), t0);
+        t1 = _mm_min_ps(_mm_max_ps(a, b), t1);
+    }
+
+    tNear = t0;
+    return _mm_movemask_ps(_mm_cmple_ps(t0, t1));
+}
+
+// menor distância de entrada entre os raios da máscara
+static inline float NearestOf(__m128 tNear, int mask)
+{
+    alignas(16) float t[4];
+    _mm_store_ps(t, tNear);
+
+    float nearest = FLT_MAX;
+    for (uint i = 0; i < 4; ++i)
+        if ((mask >> i) & 1)
+            nearest = t[i] < nearest ? t[i] : nearest;
+
+    return nearest;
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Intersect4(const Ray rays[4], RayHit hits[4], float maxDistance) const
+{
+    for (uint i = 0; i < 4; ++i)
+        hits[i] = { None, maxDistance, 0.0f, 0.0f };
+
+    if (nodes.empty())
+        return;
+
+    // mesmo componente dos 4 raios em cada registrador
+    __m128 o[3], d[3], inv[3];
+    for (uint c = 0; c < 3; ++c)
+    {
+        o[c] = _mm_setr_ps((&rays[0].origin.x)[c], (&rays[1].origin.x)[c], (&rays[2].origin.x)[c], (&rays[3].origin.x)[c]);
+        d[c] = _mm_setr_ps((&rays[0].direction.x)[c], (&rays[1].direction.x)[c], (&rays[2].direction.x)[c], (&rays[3].direction.x)[c]);
+        inv[c] = _mm_div_ps(_mm_set1_ps(1.0f), d[c]);
+    }
+
+    __m128 tMax = _mm_set1_ps(maxDistance);
+    __m128 hitU = _mm_setzero_ps();
+    __m128 hitV = _mm_setzero_ps();
+    __m128i found = _mm_set1_epi32(-1);
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 tNear;
+    if (!HitBox4(nodes[0].min, nodes[0].max, o, inv, tMax, tNear))
+        return;
+
+    uint stack[StackSize];
+    uint top = 0;
+    uint index = 0;
+
+    for (;;)
+    {
+        const Node & node = nodes[index];
+
+        if (node.count)
+        {
+            for (uint k = node.first; k < node.first + node.count; ++k)
+            {
+                const Triangle & tri = triangles[k];
+                __m128 e1x = _mm_set1_ps(tri.e1.x), e1y = _mm_set1_ps(tri.e1.y), e1z = _mm_set1_ps(tri.e1.z);
+                __m128 e2x = _mm_set1_ps(tri.e2.x), e2y = _mm_set1_ps(tri.e2.y), e2z = _mm_set1_ps(tri.e2.z);
+
+                __m128 px = _mm_sub_ps(_mm_mul_ps(d[1], e2z), _mm_mul_ps(d[2], e2y));
+                __m128 py = _mm_sub_ps(_mm_mul_ps(d[2], e2x), _mm_mul_ps(d[0], e2z));
+                __m128 pz = _mm_sub_ps(_mm_mul_ps(d[0], e2y), _mm_mul_ps(d[1], e2x));
+                __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                __m128 invDet = _mm_div_ps(one, det);
+
+                __m128 sx = _mm_sub_ps(o[0], _mm_set1_ps(tri.v0.x));
+                __m128 sy = _mm_sub_ps(o[1], _mm_set1_ps(tri.v0.y));
+                __m128 sz = _mm_sub_ps(o[2], _mm_set1_ps(tri.v0.z));
+                __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+                __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+                __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+                __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+                __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d[0], qx), _mm_mul_ps(d[1], qy)), _mm_mul_ps(d[2], qz)), invDet);
+                __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+                __m128 valid = _mm_cmpneq_ps(det, zero);
+                valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+                valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+                valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, tMax)));
+
+                if (_mm_movemask_ps(valid) == 0)
+                    continue;
+
+                // troca só nas posições dos raios que acharam algo mais perto
+                tMax = _mm_or_ps(_mm_and_ps(valid, t), _mm_andnot_ps(valid, tMax));
+                hitU = _mm_or_ps(_mm_and_ps(valid, u), _mm_andnot_ps(valid, hitU));
+                hitV = _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, hitV));
+                __m128i mask = _mm_castps_si128(valid);
+                found = _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi32(int(k))), _mm_andnot_si128(mask, found));
+            }
+        }
+        else
+        {
+            // desce pelo filho em que algum raio entra primeiro
+            __m128 near0, near1;
+            int mask0 = HitBox4(nodes[node.first].min, nodes[node.first].max, o, inv, tMax, near0);
+            int mask1 = HitBox4(nodes[node.first + 1].min, nodes[node.first + 1].max, o, inv, tMax, near1);
+
+            if (mask0 && mask1)
+            {
+                bool swap = NearestOf(near1, mask1) < NearestOf(near0, mask0);
+                stack[top++] = swap ? node.first : node.first + 1;
+                index = swap ? node.first + 1 : node.first;
+                continue;
+            }
+            if (mask0 || mask1)
+            {
+                index = mask0 ? node.first : node.first + 1;
+                continue;
+            }
+        }
+
+        // próximo nó adiado que algum raio ainda atinge antes do que já achou
+        bool next = false;
+        while (top > 0 && !next)
+        {
+            index = stack[--top];
+            next = HitBox4(nodes[index].min, nodes[index].max, o, inv, tMax, tNear) != 0;
+        }
+        if (!next)
+            break;
+    }
+
+    alignas(16) float distance[4], u[4], v[4];
+    alignas(16) int triangle[4];
+    _mm_store_ps(distance, tMax);
+    _mm_store_ps(u, hitU);
+    _mm_store_ps(v, hitV);
+    _mm_store_si128((__m128i*) triangle, found);
+
+    for (uint i = 0; i < 4; ++i)
+    {
+        if (triangle[i] < 0)
+            continue;
+
+        hits[i].triangle = triangleId[triangle[i]];
+        hits[i].distance = distance[i];
+        hits[i].u = u[i];
+        hits[i].v = v[i];
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Bvh::Intersect(const Ray * rays, uint count, RayHit * hits, float maxDistance) const
+{
+    uint packets = count / 4;
+    for (uint p = 0; p < packets; ++p)
+        Intersect4(rays + 4 * p, hits + 4 * p, maxDistance);
+
+    for (uint i = packets * 4; i < count; ++i)
+        hits[i] = Intersect(rays[i], maxDistance);
+}
+
+// -------------------------------------------------------------------------------
+
+Ray PickRay(float x, float y, float width, float height, const XMFLOAT4X4 & viewProj)
+{
+    // centro do pixel em coordenadas normalizadas (y para cima)
+    float nx = 2.0f * (x + 0.5f) / width - 1.0f;
+    float ny = 1.0f - 2.0f * (y + 0.5f) / height;
+
+    // pontos nos planos próximo (z = 0) e distante (z = 1) de volta ao espaço
+    // da matriz
+    XMMATRIX inverse = XMMatrixInverse(nullptr, XMLoadFloat4x4(&viewProj));
+    XMVECTOR nearPoint = XMVector3TransformCoord(XMVectorSet(nx, ny, 0.0f, 1.0f), inverse);
+    XMVECTOR farPoint = XMVector3TransformCoord(XMVectorSet(nx, ny, 1.0f, 1.0f), inverse);
+
+    Ray ray;
+    XMStoreFloat3(&ray.origin, nearPoint);
+    XMStoreFloat3(&ray.direction, XMVector3Normalize(farPoint - nearPoint));
+    return ray;
+}
+
+// -------------------------------------------------------------------------------
+// Medição da construção e da travessia
+
+string BvhBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << triangles << " triângulos, " << threads << " threads: construção "
+         << buildSerialMs << " ms em uma thread, " << buildParallelMs << " ms em paralelo ("
+         << buildSerialMs / buildParallelMs << "x); " << stats.nodes << " nós, profundidade "
+         << stats.depth << ", custo SAH " << stats.sahCost << "; "
+         << rays << " raios (" << hitFraction * 100.0 << "% atingem): um a um "
+         << singlePerSec / 1e6 << " milhões/s, pacotes de 4 " << packetPerSec / 1e6
+         << " milhões/s, força bruta " << bruteForcePerSec << " raios/s; "
+         << mismatches << " resultados diferentes";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+BvhBenchmark BenchmarkBvh(uint triangles, uint side, uint threads)
+{
+    Timer timer;
+
+    JobSystem jobs(threads);
+
+    BvhBenchmark result = {};
+    result.threads = jobs.Threads();
+    side = side ? side : 1;
+
+    // terreno em grade com ondulações: dois triângulos por célula
+    uint cells = uint(std::sqrt(double(triangles ? triangles : 2) / 2.0));
+    cells = cells ? cells : 1;
+    uint grid = cells + 1;
+
+    vector<XMFLOAT3> positions(size_t(grid) * grid);
+    for (uint z = 0; z < grid; ++z)
+        for (uint x = 0; x < grid; ++x)
+        {
+            float fx = float(x) / cells;
+            float fz = float(z) / cells;
+            float h = 0.05f * std::sin(fx * 37.0f) * std::cos(fz * 23.0f) + 0.02f * std::sin((fx + fz) * 91.0f);
+            positions[size_t(z) * grid + x] = XMFLOAT3(fx * 2.0f - 1.0f, h, fz * 2.0f - 1.0f);
+        }
+
+    vector<uint> indices;
+    indices.reserve(size_t(cells) * cells * 6);
+    for (uint z = 0; z < cells; ++z)
+        for (uint x = 0; x < cells; ++x)
+        {
+            uint a = z * grid + x;
+            uint b = a + 1;
+            uint c = a + grid;
+            uint d = c + 1;
+            indices.insert(indices.end(), { a, c, b, b, c, d });
+        }
+
+    result.triangles = uint(indices.size() / 3);
+
+    // construção em uma thread e com o sistema de trabalhos
+    Bvh bvh;
+    result.buildSerialMs = bvh.Build(positions.data(), uint(positions.size()), indices.data(), uint(indices.size())).seconds * 1000.0;
+    result.stats = bvh.Build(positions.data(), uint(positions.size()), indices.data(), uint(indices.size()), &jobs);
+    result.buildParallelMs = result.stats.seconds * 1000.0;
+
+    // raios primários de uma câmera oblíqua, em blocos de 2 x 2 pixels
+    XMFLOAT4X4 viewProj;
+    XMStoreFloat4x4(&viewProj,
+        XMMatrixLookAtLH(XMVectorSet(0.0f, 0.8f, -1.6f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f))
+        * XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 1.0f, 0.1f, 10.0f));
+
+    side = (side + 1) & ~1u;
+    result.rays = side * side;
+    vector<Ray> rays;
+    rays.reserve(result.rays);
+    for (uint y = 0; y < side; y += 2)
+        for (uint x = 0; x < side; x += 2)
+            for (uint k = 0; k < 4; ++k)
+                rays.push_back(PickRay(float(x + (k & 1)), float(y + (k >> 1)), float(side), float(side), viewProj));
+
+    vector<RayHit> single(result.rays);
+    vector<RayHit> packet(result.rays);
+
+    timer.Start();
+    for (uint i = 0; i < result.rays; ++i)
+        single[i] = bvh.Intersect(rays[i]);
+    result.singlePerSec = result.rays / timer.Elapsed();
+
+    timer.Start();
+    bvh.Intersect(rays.data(), result.rays, packet.data());
+    result.packetPerSec = result.rays / timer.Elapsed();
+
+    // mesmo ponto (o triângulo pode diferir só em arestas compartilhadas)
+    auto differ = [](const RayHit & a, const RayHit & b)
+    {
+        if (a.Hit() != b.Hit())
+            return true;
+        return a.Hit() && std::fabs(a.distance - b.distance) > 1e-5f * (1.0f + a.distance);
+    };
+
+    uint hits = 0;
+    for (uint i = 0; i < result.rays; ++i)
+    {
+        hits += single[i].Hit();
+        result.mismatches += differ(single[i], packet[i]);
+    }
+    result.hitFraction = double(hits) / result.rays;
+
+    // alguns raios testados contra todos os triângulos
+    const uint samples = 16;
+    uint step = result.rays / samples ? result.rays / samples : 1;
+    timer.Start();
+    for (uint s = 0; s < samples && s * step < result.rays; ++s)
+    {
+        const Ray & ray = rays[s * step];
+        const float * o = &ray.origin.x;
+        const float * d = &ray.direction.x;
+        RayHit best = { Bvh::None, FLT_MAX, 0.0f, 0.0f };
+
+        for (uint t = 0; t < result.triangles; ++t)
+        {
+            XMVECTOR a = XMLoadFloat3(&positions[indices[3 * t]]);
+            XMVECTOR e1 = XMLoadFloat3(&positions[indices[3 * t + 1]]) - a;
+            XMVECTOR e2 = XMLoadFloat3(&positions[indices[3 * t + 2]]) - a;
+            XMVECTOR dir = XMVectorSet(d[0], d[1], d[2], 0.0f);
+            XMVECTOR p = XMVector3Cross(dir, e2);
+            float det = XMVectorGetX(XMVector3Dot(e1, p));
+            if (det == 0.0f)
+                continue;
+
+            XMVECTOR sv = XMVectorSet(o[0], o[1], o[2], 0.0f) - a;
+            float u = XMVectorGetX(XMVector3Dot(sv, p)) / det;
+            XMVECTOR q = XMVector3Cross(sv, e1);
+            float v = XMVectorGetX(XMVector3Dot(dir, q)) / det;
+            float dist = XMVectorGetX(XMVector3Dot(e2, q)) / det;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && dist >= 0.0f && dist < best.distance)
+                best = { t, dist, u, v };
+        }
+
+        result.mismatches += differ(best, single[s * step]);
+    }
+    result.bruteForcePerSec = samples / timer.Elapsed();
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
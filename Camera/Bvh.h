@@ -0,0 +1,176 @@
+/**********************************************************************************
+// Bvh (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Hierarquia de volumes envolventes sobre os triângulos de uma
+//              malha, para seleção com o mouse e consultas de raios.
+//
+//              A construção divide os triângulos pela heurística de área de
+//              superfície (SAH) avaliada em faixas ao longo de cada eixo: os
+//              centróides são distribuídos em Bins faixas e o custo de cada
+//              corte entre faixas é calculado com a área e o número de
+//              triângulos dos dois lados. Nós grandes contam as faixas em
+//              paralelo e constroem as duas subárvores como trabalhos
+//              independentes do sistema de trabalhos.
+//
+//              Os nós ocupam 32 bytes e os dois filhos ficam lado a lado. Os
+//              triângulos são guardados na ordem das folhas como um vértice
+//              e duas arestas, prontos para o teste de Möller e Trumbore.
+//              Um raio percorre a árvore sozinho ou em pacotes de 4 raios
+//              (SSE), que testam cada nó e cada triângulo com os 4 raios de
+//              uma vez e descem enquanto algum deles ainda o atinge.
+//
+**********************************************************************************/
+
+#ifndef DXUT_BVH_H
+#define DXUT_BVH_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "JobSystem.h"                  // construção paralela
+#include <DirectXMath.h>
+#include <cfloat>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// raio: origin + t * direction, com t >= 0
+struct Ray
+{
+    XMFLOAT3 origin;                    // ponto de partida
+    XMFLOAT3 direction;                 // direção (não precisa ser unitária)
+};
+
+// interseção mais próxima de um raio
+struct RayHit
+{
+    uint  triangle;                     // triângulo atingido (Bvh::None se nenhum)
+    float distance;                     // parâmetro t do ponto (distância se a direção é unitária)
+    float u;                            // coordenadas baricêntricas: o ponto é
+    float v;                            // (1 - u - v) * a + u * b + v * c
+
+    bool Hit() const;                   // o raio atingiu algum triângulo
+};
+
+// resultado da construção
+struct BvhStats
+{
+    uint   triangles;                   // triângulos na árvore
+    uint   nodes;                       // nós usados
+    uint   leaves;                      // folhas
+    uint   depth;                       // maior profundidade
+    double sahCost;                     // custo SAH da árvore (relativo à raiz)
+    double seconds;                     // tempo da construção
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class Bvh
+{
+public:
+    static constexpr uint None = 0xffffffff;    // nenhum triângulo atingido
+    static const uint Bins = 16;                // faixas da SAH por eixo
+    static const uint MaxLeafSize = 8;          // triângulos de uma folha sem corte útil
+    static const uint MaxDepth = 48;            // a partir daqui divide pela mediana
+    static const uint StackSize = 128;          // pilha da travessia
+
+private:
+    // caixa do nó; folhas apontam para count triângulos a partir de first e
+    // nós internos (count = 0) para os filhos first e first + 1
+    struct Node
+    {
+        XMFLOAT3 min;
+        uint first;
+        XMFLOAT3 max;
+        uint count;
+    };
+
+    // triângulo pronto para o teste de interseção
+    struct Triangle
+    {
+        XMFLOAT3 v0;                    // primeiro vértice
+        XMFLOAT3 e1;                    // v1 - v0
+        XMFLOAT3 e2;                    // v2 - v0
+    };
+
+    struct Builder;
+    friend struct Builder;
+
+    vector<Node> nodes;                 // raiz na posição 0
+    vector<Triangle> triangles;         // na ordem das folhas
+    vector<uint> triangleId;            // triângulo original de cada posição
+
+public:
+    // constrói a árvore sobre os triângulos indices[3t, 3t + 3) (em paralelo se
+    // jobs não for nulo); os triângulos retornados são os valores de t
+    BvhStats Build(const XMFLOAT3 * positions, uint vertexCount,
+                   const uint * indices, uint indexCount,
+                   JobSystem * jobs = nullptr);
+
+    void Clear();                       // remove a árvore
+    uint Triangles() const;             // triângulos na árvore
+
+    // interseção mais próxima com t em [0, maxDistance)
+    RayHit Intersect(const Ray & ray, float maxDistance = FLT_MAX) const;
+
+    // interseções de um pacote de 4 raios (mais rápido com raios próximos)
+    void Intersect4(const Ray rays[4], RayHit hits[4], float maxDistance = FLT_MAX) const;
+
+    // interseções de count raios em pacotes de 4
+    void Intersect(const Ray * rays, uint count, RayHit * hits, float maxDistance = FLT_MAX) const;
+};
+
+// -------------------------------------------------------------------------------
+
+// raio da câmera pelo pixel (x, y) de uma tela width x height; com
+// mundo x visão x projeção o raio fica no espaço do objeto
+Ray PickRay(float x, float y, float width, float height, const XMFLOAT4X4 & viewProj);
+
+// -------------------------------------------------------------------------------
+
+// medição da construção e da travessia sobre um terreno de triângulos
+struct BvhBenchmark
+{
+    uint   triangles;                   // triângulos da malha
+    uint   threads;                     // threads de trabalho
+    uint   rays;                        // raios por medição
+    BvhStats stats;                     // árvore construída em paralelo
+    double buildSerialMs;               // construção em uma thread (ms)
+    double buildParallelMs;             // construção com o sistema de trabalhos (ms)
+    double hitFraction;                 // fração dos raios que atinge a malha
+    double singlePerSec;                // raios/s percorrendo um a um
+    double packetPerSec;                // raios/s em pacotes de 4
+    double bruteForcePerSec;            // raios/s testando todos os triângulos
+    uint   mismatches;                  // resultados diferentes entre os métodos
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// constrói a árvore sobre um terreno com cerca de triangles triângulos e
+// lança raios primários de uma câmera de side x side pixels
+BvhBenchmark BenchmarkBvh(uint triangles = 2000000, uint side = 1024, uint threads = 0);
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// o raio atingiu algum triângulo
+inline bool RayHit::Hit() const
+{ return triangle != Bvh::None; }
+
+// triângulos na árvore
+inline uint Bvh::Triangles() const
+{ return uint(triangles.size()); }
+
+// -------------------------------------------------------------------------------
+
+#endif
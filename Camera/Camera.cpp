@@ -1,11 +1,11 @@
 /**********************************************************************************
-// Camera (Cdigo Fonte)
+// Camera (Código Fonte)
 //
-// Criao:		27 Abr 2016
-// Atualizao:	26 Set 2021
+// Criação:		27 Abr 2016
+// Atualização:	17 Out 2026
 // Compilador:	Visual C++ 2019
 //
-// Descrio:	Controla a cmera em uma cena 3D
+// Descrição:	Controla a câmera em uma cena 3D
 //
 **********************************************************************************/
 
@@ -13,61 +13,45 @@
 
 // ------------------------------------------------------------------------------
 
+Camera::Camera(const CameraOptions & options) : scene(options)
+{
+}
 
-
+// ------------------------------------------------------------------------------
 
 void Camera::Init()
 {
-	medidorTempo.Start();
-	spin = true;
-	listIndex = {};
-	listVertex = {};
-	contadorNormal = 0;
-	contadorVertex = 0;
-	contadorTexture = 0;
-	readObject();
-
-	theta = XM_PIDIV4;
-	phi = XM_PIDIV4;
-	radius = 5.0f;
-
-	// pega ltima posio do mouse
+	// malha, instâncias e matrizes da cena (a mesma do CameraHeadless)
+	if (!scene.Init(jobs, window->Width(), window->Height()))
+	{
+		OutputDebugString("Impossível abrir o arquivo .obj\n");
+		exit(1);
+	}
+
+	// pega última posição do mouse
 	lastMousePosX = (float)input->MouseX();
 	lastMousePosY = (float)input->MouseY();
 
-	// inicializa as matrizes World e View para a identidade
-	World = View = {
-		1.0f, 0.0f, 0.0f, 0.0f,
-		0.0f, 1.0f, 0.0f, 0.0f,
-		0.0f, 0.0f, 1.0f, 0.0f,
-		0.0f, 0.0f, 0.0f, 1.0f };
-
-	// inicializa a matriz de projeo
-	XMStoreFloat4x4(&Proj, XMMatrixPerspectiveFovLH(
-		XMConvertToRadians(45.0f),
-		window->AspectRatio(),
-		1.0f, 100.0f));
-
-	// contri geometria e inicializa pipeline
-	graphics->ResetCommands();
-	// ---------------------------------------
-	BuildConstantBuffers();
-	BuildGeometry();
-	BuildRootSignature();
-	BuildPipelineState();
-	// ---------------------------------------
-	graphics->SubmitCommands();
-
-
-
-
-
+	// sem janela a cena desenha direto nos buffers da malha na memória
+	if (!rasterizer)
+	{
+		// contrói geometria e inicializa pipeline
+		graphics->ResetCommands();
+		// ---------------------------------------
+		BuildGeometry();
+		BuildRootSignature();
+		BuildPipelineState();
+		// ---------------------------------------
+		graphics->SubmitCommands();
+	}
 }
 
 // ------------------------------------------------------------------------------
 
 void Camera::Update()
 {
+	// estado da atualização anterior: ponto de partida da interpolação no desenho
+	scene.Save();
 
 	// sai com o pressionamento da tecla ESC
 	if (input->KeyPress(VK_ESCAPE))
@@ -75,32 +59,29 @@ void Camera::Update()
 
 	// ativa ou desativa o giro do objeto
 	if (input->KeyPress('S'))
-	{
-		spin = spin ? false : true;
+		scene.ToggleSpin();
 
-		if (spin)
-			medidorTempo.Start();
-		else
-			medidorTempo.Stop();
-	}
+	// ativa ou desativa o descarte de agrupamentos de costas
+	if (input->KeyPress('C'))
+		scene.ToggleConeCulling();
 
 
 	float mousePosX = (float)input->MouseX();
 	float mousePosY = (float)input->MouseY();
 
+	// seleciona o triângulo sob o cursor (matrizes do quadro anterior)
+	if (input->KeyPress(VK_MBUTTON))
+		OutputDebugString(scene.Pick(mousePosX, mousePosY).c_str());
+
 	if (input->KeyDown(VK_LBUTTON))
 	{
 		// cada pixel corresponde a 1/4 de grau
 		float dx = XMConvertToRadians(0.25f * (mousePosX - lastMousePosX));
 		float dy = XMConvertToRadians(0.25f * (mousePosY - lastMousePosY));
 
-		// atualiza ngulos com base no deslocamento do mouse 
-		// para orbitar a cmera ao redor da caixa
-		theta += dx;
-		phi += dy;
-
-		// restringe o ngulo de phi ]0-180[ graus
-		phi = phi < 0.1f ? 0.1f : (phi > (XM_PI - 0.1f) ? XM_PI - 0.1f : phi);
+		// atualiza ângulos com base no deslocamento do mouse 
+		// para orbitar a câmera ao redor da caixa
+		scene.Orbit(dx, dy);
 	}
 	else if (input->KeyDown(VK_RBUTTON))
 	{
@@ -108,59 +89,61 @@ void Camera::Update()
 		float dx = 0.05f * (mousePosX - lastMousePosX);
 		float dy = 0.05f * (mousePosY - lastMousePosY);
 
-		// atualiza o raio da cmera com base no deslocamento do mouse 
-		radius += dx - dy;
-
-		// restringe o raio (3 a 15 unidades)
-		radius = radius < 3.0f ? 3.0f : (radius > 15.0f ? 15.0f : radius);
+		// atualiza o raio da câmera com base no deslocamento do mouse 
+		scene.Zoom(dx - dy);
 	}
 
 	lastMousePosX = mousePosX;
 	lastMousePosY = mousePosY;
 
-	// converte coordenadas esfricas para cartesianas
-	float x = radius * sinf(phi) * cosf(theta);
-	float z = radius * sinf(phi) * sinf(theta);
-	float y = radius * cosf(phi);
-
-	// constri a matriz da cmera (view matrix)
-	XMVECTOR pos = XMVectorSet(x, y, z, 1.0f);
-	XMVECTOR target = XMVectorZero();
-	XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-	XMMATRIX view = XMMatrixLookAtLH(pos, target, up);
-	XMStoreFloat4x4(&View, view);
-
-	// constri matriz combinada (world x view x proj)
-	XMMATRIX world = XMMatrixRotationY(float(medidorTempo.Elapsed())/2);
-	XMMATRIX proj = XMLoadFloat4x4(&Proj);
-	XMMATRIX WorldViewProj = world * view * proj;
-
-	// atualiza o buffer constante com a matriz combinada
-	ObjectConstants objConstants;
-	XMStoreFloat4x4(&objConstants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
-	memcpy(constantBufferData, &objConstants, sizeof(ObjectConstants));
-
+	// o giro avança com o tempo de cada atualização (um passo no passo fixo)
+	scene.Step(frameTime);
 }
 
 // ------------------------------------------------------------------------------
 
 void Camera::Draw()
 {
+	// matrizes e descarte com o estado interpolado pela fração do passo
+	// fixo que sobrou no acumulador (sem janela o quadro é o passo inteiro)
+	scene.Interpolate(rasterizer ? 1.0f : float(scheduler->Alpha()), frameTime);
+
+	// execução sem janela: mesmos comandos no renderizador em software
+	if (rasterizer)
+	{
+		scene.Draw(*rasterizer);
+		return;
+	}
+
+	Mesh* geometry = scene.Geometry();
+	uint visibleCount = scene.VisibleCount();
 
 	// limpa o backbuffer
 	graphics->Clear(pipelineState);
 
-	// comandos de configurao do pipeline
-	ID3D12DescriptorHeap* descriptorHeaps[] = { constantBufferHeap };
-	graphics->CommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+	// comandos de configuração do pipeline
 	graphics->CommandList()->SetGraphicsRootSignature(rootSignature);
 	graphics->CommandList()->IASetVertexBuffers(0, 1, geometry->VertexBufferView());
 	graphics->CommandList()->IASetIndexBuffer(geometry->IndexBufferView());
 	graphics->CommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	graphics->CommandList()->SetGraphicsRootDescriptorTable(0, constantBufferHeap->GetGPUDescriptorHandleForHeapStart());
 
-	// comando de desenho
-	graphics->CommandList()->DrawIndexedInstanced((uint)listIndex.size(), 1, 0, 0, 0);
+	// constantes copiadas para o anel de upload do quadro atual
+	UploadAllocation cb = graphics->AllocateUpload(sizeof(ObjectConstants));
+	memcpy(cb.cpu, &scene.Constants(), sizeof(ObjectConstants));
+	graphics->CommandList()->SetGraphicsRootConstantBufferView(0, cb.gpu);
+
+	// matrizes combinadas das instâncias visíveis calculadas em lote
+	// e gravadas direto no buffer por instância do anel de upload
+	if (visibleCount > 0)
+	{
+		UploadAllocation ib = graphics->AllocateUpload(visibleCount * sizeof(XMFLOAT4X4));
+		scene.InstanceMatrices((XMFLOAT4X4*) ib.cpu);
+		graphics->CommandList()->SetGraphicsRootShaderResourceView(1, ib.gpu);
+
+		// comandos de desenho (um por faixa visível do nível de detalhe)
+		for (const SubMesh& part : scene.DrawList())
+			graphics->CommandList()->DrawIndexedInstanced(part.indexCount, visibleCount, part.startIndex, part.baseVertex, 0);
+	}
 
 	// apresenta o backbuffer na tela
 	graphics->Present();
@@ -171,208 +154,18 @@ void Camera::Draw()
 
 void Camera::Finalize()
 {
-
-	constantBufferUpload->Unmap(0, nullptr);
-	constantBufferUpload->Release();
-	constantBufferHeap->Release();
-
-	rootSignature->Release();
-	pipelineState->Release();
-	delete geometry;
-
-}
-
-
-
-void Camera::readObject()
-{
-	ifstream fin;
-
-	fin.open("Resources/esfera_icosaedrica.obj");
-
-
-	if (!fin.is_open())
-	{
-
-
-		OutputDebugString("Impossvel abrir o arquivo .obj\n");
-		exit(1);
-	}
-	else
+	// sem janela nenhum recurso do Direct3D foi criado
+	if (!rasterizer)
 	{
-
-		string line;
-
-		while (fin.good())
-		{
-			getline(fin, line);
-			stringstream flush(line, std::stringstream::in);
-
-			std::string s;
-			flush >> s;
-
-
-
-			// linha de normal
-			if (flush.str()[0] == 'v' && flush.str()[1] == 'n')
-			{
-				contadorNormal++;
-				//OutputDebugString("linha vn\n");
-			}
-			else
-			{
-				// linha de textura
-				if (flush.str()[0] == 'v' && flush.str()[1] == 't')
-				{
-					contadorTexture++;
-					//OutputDebugString("linha vt\n");
-				}
-				else
-				{
-					// linha de vertice
-					if (flush.str()[0] == 'v')
-					{
-						//OutputDebugString("linha v\n");
-						contadorVertex++;
-
-						Vertex v;
-						if (azul)
-						{
-							v.Color = XMFLOAT4(Colors::Blue);
-							azul = !azul;
-						}
-						else
-						{
-							v.Color = XMFLOAT4(Colors::Pink);
-							azul = !azul;
-						}
-						
-						
-
-						flush >> v.Pos.x >> v.Pos.y >> v.Pos.z;
-						listVertex.push_back(v);
-
-
-					}
-					else
-					{
-						int tipo = 0;
-						if (contadorNormal) tipo++;
-						if (contadorVertex) tipo++;
-						if (contadorTexture) tipo++;
-
-
-						// face de f
-						if (flush.str()[0] == 'f')
-						{
-							uint tamanho_anterior = (uint)listIndex.size();
-
-							//OutputDebugString("linha f\n");
-							ushort index;
-							do {
-								stringstream ss2;
-								switch (tipo)
-								{
-
-									//f v1/t1/n1 v2/t2/n2 ...
-								case 3:
-									flush >> index;
-
-									flush.ignore();
-									// adicionando o indice no vetor de indices
-									listIndex.push_back(index - 1);
-
-									//ss2 << "Inseriu " << index - 1 << "\n";
-									//OutputDebugString(ss2.str().c_str());
-									flush >> index;
-									//ignorando a /
-									flush.ignore();
-									flush >> index;
-									//ignorando o espao
-									flush.ignore();
-									break;
-
-									//f v1//t1 v2//t2 ...
-								case 2:
-
-									flush >> index;
-									//ignorando as duas /
-									flush.ignore();
-									flush.ignore();
-
-									listIndex.push_back(index - 1);
-
-									flush >> index;
-									//ignorando o espao
-									flush.ignore();
-
-									break;
-
-
-								case 1:
-									// f v1 v2 ...
-									flush >> index;
-									listIndex.push_back(index - 1);
-									break;
-
-
-								}
-
-							} while (!flush.eof());
-
-							
-							uint vertices_lidos_linha = (uint)listIndex.size() - (uint)tamanho_anterior;
-
-
-							//OutputDebugString("\nEntrou aqui\n");
-							vector<ushort> manipulado;
-
-							// copiando os novos valores adicionados para o vetor de manipulaao
-							for (size_t cont = tamanho_anterior; cont < listIndex.size(); cont++)
-							{
-								manipulado.push_back(listIndex[cont]);
-							}
-
-							//removendo os valores adicionados no vetor de manipulacao do vetor original
-							for (size_t cont = 0; cont < vertices_lidos_linha; cont++)
-							{
-								listIndex.pop_back();
-							}
-
-							//manipulando o vetor de manipulao para gerar os triangulos
-							// thanks stackoverflow.com/questions/23723993/converting-quadriladerals-in-an-obj-file-into-triangles/23724231#23724231
-
-							for (size_t cont = 1; cont < manipulado.size() - 1; cont++)
-							{
-								listIndex.push_back(manipulado[0]);
-								listIndex.push_back(manipulado[cont]);
-								listIndex.push_back(manipulado[cont + 1]);
-							}
-							//manipulado.clear();
-
-
-						}
-
-					}
-
-				}
-			}
-		}
-		/*
-		for (auto& v : listVertex)
-		{
-			stringstream s;
-			s <<"Vertice: " <<  v.Pos.x << "," << v.Pos.y << "," << v.Pos.z << "\n";
-			OutputDebugString(s.str().c_str());
-			//s.str("");
-			//s << "Tamanho da listVertex = " << listVertex.size() << "\n";
-			//OutputDebugString(s.str().c_str());
-
-		}
-		*/
-
-		
-
+		rootSignature->Release();
+		pipelineState->Release();
+
+		// buffers da GPU voltam para as heaps compartilhadas (a malha é da cena)
+		Mesh* geometry = scene.Geometry();
+		graphics->Release(geometry->vertexBufferGPU);
+		graphics->Release(geometry->indexBufferGPU);
+		geometry->vertexBufferGPU = nullptr;
+		geometry->indexBufferGPU = nullptr;
 	}
 }
 
@@ -380,117 +173,39 @@ void Camera::readObject()
 //                                     D3D                                      
 // ------------------------------------------------------------------------------
 
-void Camera::BuildConstantBuffers()
-{
-
-	// descritor do buffer constante
-	// descritor do buffer constante
-	// descritor do buffer constante
-	D3D12_DESCRIPTOR_HEAP_DESC constantBufferHeapDesc = {};
-	constantBufferHeapDesc.NumDescriptors = 1;
-	constantBufferHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	constantBufferHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-	// cria descritor para buffer constante
-	graphics->Device()->CreateDescriptorHeap(&constantBufferHeapDesc, IID_PPV_ARGS(&constantBufferHeap));
-
-	// propriedades da heap do buffer de upload
-	D3D12_HEAP_PROPERTIES uploadHeapProperties = {};
-	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
-	uploadHeapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-	uploadHeapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-	uploadHeapProperties.CreationNodeMask = 1;
-	uploadHeapProperties.VisibleNodeMask = 1;
-
-	// o tamanho dos "Constant Buffers" precisam ser mltiplos 
-	// do tamanho de alocao mnima do hardware (256 bytes)
-	uint constantBufferSize = (sizeof(ObjectConstants) + 255) & ~255;
-
-	// descrio do buffer de upload
-	D3D12_RESOURCE_DESC uploadBufferDesc = {};
-	uploadBufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	uploadBufferDesc.Alignment = 0;
-	uploadBufferDesc.Width = constantBufferSize;
-	uploadBufferDesc.Height = 1;
-	uploadBufferDesc.DepthOrArraySize = 1;
-	uploadBufferDesc.MipLevels = 1;
-	uploadBufferDesc.Format = DXGI_FORMAT_UNKNOWN;
-	uploadBufferDesc.SampleDesc.Count = 1;
-	uploadBufferDesc.SampleDesc.Quality = 0;
-	uploadBufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-	uploadBufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-	// cria um buffer de upload para o buffer constante
-	graphics->Device()->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&uploadBufferDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&constantBufferUpload));
-
-	// endereo do buffer de upload na GPU
-	D3D12_GPU_VIRTUAL_ADDRESS uploadAddress = constantBufferUpload->GetGPUVirtualAddress();
-
-	// descreve view do buffer constante
-	D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc;
-	cbvDesc.BufferLocation = uploadAddress;
-	cbvDesc.SizeInBytes = constantBufferSize;
-
-	// cria uma view para o buffer constante
-	graphics->Device()->CreateConstantBufferView(
-		&cbvDesc,
-		constantBufferHeap->GetCPUDescriptorHandleForHeapStart());
-
-	// mapeia memria do upload buffer para um endereo acessvel pela CPU
-	constantBufferUpload->Map(0, nullptr, reinterpret_cast<void**>(&constantBufferData));
-
-}
-
-
-
-
 void Camera::BuildGeometry()
 {
-
-
-
-
-
 	// -----------------------------------------------------------
-	// >> Alocao e Cpia de Vertex e Index Buffers para a GPU <<
+	// >> Alocação e Cópia de Vertex e Index Buffers para a GPU <<
 	// -----------------------------------------------------------
 
-	// tamanho em bytes dos vrtices e ndices
-	uint vbSize = (uint)listVertex.size() * sizeof(Vertex);
-	uint ibSize = (uint)listIndex.size() * sizeof(ushort);
-	
-	// cria malha 3D
-	geometry = new Mesh("Box");
-
-	// ajusta atributos da malha 3D
-	geometry->vertexByteStride = sizeof(Vertex);
-	geometry->vertexBufferSize = vbSize;
-	geometry->indexFormat = DXGI_FORMAT_R16_UINT;
-	geometry->indexBufferSize = ibSize;
+	// formato, tamanhos e dados preparados pela cena (cache ou .obj)
+	Mesh* geometry = scene.Geometry();
+	const void* vertexData = scene.VertexData();
+	const void* indexData = scene.IndexData();
+	uint vbSize = geometry->vertexBufferSize;
+	uint ibSize = geometry->indexBufferSize;
 
 	// aloca recursos para o vertex buffer
 	graphics->Allocate(vbSize, &geometry->vertexBufferCPU);
-	graphics->Allocate(UPLOAD, vbSize, &geometry->vertexBufferUpload);
 	graphics->Allocate(GPU, vbSize, &geometry->vertexBufferGPU);
 
 	// aloca recursos para o index buffer
 	graphics->Allocate(ibSize, &geometry->indexBufferCPU);
-	graphics->Allocate(UPLOAD, ibSize, &geometry->indexBufferUpload);
 	graphics->Allocate(GPU, ibSize, &geometry->indexBufferGPU);
 
-	// guarda uma cpia dos vrtices e ndices na malha
-	graphics->Copy(&listVertex[0], vbSize, geometry->vertexBufferCPU);
-	graphics->Copy(&listIndex[0], ibSize, geometry->indexBufferCPU);
+	// guarda uma cópia dos vértices e índices na malha
+	graphics->Copy(vertexData, vbSize, geometry->vertexBufferCPU);
+	graphics->Copy(indexData, ibSize, geometry->indexBufferCPU);
+
+	// copia vértices e índices para a GPU em um único lote de envio
+	// (a área de upload é liberada quando a GPU concluir a cópia)
+	graphics->Upload(vertexData, vbSize, geometry->vertexBufferGPU);
+	graphics->Upload(indexData, ibSize, geometry->indexBufferGPU);
+	graphics->SubmitUploads();
 
-	// copia vrtices e ndices para a GPU usando o buffer de Upload
-	graphics->Copy(&listVertex[0], vbSize, geometry->vertexBufferUpload, geometry->vertexBufferGPU);
-	graphics->Copy(&listIndex[0], ibSize, geometry->indexBufferUpload, geometry->indexBufferGPU);
+	// os dados já estão nos buffers da malha
+	scene.ReleaseSource();
 }
 
 // ------------------------------------------------------------------------------
@@ -498,24 +213,24 @@ void Camera::BuildGeometry()
 void Camera::BuildRootSignature()
 {
 
-	// cria uma nica tabela de descritores de CBVs
-	D3D12_DESCRIPTOR_RANGE cbvTable = {};
-	cbvTable.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;
-	cbvTable.NumDescriptors = 1;
-	cbvTable.BaseShaderRegister = 0;
-	cbvTable.RegisterSpace = 0;
-	cbvTable.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
-
-	// parmetro raiz pode ser uma tabela, descritor raiz ou constantes raiz
-	D3D12_ROOT_PARAMETER rootParameters[1];
-	rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	// parâmetro raiz pode ser uma tabela, descritor raiz ou constantes raiz:
+	// um descritor raiz aponta direto para as constantes no anel de upload,
+	// sem precisar de uma heap de descritores
+	D3D12_ROOT_PARAMETER rootParameters[2];
+	rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
 	rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-	rootParameters[0].DescriptorTable.NumDescriptorRanges = 1;
-	rootParameters[0].DescriptorTable.pDescriptorRanges = &cbvTable;
+	rootParameters[0].Descriptor.ShaderRegister = 0;
+	rootParameters[0].Descriptor.RegisterSpace = 0;
 
-	// uma assinatura raiz  um vetor de parmetros raiz
+	// matrizes das instâncias lidas pelo vertex shader (StructuredBuffer em t0)
+	rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	rootParameters[1].Descriptor.ShaderRegister = 0;
+	rootParameters[1].Descriptor.RegisterSpace = 0;
+
+	// uma assinatura raiz é um vetor de parâmetros raiz
 	D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-	rootSigDesc.NumParameters = 1;
+	rootSigDesc.NumParameters = 2;
 	rootSigDesc.pParameters = rootParameters;
 	rootSigDesc.NumStaticSamplers = 0;
 	rootSigDesc.pStaticSamplers = nullptr;
@@ -536,8 +251,8 @@ void Camera::BuildRootSignature()
 		OutputDebugString((char*)error->GetBufferPointer());
 	}
 
-	// cria uma assinatura raiz com um nico slot que aponta para  
-	// uma faixa de descritores consistindo de um nico buffer constante
+	// cria uma assinatura raiz com um slot que aponta para um buffer
+	// constante e outro para as matrizes das instâncias
 	ThrowIfFailed(graphics->Device()->CreateRootSignature(
 		0,
 		serializedRootSig->GetBufferPointer(),
@@ -555,11 +270,7 @@ void Camera::BuildPipelineState()
 	// --- Input Layout ---
 	// --------------------
 
-	D3D12_INPUT_ELEMENT_DESC inputLayout[2] =
-	{
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-	};
+	// definido em Init conforme o formato dos vértices (VertexLayout)
 
 	// --------------------
 	// ----- Shaders ------
@@ -568,7 +279,11 @@ void Camera::BuildPipelineState()
 	ID3DBlob* vertexShader;
 	ID3DBlob* pixelShader;
 
-	D3DReadFileToBlob(L"Shaders/Vertex.cso", &vertexShader);
+	// vértices compactos usam a variante que recupera as posições
+	if (scene.Format() == VERTEX_FLOAT)
+		D3DReadFileToBlob(L"Shaders/Vertex.cso", &vertexShader);
+	else
+		D3DReadFileToBlob(L"Shaders/VertexPacked.cso", &vertexShader);
 	D3DReadFileToBlob(L"Shaders/Pixel.cso", &pixelShader);
 
 	// --------------------
@@ -578,7 +293,7 @@ void Camera::BuildPipelineState()
 	D3D12_RASTERIZER_DESC rasterizer = {};
 	rasterizer.FillMode = D3D12_FILL_MODE_SOLID;
 	//rasterizer.FillMode = D3D12_FILL_MODE_WIREFRAME;
-	rasterizer.CullMode = D3D12_CULL_MODE_NONE;
+	rasterizer.CullMode = scene.BackfaceCulling() ? D3D12_CULL_MODE_BACK : D3D12_CULL_MODE_NONE;
 	rasterizer.FrontCounterClockwise = FALSE;
 	rasterizer.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
 	rasterizer.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
@@ -635,7 +350,7 @@ void Camera::BuildPipelineState()
 	pso.SampleMask = UINT_MAX;
 	pso.RasterizerState = rasterizer;
 	pso.DepthStencilState = depthStencil;
-	pso.InputLayout = { inputLayout, 2 };
+	pso.InputLayout = { scene.InputLayout(), scene.InputCount() };
 	pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 	pso.NumRenderTargets = 1;
 	pso.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -651,6 +366,16 @@ void Camera::BuildPipelineState()
 
 
 
+// ------------------------------------------------------------------------------
+
+// mostra o resultado de uma medição e retorna o código de saída
+static int Report(const string & report)
+{
+	OutputDebugString(report.c_str());
+	MessageBox(nullptr, report.c_str(), "Câmera", MB_OK);
+	return 0;
+}
+
 // ------------------------------------------------------------------------------
 //                                  WinMain                                      
 // ------------------------------------------------------------------------------
@@ -662,28 +387,130 @@ int APIENTRY WinMain(_In_ HINSTANCE hInstance,
 {
 	try
 	{
+		// medições isoladas: não dependem do motor e encerram logo em seguida
+		if (strstr(lpCmdLine, "-rasterbench"))
+			return Report(BenchmarkRasterizer(800, 600).ToString() + "\n"
+				+ BenchmarkRasterizer(3840, 2160).ToString() + "\n");
+
+		// vazão da leitura de .obj contra a leitura antiga, de 1 mil a 10 milhões de vértices
+		if (strstr(lpCmdLine, "-objbench"))
+			return Report(BenchmarkObjLoader().ToString());
+
+		// partida sem cache (leitura do .obj) contra partida com cache
+		if (strstr(lpCmdLine, "-cachebench"))
+			return Report(BenchmarkMeshCache().ToString() + "\n");
+
+		// escala da leitura de .obj em trechos paralelos de 1 a 16 threads
+		if (strstr(lpCmdLine, "-objscaling"))
+			return Report(BenchmarkObjScaling().ToString());
+
+		// custo de leitura das fontes de tempo
+		if (strstr(lpCmdLine, "-timerbench"))
+			return Report(BenchmarkTimer().ToString() + "\n");
+
+		// sobreposição entre CPU e GPU com uma fila simulada
+		if (strstr(lpCmdLine, "-framebench"))
+		{
+			string report;
+			for (uint frames = 1; frames <= 3; ++frames)
+				report += BenchmarkFramesInFlight(frames).ToString() + "\n";
+			return Report(report);
+		}
+
+		// vazão do cálculo das matrizes das instâncias
+		if (strstr(lpCmdLine, "-instancebench"))
+			return Report(BenchmarkInstanceTransform().ToString() + "\n");
+
+		// descarte de 100 mil e 1 milhão de objetos
+		if (strstr(lpCmdLine, "-cullbench"))
+			return Report(BenchmarkObjectCull(100000).ToString() + "\n"
+				+ BenchmarkObjectCull(1000000).ToString() + "\n");
+
+		// construção da árvore de seleção e vazão de raios
+		if (strstr(lpCmdLine, "-bvhbench"))
+			return Report(BenchmarkBvh().ToString() + "\n");
+
+		// atualização das transformações de uma cena grande
+		if (strstr(lpCmdLine, "-scenebench"))
+			return Report(BenchmarkScene().ToString() + "\n");
+
+		// escala do sistema de trabalhos de 1 a 64 threads
+		if (strstr(lpCmdLine, "-jobbench"))
+			return Report(BenchmarkJobScaling().ToString() + "\n");
+
+		// grafos de trabalhos aleatórios sob carga (código de saída 1 em falhas)
+		if (strstr(lpCmdLine, "-jobstress"))
+		{
+			JobStressReport stress = StressJobGraph();
+			OutputDebugString(("---> Grafos de trabalhos: " + stress.ToString() + "\n").c_str());
+			return stress.Passed() ? 0 : 1;
+		}
+
+		// vazão e fragmentação do subalocador de heaps
+		if (strstr(lpCmdLine, "-heapbench"))
+			return Report(BenchmarkHeapChurn().ToString() + "\n");
+
+		// vazão de alocações do anel de upload
+		if (strstr(lpCmdLine, "-uploadbench"))
+			return Report(BenchmarkUploadRing().ToString() + "\n");
+
+		// vazão e latência da fila de eventos de entrada
+		if (strstr(lpCmdLine, "-inputbench"))
+			return Report(BenchmarkInputRing().ToString() + "\n");
+
+		// verificações determinísticas dos módulos (código de saída 1 em falhas)
+		if (strstr(lpCmdLine, "-selftest"))
+		{
+			string report;
+			bool passed = RunSelfTests(report);
+			Report(report);
+			return passed ? 0 : 1;
+		}
+
 		// cria motor e configura a janela
 		Engine* engine = new Engine();
 		engine->window->Mode(WINDOWED);
 		engine->window->Size(800, 600);
-		engine->window->Color(30, 30, 30);
-		engine->window->Title("Cmera");
+		engine->window->Color(SceneBackground[0], SceneBackground[1], SceneBackground[2]);
+		engine->window->Title("Câmera");
 		engine->window->Icon(IDI_ICON);
 		engine->window->Cursor(IDC_CURSOR);
 		engine->window->LostFocus(Engine::Pause);
 		engine->window->InFocus(Engine::Resume);
 
-		// cria e executa a aplicao
-		int exit = engine->Start(new Camera());
+		// agenda dos quadros: -fixed atualizações por segundo, -fps limite de quadros
+		const char* option = nullptr;
+		if ((option = strstr(lpCmdLine, "-fixed")))
+			engine->scheduler->FixedRate(atof(option + 6));
+		if ((option = strstr(lpCmdLine, "-fps")))
+			engine->scheduler->FrameLimit(atof(option + 4));
+
+		// opções da câmera: -instances N cópias da malha, -split submalhas de 16 bits,
+		// -noweld um vértice por posição do .obj, -unorm16 ou -half posições quantizadas,
+		// -backface descarta faces e agrupamentos de costas
+		CameraOptions options;
+		ParseCameraOptions(lpCmdLine, options);
+
+		// execução sem janela para testes em lote (código de saída 1 em falhas)
+		HeadlessSettings headless;
+		if (HeadlessOptions(lpCmdLine, headless))
+		{
+			int exit = engine->Start(new Camera(options), headless);
+			delete engine;
+			return exit;
+		}
+
+		// cria e executa a aplicação
+		int exit = engine->Start(new Camera(options));
 
-		// finaliza execuo
+		// finaliza execução
 		delete engine;
 		return exit;
 	}
 	catch (Error& e)
 	{
 		// exibe mensagem em caso de erro
-		MessageBox(nullptr, e.ToString().data(), "Cmera", MB_OK);
+		MessageBox(nullptr, e.ToString().data(), "Câmera", MB_OK);
 		return 0;
 	}
 }
@@ -0,0 +1,805 @@
+/**********************************************************************************
+// CameraScene (Código Fonte)
+//
+// Criação:     17 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cena da aplicação Câmera sem dependência do Windows.
+//
+**********************************************************************************/
+
+#include "CameraScene.h"
+#include "ObjLoader.h"
+#include "MeshSimplifier.h"
+#include "Timer.h"
+#include <DirectXColors.h>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+using std::stringstream;
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// -------------------------------------------------------------------------------
+
+// versão do processamento das malhas: mudanças invalidam caches gravados
+static const uint meshPipeline = 3;
+
+// frações dos triângulos originais em cada nível de detalhe
+static const float lodRatios[] = { 0.5f, 0.25f, 0.125f, 0.0625f };
+
+// descrição do input layout gravada no cache
+static void DescribeLayout(const D3D12_INPUT_ELEMENT_DESC * input, uint count, VertexElement * layout)
+{
+    for (uint i = 0; i < count; ++i)
+    {
+        layout[i] = {};
+        strncpy(layout[i].semantic, input[i].SemanticName, sizeof(layout[i].semantic) - 1);
+        layout[i].semanticIndex = input[i].SemanticIndex;
+        layout[i].format = input[i].Format;
+        layout[i].offset = input[i].AlignedByteOffset;
+    }
+}
+
+#ifdef _DEBUG
+// mensagens de depuração: saída de depuração no Windows, stderr nos demais
+static void DebugText(const string & text)
+{
+#ifdef _WIN32
+    OutputDebugString(text.c_str());
+#else
+    fputs(text.c_str(), stderr);
+#endif
+}
+#endif
+
+// -------------------------------------------------------------------------------
+
+void ParseCameraOptions(const string & cmdLine, CameraOptions & options)
+{
+    const char * line = cmdLine.c_str();
+    const char * option = nullptr;
+
+    if ((option = strstr(line, "-instances")))
+        options.instances = uint(atoi(option + 10));
+    options.splitIndices = strstr(line, "-split") != nullptr;
+    options.weld = strstr(line, "-noweld") == nullptr;
+    if (strstr(line, "-unorm16"))
+        options.vertexFormat = VERTEX_UNORM16;
+    else if (strstr(line, "-half"))
+        options.vertexFormat = VERTEX_HALF;
+    options.backfaceCulling = strstr(line, "-backface") != nullptr;
+}
+
+// -------------------------------------------------------------------------------
+
+CameraScene::CameraScene(const CameraOptions & options)
+{
+    instanceCount = options.instances ? options.instances : 1;
+    splitIndices = options.splitIndices;
+    weld = options.weld;
+    vertexFormat = options.vertexFormat;
+
+    // agrupamentos de costas só podem sumir se o rasterizador também
+    // descarta as faces de costas (malhas abertas mostram os dois lados)
+    backfaceCulling = options.backfaceCulling;
+    coneCulling = backfaceCulling;
+}
+
+// -------------------------------------------------------------------------------
+
+CameraScene::~CameraScene()
+{
+    delete geometry;
+}
+
+// -------------------------------------------------------------------------------
+
+bool CameraScene::Init(JobSystem * jobSystem, uint targetWidth, uint targetHeight)
+{
+    jobs = jobSystem;
+    width = targetWidth;
+    height = targetHeight;
+
+    spin = true;
+    listIndex = {};
+    listVertex = {};
+
+    // atributos dos vértices no formato escolhido
+    inputCount = VertexLayout(vertexFormat, false, inputLayout);
+
+    if (!ReadObject())
+        return false;
+
+    theta = XM_PIDIV4;
+    phi = XM_PIDIV4;
+    radius = 5.0f;
+
+    // instâncias em grade no plano XZ, com giro e escala variados, como
+    // folhas de uma raiz na cena (uma única instância fica na origem,
+    // sem giro nem escala)
+    const float spacing = 3.0f;
+    uint side = uint(ceil(sqrt(double(instanceCount))));
+    float extent = spacing * side;
+    float center = spacing * (side - 1) * 0.5f;
+
+    uint root = scene.Add();
+    for (uint i = 0; i < instanceCount; ++i)
+    {
+        float scale = 1.0f - (i % 4) * 0.15f;
+        XMFLOAT4 rotation;
+        XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(0.0f, i * 0.37f, 0.0f));
+        scene.Add(root, XMFLOAT3((i % side) * spacing - center, 0.0f, (i / side) * spacing - center),
+            rotation, XMFLOAT3(scale, scale, scale));
+    }
+    scene.Update(jobs);
+
+    instances.Resize(instanceCount);
+    for (uint i = 0; i < instanceCount; ++i)
+        instances.Set(i, scene.World(1 + i));
+
+    // a câmera se afasta o suficiente para ver a grade inteira
+    if (instanceCount > 1)
+    {
+        radius = extent;
+        maxRadius = 1.5f * extent;
+    }
+
+    // sem passo anterior o desenho começa no estado inicial
+    Save();
+
+    // inicializa a matriz View para a identidade
+    View = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f };
+
+    // inicializa a matriz de projeção
+    XMStoreFloat4x4(&Proj, XMMatrixPerspectiveFovLH(
+        XMConvertToRadians(45.0f),
+        float(width) / float(height),
+        1.0f, maxRadius > 50.0f ? 2.0f * maxRadius : 100.0f));
+
+    BuildGeometry();
+
+    // caixas envolventes das instâncias (a da malha vem da geometria)
+    bounds.Resize(instanceCount);
+    visibleList.resize(instanceCount);
+    for (uint i = 0; i < instanceCount; ++i)
+        bounds.SetBox(i, meshCenter, meshExtents, scene.World(1 + i));
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::ReleaseSource()
+{
+    vertexData = nullptr;
+    indexData = nullptr;
+
+    listVertex = {};
+    listIndex = {};
+    listIndex16 = {};
+    listPacked = {};
+    cache.Close();
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Save()
+{
+    lastTheta = theta;
+    lastPhi = phi;
+    lastRadius = radius;
+    lastSpinTime = spinTime;
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Orbit(float dTheta, float dPhi)
+{
+    theta += dTheta;
+    phi += dPhi;
+
+    // restringe o ângulo de phi ]0-180[ graus
+    phi = phi < 0.1f ? 0.1f : (phi > (XM_PI - 0.1f) ? XM_PI - 0.1f : phi);
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Zoom(float dRadius)
+{
+    radius += dRadius;
+
+    // restringe o raio (3 unidades até o limite da cena)
+    radius = radius < 3.0f ? 3.0f : (radius > maxRadius ? maxRadius : radius);
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Step(double dt)
+{
+    // o giro avança com o tempo de cada passo (um passo no passo fixo),
+    // o que mantém os quadros sem janela reproduzíveis
+    if (spin)
+        spinTime += dt;
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::ToggleSpin()
+{
+    spin = !spin;
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::ToggleConeCulling()
+{
+    coneCulling = backfaceCulling && !coneCulling;
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Interpolate(float alpha, double frameTime)
+{
+    // estado entre o passo anterior e o atual
+    float orbitTheta = lastTheta + (theta - lastTheta) * alpha;
+    float orbitPhi = lastPhi + (phi - lastPhi) * alpha;
+    float orbitRadius = lastRadius + (radius - lastRadius) * alpha;
+    double elapsed = lastSpinTime + (spinTime - lastSpinTime) * alpha;
+
+    // converte coordenadas esféricas para cartesianas
+    float x = orbitRadius * sinf(orbitPhi) * cosf(orbitTheta);
+    float z = orbitRadius * sinf(orbitPhi) * sinf(orbitTheta);
+    float y = orbitRadius * cosf(orbitPhi);
+
+    // constrói a matriz da câmera (view matrix)
+    XMVECTOR pos = XMVectorSet(x, y, z, 1.0f);
+    XMVECTOR target = XMVectorZero();
+    XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    XMMATRIX view = XMMatrixLookAtLH(pos, target, up);
+    XMStoreFloat4x4(&View, view);
+
+    // nível mais simples cujo erro projetado fica abaixo da tolerância
+    float pixelsPerUnit = height * 0.5f * Proj._22 / orbitRadius;
+    lodLevel = 0;
+    for (uint i = 1; i < geometry->lods.size(); ++i)
+        if (geometry->lods[i].error * pixelsPerUnit <= lodTolerance)
+            lodLevel = i;
+
+    // constrói matriz combinada (world x view x proj)
+    XMMATRIX world = XMMatrixRotationY(float(elapsed) / 2);
+
+    // 1% das instâncias também gira em torno do próprio eixo: só os nós
+    // alterados são recalculados e copiados para as matrizes das instâncias
+    if (instanceCount > 1 && spin)
+    {
+        for (uint i = 0; i < instanceCount; i += 100)
+        {
+            XMFLOAT4 rotation;
+            XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(0.0f, i * 0.37f + float(elapsed) * 2.0f, 0.0f));
+            scene.Rotation(1 + i, rotation);
+        }
+        scene.Update(jobs);
+
+        // as instâncias são folhas da raiz: só os nós girados mudam
+        for (uint i = 0; i < instanceCount; i += 100)
+        {
+            instances.Set(i, scene.World(1 + i));
+            bounds.SetBox(i, meshCenter, meshExtents, scene.World(1 + i));
+        }
+    }
+
+    XMMATRIX proj = XMLoadFloat4x4(&Proj);
+    XMMATRIX WorldViewProj = world * view * proj;
+
+    // faixas de índices visíveis no nível escolhido
+    CullGeometry(world, view * proj, pos, frameTime);
+
+    // guarda as constantes com a matriz combinada (enviadas à GPU no desenho)
+    XMStoreFloat4x4(&constants.WorldViewProj, XMMatrixTranspose(WorldViewProj));
+    XMStoreFloat4x4(&instanceViewProj, WorldViewProj);
+    constants.PosScale = XMFLOAT4(quantization.Scale.x, quantization.Scale.y, quantization.Scale.z, 0.0f);
+    constants.PosBias = XMFLOAT4(quantization.Bias.x, quantization.Bias.y, quantization.Bias.z, 0.0f);
+
+    // instâncias dentro do volume de visão
+    CullInstances(frameTime);
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::InstanceMatrices(XMFLOAT4X4 * out)
+{
+    // blocos da lista compacta distribuídos entre as threads de trabalho
+    const uint block = 1024;
+    jobs->ParallelFor((visibleCount + block - 1) / block, 1, [&](uint begin, uint end)
+    {
+        uint first = begin * block;
+        uint last = end * block < visibleCount ? end * block : visibleCount;
+        TransformInstanceList(instances, instanceViewProj, out + first, visibleList.data() + first, last - first);
+    });
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::Draw(Rasterizer & rasterizer)
+{
+    const float bgColor[4] = {
+        SceneBackground[0] / 255.0f, SceneBackground[1] / 255.0f, SceneBackground[2] / 255.0f, 1.0f };
+
+    rasterizer.Clear(bgColor);
+    rasterizer.SetVertexBuffer(vertexData, geometry->vertexByteStride,
+        geometry->vertexBufferSize / geometry->vertexByteStride, vertexFormat);
+    rasterizer.SetIndexBuffer(indexData, geometry->indexFormat);
+    rasterizer.SetConstants(&constants);
+
+    // as mesmas matrizes das instâncias visíveis enviadas à GPU
+    if (visibleCount > 0)
+    {
+        instanceMatrices.resize(visibleCount);
+        InstanceMatrices(instanceMatrices.data());
+        rasterizer.SetInstances(instanceMatrices.data(), visibleCount);
+
+        for (const SubMesh & part : drawList)
+            rasterizer.DrawIndexedInstanced(part.indexCount, visibleCount, part.startIndex, part.baseVertex, 0);
+    }
+
+    rasterizer.Present();
+}
+
+// -------------------------------------------------------------------------------
+
+bool CameraScene::ReadObject()
+{
+    // usa o cache binário se ele ainda corresponder ao arquivo .obj (o
+    // conteúdo só é lido se o tamanho ou a data do arquivo mudaram)
+    VertexElement layout[MaxVertexElements];
+    DescribeLayout(inputLayout, inputCount, layout);
+
+    if (cache.Open(cacheFile, objFile, CacheFlags(), layout, inputCount))
+    {
+#ifdef _DEBUG
+        stringstream text;
+        text << std::fixed;
+        text.precision(2);
+        text << "---> Cache: " << cache.Seconds() * 1000.0 << " ms"
+             << (cache.Hashed() ? " (data do .obj alterada, hash conferido)" : "") << "\n";
+        DebugText(text.str());
+#endif
+        return true;
+    }
+
+    ObjLoader loader;
+    loader.Jobs(jobs);
+    loader.Weld(weld);
+
+    if (!loader.Load(objFile, listVertex, listIndex))
+        return false;
+
+    // alterna as cores dos vértices
+    for (Vertex & v : listVertex)
+    {
+        v.Color = azul ? XMFLOAT4(Colors::Blue) : XMFLOAT4(Colors::Pink);
+        azul = !azul;
+    }
+
+#ifdef _DEBUG
+    DebugText(loader.Stats().ToString());
+#endif
+
+    OptimizeGeometry();
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+uint CameraScene::CacheFlags() const
+{
+    // limiar de overdraw em centésimos a partir do bit 16
+    uint threshold = uint(overdrawThreshold * 100.0f + 0.5f);
+    return (threshold << 16) | (meshPipeline << 8) | (weld ? 8 : 0) | (uint(vertexFormat) << 1) | (splitIndices ? 1 : 0);
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::OptimizeGeometry()
+{
+    uint vertexCount = (uint)listVertex.size();
+    uint indexCount = (uint)listIndex.size();
+
+    if (vertexCount == 0 || indexCount == 0)
+        return;
+
+    const float * positions = &listVertex[0].Pos.x;
+
+#ifdef _DEBUG
+    VertexCacheStats cacheBefore = SimulateVertexCache(listIndex.data(), indexCount, vertexCount);
+    OverdrawStats overdrawBefore = EstimateOverdraw(listIndex.data(), indexCount, positions, sizeof(Vertex), vertexCount);
+    Timer timer;
+    timer.Start();
+#endif
+
+    // reordena triângulos para reaproveitar o cache de vértices da GPU
+    OptimizeVertexCache(listIndex.data(), indexCount, vertexCount);
+
+    // desenha primeiro os agrupamentos voltados para fora (0 desativa)
+    if (overdrawThreshold > 0.0f)
+        OptimizeOverdraw(listIndex.data(), indexCount, positions, sizeof(Vertex), vertexCount, overdrawThreshold);
+
+    // níveis de detalhe acrescentados ao final da lista de índices
+    SimplifyStats lodStats = BuildLodChain(listIndex, positions, sizeof(Vertex), vertexCount,
+        lodRatios, uint(sizeof(lodRatios) / sizeof(lodRatios[0])), listLod);
+
+    for (uint i = 1; i < listLod.size(); ++i)
+        OptimizeVertexCache(listIndex.data() + listLod[i].startIndex, listLod[i].indexCount, vertexCount);
+
+    // vértices na ordem do primeiro uso para localidade de leitura
+    listVertex.resize(OptimizeVertexFetch(listVertex.data(), vertexCount, sizeof(Vertex), listIndex.data(), (uint)listIndex.size()));
+
+    // agrupamentos de triângulos de cada nível para o descarte na CPU
+    MeshletStats meshletStats = {};
+    listMeshlet.clear();
+    for (MeshLod & lod : listLod)
+    {
+        lod.firstMeshlet = (uint)listMeshlet.size();
+        MeshletStats level = BuildMeshlets(listIndex.data(), lod.startIndex, lod.indexCount,
+            &listVertex[0].Pos.x, sizeof(Vertex), (uint)listVertex.size(), listMeshlet);
+        lod.meshletCount = level.meshlets;
+
+        meshletStats.meshlets += level.meshlets;
+        meshletStats.triangles += level.triangles;
+        meshletStats.vertices += level.vertices;
+        meshletStats.openCones += level.openCones;
+        meshletStats.seconds += level.seconds;
+    }
+
+#ifdef _DEBUG
+    double elapsed = timer.Elapsed();
+
+    vertexCount = (uint)listVertex.size();
+    positions = &listVertex[0].Pos.x;
+    VertexCacheStats cacheAfter = SimulateVertexCache(listIndex.data(), indexCount, vertexCount);
+    OverdrawStats overdrawAfter = EstimateOverdraw(listIndex.data(), indexCount, positions, sizeof(Vertex), vertexCount);
+
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << "---> Cache de vértices: " << cacheBefore.ToString() << "\n"
+         << "---> Overdraw: " << overdrawBefore.ToString() << "\n"
+         << "---> Otimizado em " << elapsed * 1000.0 << " ms: "
+         << cacheAfter.ToString() << ", " << overdrawAfter.ToString() << "\n"
+         << "---> LOD: " << lodStats.ToString() << "\n"
+         << "---> Agrupamentos: " << meshletStats.ToString() << "\n";
+
+    text.precision(5);
+    for (uint i = 0; i < listLod.size(); ++i)
+        text << "     nível " << i << ": " << listLod[i].indexCount / 3
+             << " triângulos, " << listLod[i].meshletCount << " agrupamentos, erro "
+             << listLod[i].error << "\n";
+
+    DebugText(text.str());
+#else
+    (void) lodStats;
+#endif
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::BuildGeometry()
+{
+    // cria malha 3D
+    geometry = new Mesh("Box");
+
+    vertexData = listVertex.data();
+    indexData = listIndex.data();
+
+    // tamanho em bytes dos vértices e índices
+    uint vertexStride = VertexStride(vertexFormat, false);
+    uint vbSize = (uint)listVertex.size() * sizeof(Vertex);
+    uint ibSize = (uint)listIndex.size() * sizeof(uint);
+
+    if (cache.IsOpen())
+    {
+        // os blocos mapeados do cache vão direto para os buffers da malha
+        const MeshCacheHeader & header = cache.Header();
+        geometry->indexFormat = DXGI_FORMAT(header.indexFormat);
+        geometry->subMeshes = cache.SubMeshes();
+        geometry->lods = cache.Lods();
+        geometry->meshlets = cache.Meshlets();
+
+        // a caixa envolvente gravada define a quantização das posições
+        quantization = ComputeQuantization(header.boundsMin, header.boundsMax);
+        vertexStride = header.vertexStride;
+
+        vertexData = cache.Vertices();
+        indexData = cache.Indices();
+        vbSize = (uint)header.vertexSize;
+        ibSize = (uint)header.indexSize;
+    }
+    else
+    {
+        // escolhe índices de 16 ou 32 bits conforme o número de vértices
+        geometry->lods = listLod;
+        geometry->meshlets = listMeshlet;
+        geometry->indexFormat = SelectIndexFormat(listVertex, listIndex, splitIndices, listIndex16, geometry->subMeshes, geometry->lods);
+
+        // converte os vértices (já com os acrescentados pela divisão) para o formato da GPU
+        uint vertexCount = (uint)listVertex.size();
+        quantization = ComputeQuantization(listVertex.data(), vertexCount);
+        listPacked.resize(size_t(vertexCount) * vertexStride);
+        PackVertices(vertexFormat, listVertex.data(), nullptr, vertexCount, quantization, listPacked.data());
+
+        vertexData = listPacked.data();
+        vbSize = vertexCount * vertexStride;
+
+#ifdef _DEBUG
+        PackingStats packing = MeasurePacking(vertexFormat, listVertex.data(), nullptr, vertexCount, quantization, listPacked.data());
+        DebugText("---> Vértices: " + packing.ToString() + "\n");
+#endif
+
+        uint indexCount = (uint)listIndex.size();
+
+        if (geometry->indexFormat == DXGI_FORMAT_R16_UINT)
+        {
+            indexCount = (uint)listIndex16.size();
+            ibSize = indexCount * sizeof(ushort);
+            indexData = listIndex16.data();
+        }
+
+        // grava o cache para as próximas execuções
+        VertexElement layout[MaxVertexElements];
+        DescribeLayout(inputLayout, inputCount, layout);
+
+        // a caixa envolvente permite recuperar as posições compactas
+        const float * boundsMin = &quantization.Bias.x;
+        float boundsMax[3] = {
+            quantization.Bias.x + quantization.Scale.x,
+            quantization.Bias.y + quantization.Scale.y,
+            quantization.Bias.z + quantization.Scale.z };
+
+        MeshCache::Write(cacheFile, objFile, CacheFlags(),
+            layout, inputCount,
+            vertexData, vertexCount, vertexStride,
+            indexData, indexCount, geometry->indexFormat,
+            geometry->subMeshes, geometry->lods, geometry->meshlets,
+            boundsMin, boundsMax);
+    }
+
+    // ajusta atributos da malha 3D
+    geometry->vertexByteStride = vertexStride;
+    geometry->vertexBufferSize = vbSize;
+    geometry->indexBufferSize = ibSize;
+
+    // a caixa envolvente da quantização também limita a malha no descarte
+    meshExtents = XMFLOAT3(quantization.Scale.x * 0.5f, quantization.Scale.y * 0.5f, quantization.Scale.z * 0.5f);
+    meshCenter = XMFLOAT3(quantization.Bias.x + meshExtents.x, quantization.Bias.y + meshExtents.y, quantization.Bias.z + meshExtents.z);
+
+    // árvore de seleção sobre os triângulos do nível 0 (posições recuperadas
+    // do formato da GPU e índices das submalhas somados ao vértice base)
+    uint vertexCount = vbSize / vertexStride;
+    vector<XMFLOAT3> positions(vertexCount);
+    UnpackPositions(vertexFormat, vertexData, vertexStride, vertexCount, quantization, positions.data());
+
+    uint firstSubMesh = 0;
+    uint subMeshCount = (uint)geometry->subMeshes.size();
+    if (!geometry->lods.empty())
+    {
+        firstSubMesh = geometry->lods[0].firstSubMesh;
+        subMeshCount = geometry->lods[0].subMeshCount;
+    }
+
+    uint indexTotal = 0;
+    for (uint s = firstSubMesh; s < firstSubMesh + subMeshCount; ++s)
+        indexTotal += geometry->subMeshes[s].indexCount;
+
+    vector<uint> triangles;
+    triangles.reserve(indexTotal);
+    for (uint s = firstSubMesh; s < firstSubMesh + subMeshCount; ++s)
+    {
+        const SubMesh & part = geometry->subMeshes[s];
+        for (uint k = part.startIndex; k < part.startIndex + part.indexCount; ++k)
+        {
+            uint index = geometry->indexFormat == DXGI_FORMAT_R16_UINT
+                ? ((const ushort*)indexData)[k] : ((const uint*)indexData)[k];
+            triangles.push_back(uint(int(index) + part.baseVertex));
+        }
+    }
+
+    BvhStats stats = bvh.Build(positions.data(), vertexCount, triangles.data(), (uint)triangles.size(), jobs);
+
+#ifdef _DEBUG
+    DebugText("---> Seleção: " + stats.ToString() + "\n");
+#else
+    (void) stats;
+#endif
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::CullGeometry(const XMMATRIX & world, const XMMATRIX & viewProj, const XMVECTOR & eye, double frameTime)
+{
+    const MeshLod & lod = geometry->lods[lodLevel];
+    const SubMesh & part = geometry->subMeshes[lod.firstSubMesh];
+
+    drawList.clear();
+
+    // os agrupamentos apontam para a lista de 32 bits: só valem quando o
+    // nível é desenhado por uma única submalha com os mesmos índices
+    // (e o descarte considera um único objeto, não as instâncias)
+    if (instanceCount > 1 || lod.meshletCount == 0 || lod.subMeshCount != 1
+        || part.startIndex != lod.startIndex || part.baseVertex != 0)
+    {
+        drawList.assign(geometry->subMeshes.begin() + lod.firstSubMesh,
+            geometry->subMeshes.begin() + lod.firstSubMesh + lod.subMeshCount);
+        return;
+    }
+
+    // volume de visão e câmera no espaço do objeto
+    XMFLOAT4X4 worldViewProj;
+    XMStoreFloat4x4(&worldViewProj, world * viewProj);
+
+    XMFLOAT3 eyeObject;
+    XMStoreFloat3(&eyeObject, XMVector3TransformCoord(eye, XMMatrixInverse(nullptr, world)));
+
+    MeshletCullStats stats = CullMeshlets(&geometry->meshlets[lod.firstMeshlet], lod.meshletCount,
+        worldViewProj, eyeObject, coneCulling, drawList);
+
+    // média por quadro a cada segundo
+    cullTotal.meshlets += stats.meshlets;
+    cullTotal.visible += stats.visible;
+    cullTotal.triangles += stats.triangles;
+    cullTotal.frustumCulled += stats.frustumCulled;
+    cullTotal.coneCulled += stats.coneCulled;
+    cullTotal.ranges += stats.ranges;
+    cullTotal.seconds += stats.seconds;
+    cullTime += frameTime;
+    ++cullFrames;
+
+    if (cullTime >= 1.0)
+    {
+        MeshletCullStats average = cullTotal;
+        average.meshlets /= cullFrames;
+        average.visible /= cullFrames;
+        average.triangles /= cullFrames;
+        average.frustumCulled /= cullFrames;
+        average.coneCulled /= cullFrames;
+        average.ranges /= cullFrames;
+        average.seconds /= cullFrames;
+
+#ifdef _DEBUG
+        DebugText("---> Descarte por quadro: " + average.ToString() + "\n");
+#endif
+        cullTotal = {};
+        cullTime = 0.0;
+        cullFrames = 0;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void CameraScene::CullInstances(double frameTime)
+{
+    Timer timer;
+    timer.Start();
+
+    // volume de visão no espaço das instâncias (antes do giro comum)
+    Frustum frustum = ExtractFrustum(instanceViewProj);
+
+    // blocos testados em paralelo, cada um gravando na sua parte da lista
+    const uint block = 1024;
+    uint blocks = (instanceCount + block - 1) / block;
+    blockVisible.resize(blocks);
+
+    jobs->ParallelFor(blocks, 1, [&](uint begin, uint end)
+    {
+        for (uint b = begin; b < end; ++b)
+        {
+            uint first = b * block;
+            uint count = first + block < instanceCount ? block : instanceCount - first;
+            blockVisible[b] = CullObjects(frustum, bounds, CULL_BOX, first, count, visibleList.data() + first);
+        }
+    });
+
+    // junta as partes em uma lista compacta, na ordem das instâncias
+    visibleCount = 0;
+    for (uint b = 0; b < blocks; ++b)
+    {
+        if (visibleCount != b * block)
+            memmove(&visibleList[visibleCount], &visibleList[b * block], blockVisible[b] * sizeof(uint));
+        visibleCount += blockVisible[b];
+    }
+
+    instanceCull.objects = instanceCount;
+    instanceCull.visible = visibleCount;
+    instanceCull.culled = instanceCount - visibleCount;
+    instanceCull.seconds = timer.Elapsed();
+
+    // média por quadro a cada segundo
+    instanceCullTotal.objects += instanceCull.objects;
+    instanceCullTotal.visible += instanceCull.visible;
+    instanceCullTotal.culled += instanceCull.culled;
+    instanceCullTotal.seconds += instanceCull.seconds;
+    instanceCullTime += frameTime;
+    ++instanceCullFrames;
+
+    if (instanceCullTime >= 1.0)
+    {
+        ObjectCullStats average = instanceCullTotal;
+        average.objects /= instanceCullFrames;
+        average.visible /= instanceCullFrames;
+        average.culled /= instanceCullFrames;
+        average.seconds /= instanceCullFrames;
+
+#ifdef _DEBUG
+        DebugText("---> Instâncias por quadro: " + average.ToString() + "\n");
+#endif
+        instanceCullTotal = {};
+        instanceCullTime = 0.0;
+        instanceCullFrames = 0;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+string CameraScene::Pick(float x, float y)
+{
+    Timer timer;
+    timer.Start();
+
+    // raio no espaço das instâncias (antes do giro comum)
+    Ray ray = PickRay(x, y, float(width), float(height), instanceViewProj);
+    XMVECTOR origin = XMLoadFloat3(&ray.origin);
+    XMVECTOR direction = XMLoadFloat3(&ray.direction);
+
+    RayHit best = { Bvh::None, FLT_MAX, 0.0f, 0.0f };
+    uint picked = 0;
+
+    for (uint k = 0; k < visibleCount; ++k)
+    {
+        uint i = visibleList[k];
+
+        // esfera envolvente descarta a instância antes da árvore
+        XMVECTOR center = XMVectorSet(bounds.x[i], bounds.y[i], bounds.z[i], 0.0f);
+        XMVECTOR offset = center - origin;
+        float along = XMVectorGetX(XMVector3Dot(offset, direction));
+        float gap = XMVectorGetX(XMVector3LengthSq(offset)) - along * along;
+        float radius2 = bounds.radius[i] * bounds.radius[i];
+        if (gap > radius2 || along + bounds.radius[i] < 0.0f || along - bounds.radius[i] > best.distance)
+            continue;
+
+        // o raio vai para o espaço da malha sem normalizar a direção, de
+        // modo que a distância t continua comparável entre as instâncias
+        XMMATRIX inverse = XMMatrixInverse(nullptr, XMLoadFloat4x4(&scene.World(1 + i)));
+        Ray local;
+        XMStoreFloat3(&local.origin, XMVector3TransformCoord(origin, inverse));
+        XMStoreFloat3(&local.direction, XMVector3TransformNormal(direction, inverse));
+
+        RayHit hit = bvh.Intersect(local, best.distance);
+        if (hit.Hit())
+        {
+            best = hit;
+            picked = i;
+        }
+    }
+
+    stringstream text;
+    text.precision(3);
+    if (best.Hit())
+        text << "---> Seleção: instância " << picked << ", triângulo " << best.triangle
+             << ", distância " << best.distance << ", (u, v) = (" << best.u << ", " << best.v << ")";
+    else
+        text << "---> Seleção: nada sob o cursor";
+    text << " em " << timer.Elapsed() * 1000.0 << " ms\n";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
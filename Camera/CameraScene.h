@@ -0,0 +1,246 @@
+/**********************************************************************************
+// CameraScene (Arquivo de Cabeçalho)
+//
+// Criação:     17 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cena da aplicação Câmera sem dependência do Windows.
+//
+//              Carrega a malha (cache binário ou .obj com soldagem,
+//              otimização, níveis de detalhe e agrupamentos), escolhe a
+//              largura dos índices, converte os vértices para o formato da
+//              GPU, monta a grade de instâncias e a árvore de seleção.
+//              A cada quadro interpola a órbita da câmera e o giro, escolhe
+//              o nível de detalhe e descarta agrupamentos e instâncias.
+//
+//              A aplicação trata a entrada e envia os buffers e comandos
+//              ao Direct3D; a execução sem janela e o CameraHeadless do
+//              build portável desenham a mesma cena no renderizador em
+//              software, de modo que as imagens de referência cobrem o
+//              caminho completo da aplicação.
+//
+**********************************************************************************/
+
+#ifndef DXUT_CAMERASCENE_H
+#define DXUT_CAMERASCENE_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Vertex.h"                     // vértice completo em ponto flutuante
+#include "Mesh.h"                       // malha, submalhas e níveis de detalhe
+#include "MeshCache.h"                  // malha binária pronta para a GPU
+#include "MeshOptimizer.h"              // limiar de overdraw
+#include "Meshlet.h"                    // descarte de agrupamentos
+#include "VertexFormat.h"               // formatos compactos de vértice
+#include "InstanceTransform.h"          // matrizes das instâncias em lote
+#include "Scene.h"                      // hierarquia de transformações
+#include "ObjectCull.h"                 // descarte de instâncias
+#include "Bvh.h"                        // seleção com o mouse
+#include "JobSystem.h"                  // trabalhos paralelos
+#include "Rasterizer.h"                 // renderizador em software
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// cor de fundo da janela e do renderizador em software (RGB de 0 a 255)
+const uint SceneBackground[3] = { 30, 30, 30 };
+
+// buffer constante lido pelos vertex shaders
+struct ObjectConstants
+{
+    XMFLOAT4X4 WorldViewProj =
+    { 1.0f, 0.0f, 0.0f, 0.0f,
+      0.0f, 1.0f, 0.0f, 0.0f,
+      0.0f, 0.0f, 1.0f, 0.0f,
+      0.0f, 0.0f, 0.0f, 1.0f };
+
+    // recupera posições de vértices compactos
+    XMFLOAT4 PosScale = { 1.0f, 1.0f, 1.0f, 0.0f };
+    XMFLOAT4 PosBias = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+// opções escolhidas na linha de comando
+struct CameraOptions
+{
+    uint instances = 1;                 // cópias da malha desenhadas com instâncias (-instances N)
+    bool splitIndices = false;          // divide malhas grandes em submalhas de 16 bits (-split)
+    bool weld = true;                   // solda triplas (v, vt, vn) em vértices únicos (-noweld desliga)
+    VertexFormatType vertexFormat = VERTEX_FLOAT;   // posições quantizadas com -unorm16 ou -half
+    bool backfaceCulling = false;       // descarta faces e agrupamentos de costas (-backface)
+};
+
+// lê as opções da câmera de uma linha de comando: -instances N, -split,
+// -noweld, -unorm16 ou -half e -backface
+void ParseCameraOptions(const string & cmdLine, CameraOptions & options);
+
+// -------------------------------------------------------------------------------
+
+class CameraScene
+{
+private:
+    JobSystem * jobs = nullptr;         // trabalhos paralelos (descarte e transformações)
+    uint width = 0;                     // largura do alvo (seleção)
+    uint height = 0;                    // altura do alvo (nível de detalhe)
+
+    Mesh * geometry = nullptr;          // malha (os buffers da GPU são da aplicação)
+    ObjectConstants constants;          // constantes calculadas no quadro
+
+    uint instanceCount = 1;             // cópias da malha desenhadas com uma chamada
+    InstanceTransforms instances;       // matrizes de mundo das instâncias (SoA)
+    Scene scene;                        // raiz da grade (nó 0) e uma folha por instância (nó 1 + i)
+    XMFLOAT4X4 instanceViewProj = {};   // giro x visão x projeção comum às instâncias
+    ObjectBounds bounds;                // caixas envolventes das instâncias (antes do giro)
+    XMFLOAT3 meshCenter = {};           // centro da caixa envolvente da malha
+    XMFLOAT3 meshExtents = {};          // meia extensão da caixa envolvente da malha
+    vector<uint> visibleList;           // instâncias visíveis no quadro (lista compacta)
+    vector<uint> blockVisible;          // instâncias visíveis em cada bloco do descarte
+    uint visibleCount = 0;              // instâncias visíveis em visibleList
+    vector<XMFLOAT4X4> instanceMatrices;        // matrizes das instâncias no renderizador em software
+    ObjectCullStats instanceCull = {};  // descarte de instâncias do último quadro
+    ObjectCullStats instanceCullTotal = {};     // descarte acumulado para medição
+    uint instanceCullFrames = 0;        // quadros acumulados em instanceCullTotal
+    double instanceCullTime = 0.0;      // tempo acumulado em instanceCullTotal
+    float maxRadius = 15.0f;            // maior distância da câmera ao centro
+    Bvh bvh;                            // triângulos do nível 0 para a seleção com o mouse
+
+    bool spin = true;
+    double spinTime = 0.0;              // tempo do giro (soma dos passos)
+    double lastSpinTime = 0.0;          // tempo do giro no passo anterior
+
+    XMFLOAT4X4 View = {};
+    XMFLOAT4X4 Proj = {};
+
+    float theta = 0;
+    float phi = 0;
+    float radius = 0;
+    float lastTheta = 0;                // órbita da câmera no passo anterior
+    float lastPhi = 0;
+    float lastRadius = 0;
+
+    vector<uint> listIndex;
+    vector<Vertex> listVertex;
+    vector<ushort> listIndex16;         // índices de 16 bits (malhas pequenas ou divididas)
+    vector<byte> listPacked;            // vértices no formato da GPU
+    bool azul = false;
+    bool splitIndices = false;          // divide malhas grandes em submalhas de 16 bits
+    bool weld = true;                   // um vértice por tripla (v, vt, vn) distinta
+    float overdrawThreshold = OverdrawThreshold;    // perda aceita no cache de vértices (0 desativa)
+    vector<MeshLod> listLod;            // níveis de detalhe gerados na carga
+    float lodTolerance = 1.0f;          // erro geométrico aceito em pixels
+    uint lodLevel = 0;                  // nível de detalhe desenhado
+
+    vector<Meshlet> listMeshlet;        // agrupamentos de triângulos de cada nível
+    vector<SubMesh> drawList;           // faixas desenhadas no quadro atual
+    bool backfaceCulling = false;       // o rasterizador descarta faces de costas
+    bool coneCulling = false;           // descarta agrupamentos de costas (só com backfaceCulling)
+    MeshletCullStats cullTotal = {};    // descarte acumulado para medição
+    uint cullFrames = 0;                // quadros acumulados em cullTotal
+    double cullTime = 0.0;              // tempo acumulado em cullTotal
+
+    VertexFormatType vertexFormat = VERTEX_FLOAT;       // formato dos vértices na GPU
+    VertexQuantization quantization = {};               // escala e deslocamento das posições
+    D3D12_INPUT_ELEMENT_DESC inputLayout[MaxVertexElements] = {};
+    uint inputCount = 0;                // atributos do input layout
+
+    string objFile = "Resources/esfera_icosaedrica.obj";
+    string cacheFile = "Resources/esfera_icosaedrica.mesh";
+    MeshCache cache;                    // malha binária pronta para a GPU
+
+    const void * vertexData = nullptr;  // vértices no formato da GPU (cache ou listPacked)
+    const void * indexData = nullptr;   // índices (cache, listIndex16 ou listIndex)
+
+    bool ReadObject();                  // lê a malha do cache ou do .obj
+    void OptimizeGeometry();            // ordem dos triângulos, níveis e agrupamentos
+    void BuildGeometry();               // formato dos índices e vértices, cache e seleção
+    void CullGeometry(const XMMATRIX & world, const XMMATRIX & viewProj,
+                      const XMVECTOR & eye, double frameTime);
+    void CullInstances(double frameTime);
+    uint CacheFlags() const;
+
+public:
+    CameraScene(const CameraOptions & options = CameraOptions());
+    ~CameraScene();
+
+    // carrega a malha e monta a cena para um alvo de width x height;
+    // retorna falso se a malha não puder ser lida
+    bool Init(JobSystem * jobSystem, uint width, uint height);
+
+    // libera os dados da malha na CPU depois do envio para a GPU
+    void ReleaseSource();
+
+    void Save();                        // início de um passo: guarda o estado anterior
+    void Orbit(float dTheta, float dPhi);           // gira a câmera em volta da cena
+    void Zoom(float dRadius);           // aproxima ou afasta a câmera
+    void Step(double dt);               // avança o giro (se ativo) em um passo
+    void ToggleSpin();                  // ativa ou desativa o giro
+    void ToggleConeCulling();           // ativa ou desativa o descarte de agrupamentos
+
+    // estado entre o passo anterior e o atual (alpha de 0 a 1): matrizes,
+    // nível de detalhe e descarte de agrupamentos e instâncias
+    void Interpolate(float alpha, double frameTime);
+
+    // matrizes combinadas das instâncias visíveis (visibleCount matrizes,
+    // transpostas, no layout lido pelos shaders), calculadas em paralelo
+    void InstanceMatrices(XMFLOAT4X4 * out);
+
+    // desenha o quadro no renderizador em software
+    void Draw(Rasterizer & rasterizer);
+
+    // seleciona o triângulo sob o cursor e descreve o resultado
+    string Pick(float x, float y);
+
+    Mesh * Geometry() const;            // malha com formato, níveis e submalhas
+    const void * VertexData() const;    // vértices no formato da GPU
+    const void * IndexData() const;     // índices no formato da malha
+    const ObjectConstants & Constants() const;      // constantes do quadro
+    const vector<SubMesh> & DrawList() const;       // faixas desenhadas no quadro
+    uint VisibleCount() const;          // instâncias visíveis no quadro
+    VertexFormatType Format() const;    // formato dos vértices na GPU
+    const D3D12_INPUT_ELEMENT_DESC * InputLayout() const;
+    uint InputCount() const;            // atributos do input layout
+    bool BackfaceCulling() const;       // faces de costas descartadas
+};
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+inline Mesh * CameraScene::Geometry() const
+{ return geometry; }
+
+inline const void * CameraScene::VertexData() const
+{ return vertexData; }
+
+inline const void * CameraScene::IndexData() const
+{ return indexData; }
+
+inline const ObjectConstants & CameraScene::Constants() const
+{ return constants; }
+
+inline const vector<SubMesh> & CameraScene::DrawList() const
+{ return drawList; }
+
+inline uint CameraScene::VisibleCount() const
+{ return visibleCount; }
+
+inline VertexFormatType CameraScene::Format() const
+{ return vertexFormat; }
+
+inline const D3D12_INPUT_ELEMENT_DESC * CameraScene::InputLayout() const
+{ return inputLayout; }
+
+inline uint CameraScene::InputCount() const
+{ return inputCount; }
+
+inline bool CameraScene::BackfaceCulling() const
+{ return backfaceCulling; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -1,11 +1,11 @@
 /**********************************************************************************
-// DXUT (Arquivo de Cabealho)
+// DXUT (Arquivo de Cabeçalho)
 //
-// Criao:     04 Jan 2020
-// Atualizao: 14 Ago 2021
+// Criação:     04 Jan 2020
+// Atualização: 14 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Arquivo mestre para o DirectX Utility Toolkit (DXUT)
+// Descrição:   Arquivo mestre para o DirectX Utility Toolkit (DXUT)
 //
 **********************************************************************************/
 
@@ -1,29 +1,34 @@
 /**********************************************************************************
-// Engine (Cdigo Fonte)
+// Engine (Código Fonte)
 //
-// Criao:     15 Mai 2014
-// Atualizao: 07 Ago 2021
+// Criação:     15 Mai 2014
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   A Engine roda aplicaes criadas a partir da classe App.
+// Descrição:   A Engine roda aplicações criadas a partir da classe App.
 //
-//              Para usar a Engine crie uma instncia e chame o mtodo
+//              Para usar a Engine crie uma instância e chame o método
 //              Start() com um objeto derivado da classe App.
 //
 **********************************************************************************/
 
 #include "Engine.h"
 #include <windows.h>
+#include <fstream>
 #include <sstream>
 using std::stringstream;
 
 // ------------------------------------------------------------------------------
-// Inicializao de variveis estticas da classe
+// Inicialização de variáveis estáticas da classe
 
-Graphics* Engine::graphics  = nullptr;    // dispositivo grfico
-Window*   Engine::window    = nullptr;    // janela da aplicao
+Graphics* Engine::graphics  = nullptr;    // dispositivo gráfico
+Window*   Engine::window    = nullptr;    // janela da aplicação
 Input*    Engine::input     = nullptr;    // dispositivos de entrada
-App*      Engine::app       = nullptr;    // apontadador da aplicao
+EventSource* Engine::events = nullptr;    // fonte de eventos
+Scheduler* Engine::scheduler = nullptr;   // agenda de atualizações e quadros
+JobSystem* Engine::jobs     = nullptr;    // trabalhos paralelos
+App*      Engine::app       = nullptr;    // apontadador da aplicação
+Rasterizer* Engine::rasterizer = nullptr; // renderizador em software
 double    Engine::frameTime = 0.0;        // tempo do quadro atual
 bool      Engine::paused    = false;      // estado do motor
 Timer     Engine::timer;                  // medidor de tempo
@@ -34,6 +39,10 @@ Engine::Engine()
 {
     window = new Window();
     graphics = new Graphics();
+    scheduler = new Scheduler();
+
+    // a thread do laço principal é a thread 0 dos trabalhos
+    jobs = new JobSystem();
 }
 
 // -------------------------------------------------------------------------------
@@ -41,8 +50,12 @@ Engine::Engine()
 Engine::~Engine()
 {
     delete app;
+    delete rasterizer;
     delete graphics;
     delete input;
+    delete events;
+    delete scheduler;
+    delete jobs;
     delete window;
 }
 
@@ -52,25 +65,29 @@ int Engine::Start(App * application)
 {
     app = application;
 
-    // cria janela da aplicao
+    // cria janela da aplicação
     window->Create();
 
-    // inicializa dispositivos de entrada (deve ser feito aps criao da janela)
+    // inicializa dispositivos de entrada (deve ser feito após criação da janela)
     input = new Input();
 
-    // inicializa dispositivo grfico
+    // inicializa dispositivo gráfico
     graphics->Initialize(window);
 
     // altera a window procedure da janela ativa para EngineProc
     SetWindowLongPtr(window->Id(), GWLP_WNDPROC, (LONG_PTR)EngineProc);
 
-    // ajusta a resoluo do Sleep para 1 milisegundo
+    // mensagens do Windows, a menos que outra fonte tenha sido definida
+    if (!events)
+        events = new WindowEventSource();
+
+    // ajusta a resolução do Sleep para 1 milisegundo
     // requer uso da biblioteca winmm.lib
     timeBeginPeriod(1);
 
     int exitCode = Loop();
 
-    // volta a resoluo do Sleep ao valor original
+    // volta a resolução do Sleep ao valor original
     timeEndPeriod(1);
 
     return exitCode;
@@ -78,6 +95,50 @@ int Engine::Start(App * application)
 
 // -----------------------------------------------------------------------------
 
+int Engine::Start(App * application, const HeadlessSettings & settings)
+{
+    app = application;
+
+    // sem janela e sem dispositivo gráfico: o tamanho da
+    // configuração define o alvo e a proporção da câmera
+    window->Size(settings.width, settings.height);
+
+    // entrada sem janela associada: nenhuma tecla pressionada
+    // e o mouse parado, o que mantém a câmera fixa
+    input = new Input();
+
+    rasterizer = new Rasterizer();
+    rasterizer->Initialize(settings.width, settings.height, settings.threads);
+
+    // passo de tempo fixo em todos os quadros
+    frameTime = settings.timestep;
+
+    app->Init();
+
+    HeadlessReport report = RunHeadless(settings, *rasterizer,
+        [](uint)
+        {
+            app->Update();
+            app->Draw();
+        });
+
+    app->Finalize();
+
+    string text = report.ToString() + "\n";
+    OutputDebugString(("---> Sem janela: " + text).c_str());
+
+    // relatório junto aos quadros gravados
+    if (!settings.outputDir.empty())
+    {
+        std::ofstream file(settings.outputDir + "/report.txt");
+        file << text;
+    }
+
+    return report.Passed() ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+
 double Engine::FrameTime()
 {
 
@@ -100,8 +161,8 @@ double Engine::FrameTime()
     if (totalTime >= 1.0)
     {
         stringstream text;            // fluxo de texto para mensagens
-        text << std::fixed;            // sempre mostra a parte fracionria
-        text.precision(3);            // trs casas depois da vrgula
+        text << std::fixed;            // sempre mostra a parte fracionária
+        text.precision(3);            // três casas depois da vírgula
 
         text << window->Title().c_str() << "    "
             << "FPS: " << frameCount << "    "
@@ -124,61 +185,78 @@ int Engine::Loop()
     // inicia contagem de tempo
     timer.Start();
     
-    // mensagens do Windows
-    MSG msg = { 0 };
-    
-    // inicializao da aplicao
+    // inicialização da aplicação
     app->Init();
 
-    // lao principal
-    do
+    // laço principal: cada volta trata todos os eventos pendentes
+    // e só então aplica a entrada, atualiza e desenha um quadro
+    while (events->Pump(Input::Buffer()))
     {
-        // trata todos os eventos antes de atualizar a aplicao
-        if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+        // eventos de entrada do quadro aplicados em lote
+        input->BeginFrame();
+
+        // -----------------------------------------------
+        // Pausa/Resume Jogo
+        // -----------------------------------------------
+
+        if (input->KeyPress(VK_PAUSE))
         {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            if (paused)
+                Resume();
+            else
+                Pause();
         }
-        else
-        {
-            // -----------------------------------------------
-            // Pausa/Resume Jogo
-            // -----------------------------------------------
 
-            if (input->KeyPress(VK_PAUSE))
-            {
-                if (paused)
-                    Resume();
-                else
-                    Pause();
-            }
+        // -----------------------------------------------
+
+        if (!paused)
+        {
+            // calcula o tempo do quadro
+            frameTime = FrameTime();
 
-            // -----------------------------------------------
+            // atualização da aplicação: uma vez com o tempo medido ou,
+            // no passo fixo, quantas vezes o tempo acumulado permitir
+            uint steps = scheduler->Advance(frameTime);
 
-            if (!paused)
+            if (scheduler->Fixed())
             {
-                // calcula o tempo do quadro
-                frameTime = FrameTime();
+                double measured = frameTime;
+                frameTime = scheduler->Step();
 
-                // atualizao da aplicao 
-                app->Update();
+                for (uint i = 0; i < steps; ++i)
+                    app->Update();
 
-                // desenho da aplicao
-                app->Draw();
+                frameTime = measured;
             }
             else
             {
-                app->OnPause();
+                app->Update();
             }
-        }
 
-    } while (msg.message != WM_QUIT);
+            // desenho da aplicação (interpolado com scheduler->Alpha())
+            app->Draw();
+
+            // limitador de quadros e medição dos intervalos
+            scheduler->Wait();
+        }
+        else
+        {
+            // em pausa nada muda até a próxima entrada: a thread
+            // espera um evento em vez de acordar em intervalos fixos
+            app->OnPause();
+            events->Wait();
+        }
+    }
 
-    // finalizao do aplicao
+    // finalização do aplicação
     app->Finalize();    
 
-    // encerra aplicao
-    return int(msg.wParam);
+    // desvios dos intervalos entre quadros da execução
+    OutputDebugString(("---> Intervalos entre quadros: " + scheduler->Jitter().ToString()).c_str());
+    OutputDebugString(("---> Trabalhos: " + jobs->Stats().ToString() + "\n").c_str());
+
+    // encerra aplicação
+    return events->ExitCode();
 }
 
 // -------------------------------------------------------------------------------
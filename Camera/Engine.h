@@ -1,13 +1,13 @@
 /**********************************************************************************
-// Engine (Arquivo de Cabealho)
+// Engine (Arquivo de Cabeçalho)
 //
-// Criao:     15 Mai 2014
-// Atualizao: 07 Ago 2021
+// Criação:     15 Mai 2014
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   A Engine roda aplicaes criadas a partir da classe App. 
+// Descrição:   A Engine roda aplicações criadas a partir da classe App. 
 //                
-//              Para usar a Engine crie uma instncia e chame o mtodo
+//              Para usar a Engine crie uma instância e chame o método
 //              Start() com um objeto derivado da classe App.
 //
 **********************************************************************************/
@@ -17,11 +17,16 @@
 
 // ---------------------------------------------------------------------------------
 
-#include "Graphics.h"                   // dispositivo grfico
-#include "Window.h"                     // janela da aplicao
+#include "Graphics.h"                   // dispositivo gráfico
+#include "Window.h"                     // janela da aplicação
 #include "Input.h"                      // dispositivo de entrada
+#include "EventSource.h"                // fonte de eventos do laço principal
 #include "Timer.h"                      // medidor de tempo
-#include "App.h"                        // aplicao grfica
+#include "Scheduler.h"                  // agenda de atualizações e quadros
+#include "JobSystem.h"                  // trabalhos paralelos
+#include "App.h"                        // aplicação gráfica
+#include "Rasterizer.h"                 // renderizador em software
+#include "Headless.h"                   // execução sem janela
 
 // ---------------------------------------------------------------------------------
 
@@ -29,22 +34,29 @@ class Engine
 {
 private:
     static Timer timer;                 // medidor de tempo
-    static bool  paused;                // estado do aplicao
+    static bool  paused;                // estado do aplicação
 
     double FrameTime();                 // calcula o tempo do quadro
-    int Loop();                         // inicia lao principal do motor
+    int Loop();                         // inicia laço principal do motor
 
 public:
-    static Graphics* graphics;          // dispositivo grfico
-    static Window*   window;            // janela da aplicao
-    static Input*    input;             // entrada da aplicao
-    static App*      app;               // aplicao a ser executada
+    static Graphics* graphics;          // dispositivo gráfico
+    static Window*   window;            // janela da aplicação
+    static Input*    input;             // entrada da aplicação
+    static EventSource* events;         // fonte de eventos (mensagens do Windows se nula)
+    static Scheduler* scheduler;        // agenda de atualizações e quadros
+    static JobSystem* jobs;             // trabalhos paralelos (uma thread por núcleo)
+    static App*      app;               // aplicação a ser executada
+    static Rasterizer* rasterizer;      // renderizador em software (só na execução sem janela)
     static double    frameTime;         // tempo do quadro atual
 
     Engine();                           // construtor
     ~Engine();                          // destrutor
 
-    int Start(App * application);       // inicia o execuo da aplicao
+    int Start(App * application);       // inicia o execução da aplicação
+
+    // executa a aplicação sem janela no renderizador em software
+    int Start(App * application, const HeadlessSettings & settings);
     
     static void Pause();                // pausa o motor
     static void Resume();               // reinicia o motor
@@ -54,13 +66,13 @@ public:
 };
 
 // -----------------------------------------------------------------------------
-// Funes Inline
+// Funções Inline
 
 inline void Engine::Pause()
 { paused = true; timer.Stop(); }
 
 inline void Engine::Resume()
-{ paused = false; timer.Start(); }
+{ paused = false; timer.Start(); scheduler->Restart(); }
 
 // ---------------------------------------------------------------------------------
 
@@ -1,16 +1,16 @@
 /**********************************************************************************
-// Error (Cdigo Fonte)
+// Error (Código Fonte)
 //
-// Criao:     25 Jan 2020
-// Atualizao: 07 Ago 2021
+// Criação:     25 Jan 2020
+// Atualização: 07 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Uma classe para tratamento de erros
+// Descrição:   Uma classe para tratamento de erros
 //
 **********************************************************************************/
 
 #include "Error.h"              // tratamento de erros
-#include <comdef.h>             // definies COM para C++
+#include <comdef.h>             // definições COM para C++
 #include <sstream>              // buffer string para texto
 using std::stringstream;        // habilita o uso sem o prefixo std::
 
@@ -19,7 +19,7 @@ using std::stringstream;        // habilita o uso sem o prefixo std::
 Error::Error() 
     : hrCode(S_OK), lineNum(-1)
 {
-    // nomes da funo e do arquivo vazios
+    // nomes da função e do arquivo vazios
 }
 
 // -------------------------------------------------------------------------------
@@ -27,13 +27,13 @@ Error::Error()
 Error::Error(HRESULT hr, const string & func, const string & file, int line) 
     : hrCode(hr), funcName(func), lineNum(line)
 {
-    // posio da ltima barra no nome do arquivo
+    // posição da última barra no nome do arquivo
     size_t pos = file.find_last_of('\\');
 
     // se a barra foi encontrada
     if (pos != string::npos)
     {
-        // guarda apenas nome do arquivo e no o caminho completo
+        // guarda apenas nome do arquivo e não o caminho completo
         fileName = file.substr(pos + 1);
     }
 }
@@ -42,7 +42,7 @@ Error::Error(HRESULT hr, const string & func, const string & file, int line)
 
 string Error::ToString() const
 {
-    // pega a descrio do cdigo de erro COM em formato string
+    // pega a descrição do código de erro COM em formato string
     _com_error err(hrCode);
     
     stringstream text;
@@ -1,18 +1,18 @@
 /**********************************************************************************
-// Error (Arquivo de Cabealho)
+// Error (Arquivo de Cabeçalho)
 //
-// Criao:     25 Jan 2020
-// Atualizao: 07 Ago 2021
+// Criação:     25 Jan 2020
+// Atualização: 07 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Uma classe para tratamento de erros
+// Descrição:   Uma classe para tratamento de erros
 //
 **********************************************************************************/
 
 #ifndef DXUT_ERROR_H
 #define DXUT_ERROR_H
 
-#include <windows.h>            // funes do windows
+#include <windows.h>            // funções do windows
 #include <string>               // tipo string
 using std::string;              // uso de string sem std::
 
@@ -21,10 +21,10 @@ using std::string;              // uso de string sem std::
 class Error
 {
 private:
-    HRESULT hrCode;             // cdigo de erro do windows
-    string funcName;            // nome da funo em que ocorreu o erro
+    HRESULT hrCode;             // código de erro do windows
+    string funcName;            // nome da função em que ocorreu o erro
     string fileName;            // nome do arquivo em que ocorreu o erro
-    int lineNum;                // nmero da linha do erro
+    int lineNum;                // número da linha do erro
     
 public:
     Error();                    
@@ -34,8 +34,8 @@ public:
 
 // ---------------------------------------------------------------------------------
 
-// O cdigo precisa ser uma macro porque o nome do arquivo, 
-// linha e funo precisam ser capturados no local do erro 
+// O código precisa ser uma macro porque o nome do arquivo, 
+// linha e função precisam ser capturados no local do erro 
 
 #ifndef ThrowIfFailed
 #define ThrowIfFailed(x)                                               \
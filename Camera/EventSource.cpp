@@ -0,0 +1,468 @@
+/**********************************************************************************
+// EventSource (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Eventos de entrada com marca de tempo e as fontes que os
+//              produzem para o laço principal.
+//
+**********************************************************************************/
+
+#include "EventSource.h"
+#include <algorithm>
+#include <sstream>
+#include <thread>
+using std::stringstream;
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// -------------------------------------------------------------------------------
+
+void InputState::Apply(const vector<InputEvent> & events)
+{
+    int startX = mouseX;
+    int startY = mouseY;
+
+    for (const InputEvent & e : events)
+    {
+        switch (e.type)
+        {
+        case INPUT_KEYDOWN:
+            if (uint(e.code) < 256)
+                keys[e.code] = true;
+            break;
+
+        case INPUT_KEYUP:
+            if (uint(e.code) < 256)
+                keys[e.code] = false;
+            break;
+
+        case INPUT_MOUSEMOVE:
+            mouseX = e.x;
+            mouseY = e.y;
+            break;
+
+        case INPUT_MOUSEWHEEL:
+            wheel += e.x;
+            break;
+        }
+    }
+
+    // amostras do lote reduzidas a um deslocamento
+    deltaX = mouseX - startX;
+    deltaY = mouseY - startY;
+}
+
+// -------------------------------------------------------------------------------
+
+InputBuffer::InputBuffer() : dropped(0), resync(false)
+{
+    for (atomic<uint> & bits : keyBits)
+        bits.store(0, std::memory_order_relaxed);
+
+    // eventos da fila mais o estado de todas as teclas
+    batch.reserve(Capacity + 256);
+}
+
+// -------------------------------------------------------------------------------
+
+bool InputBuffer::Push(const InputEvent & event)
+{
+    // o estado das teclas acompanha todos os eventos, inclusive os descartados
+    bool key = (event.type == INPUT_KEYDOWN || event.type == INPUT_KEYUP) && uint(event.code) < 256;
+    if (key)
+    {
+        uint bit = 1u << (event.code & 31);
+        if (event.type == INPUT_KEYDOWN)
+            keyBits[event.code >> 5].fetch_or(bit, std::memory_order_relaxed);
+        else
+            keyBits[event.code >> 5].fetch_and(~bit, std::memory_order_relaxed);
+    }
+
+    // a fonte de eventos nunca espera pela atualização: com a
+    // fila cheia o evento é descartado e contado
+    if (pending.Push(event))
+        return true;
+
+    dropped.fetch_add(1, std::memory_order_relaxed);
+
+    // o próximo lote corrige as teclas (o mouse se corrige na próxima posição)
+    if (key)
+        resync.store(true, std::memory_order_release);
+
+    return false;
+}
+
+// -------------------------------------------------------------------------------
+
+bool InputBuffer::Push(uint type, int code, int x, int y)
+{
+    return Push(InputEvent{ Timer::Ticks(), type, code, x, y });
+}
+
+// -------------------------------------------------------------------------------
+
+const vector<InputEvent> & InputBuffer::Flush()
+{
+    batch.clear();
+    pending.Drain([this](const InputEvent & event) { batch.push_back(event); });
+
+    // depois de um descarte de teclado o lote termina com o estado de
+    // cada tecla segundo a fonte: uma liberação perdida não prende a tecla
+    if (resync.exchange(false, std::memory_order_acquire))
+    {
+        llong stamp = Timer::Ticks();
+        for (uint code = 0; code < 256; ++code)
+        {
+            bool down = ((keyBits[code >> 5].load(std::memory_order_relaxed) >> (code & 31)) & 1) != 0;
+            batch.push_back(InputEvent{ stamp, uint(down ? INPUT_KEYDOWN : INPUT_KEYUP), int(code), 0, 0 });
+        }
+    }
+
+    return batch;
+}
+
+// -------------------------------------------------------------------------------
+// Medição da fila de eventos
+
+string InputRingBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << events << " eventos em " << seconds * 1000.0 << " ms ("
+         << eventsPerSec / 1e6 << " milhões/s), "
+         << retries << " tentativas com a fila cheia, "
+         << outOfOrder << " fora de ordem; latência média " << meanNs
+         << " ns, mediana " << p50Ns << " ns, p99 " << p99Ns
+         << " ns, máxima " << maxNs << " ns";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+InputRingBenchmark BenchmarkInputRing(ullong events)
+{
+    InputRingBenchmark result = {};
+    result.events = events;
+
+    // o buffer tem membros alinhados a linhas de cache
+    InputBuffer * buffer = new InputBuffer();
+    // a primeira consulta calibra o contador antes das marcas de tempo
+    double nsPerTick = 1e9 / Timer::Frequency();
+
+    // histograma da latência em faixas de 50 ns até 1 ms
+    const double BucketNs = 50.0;
+    vector<ullong> histogram(20001, 0);
+    double sumNs = 0.0;
+
+    llong start = Timer::Ticks();
+
+    // produtor: a marca é tomada antes da primeira tentativa, então
+    // o tempo de espera com a fila cheia entra na latência
+    std::thread producer([buffer, events, &result]
+        {
+            ullong retries = 0;
+            for (ullong i = 0; i < events; ++i)
+            {
+                InputEvent event = { Timer::Ticks(), INPUT_MOUSEMOVE, int(i), int(i & 0xffff), 0 };
+                // cede o processador ao consumidor se a fila encher
+                while (!buffer->Push(event))
+                {
+                    ++retries;
+                    std::this_thread::yield();
+                }
+            }
+            result.retries = retries;
+        });
+
+    // consumidor: esvazia a fila continuamente e confere a sequência
+    ullong received = 0;
+    while (received < events)
+    {
+        const vector<InputEvent> & batch = buffer->Flush();
+        llong now = Timer::Ticks();
+
+        if (batch.empty())
+            std::this_thread::yield();
+
+        for (const InputEvent & event : batch)
+        {
+            if (event.code != int(received))
+                ++result.outOfOrder;
+            ++received;
+
+            double ns = (now - event.stamp) * nsPerTick;
+            sumNs += ns;
+            if (ns > result.maxNs)
+                result.maxNs = ns;
+
+            size_t bucket = size_t(ns / BucketNs);
+            ++histogram[bucket < histogram.size() ? bucket : histogram.size() - 1];
+        }
+    }
+
+    llong end = Timer::Ticks();
+    producer.join();
+    delete buffer;
+
+    result.seconds = double(end - start) / Timer::Frequency();
+    result.eventsPerSec = result.seconds > 0.0 ? events / result.seconds : 0.0;
+    result.meanNs = events ? sumNs / events : 0.0;
+
+    // percentis pelo limite superior da faixa (a última faixa é aberta)
+    ullong count = 0;
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+        double limit = i + 1 < histogram.size() ? (i + 1) * BucketNs : result.maxNs;
+
+        count += histogram[i];
+        if (result.p50Ns == 0.0 && count * 2 >= events)
+            result.p50Ns = limit;
+        if (count * 100 >= events * 99)
+        {
+            result.p99Ns = limit;
+            break;
+        }
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+
+ScriptedEventSource::ScriptedEventSource(uint frames)
+{
+    next = 0;
+    frame = 0;
+    this->frames = frames;
+    sorted = true;
+}
+
+// -------------------------------------------------------------------------------
+
+void ScriptedEventSource::Key(uint frame, int vkcode, bool down)
+{
+    sorted = sorted && (script.empty() || script.back().frame <= frame);
+    script.push_back({ frame, { 0, uint(down ? INPUT_KEYDOWN : INPUT_KEYUP), vkcode, 0, 0 } });
+}
+
+// -------------------------------------------------------------------------------
+
+void ScriptedEventSource::MouseMove(uint frame, int x, int y)
+{
+    sorted = sorted && (script.empty() || script.back().frame <= frame);
+    script.push_back({ frame, { 0, INPUT_MOUSEMOVE, 0, x, y } });
+}
+
+// -------------------------------------------------------------------------------
+
+void ScriptedEventSource::MouseWheel(uint frame, int delta)
+{
+    sorted = sorted && (script.empty() || script.back().frame <= frame);
+    script.push_back({ frame, { 0, INPUT_MOUSEWHEEL, 0, delta, 0 } });
+}
+
+// -------------------------------------------------------------------------------
+
+bool ScriptedEventSource::Pump(InputBuffer & buffer)
+{
+    if (!sorted)
+    {
+        // eventos do mesmo quadro mantêm a ordem de inclusão
+        std::stable_sort(script.begin() + next, script.end(),
+            [](const Entry & a, const Entry & b) { return a.frame < b.frame; });
+        sorted = true;
+    }
+
+    if (frame >= frames)
+        return false;
+
+    // entrega todos os eventos programados até este quadro
+    llong stamp = Timer::Ticks();
+    for (; next < script.size() && script[next].frame <= frame; ++next)
+    {
+        InputEvent event = script[next].event;
+        event.stamp = stamp;
+        buffer.Push(event);
+    }
+
+    ++frame;
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+// Verificação da repetição de roteiros
+
+// estado da entrada ao fim de um quadro do roteiro
+struct ReplayFrame
+{
+    bool   keyA;                        // tecla A pressionada
+    bool   keyShift;                    // tecla Shift pressionada
+    int    mouseX;                      // posição do mouse
+    int    mouseY;
+    int    deltaX;                      // deslocamento no lote
+    int    deltaY;
+    int    wheel;                       // rotação acumulada da roda
+    size_t events;                      // eventos do lote
+
+    bool operator==(const ReplayFrame & other) const
+    {
+        return keyA == other.keyA && keyShift == other.keyShift
+            && mouseX == other.mouseX && mouseY == other.mouseY
+            && deltaX == other.deltaX && deltaY == other.deltaY
+            && wheel == other.wheel && events == other.events;
+    }
+};
+
+// código virtual da tecla Shift no Windows
+static const int KeyShift = 0x10;
+
+// executa o roteiro de teste e guarda o estado de cada quadro
+static vector<ReplayFrame> ReplayScript(ScriptedEventSource & source)
+{
+    // incluídos fora de ordem: a fonte ordena por quadro e mantém
+    // a ordem de inclusão dos eventos de um mesmo quadro
+    source.MouseMove(3, 40, 50);
+    source.Key(0, 'A', true);
+    source.MouseMove(0, 10, 20);
+    source.MouseMove(0, 12, 25);
+    source.Key(3, 'A', false);
+    source.Key(1, KeyShift, true);
+    source.MouseWheel(2, 120);
+    source.MouseWheel(2, -240);
+    source.Key(5, KeyShift, false);
+    source.Key(5, 'A', true);
+    source.Key(5, 'A', false);
+
+    // o buffer tem membros alinhados a linhas de cache
+    InputBuffer * buffer = new InputBuffer();
+    InputState state = {};
+    vector<ReplayFrame> frames;
+
+    while (source.Pump(*buffer))
+    {
+        const vector<InputEvent> & batch = buffer->Flush();
+        state.Apply(batch);
+        frames.push_back({ state.keys['A'], state.keys[KeyShift], state.mouseX, state.mouseY,
+            state.deltaX, state.deltaY, state.wheel, batch.size() });
+    }
+
+    delete buffer;
+    return frames;
+}
+
+// -------------------------------------------------------------------------------
+
+SelfTestReport TestInputReplay()
+{
+    SelfTestReport report("Entrada");
+
+    // estado esperado ao fim de cada quadro
+    const ReplayFrame expected[] =
+    {
+        { true,  false, 12, 25, 12, 25,    0, 3 },   // A pressionada, duas posições
+        { true,  true,  12, 25,  0,  0,    0, 1 },   // Shift pressionada
+        { true,  true,  12, 25,  0,  0, -120, 2 },   // roda acumulada
+        { false, true,  40, 50, 28, 25, -120, 2 },   // posição nova e A liberada
+        { false, true,  40, 50,  0,  0, -120, 0 },   // quadro sem eventos
+        { false, false, 40, 50,  0,  0, -120, 3 },   // A pressionada e liberada no mesmo lote
+    };
+    const uint frameCount = uint(sizeof(expected) / sizeof(expected[0]));
+
+    ScriptedEventSource source(frameCount);
+    vector<ReplayFrame> frames = ReplayScript(source);
+
+    report.Check(frames.size() == frameCount, "a fonte entrega " + std::to_string(frameCount) + " quadros");
+    report.Check(source.Frame() == frameCount, "Frame conta os quadros entregues");
+    report.Check(source.ExitCode() == 0, "código de saída do roteiro");
+
+    for (uint i = 0; i < frameCount && i < frames.size(); ++i)
+        report.Check(frames[i] == expected[i], "estado da entrada no quadro " + std::to_string(i));
+
+    // uma segunda execução do mesmo roteiro produz os mesmos quadros
+    ScriptedEventSource again(frameCount);
+    report.Check(ReplayScript(again) == frames, "repetição idêntica do roteiro");
+
+    // fila cheia: a liberação descartada não deixa a tecla presa
+    InputBuffer * full = new InputBuffer();
+    full->Push(INPUT_KEYDOWN, 'K');
+    while (full->Push(INPUT_MOUSEMOVE, 0, 1, 1));
+    bool lost = !full->Push(INPUT_KEYUP, 'K');
+
+    InputState state = {};
+    state.Apply(full->Flush());
+    report.Check(lost, "liberação descartada com a fila cheia");
+    report.Check(full->Dropped() == 2, "descartes contados");
+    report.Check(state.keys['K'] == false, "tecla liberada depois do descarte da liberação");
+
+    // o estado das teclas só é repetido no lote seguinte ao descarte
+    report.Check(full->Flush().empty(), "lote sem eventos depois da correção");
+
+    // um pressionamento descartado também chega ao estado
+    while (full->Push(INPUT_MOUSEMOVE, 0, 2, 2));
+    full->Push(INPUT_KEYDOWN, 'L');
+    state.Apply(full->Flush());
+    report.Check(state.keys['L'] && !state.keys['K'], "pressionamento descartado aplicado pela correção");
+    report.Check(state.mouseX == 2 && state.mouseY == 2, "posições do mouse aplicadas em ordem");
+
+    delete full;
+    return report;
+}
+
+// -------------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+WindowEventSource::WindowEventSource()
+{
+    exitCode = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+bool WindowEventSource::Pump(InputBuffer &)
+{
+    // DispatchMessage chama Input::InputProc, que grava os eventos
+    // de entrada em Input::Buffer(), o buffer recebido aqui
+    MSG msg = { 0 };
+
+    // esvazia a fila antes do quadro: uma rajada de mensagens do mouse
+    // não atrasa o quadro seguinte por várias voltas do laço
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+    {
+        if (msg.message == WM_QUIT)
+        {
+            exitCode = int(msg.wParam);
+            return false;
+        }
+
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void WindowEventSource::Wait()
+{
+    // a thread dorme até a fila receber uma mensagem nova
+    WaitMessage();
+}
+
+// -------------------------------------------------------------------------------
+
+int WindowEventSource::ExitCode() const
+{
+    return exitCode;
+}
+
+#endif
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,229 @@
+/**********************************************************************************
+// EventSource (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Eventos de entrada com marca de tempo e as fontes que os
+//              produzem para o laço principal.
+//
+//              A cada quadro a fonte trata todos os eventos pendentes da
+//              plataforma de uma vez. Os eventos de teclado e mouse são
+//              gravados em ordem em um buffer e aplicados juntos ao estado
+//              da entrada antes da atualização da aplicação, que pode ler
+//              o estado final, o deslocamento acumulado do mouse ou cada
+//              amostra do lote.
+//
+//              A fonte da plataforma (mensagens do Windows) fica atrás de
+//              uma interface. Uma fonte roteirizada entrega eventos
+//              programados por quadro e permite executar o laço em testes,
+//              inclusive em Linux.
+//
+//              Os eventos pendentes passam por uma fila circular sem travas
+//              de um produtor (a fonte de eventos) e um consumidor (a
+//              atualização), de modo que a simulação pode rodar em outra
+//              thread sem compartilhar o estado do teclado e do mouse.
+//              Com a fila cheia os eventos são descartados, mas a fonte
+//              mantém o estado de cada tecla: depois de um descarte de
+//              teclado o lote seguinte termina com esse estado, de modo que
+//              uma liberação perdida nunca deixa uma tecla presa.
+//
+**********************************************************************************/
+
+#ifndef DXUT_EVENTSOURCE_H
+#define DXUT_EVENTSOURCE_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Timer.h"                      // marcas de tempo dos eventos
+#include "SpscRing.h"                   // fila sem travas entre as threads
+#include "SelfTest.h"                   // verificações de -selftest
+#include <atomic>
+#include <string>
+#include <vector>
+using std::atomic;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// tipos de eventos de entrada
+enum InputEventType { INPUT_KEYDOWN, INPUT_KEYUP, INPUT_MOUSEMOVE, INPUT_MOUSEWHEEL };
+
+// evento de entrada
+struct InputEvent
+{
+    llong stamp;                        // instante do tratamento (Timer::Ticks)
+    uint  type;                         // InputEventType
+    int   code;                         // tecla ou botão (códigos virtuais do Windows)
+    int   x;                            // posição x do mouse ou rotação da roda
+    int   y;                            // posição y do mouse
+};
+
+// estado da entrada depois de aplicados os eventos
+struct InputState
+{
+    bool keys[256];                     // teclas e botões pressionados
+    int  mouseX;                        // posição do mouse no eixo x
+    int  mouseY;                        // posição do mouse no eixo y
+    int  deltaX;                        // deslocamento x do mouse no último lote
+    int  deltaY;                        // deslocamento y do mouse no último lote
+    int  wheel;                         // rotação da roda acumulada até ser lida
+
+    void Apply(const vector<InputEvent> & events);  // aplica um lote em ordem
+};
+
+// -------------------------------------------------------------------------------
+
+// eventos recebidos desde o último quadro e o lote do quadro atual
+//
+// Push é chamado apenas pela thread que trata os eventos (produtor) e
+// Flush apenas pela thread que atualiza a aplicação (consumidor)
+class InputBuffer
+{
+public:
+    static const uint Capacity = 4096;  // eventos pendentes antes de descartar
+
+private:
+    SpscRing<InputEvent, Capacity> pending;     // recebidos desde o último quadro
+    vector<InputEvent> batch;           // lote do quadro atual
+    atomic<ullong> dropped;             // eventos descartados com a fila cheia
+    atomic<uint> keyBits[8];            // teclas pressionadas segundo a fonte (256 bits)
+    atomic<bool> resync;                // evento de teclado descartado desde o último lote
+
+public:
+    InputBuffer();                      // construtor
+
+    bool Push(const InputEvent & event);                        // grava um evento
+    bool Push(uint type, int code, int x = 0, int y = 0);       // grava com a marca atual
+
+    const vector<InputEvent> & Flush(); // começa um lote com os eventos pendentes
+    const vector<InputEvent> & Batch() const;                   // lote do quadro atual
+    size_t Pending() const;             // eventos ainda não entregues
+    ullong Dropped() const;             // eventos descartados
+};
+
+// -------------------------------------------------------------------------------
+
+// medição da fila de eventos entre duas threads
+struct InputRingBenchmark
+{
+    ullong events;                      // eventos transferidos
+    ullong retries;                     // tentativas com a fila cheia
+    ullong outOfOrder;                  // eventos fora de sequência (deve ser zero)
+    double seconds;                     // duração da transferência
+    double eventsPerSec;                // vazão
+    double meanNs;                      // latência média da gravação à leitura
+    double p50Ns;                       // mediana da latência
+    double p99Ns;                       // percentil 99 da latência
+    double maxNs;                       // maior latência
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// produz eventos em uma thread e consome em outra o mais rápido possível
+InputRingBenchmark BenchmarkInputRing(ullong events = 10000000);
+
+// reproduz um roteiro pela fonte roteirizada e confere o estado de cada
+// quadro, a repetição idêntica e a liberação de teclas com a fila cheia
+SelfTestReport TestInputReplay();
+
+// -------------------------------------------------------------------------------
+
+// fonte de eventos da plataforma
+class EventSource
+{
+public:
+    virtual ~EventSource() {}
+
+    // trata todos os eventos pendentes, gravando os de entrada em buffer,
+    // e retorna falso quando a aplicação deve encerrar
+    virtual bool Pump(InputBuffer & buffer) = 0;
+
+    // bloqueia até chegar um novo evento (laço em pausa); fontes
+    // sem eventos externos, como a roteirizada, retornam logo
+    virtual void Wait() {}
+
+    // código de saída depois que Pump retorna falso
+    virtual int ExitCode() const = 0;
+};
+
+// -------------------------------------------------------------------------------
+
+// eventos programados por quadro para testes
+class ScriptedEventSource : public EventSource
+{
+private:
+    struct Entry
+    {
+        uint frame;                     // quadro em que o evento é entregue
+        InputEvent event;               // evento entregue
+    };
+
+    vector<Entry> script;               // eventos programados
+    size_t next;                        // próximo evento a entregar
+    uint frame;                         // quadro atual
+    uint frames;                        // quadros executados antes de encerrar
+    bool sorted;                        // roteiro em ordem de quadro
+
+public:
+    ScriptedEventSource(uint frames);   // executa frames quadros
+
+    void Key(uint frame, int vkcode, bool down);    // tecla ou botão
+    void MouseMove(uint frame, int x, int y);       // nova posição do mouse
+    void MouseWheel(uint frame, int delta);         // rotação da roda
+
+    bool Pump(InputBuffer & buffer);
+    int ExitCode() const;
+    uint Frame() const;                 // quadros já entregues
+};
+
+// -------------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+// mensagens da fila do Windows
+class WindowEventSource : public EventSource
+{
+private:
+    int exitCode;                       // wParam de WM_QUIT
+
+public:
+    WindowEventSource();
+
+    // os eventos de entrada chegam ao buffer pela window procedure de Input
+    bool Pump(InputBuffer & buffer);
+    void Wait();                        // espera uma nova mensagem (WaitMessage)
+    int ExitCode() const;
+};
+
+#endif
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// lote do quadro atual
+inline const vector<InputEvent> & InputBuffer::Batch() const
+{ return batch; }
+
+// eventos ainda não entregues
+inline size_t InputBuffer::Pending() const
+{ return pending.Size(); }
+
+// eventos descartados com a fila cheia
+inline ullong InputBuffer::Dropped() const
+{ return dropped.load(std::memory_order_relaxed); }
+
+// código de saída da fonte roteirizada
+inline int ScriptedEventSource::ExitCode() const
+{ return 0; }
+
+// quadros já entregues
+inline uint ScriptedEventSource::Frame() const
+{ return frame; }
+
+// -------------------------------------------------------------------------------
+
+#endif
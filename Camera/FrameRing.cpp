@@ -0,0 +1,308 @@
+/**********************************************************************************
+// FrameRing (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Quadros em andamento na GPU, fila de comandos simulada e
+//              medição da sobreposição entre CPU e GPU.
+//
+**********************************************************************************/
+
+#include "FrameRing.h"
+#include "Timer.h"
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+FrameRing::FrameRing(uint framesInFlight)
+{
+    frames = 0;
+    stalls = 0;
+    stallTime = 0.0;
+    Frames(framesInFlight);
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameRing::Frames(uint framesInFlight)
+{
+    count = framesInFlight < 1 ? 1 : (framesInFlight > MaxFrames ? MaxFrames : framesInFlight);
+    index = 0;
+
+    for (uint i = 0; i < MaxFrames; ++i)
+        fences[i] = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameRing::Advance(GpuTimeline & queue)
+{
+    // o slot atual fica ocupado até a GPU passar por este valor
+    fences[index] = queue.Signal();
+    index = (index + 1) % count;
+    ++frames;
+
+    // o próximo slot só é reutilizado depois que a GPU terminou
+    // o quadro que o usou pela última vez
+    if (queue.Completed() < fences[index])
+    {
+        llong start = Timer::Ticks();
+        queue.Wait(fences[index]);
+        stallTime += double(Timer::Ticks() - start) / Timer::Frequency();
+        ++stalls;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void FrameRing::Flush(GpuTimeline & queue)
+{
+    queue.Wait(queue.Signal());
+}
+
+// -------------------------------------------------------------------------------
+
+SimulatedQueue::SimulatedQueue() : completed(0)
+{
+    signaled = 0;
+    busy = 0.0;
+    quit = false;
+    gpu = std::thread(&SimulatedQueue::Run, this);
+}
+
+// -------------------------------------------------------------------------------
+
+SimulatedQueue::~SimulatedQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    work.notify_one();
+    gpu.join();
+}
+
+// -------------------------------------------------------------------------------
+
+void SimulatedQueue::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+        work.wait(lock, [this] { return quit || !items.empty(); });
+        if (items.empty())
+            return;
+
+        Item item = items.front();
+        items.pop_front();
+
+        if (item.fence)
+        {
+            // a cerca só é alcançada depois de todos os trabalhos anteriores
+            completed.store(item.fence, std::memory_order_release);
+            done.notify_all();
+        }
+        else
+        {
+            // a GPU fica ocupada sem segurar a fila
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::duration<double>(item.seconds));
+            lock.lock();
+            busy += item.seconds;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void SimulatedQueue::Execute(double gpuSeconds)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push_back({ gpuSeconds, 0 });
+    }
+    work.notify_one();
+}
+
+// -------------------------------------------------------------------------------
+
+ullong SimulatedQueue::Signal()
+{
+    ullong value;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = ++signaled;
+        items.push_back({ 0.0, value });
+    }
+    work.notify_one();
+    return value;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong SimulatedQueue::Completed()
+{
+    return completed.load(std::memory_order_acquire);
+}
+
+// -------------------------------------------------------------------------------
+
+void SimulatedQueue::Wait(ullong value)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this, value] { return completed.load(std::memory_order_acquire) >= value; });
+}
+
+// -------------------------------------------------------------------------------
+
+double SimulatedQueue::Busy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return busy;
+}
+
+// -------------------------------------------------------------------------------
+// Medição da sobreposição entre CPU e GPU
+
+string FrameOverlapBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << framesInFlight << " quadro(s) em andamento, CPU " << cpuMs << " ms + GPU "
+         << gpuMs << " ms: " << frameMs << " ms por quadro, GPU ocupada "
+         << gpuUsage * 100.0 << "%, " << stalls << " esperas ("
+         << stallMs << " ms por quadro)";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+FrameOverlapBenchmark BenchmarkFramesInFlight(uint framesInFlight, uint frames, double cpuMs, double gpuMs)
+{
+    Timer timer;
+
+    SimulatedQueue queue;
+    FrameRing ring(framesInFlight);
+
+    FrameOverlapBenchmark result = {};
+    result.framesInFlight = ring.Count();
+    result.frames = frames ? frames : 1;
+    result.cpuMs = cpuMs;
+    result.gpuMs = gpuMs;
+
+    timer.Start();
+
+    for (uint i = 0; i < result.frames; ++i)
+    {
+        // gravação dos comandos do quadro na CPU
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(cpuMs));
+
+        // submissão e troca de slot
+        queue.Execute(gpuMs / 1000.0);
+        ring.Advance(queue);
+    }
+
+    ring.Flush(queue);
+    double seconds = timer.Elapsed();
+
+    result.frameMs = seconds * 1000.0 / result.frames;
+    result.gpuUsage = seconds > 0.0 ? queue.Busy() / seconds : 0.0;
+    result.stalls = ring.Stalls();
+    result.stallMs = ring.StallTime() * 1000.0 / result.frames;
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+// Verificação dos quadros em andamento
+
+// linha do tempo controlada pelo teste: a GPU só avança quando a CPU
+// espera por uma cerca, ou conclui cada quadro assim que ele é sinalizado
+class ManualTimeline : public GpuTimeline
+{
+public:
+    bool   instant = false;             // a GPU conclui tudo imediatamente
+    ullong signaled = 0;                // último valor sinalizado
+    ullong completed = 0;               // último valor alcançado
+    ullong waits = 0;                   // esperas da CPU
+    ullong waitedFor = 0;               // valor da última espera
+
+    ullong Signal() { ++signaled; if (instant) completed = signaled; return signaled; }
+    ullong Completed() { return completed; }
+    void Wait(ullong value) { ++waits; waitedFor = value; if (completed < value) completed = value; }
+};
+
+SelfTestReport TestFrameRing()
+{
+    SelfTestReport report("Quadros em andamento");
+
+    // número de slots limitado a [1, MaxFrames]
+    report.Check(FrameRing(0).Count() == 1, "pelo menos um quadro em andamento");
+    report.Check(FrameRing(FrameRing::MaxFrames + 5).Count() == FrameRing::MaxFrames, "limite de quadros em andamento");
+
+    for (uint count = 1; count <= FrameRing::MaxFrames; ++count)
+    {
+        // GPU parada: a CPU só espera quando volta a um slot ainda em uso
+        ManualTimeline stuck;
+        FrameRing ring(count);
+
+        bool ahead = true;
+        bool cycle = true;
+        bool oldest = true;
+        const uint frames = 20;
+        for (uint i = 0; i < frames; ++i)
+        {
+            ullong waits = stuck.waits;
+            ring.Advance(stuck);
+
+            cycle = cycle && ring.Index() == (i + 1) % count;
+            ahead = ahead && stuck.signaled - stuck.completed < count;
+
+            // o quadro i + 1 reutiliza o slot do quadro i + 1 - count
+            if (i + 1 >= count)
+                oldest = oldest && stuck.waits == waits + 1 && stuck.waitedFor == i + 2 - count;
+            else
+                oldest = oldest && stuck.waits == waits;
+        }
+
+        string slots = std::to_string(count) + " slot(s): ";
+        report.Check(cycle, slots + "slots usados em ordem circular");
+        report.Check(ahead, slots + "CPU no máximo N - 1 quadros à frente da GPU");
+        report.Check(oldest, slots + "espera pela cerca do quadro que usou o slot");
+        report.Check(ring.Stalls() == frames + 1 - count && ring.Submitted() == frames, slots + "esperas contadas");
+
+        // GPU sempre em dia: nenhuma espera
+        ManualTimeline idle;
+        idle.instant = true;
+        FrameRing fast(count);
+        for (uint i = 0; i < frames; ++i)
+            fast.Advance(idle);
+        report.Check(fast.Stalls() == 0 && idle.waits == 0, slots + "nenhuma espera com a GPU em dia");
+
+        // Flush conclui todos os quadros em andamento
+        ring.Flush(stuck);
+        report.Check(stuck.completed == stuck.signaled, slots + "Flush alcança a última cerca");
+    }
+
+    // fila simulada: a cerca vem depois dos trabalhos submetidos antes dela
+    SimulatedQueue queue;
+    queue.Execute(0.002);
+    queue.Execute(0.002);
+    ullong fence = queue.Signal();
+    queue.Wait(fence);
+    report.Check(queue.Completed() == fence, "fila simulada alcança a cerca");
+    report.Check(queue.Busy() >= 0.004 - 1e-9, "cerca alcançada depois dos trabalhos anteriores");
+
+    ullong first = queue.Signal();
+    ullong second = queue.Signal();
+    queue.Wait(second);
+    report.Check(second == first + 1 && queue.Completed() == second, "cercas sinalizadas e alcançadas em ordem");
+
+    return report;
+}
+
+// -------------------------------------------------------------------------------
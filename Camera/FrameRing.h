@@ -0,0 +1,171 @@
+/**********************************************************************************
+// FrameRing (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Quadros em andamento na GPU.
+//
+//              Cada quadro grava seus comandos em um slot próprio (alocador
+//              de comandos, dados dinâmicos) e, ao ser submetido, guarda o
+//              valor da cerca sinalizado depois dele. A CPU passa para o
+//              próximo slot e só espera quando esse slot ainda está em uso
+//              pela GPU, o que permite à CPU preparar até N quadros à frente
+//              em vez de esperar a GPU ficar ociosa a cada quadro.
+//
+//              A fila de comandos é vista pela interface GpuTimeline. O
+//              Direct3D a implementa em Graphics; a fila simulada executa o
+//              trabalho em outra thread com a latência pedida, o que permite
+//              medir a sobreposição entre CPU e GPU sem placa de vídeo.
+//
+**********************************************************************************/
+
+#ifndef DXUT_FRAMERING_H
+#define DXUT_FRAMERING_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "SelfTest.h"                   // verificações de -selftest
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+// linha do tempo de uma fila de comandos
+class GpuTimeline
+{
+public:
+    virtual ~GpuTimeline() {}
+
+    virtual ullong Signal() = 0;            // marca o fim dos comandos já submetidos
+    virtual ullong Completed() = 0;         // último valor alcançado pela GPU
+    virtual void Wait(ullong value) = 0;    // bloqueia a CPU até a GPU alcançar value
+};
+
+// -------------------------------------------------------------------------------
+
+class FrameRing
+{
+public:
+    static const uint MaxFrames = 4;    // limite de quadros em andamento
+
+private:
+    uint   count;                       // quadros em andamento
+    uint   index;                       // slot do quadro atual
+    ullong fences[MaxFrames];           // valor da cerca do último uso de cada slot
+
+    ullong frames;                      // quadros submetidos
+    ullong stalls;                      // esperas por um slot ocupado
+    double stallTime;                   // tempo total das esperas (segundos)
+
+public:
+    FrameRing(uint framesInFlight = 2); // construtor
+
+    void Frames(uint framesInFlight);   // altera o número de slots (com a GPU ociosa)
+    void Advance(GpuTimeline & queue);  // fim do quadro: sinaliza e libera o próximo slot
+    void Flush(GpuTimeline & queue);    // espera todos os quadros em andamento
+
+    uint   Index() const;               // slot do quadro atual
+    uint   Count() const;               // quadros em andamento
+    ullong Submitted() const;           // quadros submetidos
+    ullong Stalls() const;              // esperas por um slot ocupado
+    double StallTime() const;           // tempo total das esperas
+};
+
+// -------------------------------------------------------------------------------
+
+// fila de comandos simulada: executa cada trabalho em outra thread
+// durante o tempo pedido e sinaliza as cercas em ordem
+class SimulatedQueue : public GpuTimeline
+{
+private:
+    struct Item
+    {
+        double seconds;                 // duração do trabalho (0 para cercas)
+        ullong fence;                   // valor sinalizado (0 para trabalhos)
+    };
+
+    std::deque<Item> items;             // trabalhos e cercas pendentes
+    std::mutex mutex;                   // protege a fila e o estado
+    std::condition_variable work;       // acorda a GPU simulada
+    std::condition_variable done;       // acorda quem espera por uma cerca
+    std::atomic<ullong> completed;      // último valor alcançado
+    ullong signaled;                    // último valor sinalizado
+    double busy;                        // tempo total ocupado (segundos)
+    bool quit;                          // encerra a thread
+    std::thread gpu;                    // thread que executa os trabalhos
+
+    void Run();                         // laço da GPU simulada
+
+public:
+    SimulatedQueue();                   // construtor
+    ~SimulatedQueue();                  // destrutor
+
+    void Execute(double gpuSeconds);    // submete um trabalho
+
+    ullong Signal();
+    ullong Completed();
+    void Wait(ullong value);
+
+    double Busy();                      // tempo total ocupado
+};
+
+// -------------------------------------------------------------------------------
+
+// medição da sobreposição entre CPU e GPU
+struct FrameOverlapBenchmark
+{
+    uint   framesInFlight;              // quadros em andamento
+    uint   frames;                      // quadros medidos
+    double cpuMs;                       // trabalho da CPU por quadro
+    double gpuMs;                       // trabalho da GPU por quadro
+    double frameMs;                     // intervalo médio entre quadros
+    double gpuUsage;                    // fração do tempo com a GPU ocupada
+    ullong stalls;                      // esperas por um slot ocupado
+    double stallMs;                     // espera média por quadro
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// simula frames quadros com o custo dado de CPU e GPU
+FrameOverlapBenchmark BenchmarkFramesInFlight(uint framesInFlight, uint frames = 120,
+                                              double cpuMs = 4.0, double gpuMs = 6.0);
+
+// confere que a CPU nunca fica mais de N quadros à frente da GPU, que um
+// slot só é reutilizado depois da sua cerca e que a fila simulada alcança
+// as cercas em ordem, depois dos trabalhos anteriores
+SelfTestReport TestFrameRing();
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// slot do quadro atual
+inline uint FrameRing::Index() const
+{ return index; }
+
+// quadros em andamento
+inline uint FrameRing::Count() const
+{ return count; }
+
+// quadros submetidos
+inline ullong FrameRing::Submitted() const
+{ return frames; }
+
+// esperas por um slot ocupado
+inline ullong FrameRing::Stalls() const
+{ return stalls; }
+
+// tempo total das esperas
+inline double FrameRing::StallTime() const
+{ return stallTime; }
+
+// -------------------------------------------------------------------------------
+
+#endif
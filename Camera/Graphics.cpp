@@ -1,11 +1,11 @@
 /**********************************************************************************
-// Graphics (Cdigo Fonte)
+// Graphics (Código Fonte)
 // 
-// Criao:     06 Abr 2011
-// Atualizao: 15 Ago 2021
+// Criação:     06 Abr 2011
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Usa funes do Direct3D 12 para acessar a GPU
+// Descrição:   Usa funções do Direct3D 12 para acessar a GPU
 //
 **********************************************************************************/
 
@@ -18,26 +18,26 @@ using std::wstringstream;
 
 Graphics::Graphics()
 {
-    // configurao
+    // configuração
     backBufferCount = 2;    // double-buffering
-    backBufferIndex = 0;    // zero  o primeiro
+    backBufferIndex = 0;    // zero é o primeiro
     antialiasing = 1;       // sem antialiasing
-    quality = 0;            // qualidade padro
+    quality = 0;            // qualidade padrão
     vSync = false;          // sem vertical sync
 
     // cor de fundo
     bgColor[0] = 0.0f;      // Red
     bgColor[1] = 0.0f;      // Green
     bgColor[2] = 0.0f;      // Blue
-    bgColor[3] = 0.0f;      // Alpha (0 = transparente, 1 = slido)
+    bgColor[3] = 0.0f;      // Alpha (0 = transparente, 1 = sólido)
 
-    // infraestrutura grfica
+    // infraestrutura gráfica
     factory           = nullptr;
     device            = nullptr;
     swapChain         = nullptr;
     commandQueue      = nullptr;
     commandList       = nullptr;
-    commandListAlloc  = nullptr;
+    commandAllocators = new ID3D12CommandAllocator*[backBufferCount] {nullptr};
     
     // pipeline do Direct3D
     renderTargets     = new ID3D12Resource*[backBufferCount] {nullptr};
@@ -48,17 +48,40 @@ Graphics::Graphics()
     ZeroMemory(&viewport, sizeof(viewport));
     ZeroMemory(&scissorRect, sizeof(scissorRect));
 
-    // sincronizao cpu/gpu
+    // sincronização cpu/gpu
     fence = nullptr;
     currentFence = 0;
+    fenceEvent = nullptr;
+    frames.Frames(backBufferCount);
+
+    // dados por quadro
+    uploadMemory = nullptr;
+    uploadRing = nullptr;
+
+    // buffers estáticos
+    heapMemory = nullptr;
+    heapAllocator = nullptr;
+    uploadBatch = nullptr;
 }
 
 // ------------------------------------------------------------------------------
 
 Graphics::~Graphics()
 {
-    // espera GPU finalizar comandos na fila
-    WaitCommandQueue();
+    // espera GPU finalizar comandos na fila (se o Direct3D foi inicializado)
+    if (commandQueue)
+        WaitCommandQueue();
+
+    // libera o anel e as áreas de upload (GPU ociosa)
+    delete uploadBatch;
+    delete uploadRing;
+    delete uploadMemory;
+
+    // libera buffers estáticos devolvidos e as heaps (recursos
+    // colocados ainda em uso mantêm sua heap viva no Direct3D)
+    ReleaseRetired(currentFence);
+    delete heapAllocator;
+    delete heapMemory;
 
     // libera depth stencil buffer
     if (depthStencil)
@@ -75,10 +98,13 @@ Graphics::~Graphics()
         delete[] renderTargets;
     }
 
-    // libera barreira
+    // libera barreira e evento de espera
     if (fence)
         fence->Release();
 
+    if (fenceEvent)
+        CloseHandle(fenceEvent);
+
     // libera depth stencil heap
     if (depthStencilHeap)
         depthStencilHeap->Release();
@@ -90,7 +116,7 @@ Graphics::~Graphics()
     // libera swap chain
     if (swapChain)
     {
-        // Direct3D  incapaz de fechar quando em tela cheia
+        // Direct3D é incapaz de fechar quando em tela cheia
         swapChain->SetFullscreenState(false, NULL);
         swapChain->Release();
     }
@@ -99,15 +125,22 @@ Graphics::~Graphics()
     if (commandList)
         commandList->Release();
 
-    // libera alocador de comandos
-    if (commandListAlloc)
-        commandListAlloc->Release();
+    // libera alocadores de comandos
+    if (commandAllocators)
+    {
+        for (uint i = 0; i < backBufferCount; ++i)
+        {
+            if (commandAllocators[i])
+                commandAllocators[i]->Release();
+        }
+        delete[] commandAllocators;
+    }
 
     // libera fila de comandos
     if (commandQueue)
         commandQueue->Release();
 
-    // libera dispositivo grfico
+    // libera dispositivo gráfico
     if (device)
         device->Release();
 
@@ -123,7 +156,7 @@ void Graphics::LogHardwareInfo()
     const uint BytesinMegaByte = 1048576U;
 
     // --------------------------------------
-    // Adaptador de vdeo (placa de vdeo)
+    // Adaptador de vídeo (placa de vídeo)
     // --------------------------------------
     IDXGIAdapter* adapter = nullptr;
     if (factory->EnumAdapters(0, &adapter) != DXGI_ERROR_NOT_FOUND)
@@ -132,7 +165,7 @@ void Graphics::LogHardwareInfo()
         adapter->GetDesc(&desc);
 
         wstringstream text;
-        text << L"---> Placa de vdeo: " << desc.Description << L"\n";
+        text << L"---> Placa de vídeo: " << desc.Description << L"\n";
         OutputDebugStringW(text.str().c_str());
     }
 
@@ -143,15 +176,15 @@ void Graphics::LogHardwareInfo()
         adapter4->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &memInfo);
         
         wstringstream text;
-        text << L"---> Memria de vdeo (livre): " << memInfo.Budget / BytesinMegaByte << L"MB\n";
-        text << L"---> Memria de vdeo (usada): " << memInfo.CurrentUsage / BytesinMegaByte << L"MB\n";
+        text << L"---> Memória de vídeo (livre): " << memInfo.Budget / BytesinMegaByte << L"MB\n";
+        text << L"---> Memória de vídeo (usada): " << memInfo.CurrentUsage / BytesinMegaByte << L"MB\n";
         OutputDebugStringW(text.str().c_str());
 
         adapter4->Release();
     }    
 
     // -----------------------------------------
-    // Feature Level mximo suportado pela GPU
+    // Feature Level máximo suportado pela GPU
     // -----------------------------------------
     D3D_FEATURE_LEVEL featureLevels[9] =
     {
@@ -175,7 +208,7 @@ void Graphics::LogHardwareInfo()
         &featureLevelsInfo,
         sizeof(featureLevelsInfo));
 
-    // bloco de instrues
+    // bloco de instruções
     {
         wstringstream text;
         text << L"---> Feature Level: ";
@@ -195,7 +228,7 @@ void Graphics::LogHardwareInfo()
     }
 
     // -----------------------------------------
-    // Sada de vdeo (monitor)
+    // Saída de vídeo (monitor)
     // -----------------------------------------
 
     IDXGIOutput* output = nullptr;
@@ -210,22 +243,22 @@ void Graphics::LogHardwareInfo()
     }
 
     // ------------------------------------------
-    // Modo de vdeo (resoluo)
+    // Modo de vídeo (resolução)
     // ------------------------------------------
 
-    // pega as dimenses da tela
+    // pega as dimensões da tela
     uint dpi = GetDpiForSystem();
     uint screenWidth = GetSystemMetricsForDpi(SM_CXSCREEN, dpi);
     uint screenHeight = GetSystemMetricsForDpi(SM_CYSCREEN, dpi);
 
-    // pega a frequencia de atualizao da tela
+    // pega a frequencia de atualização da tela
     DEVMODE devMode = { 0 };
     devMode.dmSize = sizeof(DEVMODE);
     EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &devMode);
     uint refresh = devMode.dmDisplayFrequency;
 
     wstringstream text;
-    text << L"---> Resoluo: " << screenWidth << L"x" << screenHeight << L" " << refresh << L" Hz\n";
+    text << L"---> Resolução: " << screenWidth << L"x" << screenHeight << L" " << refresh << L" Hz\n";
     OutputDebugStringW(text.str().c_str());
 
     // ------------------------------------------
@@ -247,21 +280,21 @@ void Graphics::Initialize(Window * window)
     uint factoryFlags = 0;
 
 #ifdef _DEBUG
-    // habilita a camada de depurao do DXGI
+    // habilita a camada de depuração do DXGI
     factoryFlags = DXGI_CREATE_FACTORY_DEBUG;
-    // habilita a camada de depurao do D3D12
+    // habilita a camada de depuração do D3D12
     ID3D12Debug * debugController;
     ThrowIfFailed(D3D12GetDebugInterface(IID_PPV_ARGS(&debugController)));
     debugController->EnableDebugLayer();
 #endif
 
-    // cria objeto para infraestrutura grfica do DirectX (DXGI)
+    // cria objeto para infraestrutura gráfica do DirectX (DXGI)
     ThrowIfFailed(CreateDXGIFactory2(factoryFlags, IID_PPV_ARGS(&factory)));
 
-    // cria objeto para dispositivo grfico
+    // cria objeto para dispositivo gráfico
     if FAILED(D3D12CreateDevice(
-        nullptr,                                // adaptador de vdeo (nullptr = adaptador padro)
-        D3D_FEATURE_LEVEL_11_0,                 // verso mnima dos recursos do Direct3D
+        nullptr,                                // adaptador de vídeo (nullptr = adaptador padrão)
+        D3D_FEATURE_LEVEL_11_0,                 // versão mínima dos recursos do Direct3D
         IID_PPV_ARGS(&device)))                 // guarda o dispositivo D3D criado
     {
         // tenta criar um dispositivo WARP 
@@ -270,20 +303,20 @@ void Graphics::Initialize(Window * window)
 
         // cria objeto D3D usando dispositivo WARP
         ThrowIfFailed(D3D12CreateDevice(
-            warp,                               // adaptador de vdeo WARP (software)
-            D3D_FEATURE_LEVEL_11_0,             // verso mnima dos recursos do Direct3D
+            warp,                               // adaptador de vídeo WARP (software)
+            D3D_FEATURE_LEVEL_11_0,             // versão mínima dos recursos do Direct3D
             IID_PPV_ARGS(&device)));            // guarda o dispositivo D3D criado
 
-        // libera objeto no mais necessrio
+        // libera objeto não mais necessário
         warp->Release();
 
         // informa uso de um disposito WARP:
         // implementa as funcionalidades do 
         // D3D12 em software (lento)
-        OutputDebugString("---> Usando Adaptador WARP: no h suporte ao D3D12\n");
+        OutputDebugString("---> Usando Adaptador WARP: não há suporte ao D3D12\n");
     }
 
-    // exibe informaes do hardware grfico no Output do Visual Studio
+    // exibe informações do hardware gráfico no Output do Visual Studio
 #ifdef _DEBUG
     LogHardwareInfo();
 #endif 
@@ -298,25 +331,61 @@ void Graphics::Initialize(Window * window)
     queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
     ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&commandQueue)));
 
-    // cria o alocador de comandos
-    ThrowIfFailed(device->CreateCommandAllocator(
-        D3D12_COMMAND_LIST_TYPE_DIRECT,
-        IID_PPV_ARGS(&commandListAlloc)));
+    // cria um alocador de comandos por quadro em andamento: a memória de
+    // um alocador só pode ser reaproveitada depois que a GPU a consumiu
+    for (uint i = 0; i < backBufferCount; ++i)
+    {
+        ThrowIfFailed(device->CreateCommandAllocator(
+            D3D12_COMMAND_LIST_TYPE_DIRECT,
+            IID_PPV_ARGS(&commandAllocators[i])));
+    }
 
     // cria a lista de comandos
     ThrowIfFailed(device->CreateCommandList(
         0,                                      // usando apenas uma GPU
-        D3D12_COMMAND_LIST_TYPE_DIRECT,         // no herda estado na GPU
-        commandListAlloc,                       // alocador de comandos
+        D3D12_COMMAND_LIST_TYPE_DIRECT,         // não herda estado na GPU
+        commandAllocators[frames.Index()],      // alocador de comandos
         nullptr,                                // estado inicial do pipeline
         IID_PPV_ARGS(&commandList)));           // objeto lista de comandos
 
     // ---------------------------------------------------
-    // Cerca para sincronizao da CPU/GPU
+    // Cerca para sincronização da CPU/GPU
     // ---------------------------------------------------
 
     ThrowIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
 
+    // evento criado uma única vez e reutilizado em todas as esperas
+    fenceEvent = CreateEventEx(NULL, NULL, NULL, EVENT_ALL_ACCESS);
+    if (!fenceEvent)
+        ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+
+    // ---------------------------------------------------
+    // Anel de upload para os dados de cada quadro
+    // ---------------------------------------------------
+
+    uploadMemory = new GraphicsUploadMemory(*this);
+    uploadRing = new UploadRing(*uploadMemory);
+
+    // ---------------------------------------------------
+    // Heaps compartilhadas para os buffers estáticos
+    // ---------------------------------------------------
+
+    heapMemory = new GraphicsHeapMemory(*this);
+    heapAllocator = new HeapAllocator(*heapMemory, 64ull << 20, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+    // o orçamento é a memória local que o sistema reserva para a aplicação
+    IDXGIAdapter3 * adapter = nullptr;
+    if (SUCCEEDED(factory->EnumAdapterByLuid(device->GetAdapterLuid(), IID_PPV_ARGS(&adapter))))
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO memInfo;
+        if (SUCCEEDED(adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &memInfo)))
+            heapAllocator->Budget(memInfo.Budget);
+        adapter->Release();
+    }
+
+    // envios dos buffers estáticos usam áreas da mesma memória de upload
+    uploadBatch = new UploadBatch(*uploadMemory, *this);
+
     // ---------------------------------------------------
     // Swap Chain
     // ---------------------------------------------------
@@ -338,9 +407,9 @@ void Graphics::Initialize(Window * window)
     ThrowIfFailed(factory->CreateSwapChainForHwnd(
         commandQueue,                           // fila de comandos da GPU 
         window->Id(),                           // identificador da janela
-        &swapChainDesc,                         // descrio da swap chain
+        &swapChainDesc,                         // descrição da swap chain
         nullptr,                                // swap chain para tela cheia
-        nullptr,                                // restringir tela de sada
+        nullptr,                                // restringir tela de saída
         &swapChain));                           // objeto swap chain
 
     // ---------------------------------------------------
@@ -354,11 +423,11 @@ void Graphics::Initialize(Window * window)
     renderTargetHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
     ThrowIfFailed(device->CreateDescriptorHeap(&renderTargetHeapDesc, IID_PPV_ARGS(&renderTargetHeap)));
 
-    // pega um Handle para o incio da Heap
+    // pega um Handle para o início da Heap
     D3D12_CPU_DESCRIPTOR_HANDLE rtHandle = renderTargetHeap->GetCPUDescriptorHandleForHeapStart();
 
-    // valor a incrementar para acessar o prximo descritor dentro da Heap
-    // o tamanho de um descritor depende do hardware grfico e do tipo de heap utilizada
+    // valor a incrementar para acessar o próximo descritor dentro da Heap
+    // o tamanho de um descritor depende do hardware gráfico e do tipo de heap utilizada
     rtDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
 
     // cria um descritor (view) de Render Target para cada buffer (front e back buffers)
@@ -373,7 +442,7 @@ void Graphics::Initialize(Window * window)
     // Depth/Stencil View (e heaps associadas)
     // ---------------------------------------------------
 
-    // descrio do buffer Depth/Stencil
+    // descrição do buffer Depth/Stencil
     D3D12_RESOURCE_DESC depthStencilDesc = {};
     depthStencilDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
     depthStencilDesc.Alignment = 0;
@@ -417,13 +486,13 @@ void Graphics::Initialize(Window * window)
     depthstencilHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
     ThrowIfFailed(device->CreateDescriptorHeap(&depthstencilHeapDesc, IID_PPV_ARGS(&depthStencilHeap)));
 
-    // pega um Handle para o incio da Heap
+    // pega um Handle para o início da Heap
     D3D12_CPU_DESCRIPTOR_HANDLE dsHandle = depthStencilHeap->GetCPUDescriptorHandleForHeapStart();
 
-    // cria um descritor (view) de Depth/Stencil para o mip nvel 0
+    // cria um descritor (view) de Depth/Stencil para o mip nível 0
     device->CreateDepthStencilView(depthStencil, nullptr, dsHandle);
 
-    // faz a transio do estado inicial do recurso para ser usado como buffer de profundidade
+    // faz a transição do estado inicial do recurso para ser usado como buffer de profundidade
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -433,11 +502,11 @@ void Graphics::Initialize(Window * window)
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     commandList->ResourceBarrier(1, &barrier);
 
-    // submete comando para transio do depth/stencil buffer
+    // submete comando para transição do depth/stencil buffer
     SubmitCommands();
 
     // ---------------------------------------------------
-    // Viewport e Retngulo de Recorte
+    // Viewport e Retângulo de Recorte
     // ---------------------------------------------------
 
     // ajusta a viewport
@@ -448,7 +517,7 @@ void Graphics::Initialize(Window * window)
     viewport.MinDepth = 0.0f;
     viewport.MaxDepth = 1.0f;
 
-    // ajusta o retngulo de corte
+    // ajusta o retângulo de corte
     scissorRect = { 0, 0, window->Width(), window->Height() };
 
     // ---------------------------------------------------
@@ -462,23 +531,24 @@ void Graphics::Initialize(Window * window)
     bgColor[0] = GetRValue(color)/255.0f;   // Red
     bgColor[1] = GetGValue(color)/255.0f;   // Green
     bgColor[2] = GetBValue(color)/255.0f;   // Blue
-    bgColor[3] = 1.0f;                      // Alpha (1 = slido)
+    bgColor[3] = 1.0f;                      // Alpha (1 = sólido)
 }
 
 // -----------------------------------------------------------------------------
 
 void Graphics::Clear(ID3D12PipelineState * pso)
 {
-    // reutiliza a memria associada com a lista de comandos
-    // a lista de comandos deve ter terminado de executar na GPU
-    commandListAlloc->Reset();
+    // reutiliza a memória do alocador deste quadro: Present só
+    // libera o slot depois que a GPU terminou seu último uso
+    ID3D12CommandAllocator* commandAlloc = commandAllocators[frames.Index()];
+    commandAlloc->Reset();
 
     // uma lista de comandos pode ser reinicializada depois de 
-    // adicionada  fila de comandos da GPU (via ExecuteCommandList)
-    // reutilizando a lista de comandos reutiliza memria
-    commandList->Reset(commandListAlloc, pso);
+    // adicionada à fila de comandos da GPU (via ExecuteCommandList)
+    // reutilizando a lista de comandos reutiliza memória
+    commandList->Reset(commandAlloc, pso);
 
-    // indica que o backbuffer ser usado como alvo de renderizao
+    // indica que o backbuffer será usado como alvo de renderização
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -488,7 +558,7 @@ void Graphics::Clear(ID3D12PipelineState * pso)
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     commandList->ResourceBarrier(1, &barrier);
 
-    // ajusta a viewport e retngulos de corte
+    // ajusta a viewport e retângulos de corte
     commandList->RSSetViewports(1, &viewport);
     commandList->RSSetScissorRects(1, &scissorRect);
 
@@ -499,39 +569,98 @@ void Graphics::Clear(ID3D12PipelineState * pso)
     commandList->ClearRenderTargetView(rtHandle, bgColor, 0, nullptr);
     commandList->ClearDepthStencilView(dsHandle, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
-    // especifica quais buffers sero utilizados na renderizao
+    // especifica quais buffers serão utilizados na renderização
     commandList->OMSetRenderTargets(1, &rtHandle, true, &dsHandle);
 }
 
 // ------------------------------------------------------------------------------
 
-bool Graphics::WaitCommandQueue()
+ullong Graphics::Signal()
 {
-    // avana o valor da cerca para marcar novos comandos a partir desse ponto
+    // avança o valor da cerca para marcar novos comandos a partir desse ponto
     currentFence++;
 
-    // adiciona uma instruo na fila de comandos para inserir uma nova barreira
+    // adiciona uma instrução na fila de comandos para inserir uma nova barreira
     // GPU vai finalizar todos os comandos em curso antes de processar esse sinal
-    if (FAILED(commandQueue->Signal(fence, currentFence)))
-        return false;
+    commandQueue->Signal(fence, currentFence);
+    return currentFence;
+}
 
-    // espera a GPU completar todos os comandos anteriores
-    if (fence->GetCompletedValue() < currentFence)
+// ------------------------------------------------------------------------------
+
+ullong Graphics::Completed()
+{
+    return fence->GetCompletedValue();
+}
+
+// ------------------------------------------------------------------------------
+
+void Graphics::Wait(ullong value)
+{
+    if (fence->GetCompletedValue() < value)
     {
-        HANDLE eventHandle = CreateEventEx(NULL, NULL, NULL, EVENT_ALL_ACCESS);
+        // aciona o evento quando a GPU atingir a barreira pedida
+        if (SUCCEEDED(fence->SetEventOnCompletion(value, fenceEvent)))
+            WaitForSingleObject(fenceEvent, INFINITE);
+    }
+}
 
-        if (eventHandle)
-        {
-            // aciona evento quando a GPU atingir a barreira atual  
-            if (FAILED(fence->SetEventOnCompletion(currentFence, eventHandle)))
-                return false;
+// ------------------------------------------------------------------------------
 
-            // espera at o evento ser acionado
-            WaitForSingleObject(eventHandle, INFINITE);
-            CloseHandle(eventHandle);
-        }
+void Graphics::Transition(const BufferTransition * transitions, uint count)
+{
+    static const D3D12_RESOURCE_STATES states[] =
+    {
+        D3D12_RESOURCE_STATE_COMMON,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_GENERIC_READ
+    };
+
+    // todas as mudanças de estado em uma única chamada
+    vector<D3D12_RESOURCE_BARRIER> barriers(count);
+    for (uint i = 0; i < count; ++i)
+    {
+        barriers[i].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barriers[i].Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barriers[i].Transition.pResource = static_cast<ID3D12Resource*>(transitions[i].buffer);
+        barriers[i].Transition.StateBefore = states[transitions[i].before];
+        barriers[i].Transition.StateAfter = states[transitions[i].after];
+        barriers[i].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     }
 
+    if (count)
+        commandList->ResourceBarrier(count, barriers.data());
+}
+
+// ------------------------------------------------------------------------------
+
+void Graphics::CopyBuffer(void * dest, ullong destOffset, byte * staging, ullong stagingOffset, ullong size)
+{
+    commandList->CopyBufferRegion(
+        static_cast<ID3D12Resource*>(dest),
+        destOffset,
+        uploadMemory->Buffer(staging),
+        stagingOffset,
+        size);
+}
+
+// ------------------------------------------------------------------------------
+
+ullong Graphics::Submit()
+{
+    // submete sem esperar e reabre a lista para os comandos seguintes
+    ExecuteCommands();
+    ullong value = Signal();
+    commandList->Reset(commandAllocators[frames.Index()], nullptr);
+    return value;
+}
+
+// ------------------------------------------------------------------------------
+
+bool Graphics::WaitCommandQueue()
+{
+    // espera a GPU completar todos os comandos anteriores
+    frames.Flush(*this);
     return true;
 }
 
@@ -539,21 +668,34 @@ bool Graphics::WaitCommandQueue()
 
 void Graphics::ResetCommands()
 {
-    // reinicia a lista de comandos para preparar para os comandos de inicializao
-    commandList->Reset(commandListAlloc, nullptr);
+    // reinicia a lista de comandos para preparar para os comandos de inicialização
+    commandList->Reset(commandAllocators[frames.Index()], nullptr);
 }
 
 // -----------------------------------------------------------------------------
 
-void Graphics::SubmitCommands()
+void Graphics::ExecuteCommands()
 {
-    // submete os comandos gravados na lista para execuo na GPU
+    // submete os comandos gravados na lista para execução na GPU
     commandList->Close();
     ID3D12CommandList* cmdsLists[] = { commandList };
     commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+}
 
-    // espera at a GPU completar a execuo dos comandos
+// -----------------------------------------------------------------------------
+
+void Graphics::SubmitCommands()
+{
+    ExecuteCommands();
+
+    // espera até a GPU completar a execução dos comandos
     WaitCommandQueue();
+
+    // os dados de upload usados por esses comandos podem ser reaproveitados
+    uploadRing->FinishFrame(currentFence);
+    uploadRing->Reclaim(currentFence);
+    uploadBatch->Reclaim(currentFence);
+    ReleaseRetired(currentFence);
 }
 
 // -----------------------------------------------------------------------------
@@ -565,7 +707,7 @@ void Graphics::Allocate(uint sizeInBytes, ID3DBlob** resource)
 
 // -----------------------------------------------------------------------------
 
-void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
+void Graphics::Allocate(uint type, ullong sizeInBytes, ID3D12Resource** resource)
 {
     // propriedades da heap do buffer
     D3D12_HEAP_PROPERTIES bufferProp = {};    
@@ -578,7 +720,7 @@ void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
     if (type == UPLOAD)
         bufferProp.Type = D3D12_HEAP_TYPE_UPLOAD;
 
-    // descrio do buffer 
+    // descrição do buffer 
     D3D12_RESOURCE_DESC bufferDesc = {};
     bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
     bufferDesc.Alignment = 0;
@@ -597,6 +739,31 @@ void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
     if (type == UPLOAD)
         initState = D3D12_RESOURCE_STATE_GENERIC_READ;
 
+    // buffers da GPU são colocados em uma heap compartilhada
+    if (type == GPU)
+    {
+        D3D12_RESOURCE_ALLOCATION_INFO info = device->GetResourceAllocationInfo(0, 1, &bufferDesc);
+
+        HeapBlock block;
+        if (!heapAllocator->Allocate(info.SizeInBytes, info.Alignment, &block))
+            ThrowIfFailed(E_OUTOFMEMORY);
+
+        HRESULT hr = device->CreatePlacedResource(
+            static_cast<ID3D12Heap*>(block.heap),
+            block.offset,
+            &bufferDesc,
+            initState,
+            nullptr,
+            IID_PPV_ARGS(resource));
+
+        if (FAILED(hr))
+            heapAllocator->Free(block);
+        ThrowIfFailed(hr);
+
+        placedBuffers.push_back({ *resource, block, 0 });
+        return;
+    }
+
     // cria um buffer para o recurso
     ThrowIfFailed(device->CreateCommittedResource(
         &bufferProp,
@@ -609,110 +776,183 @@ void Graphics::Allocate(uint type, uint sizeInBytes, ID3D12Resource** resource)
 
 // -----------------------------------------------------------------------------
 
-void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3DBlob* bufferCPU)
+UploadAllocation Graphics::AllocateUpload(uint sizeInBytes, uint alignment)
 {
-    CopyMemory(bufferCPU->GetBufferPointer(), vertices, sizeInBytes);
+    // válida até a GPU concluir o quadro atual
+    return uploadRing->Allocate(sizeInBytes, alignment);
 }
 
 // -----------------------------------------------------------------------------
 
-void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3D12Resource* bufferUpload, ID3D12Resource* bufferGPU)
+void Graphics::Release(ID3D12Resource* resource)
 {
-    // ----------------------------------------------------------------------------------
-    // Copia vrtices para o buffer padro (GPU)
-    // ----------------------------------------------------------------------------------
-    //
-    //  Para copiar dados para a GPU:
-    //  - primeiro copia-se os dados para a heap intermediria de upload
-    //  - depois usando ID3D12CommandList::CopyBufferRegion copia-se de upload para a GPU
-    //
-    // ----------------------------------------------------------------------------------
+    for (size_t i = 0; i < placedBuffers.size(); ++i)
+    {
+        if (placedBuffers[i].resource == resource)
+        {
+            // comandos já gravados podem usar o buffer: ele só é
+            // liberado depois da cerca da próxima submissão
+            placedBuffers[i].fence = currentFence + 1;
+            retiredBuffers.push_back(placedBuffers[i]);
+            placedBuffers[i] = placedBuffers.back();
+            placedBuffers.pop_back();
+            return;
+        }
+    }
 
-    // descreve os dados que sero copiados
-    D3D12_SUBRESOURCE_DATA vertexSubResourceData = {};
-    vertexSubResourceData.pData = vertices;
-    vertexSubResourceData.RowPitch = sizeInBytes;
-    vertexSubResourceData.SlicePitch = sizeInBytes;
+    // buffer que não veio das heaps compartilhadas
+    if (resource)
+        resource->Release();
+}
 
-    // descreve o layout da memria de vdeo (GPU)
-    D3D12_PLACED_SUBRESOURCE_FOOTPRINT layouts;
-    uint numRows;
-    ullong rowSizesInBytes;
-    ullong requiredSize = 0;
+// -----------------------------------------------------------------------------
 
-    D3D12_RESOURCE_DESC bufferGPUDesc = bufferGPU->GetDesc();
+void Graphics::ReleaseRetired(ullong completed)
+{
+    for (size_t i = 0; i < retiredBuffers.size();)
+    {
+        if (retiredBuffers[i].fence <= completed)
+        {
+            retiredBuffers[i].resource->Release();
+            heapAllocator->Free(retiredBuffers[i].block);
+            retiredBuffers[i] = retiredBuffers.back();
+            retiredBuffers.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
 
-    // pega layout da memria de vdeo
-    device->GetCopyableFootprints(
-        &bufferGPUDesc,
-        0, 1, 0, &layouts, &numRows,
-        &rowSizesInBytes, &requiredSize);
+// -----------------------------------------------------------------------------
 
-    // trava memria do upload buffer para acesso exclusivo 
-    BYTE* pData;
-    bufferUpload->Map(0, nullptr, (void**)&pData);
+GraphicsHeapMemory::GraphicsHeapMemory(Graphics & owner) : graphics(owner)
+{
+}
 
-    // descreve o destino de uma operao de cpia
-    D3D12_MEMCPY_DEST DestData =
-    {
-        pData + layouts.Offset,
-        layouts.Footprint.RowPitch,
-        layouts.Footprint.RowPitch * ullong(numRows)
-    };
+// -----------------------------------------------------------------------------
 
-    // copia vrtices no upload buffer
-    for (uint z = 0; z < layouts.Footprint.Depth; ++z)
+void * GraphicsHeapMemory::Create(ullong size)
+{
+    // heap padrão (memória de vídeo) que aceita apenas buffers
+    D3D12_HEAP_DESC heapDesc = {};
+    heapDesc.SizeInBytes = size;
+    heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapDesc.Properties.CreationNodeMask = 1;
+    heapDesc.Properties.VisibleNodeMask = 1;
+    heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+    ID3D12Heap * heap = nullptr;
+    if (FAILED(graphics.Device()->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap))))
+        return nullptr;
+
+    return heap;
+}
+
+// -----------------------------------------------------------------------------
+
+void GraphicsHeapMemory::Release(void * heap)
+{
+    static_cast<ID3D12Heap*>(heap)->Release();
+}
+
+// -----------------------------------------------------------------------------
+
+GraphicsUploadMemory::GraphicsUploadMemory(Graphics & owner) : graphics(owner)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+byte * GraphicsUploadMemory::Create(ullong size, ullong * gpuAddress)
+{
+    ID3D12Resource * buffer = nullptr;
+    graphics.Allocate(UPLOAD, size, &buffer);
+
+    // a CPU só escreve na página: nenhuma faixa é lida
+    byte * cpu = nullptr;
+    D3D12_RANGE noRead = { 0, 0 };
+    ThrowIfFailed(buffer->Map(0, &noRead, reinterpret_cast<void**>(&cpu)));
+
+    *gpuAddress = buffer->GetGPUVirtualAddress();
+    pages.push_back({ cpu, buffer });
+    return cpu;
+}
+
+// -----------------------------------------------------------------------------
+
+void GraphicsUploadMemory::Release(byte * cpuAddress)
+{
+    for (size_t i = 0; i < pages.size(); ++i)
     {
-        // endereo de destino
-        BYTE * destSlice = (BYTE*)(DestData.pData) + DestData.SlicePitch * z;
+        if (pages[i].cpu == cpuAddress)
+        {
+            pages[i].buffer->Unmap(0, nullptr);
+            pages[i].buffer->Release();
+            pages[i] = pages.back();
+            pages.pop_back();
+            return;
+        }
+    }
+}
 
-        // endereo da fonte
-        const BYTE* srcSlice = (const BYTE*)(vertexSubResourceData.pData) + vertexSubResourceData.SlicePitch * z;
-        
-        // faz cpia linha a linha
-        for (uint y = 0; y < numRows; ++y)
-            memcpy(destSlice + DestData.RowPitch * y,
-                   srcSlice + vertexSubResourceData.RowPitch * y,
-                   (size_t)rowSizesInBytes);
+// -----------------------------------------------------------------------------
+
+ID3D12Resource * GraphicsUploadMemory::Buffer(byte * cpuAddress)
+{
+    for (const Page & page : pages)
+    {
+        if (page.cpu == cpuAddress)
+            return page.buffer;
     }
 
-    // libera trava de memria do upload buffer 
-    bufferUpload->Unmap(0, nullptr);
+    return nullptr;
+}
 
-    // altera estado da memria da GPU (de leitura para escrita)
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = bufferGPU;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    commandList->ResourceBarrier(1, &barrier);
+// -----------------------------------------------------------------------------
 
-    // copia vertex buffer do upload buffer para a GPU
-    commandList->CopyBufferRegion(
-        bufferGPU,
-        0,
-        bufferUpload,
-        layouts.Offset,
-        layouts.Footprint.Width);
-
-    // altera estado da memria da GPU (de escrita para leitura)
-    barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource = bufferGPU;
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    commandList->ResourceBarrier(1, &barrier);
+void Graphics::Copy(const void* vertices, uint sizeInBytes, ID3DBlob* bufferCPU)
+{
+    CopyMemory(bufferCPU->GetBufferPointer(), vertices, sizeInBytes);
+}
+
+// -----------------------------------------------------------------------------
+
+void Graphics::Upload(const void* data, uint sizeInBytes, ID3D12Resource* bufferGPU)
+{
+    // os dados são copiados para a área de upload só na submissão
+    uploadBatch->Add(bufferGPU, data, sizeInBytes);
+}
+
+// -----------------------------------------------------------------------------
+
+ullong Graphics::SubmitUploads()
+{
+    // ----------------------------------------------------------------------------------
+    // Copia os buffers do lote para a memória padrão (GPU)
+    // ----------------------------------------------------------------------------------
+    //
+    //  Para copiar dados para a GPU:
+    //  - primeiro copia-se os dados para uma heap intermediária de upload
+    //  - depois usando ID3D12CommandList::CopyBufferRegion copia-se de upload para a GPU
+    //
+    //  Todos os buffers do lote compartilham a área de upload, as duas listas
+    //  de barreiras (COMMON -> COPY_DEST -> GENERIC_READ) e a submissão.
+    //
+    // ----------------------------------------------------------------------------------
+
+    return uploadBatch->Submit();
 }
 
 // -----------------------------------------------------------------------------
 
 void Graphics::Present()
 {
-    // indica que o backbuffer ser usado para apresentao
+    // indica que o backbuffer será usado para apresentação
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -722,12 +962,25 @@ void Graphics::Present()
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
     commandList->ResourceBarrier(1, &barrier);
 
-    // submete a lista de comandos para execuo na GPU
-    SubmitCommands();
+    // submete a lista de comandos para execução na GPU sem esperar
+    ExecuteCommands();
 
     // apresenta frame e troca front/back buffer
     swapChain->Present(vSync, 0);
     backBufferIndex = (backBufferIndex + 1) % backBufferCount;
+
+    // marca o fim do quadro e espera apenas se o próximo
+    // slot ainda estiver sendo usado pela GPU
+    frames.Advance(*this);
+
+    // associa os dados de upload do quadro à sua cerca e
+    // recupera os dos quadros que a GPU já concluiu
+    uploadRing->FinishFrame(currentFence);
+    uploadRing->Reclaim(Completed());
+
+    // áreas de envio e buffers estáticos que a GPU não usa mais
+    uploadBatch->Reclaim(Completed());
+    ReleaseRetired(Completed());
 }
 
 // -----------------------------------------------------------------------------
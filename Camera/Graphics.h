@@ -1,11 +1,24 @@
 /**********************************************************************************
-// Graphics (Arquivo de Cabealho)
+// Graphics (Arquivo de Cabeçalho)
 // 
-// Criao:     06 Abr 2011
-// Atualizao: 15 Ago 2021
+// Criação:     06 Abr 2011
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Usa funes do Direct3D 12 para acessar a GPU
+// Descrição:   Usa funções do Direct3D 12 para acessar a GPU
+//
+//              Mantém um quadro em andamento por backbuffer: cada um tem seu
+//              alocador de comandos e o valor da cerca da sua submissão, e
+//              a CPU só espera quando o slot a reutilizar ainda está na GPU.
+//
+//              Constantes e dados dinâmicos de cada quadro vêm de um anel de
+//              upload mapeado permanentemente e recuperado pelas cercas.
+//
+//              Buffers estáticos da GPU são colocados em heaps grandes e
+//              compartilhadas por um subalocador, dentro do orçamento de
+//              memória de vídeo informado pelo adaptador. Seus dados são
+//              enviados em lotes: uma área de upload, uma lista de barreiras
+//              por mudança de estado e uma única submissão.
 //
 **********************************************************************************/
 
@@ -13,53 +26,122 @@
 #define DXUT_GRAPHICS_H
 
 // --------------------------------------------------------------------------------
-// Incluses
+// Inclusões
 
-#include <dxgi1_6.h>             // infraestrutura grfica do DirectX
-#include <d3d12.h>               // principais funes do Direct3D
+#include <dxgi1_6.h>             // infraestrutura gráfica do DirectX
+#include <d3d12.h>               // principais funções do Direct3D
 #include "Window.h"              // cria e configura uma janela do Windows
-#include "Types.h"               // tipos especficos da engine
+#include "Types.h"               // tipos específicos da engine
 #include <D3DCompiler.h>         // fornece D3DBlob
+#include "FrameRing.h"           // quadros em andamento na GPU
+#include "UploadRing.h"          // alocador linear de dados por quadro
+#include "HeapAllocator.h"       // subalocador de heaps para buffers estáticos
+#include "UploadBatch.h"         // lote de envios de geometria estática
+#include <vector>
+using std::vector;
 
 enum AllocationType { GPU, UPLOAD };
 
+class Graphics;
+
+// --------------------------------------------------------------------------------
+
+// páginas do anel de upload em buffers da heap de upload do Direct3D
+class GraphicsUploadMemory : public UploadMemory
+{
+private:
+    struct Page
+    {
+        byte * cpu;                                         // endereço mapeado
+        ID3D12Resource * buffer;                            // buffer de upload
+    };
+
+    Graphics & graphics;                                    // cria os buffers
+    vector<Page> pages;                                     // buffers mapeados
+
+public:
+    GraphicsUploadMemory(Graphics & owner);                 // construtor
+
+    byte * Create(ullong size, ullong * gpuAddress);
+    void Release(byte * cpuAddress);
+
+    ID3D12Resource * Buffer(byte * cpuAddress);             // buffer de uma página
+};
+
+// --------------------------------------------------------------------------------
+
+// heaps padrão do Direct3D que recebem os buffers estáticos
+class GraphicsHeapMemory : public HeapMemory
+{
+private:
+    Graphics & graphics;                                    // dispositivo que cria as heaps
+
+public:
+    GraphicsHeapMemory(Graphics & owner);                   // construtor
+
+    void * Create(ullong size);
+    void Release(void * heap);
+};
+
 // --------------------------------------------------------------------------------
 
-class Graphics
+class Graphics : public GpuTimeline, public CopyQueue
 {
 private:
-    // configurao
-    uint                         backBufferCount;           // nmero de buffers na swap chain (double, triple, etc.)
-    uint                         antialiasing;              // nmero de amostras para cada pixel na tela
+    // configuração
+    uint                         backBufferCount;           // número de buffers na swap chain (double, triple, etc.)
+    uint                         antialiasing;              // número de amostras para cada pixel na tela
     uint                         quality;                   // qualidade da amostragem de antialiasing
     bool                         vSync;                     // vertical sync 
     float                        bgColor[4];                // cor de fundo do backbuffer
 
     // pipeline
-    ID3D12Device4              * device;                    // dispositivo grfico
+    ID3D12Device4              * device;                    // dispositivo gráfico
     IDXGIFactory6              * factory;                   // interface principal da DXGI
     IDXGISwapChain1            * swapChain;                 // swap chain
-    uint                         backBufferIndex;           // ndice do backbuffer atual
+    uint                         backBufferIndex;           // índice do backbuffer atual
     
     ID3D12CommandQueue         * commandQueue;              // fila de comandos da GPU
     ID3D12GraphicsCommandList  * commandList;               // lista de comandos a submeter para GPU
-    ID3D12CommandAllocator     * commandListAlloc;          // memria utilizada pela lista de comandos
+    ID3D12CommandAllocator    ** commandAllocators;         // memória da lista de comandos (uma por quadro)
      
-    ID3D12Resource            ** renderTargets;             // buffers para renderizao (front e back)
+    ID3D12Resource            ** renderTargets;             // buffers para renderização (front e back)
     ID3D12Resource             * depthStencil;              // buffer de profundidade e estampa            
     ID3D12DescriptorHeap       * renderTargetHeap;          // descriptor heap para os Render Targets
     ID3D12DescriptorHeap       * depthStencilHeap;          // descriptor heap para o Depth Stencil
     uint                         rtDescriptorSize;          // tamanho de cada descritor de Render Target
     D3D12_VIEWPORT               viewport;                  // viewport
-    D3D12_RECT                   scissorRect;               // retngulo de corte
+    D3D12_RECT                   scissorRect;               // retângulo de corte
 
-    // sincronizao                         
+    // sincronização                         
     ID3D12Fence                * fence;                     // barreira para sincronizar CPU/GPU
     ullong                       currentFence;              // contador de barreiras
+    HANDLE                       fenceEvent;                // evento reutilizado nas esperas
+    FrameRing                    frames;                    // quadros em andamento na GPU
+
+    // dados por quadro
+    GraphicsUploadMemory       * uploadMemory;              // páginas do anel de upload
+    UploadRing                 * uploadRing;                // constantes e dados dinâmicos
 
-    // mtodos privados
-    void LogHardwareInfo();                                 // mostra informaes do hardware
-    bool WaitCommandQueue();                                // espera execuo da fila de comandos
+    // buffers estáticos
+    struct PlacedBuffer
+    {
+        ID3D12Resource         * resource;                  // buffer colocado na heap
+        HeapBlock                block;                     // região ocupada na heap
+        ullong                   fence;                     // cerca após o último uso (liberados)
+    };
+
+    GraphicsHeapMemory         * heapMemory;                // heaps compartilhadas
+    HeapAllocator              * heapAllocator;             // subalocador das heaps
+    vector<PlacedBuffer>         placedBuffers;             // buffers em uso
+    vector<PlacedBuffer>         retiredBuffers;            // buffers aguardando a GPU
+    UploadBatch                * uploadBatch;               // envios dos buffers estáticos
+
+    // métodos privados
+    void LogHardwareInfo();                                 // mostra informações do hardware
+    void ReleaseRetired(ullong completed);                  // libera buffers que a GPU não usa mais
+    void ExecuteCommands();                                 // submete comandos sem esperar
+    bool WaitCommandQueue();                                // espera execução da fila de comandos
 
 public:
     Graphics();                                             // constructor
@@ -71,32 +153,56 @@ public:
     void Present();                                         // apresenta desenho na tela
 
     void ResetCommands();                                   // reinicia lista para receber novos comandos
-    void SubmitCommands();                                  // submete para execuo os comandos pendentes
+    void SubmitCommands();                                  // submete para execução os comandos pendentes
+
+    ullong Signal();                                        // sinaliza a cerca após os comandos submetidos
+    ullong Completed();                                     // último valor da cerca alcançado pela GPU
+    void Wait(ullong value);                                // espera a GPU alcançar um valor da cerca
+
+    void Transition(const BufferTransition * transitions,
+                    uint count);                            // grava uma lista de barreiras
+    void CopyBuffer(void * dest, ullong destOffset,
+                    byte * staging, ullong stagingOffset,
+                    ullong size);                           // grava cópia da área de upload
+    ullong Submit();                                        // submete comandos e continua gravando
 
     void Allocate(uint sizeInBytes,
-                  ID3DBlob** resource);                     // aloca memria da CPU para recurso
+                  ID3DBlob** resource);                     // aloca memória da CPU para recurso
 
     void Allocate(uint type,
-                  uint sizeInBytes, 
-                  ID3D12Resource** resource);               // aloca memria da GPU para recurso
+                  ullong sizeInBytes,
+                  ID3D12Resource** resource);               // aloca memória da GPU para recurso
+
+    UploadAllocation AllocateUpload(uint sizeInBytes,
+                  uint alignment = 256);                    // aloca memória de upload para o quadro atual
+
+    void Release(ID3D12Resource* resource);                 // libera buffer da GPU (devolve à heap compartilhada)
+    void HeapBudget(ullong bytes);                          // limita a memória das heaps (0 sem limite)
 
     void Copy(const void* vertices,
               uint sizeInBytes,
-              ID3DBlob* bufferCPU);                         // copia vrtices para Blob na CPU
+              ID3DBlob* bufferCPU);                         // copia vértices para Blob na CPU
 
-    void Copy(const void* vertices, 
-              uint sizeInBytes,
-              ID3D12Resource* bufferUpload,
-              ID3D12Resource* bufferGPU);                   // copia vrtices para a GPU
+    void Upload(const void* data,
+                uint sizeInBytes,
+                ID3D12Resource* bufferGPU);                 // adiciona envio para a GPU ao lote
+
+    ullong SubmitUploads();                                 // submete o lote de envios (retorna a cerca)
 
     ID3D12Device4* Device();                                // retorna dispositivo Direct3D
     ID3D12GraphicsCommandList* CommandList();               // retorna lista de comandos
-    uint Antialiasing();                                    // retorna nmero de amostras por pixel
+    uint Antialiasing();                                    // retorna número de amostras por pixel
     uint Quality();                                         // retorna qualidade das amostras
+    uint FrameIndex();                                      // retorna slot do quadro atual
+    uint FramesInFlight();                                  // retorna número de quadros em andamento
+    const FrameRing & Frames();                             // retorna estatísticas dos quadros
+    const UploadRingStats & UploadStats();                  // retorna estatísticas do anel de upload
+    HeapAllocatorStats HeapStats();                         // retorna estatísticas das heaps
+    const UploadBatchStats & BatchStats();                  // retorna estatísticas dos envios
 };
 
 // --------------------------------------------------------------------------------
-// Mtodos Inline
+// Métodos Inline
 
 // liga/desliga vertical sync
 inline void Graphics::VSync(bool state)
@@ -110,7 +216,7 @@ inline ID3D12Device4* Graphics::Device()
 inline ID3D12GraphicsCommandList* Graphics::CommandList()
 { return commandList; }
 
-// retorna nmero de amostras por pixel
+// retorna número de amostras por pixel
 inline uint Graphics::Antialiasing()
 { return antialiasing; }
 
@@ -118,6 +224,34 @@ inline uint Graphics::Antialiasing()
 inline uint Graphics::Quality()
 { return quality; }
 
+// retorna slot do quadro atual (dados por quadro devem usar este índice)
+inline uint Graphics::FrameIndex()
+{ return frames.Index(); }
+
+// retorna número de quadros em andamento
+inline uint Graphics::FramesInFlight()
+{ return frames.Count(); }
+
+// retorna estatísticas dos quadros em andamento
+inline const FrameRing & Graphics::Frames()
+{ return frames; }
+
+// retorna estatísticas do anel de upload
+inline const UploadRingStats & Graphics::UploadStats()
+{ return uploadRing->Stats(); }
+
+// estatísticas dos envios de buffers estáticos
+inline const UploadBatchStats & Graphics::BatchStats()
+{ return uploadBatch->Stats(); }
+
+// limita a memória das heaps de buffers estáticos
+inline void Graphics::HeapBudget(ullong bytes)
+{ heapAllocator->Budget(bytes); }
+
+// retorna estatísticas das heaps de buffers estáticos
+inline HeapAllocatorStats Graphics::HeapStats()
+{ return heapAllocator->Stats(); }
+
 // --------------------------------------------------------------------------------
 
 #endif
\ No newline at end of file
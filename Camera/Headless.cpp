@@ -0,0 +1,501 @@
+/**********************************************************************************
+// Headless (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Execução sem janela para testes em lote: quadros com passo de
+//              tempo fixo, gravação em PPM/PNG, comparação com imagens de
+//              referência e medição do tempo de cada quadro.
+//
+**********************************************************************************/
+
+#include "Headless.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+using std::stringstream;
+namespace fs = std::filesystem;
+
+// -------------------------------------------------------------------------------
+
+bool HeadlessReport::Passed() const
+{
+    return failed == 0 && missing == 0 && writeErrors == 0;
+}
+
+// -------------------------------------------------------------------------------
+
+string HeadlessReport::ToString() const
+{
+    vector<double> ms;
+    ms.reserve(frames.size());
+    for (const HeadlessFrame & f : frames)
+        ms.push_back(f.seconds * 1000.0);
+
+    double total = 0.0;
+    for (double t : ms)
+        total += t;
+
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << frames.size() << " quadros " << width << "x" << height << ", "
+         << threads << " thread(s), passo " << timestep * 1000.0 << " ms";
+
+    if (!ms.empty())
+    {
+        // percentil 95 pelo posto mais próximo
+        vector<double> sorted = ms;
+        std::sort(sorted.begin(), sorted.end());
+        size_t p95 = std::min(sorted.size() - 1, (sorted.size() * 95 + 99) / 100 - 1);
+
+        text << "\ntempo por quadro: mínimo " << sorted.front() << " ms, médio "
+             << total / ms.size() << " ms, p95 " << sorted[p95] << " ms, máximo "
+             << sorted.back() << " ms";
+    }
+
+    text << "\nreferências: " << compared << " comparadas, " << failed << " diferentes, "
+         << missing << " ausentes";
+
+    if (writeErrors)
+        text << "\n" << writeErrors << " imagens não puderam ser gravadas";
+
+    for (uint i = 0; i < frames.size(); ++i)
+    {
+        const HeadlessFrame & f = frames[i];
+        if (f.compared && !f.passed)
+            text << "\nquadro " << i << ": " << f.diff.mismatched << "/" << f.diff.pixels
+                 << " pixels fora da tolerância, diferença máxima " << f.diff.maxDelta
+                 << ", média " << f.diff.meanDelta;
+    }
+
+    text << "\n" << (Passed() ? "APROVADO" : "REPROVADO");
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+// Imagens
+
+bool WritePpm(const string & file, const uint * pixels, uint width, uint height, uint pitch)
+{
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    out << "P6\n" << width << " " << height << "\n255\n";
+
+    vector<byte> row(size_t(width) * 3);
+    for (uint y = 0; y < height; ++y)
+    {
+        const uint * src = pixels + size_t(y) * pitch;
+        for (uint x = 0; x < width; ++x)
+        {
+            row[x * 3 + 0] = byte(src[x]);
+            row[x * 3 + 1] = byte(src[x] >> 8);
+            row[x * 3 + 2] = byte(src[x] >> 16);
+        }
+        out.write((const char*) row.data(), row.size());
+    }
+
+    return bool(out);
+}
+
+// -------------------------------------------------------------------------------
+
+// CRC-32 dos blocos do PNG (polinômio 0xEDB88320)
+static uint Crc32(const byte * data, size_t size, uint crc = 0)
+{
+    static uint table[256] = {};
+    if (table[1] == 0)
+    {
+        for (uint n = 0; n < 256; ++n)
+        {
+            uint c = n;
+            for (uint k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// acrescenta um inteiro de 32 bits big-endian
+static void PutBig32(vector<byte> & out, uint value)
+{
+    out.push_back(byte(value >> 24));
+    out.push_back(byte(value >> 16));
+    out.push_back(byte(value >> 8));
+    out.push_back(byte(value));
+}
+
+// grava um bloco do PNG (tamanho, tipo, dados e CRC do tipo e dos dados)
+static void WriteChunk(std::ofstream & out, const char * type, const vector<byte> & data)
+{
+    vector<byte> chunk;
+    chunk.reserve(data.size() + 12);
+    PutBig32(chunk, uint(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    PutBig32(chunk, Crc32(chunk.data() + 4, data.size() + 4));
+    out.write((const char*) chunk.data(), chunk.size());
+}
+
+bool WritePng(const string & file, const uint * pixels, uint width, uint height, uint pitch)
+{
+    std::ofstream out(file, std::ios::binary);
+    if (!out)
+        return false;
+
+    static const byte signature[8] = { 137, 'P', 'N', 'G', 13, 10, 26, 10 };
+    out.write((const char*) signature, sizeof(signature));
+
+    // RGB de 8 bits, sem entrelaçamento
+    vector<byte> header;
+    PutBig32(header, width);
+    PutBig32(header, height);
+    header.insert(header.end(), { 8, 2, 0, 0, 0 });
+    WriteChunk(out, "IHDR", header);
+
+    // linhas com filtro nulo
+    vector<byte> raw;
+    raw.reserve(size_t(width * 3 + 1) * height);
+    for (uint y = 0; y < height; ++y)
+    {
+        const uint * src = pixels + size_t(y) * pitch;
+        raw.push_back(0);
+        for (uint x = 0; x < width; ++x)
+        {
+            raw.push_back(byte(src[x]));
+            raw.push_back(byte(src[x] >> 8));
+            raw.push_back(byte(src[x] >> 16));
+        }
+    }
+
+    // fluxo zlib com blocos deflate sem compressão (até 65535 bytes cada):
+    // dispensa uma biblioteca de compressão e continua legível por qualquer leitor
+    vector<byte> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+
+    size_t offset = 0;
+    do
+    {
+        uint length = uint(std::min<size_t>(raw.size() - offset, 65535));
+        bool last = offset + length == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(byte(length));
+        zlib.push_back(byte(length >> 8));
+        zlib.push_back(byte(~length));
+        zlib.push_back(byte(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+    } while (offset < raw.size());
+
+    // Adler-32 dos dados sem compressão
+    uint a = 1, b = 0;
+    for (size_t i = 0; i < raw.size(); )
+    {
+        // 5552 bytes é o maior bloco sem estouro antes do módulo
+        size_t end = std::min(raw.size(), i + 5552);
+        for (; i < end; ++i)
+        {
+            a += raw[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    PutBig32(zlib, (b << 16) | a);
+
+    WriteChunk(out, "IDAT", zlib);
+    WriteChunk(out, "IEND", {});
+
+    return bool(out);
+}
+
+// -------------------------------------------------------------------------------
+
+// lê o próximo número do cabeçalho de um PPM, ignorando comentários
+static bool ReadPpmValue(std::istream & in, uint & value)
+{
+    int c = in.get();
+    while (c != EOF && (isspace(c) || c == '#'))
+    {
+        if (c == '#')
+            while (c != EOF && c != '\n')
+                c = in.get();
+        c = in.get();
+    }
+
+    if (c == EOF || !isdigit(c))
+        return false;
+
+    value = 0;
+    while (c != EOF && isdigit(c))
+    {
+        value = value * 10 + uint(c - '0');
+        c = in.get();
+    }
+
+    // um único espaço separa o cabeçalho dos dados
+    return true;
+}
+
+bool ReadPpm(const string & file, vector<uint> & pixels, uint & width, uint & height)
+{
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return false;
+
+    char magic[2] = {};
+    in.read(magic, 2);
+    if (magic[0] != 'P' || magic[1] != '6')
+        return false;
+
+    uint maxValue = 0;
+    if (!ReadPpmValue(in, width) || !ReadPpmValue(in, height) || !ReadPpmValue(in, maxValue))
+        return false;
+
+    if (width == 0 || height == 0 || maxValue == 0 || maxValue > 255
+        || width > Rasterizer::MaxSize || height > Rasterizer::MaxSize)
+        return false;
+
+    vector<byte> data(size_t(width) * height * 3);
+    in.read((char*) data.data(), data.size());
+    if (size_t(in.gcount()) != data.size())
+        return false;
+
+    pixels.resize(size_t(width) * height);
+    for (size_t i = 0; i < pixels.size(); ++i)
+    {
+        uint r = data[i * 3 + 0] * 255 / maxValue;
+        uint g = data[i * 3 + 1] * 255 / maxValue;
+        uint b = data[i * 3 + 2] * 255 / maxValue;
+        pixels[i] = r | (g << 8) | (b << 16) | 0xFF000000;
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+ImageDiff CompareImages(const uint * a, uint pitchA, const uint * b, uint pitchB,
+                        uint width, uint height, uint tolerance)
+{
+    ImageDiff diff = {};
+    ullong total = 0;
+
+    for (uint y = 0; y < height; ++y)
+    {
+        const uint * rowA = a + size_t(y) * pitchA;
+        const uint * rowB = b + size_t(y) * pitchB;
+
+        for (uint x = 0; x < width; ++x)
+        {
+            uint worst = 0;
+            for (uint shift = 0; shift < 24; shift += 8)
+            {
+                int ca = (rowA[x] >> shift) & 0xFF;
+                int cb = (rowB[x] >> shift) & 0xFF;
+                uint delta = uint(abs(ca - cb));
+                worst = std::max(worst, delta);
+                total += delta;
+            }
+
+            diff.maxDelta = std::max(diff.maxDelta, worst);
+            if (worst > tolerance)
+                ++diff.mismatched;
+        }
+    }
+
+    diff.pixels = ullong(width) * height;
+    diff.meanDelta = diff.pixels ? double(total) / (diff.pixels * 3) : 0.0;
+    return diff;
+}
+
+// -------------------------------------------------------------------------------
+// Opções
+
+bool HeadlessOptions(const string & cmdLine, HeadlessSettings & settings)
+{
+    vector<string> args;
+    std::istringstream line(cmdLine);
+    for (string arg; line >> arg; )
+        args.push_back(arg);
+
+    bool headless = false;
+
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        const string & arg = args[i];
+        bool value = i + 1 < args.size();
+
+        if (arg == "-headless")
+        {
+            headless = true;
+
+            // número de quadros opcional
+            if (value && isdigit((unsigned char)args[i + 1][0]))
+                settings.frames = strtoul(args[++i].c_str(), nullptr, 10);
+        }
+        else if (arg == "-size" && value)
+        {
+            // largura e altura separadas por 'x'
+            char * end = nullptr;
+            uint width = strtoul(args[++i].c_str(), &end, 10);
+            if (*end == 'x' && width > 0)
+            {
+                uint height = strtoul(end + 1, nullptr, 10);
+                if (height > 0)
+                {
+                    settings.width = width;
+                    settings.height = height;
+                }
+            }
+        }
+        else if (arg == "-threads" && value)
+            settings.threads = strtoul(args[++i].c_str(), nullptr, 10);
+        else if (arg == "-timestep" && value)
+            settings.timestep = strtod(args[++i].c_str(), nullptr);
+        else if (arg == "-out" && value)
+            settings.outputDir = args[++i];
+        else if (arg == "-golden" && value)
+            settings.goldenDir = args[++i];
+        else if (arg == "-tolerance" && value)
+            settings.tolerance = strtoul(args[++i].c_str(), nullptr, 10);
+        else if (arg == "-mismatch" && value)
+            settings.maxMismatch = strtod(args[++i].c_str(), nullptr);
+        else if (arg == "-update")
+            settings.updateGolden = true;
+        else if (arg == "-png")
+            settings.png = true;
+    }
+
+    return headless;
+}
+
+// -------------------------------------------------------------------------------
+// Execução
+
+HeadlessReport RunHeadless(const HeadlessSettings & settings, Rasterizer & rasterizer,
+                           const std::function<void(uint frame)> & drawFrame)
+{
+    HeadlessReport report = {};
+    report.width = rasterizer.Width();
+    report.height = rasterizer.Height();
+    report.threads = rasterizer.Threads();
+    report.timestep = settings.timestep;
+    report.frames.reserve(settings.frames);
+
+    std::error_code error;
+    if (!settings.outputDir.empty())
+        fs::create_directories(settings.outputDir, error);
+    if (settings.updateGolden && !settings.goldenDir.empty())
+        fs::create_directories(settings.goldenDir, error);
+
+    vector<uint> golden;
+
+    for (uint frame = 0; frame < settings.frames; ++frame)
+    {
+        // apenas atualização, desenho e rasterização entram no tempo do quadro
+        auto start = std::chrono::steady_clock::now();
+        drawFrame(frame);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        HeadlessFrame result = {};
+        result.seconds = elapsed.count();
+        result.passed = true;
+
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%04u", frame);
+
+        const uint * pixels = rasterizer.Pixels();
+        uint width = rasterizer.Width();
+        uint height = rasterizer.Height();
+        uint pitch = rasterizer.Pitch();
+
+        if (!settings.outputDir.empty())
+        {
+            fs::path base = fs::path(settings.outputDir) / name;
+            if (!WritePpm(base.string() + ".ppm", pixels, width, height, pitch))
+                ++report.writeErrors;
+            if (settings.png && !WritePng(base.string() + ".png", pixels, width, height, pitch))
+                ++report.writeErrors;
+        }
+
+        if (!settings.goldenDir.empty())
+        {
+            string file = (fs::path(settings.goldenDir) / name).string() + ".ppm";
+            uint goldenWidth = 0, goldenHeight = 0;
+
+            if (settings.updateGolden)
+            {
+                if (!WritePpm(file, pixels, width, height, pitch))
+                    ++report.writeErrors;
+            }
+            else if (ReadPpm(file, golden, goldenWidth, goldenHeight))
+            {
+                result.compared = true;
+                ++report.compared;
+
+                if (goldenWidth != width || goldenHeight != height)
+                {
+                    // tamanhos diferentes contam todos os pixels como diferentes
+                    result.diff.pixels = result.diff.mismatched = ullong(width) * height;
+                    result.diff.maxDelta = 255;
+                    result.passed = false;
+                }
+                else
+                {
+                    result.diff = CompareImages(pixels, pitch, golden.data(), width,
+                        width, height, settings.tolerance);
+                    result.passed = result.diff.mismatched <= settings.maxMismatch * result.diff.pixels;
+                }
+
+                if (!result.passed)
+                    ++report.failed;
+            }
+            else
+            {
+                ++report.missing;
+            }
+        }
+
+        report.frames.push_back(result);
+    }
+
+    // tempos por quadro para os limites de desempenho
+    if (!settings.outputDir.empty())
+    {
+        std::ofstream csv(fs::path(settings.outputDir) / "frames.csv");
+        csv << std::fixed;
+        csv.precision(4);
+        csv << "quadro,ms,comparado,diferentes,maxima,media\n";
+
+        for (uint i = 0; i < report.frames.size(); ++i)
+        {
+            const HeadlessFrame & f = report.frames[i];
+            csv << i << "," << f.seconds * 1000.0 << "," << (f.compared ? 1 : 0) << ","
+                << f.diff.mismatched << "," << f.diff.maxDelta << "," << f.diff.meanDelta << "\n";
+        }
+
+        if (!csv)
+            ++report.writeErrors;
+    }
+
+    return report;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+/**********************************************************************************
+// Headless (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Execução sem janela para testes em lote. Desenha um número
+//              fixo de quadros no renderizador em software com passo de
+//              tempo constante, grava cada quadro em PPM (e opcionalmente
+//              PNG) e compara com imagens de referência gravadas antes,
+//              aceitando uma diferença máxima por canal e uma fração de
+//              pixels fora dessa tolerância.
+//
+//              O tempo de cada quadro (atualização, desenho e rasterização,
+//              sem a gravação e a comparação das imagens) entra no relatório
+//              e em um arquivo CSV para uso como limite de desempenho.
+//
+//              O módulo não depende do Windows e pode ser usado em máquinas
+//              Linux sem GPU junto com Rasterizer.
+//
+**********************************************************************************/
+
+#ifndef DXUT_HEADLESS_H
+#define DXUT_HEADLESS_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Rasterizer.h"                 // renderizador em software
+#include <functional>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// configuração da execução sem janela
+struct HeadlessSettings
+{
+    uint   frames = 60;                 // quadros desenhados
+    uint   width = 800;                 // largura do alvo
+    uint   height = 600;                // altura do alvo
+    uint   threads = 0;                 // threads de rasterização (0 usa todos os núcleos)
+    double timestep = 1.0 / 60.0;       // tempo simulado de cada quadro
+    string outputDir;                   // pasta dos quadros gravados (vazio não grava)
+    string goldenDir;                   // pasta das imagens de referência (vazio não compara)
+    bool   png = false;                 // grava também os quadros em PNG
+    bool   updateGolden = false;        // grava as referências em vez de comparar
+    uint   tolerance = 2;               // diferença aceita em cada canal (0 a 255)
+    double maxMismatch = 0.001;         // fração aceita de pixels fora da tolerância
+};
+
+// diferença entre duas imagens
+struct ImageDiff
+{
+    ullong pixels;                      // pixels comparados
+    ullong mismatched;                  // pixels com algum canal fora da tolerância
+    uint   maxDelta;                    // maior diferença em um canal
+    double meanDelta;                   // diferença média por canal
+};
+
+// resultado de um quadro
+struct HeadlessFrame
+{
+    double seconds;                     // tempo de atualização e desenho
+    bool   compared;                    // existia imagem de referência
+    bool   passed;                      // dentro da tolerância (ou não comparado)
+    ImageDiff diff;                     // diferença para a referência
+};
+
+// resultado da execução sem janela
+struct HeadlessReport
+{
+    uint   width;                       // largura do alvo
+    uint   height;                      // altura do alvo
+    uint   threads;                     // threads de rasterização
+    double timestep;                    // tempo simulado de cada quadro
+    vector<HeadlessFrame> frames;       // resultado de cada quadro
+    uint   compared;                    // quadros comparados
+    uint   failed;                      // quadros fora da tolerância
+    uint   missing;                     // quadros sem referência
+    uint   writeErrors;                 // imagens que não puderam ser gravadas
+
+    bool Passed() const;                // nenhuma falha de comparação ou gravação
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// Grava a cor RGBA8 (R no byte menos significativo) como PPM binário (P6)
+// ou como PNG RGB de 8 bits. O alfa é descartado.
+
+bool WritePpm(const string & file, const uint * pixels, uint width, uint height, uint pitch);
+bool WritePng(const string & file, const uint * pixels, uint width, uint height, uint pitch);
+
+// Lê um PPM binário (P6, até 255 por canal) para RGBA8 com alfa 255.
+
+bool ReadPpm(const string & file, vector<uint> & pixels, uint & width, uint & height);
+
+// Compara os canais RGB de duas imagens do mesmo tamanho.
+
+ImageDiff CompareImages(const uint * a, uint pitchA, const uint * b, uint pitchB,
+                        uint width, uint height, uint tolerance);
+
+// Lê as opções da execução sem janela de uma linha de comando:
+// -headless [quadros] -size LxA -threads n -timestep segundos
+// -out pasta -golden pasta -update -png -tolerance n -mismatch fração
+// Retorna falso se a linha não pede a execução sem janela (-headless).
+
+bool HeadlessOptions(const string & cmdLine, HeadlessSettings & settings);
+
+// Desenha settings.frames quadros: drawFrame(frame) deve atualizar a cena
+// com o passo settings.timestep, desenhar em rasterizer e chamar Present.
+// O renderizador já deve estar inicializado no tamanho da configuração.
+
+HeadlessReport RunHeadless(const HeadlessSettings & settings, Rasterizer & rasterizer,
+                           const std::function<void(uint frame)> & drawFrame);
+
+// -------------------------------------------------------------------------------
+
+#endif
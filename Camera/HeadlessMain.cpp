@@ -0,0 +1,81 @@
+/**********************************************************************************
+// HeadlessMain (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Programa de linha de comando que desenha a cena da Câmera
+//              sem janela e sem Direct3D, usado pelo build portável
+//              (CMakeLists.txt) em máquinas Linux sem GPU. Reproduz a
+//              execução -headless da aplicação com a mesma CameraScene:
+//              malha, instâncias, órbita, nível de detalhe, descarte e cor
+//              de fundo vêm da cena, avançada com o passo de tempo fixo e
+//              desenhada pelo renderizador em software.
+//
+//              Uso: CameraHeadless [-instances N] [-split] [-noweld]
+//                   [-unorm16 | -half] [-backface] [-headless quadros]
+//                   e as demais opções de HeadlessOptions.
+//              O código de saída é 1 se algum quadro ficar fora da tolerância.
+//
+**********************************************************************************/
+
+#include "CameraScene.h"
+#include "Headless.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    // as mesmas opções da linha de comando da aplicação
+    string cmdLine = "-headless";
+    for (int i = 1; i < argc; ++i)
+        cmdLine += string(" ") + argv[i];
+
+    CameraOptions options;
+    ParseCameraOptions(cmdLine, options);
+
+    HeadlessSettings settings;
+    HeadlessOptions(cmdLine, settings);
+
+    JobSystem jobs;
+    CameraScene scene(options);
+
+    if (!scene.Init(&jobs, settings.width, settings.height))
+    {
+        fputs("Impossível abrir o arquivo .obj\n", stderr);
+        return 2;
+    }
+
+    Rasterizer rasterizer;
+    rasterizer.Initialize(settings.width, settings.height, settings.threads);
+
+    // cada quadro é uma atualização com o passo fixo seguida do desenho,
+    // como em Camera::Update e Camera::Draw na execução sem janela
+    HeadlessReport report = RunHeadless(settings, rasterizer,
+        [&](uint)
+        {
+            scene.Save();
+            scene.Step(settings.timestep);
+            scene.Interpolate(1.0f, settings.timestep);
+            scene.Draw(rasterizer);
+        });
+
+    string text = report.ToString() + "\n";
+    fputs(text.c_str(), stdout);
+
+    // relatório junto aos quadros gravados
+    if (!settings.outputDir.empty())
+    {
+        std::ofstream file(settings.outputDir + "/report.txt");
+        file << text;
+    }
+
+    return report.Passed() ? 0 : 1;
+}
+
+// -------------------------------------------------------------------------------
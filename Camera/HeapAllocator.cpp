@@ -0,0 +1,664 @@
+/**********************************************************************************
+// HeapAllocator (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Subalocador de heaps para buffers estáticos da GPU (TLSF).
+//
+**********************************************************************************/
+
+#include "HeapAllocator.h"
+#include "Timer.h"
+#include <sstream>
+using std::stringstream;
+
+#ifdef _MSC_VER
+#include <intrin.h>                     // _BitScanForward(64) e _BitScanReverse(64)
+#endif
+
+// -------------------------------------------------------------------------------
+
+// índice do bit menos significativo ligado (x diferente de zero)
+static inline uint LowestBit(ullong x)
+{
+#if defined(_M_IX86)
+    // em 32 bits as duas metades são examinadas separadamente
+    unsigned long index;
+    if (_BitScanForward(&index, ulong(x)))
+        return uint(index);
+    _BitScanForward(&index, ulong(x >> 32));
+    return uint(index) + 32;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return uint(index);
+#else
+    return uint(__builtin_ctzll(x));
+#endif
+}
+
+// índice do bit mais significativo ligado (x diferente de zero)
+static inline uint HighestBit(ullong x)
+{
+#if defined(_M_IX86)
+    unsigned long index;
+    if (_BitScanReverse(&index, ulong(x >> 32)))
+        return uint(index) + 32;
+    _BitScanReverse(&index, ulong(x));
+    return uint(index);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return uint(index);
+#else
+    return uint(63 - __builtin_clzll(x));
+#endif
+}
+
+// -------------------------------------------------------------------------------
+
+VirtualHeapMemory::VirtualHeapMemory()
+{
+    created = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void * VirtualHeapMemory::Create(ullong)
+{
+    // apenas um valor distinto para cada heap
+    return reinterpret_cast<void*>(++created);
+}
+
+// -------------------------------------------------------------------------------
+
+void VirtualHeapMemory::Release(void *)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+string HeapAllocatorStats::ToString() const
+{
+    const double MB = 1048576.0;
+
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << "heaps: " << heaps << " (" << reserved / MB << " MB";
+    if (budget)
+        text << " de " << budget / MB << " MB";
+    text << "), em uso " << used / MB << " MB em " << allocations << " blocos ("
+         << requested / MB << " MB pedidos), " << freeBlocks << " blocos livres, maior "
+         << largestFree / MB << " MB, fragmentação " << fragmentation * 100.0 << "%, "
+         << totalAllocations << " alocações, " << totalFrees << " liberações, "
+         << failures << " recusadas";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+HeapAllocator::HeapAllocator(HeapMemory & mem, ullong size, ullong gran, ullong budget) : memory(mem)
+{
+    // a granularidade é a potência de dois mais próxima acima do valor pedido
+    shift = gran > 1 ? HighestBit(gran - 1) + 1 : 0;
+    granularity = 1ull << shift;
+    heapSize = (size + granularity - 1) & ~(granularity - 1);
+    if (heapSize == 0)
+        heapSize = granularity;
+
+    flBitmap = 0;
+    for (uint fl = 0; fl < FlCount; ++fl)
+    {
+        slBitmap[fl] = 0;
+        for (uint sl = 0; sl < SlCount; ++sl)
+            lists[fl][sl] = None;
+    }
+
+    stats = {};
+    stats.budget = budget;
+}
+
+// -------------------------------------------------------------------------------
+
+HeapAllocator::~HeapAllocator()
+{
+    // quem destrói o alocador já liberou os recursos colocados nas heaps
+    for (const Heap & heap : heaps)
+    {
+        if (heap.memory)
+            memory.Release(heap.memory);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapAllocator::Mapping(ullong units, uint & fl, uint & sl)
+{
+    // tamanhos pequenos ficam todos no primeiro nível, um por faixa
+    if (units < SlCount)
+    {
+        fl = 0;
+        sl = uint(units);
+    }
+    else
+    {
+        uint high = HighestBit(units);
+        fl = high - SlBits + 1;
+        sl = uint(units >> (high - SlBits)) - SlCount;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+uint HeapAllocator::NewBlock()
+{
+    if (!unusedBlocks.empty())
+    {
+        uint b = unusedBlocks.back();
+        unusedBlocks.pop_back();
+        return b;
+    }
+
+    blocks.push_back({});
+    return uint(blocks.size() - 1);
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapAllocator::InsertFree(uint b)
+{
+    Block & block = blocks[b];
+
+    uint fl, sl;
+    Mapping(block.size >> shift, fl, sl);
+
+    block.free = true;
+    block.prevFree = None;
+    block.nextFree = lists[fl][sl];
+    if (block.nextFree != None)
+        blocks[block.nextFree].prevFree = b;
+
+    lists[fl][sl] = b;
+    slBitmap[fl] |= 1u << sl;
+    flBitmap |= 1ull << fl;
+
+    ++stats.freeBlocks;
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapAllocator::RemoveFree(uint b)
+{
+    Block & block = blocks[b];
+
+    uint fl, sl;
+    Mapping(block.size >> shift, fl, sl);
+
+    if (block.prevFree != None)
+        blocks[block.prevFree].nextFree = block.nextFree;
+    else
+        lists[fl][sl] = block.nextFree;
+
+    if (block.nextFree != None)
+        blocks[block.nextFree].prevFree = block.prevFree;
+
+    // a lista ficou vazia: desliga os bits correspondentes
+    if (lists[fl][sl] == None)
+    {
+        slBitmap[fl] &= ~(1u << sl);
+        if (slBitmap[fl] == 0)
+            flBitmap &= ~(1ull << fl);
+    }
+
+    block.free = false;
+    --stats.freeBlocks;
+}
+
+// -------------------------------------------------------------------------------
+
+uint HeapAllocator::FindFree(ullong size)
+{
+    // arredonda para a faixa seguinte: qualquer bloco dela serve
+    ullong units = size >> shift;
+    if (units >= SlCount)
+        units += (1ull << (HighestBit(units) - SlBits)) - 1;
+
+    uint fl, sl;
+    Mapping(units, fl, sl);
+    if (fl >= FlCount)
+        return None;
+
+    // faixas maiores no mesmo primeiro nível
+    uint slMap = slBitmap[fl] & (~0u << sl);
+    if (slMap == 0)
+    {
+        // primeiros níveis maiores
+        ullong flMap = fl + 1 < FlCount ? flBitmap & (~0ull << (fl + 1)) : 0;
+        if (flMap == 0)
+            return None;
+
+        fl = LowestBit(flMap);
+        slMap = slBitmap[fl];
+    }
+
+    return lists[fl][LowestBit(slMap)];
+}
+
+// -------------------------------------------------------------------------------
+
+uint HeapAllocator::Split(uint b, ullong size)
+{
+    // a sobra depois de size bytes vira um novo bloco (sem inserir na lista)
+    uint r = NewBlock();
+    Block & block = blocks[b];
+    Block & rest = blocks[r];
+
+    rest.offset = block.offset + size;
+    rest.size = block.size - size;
+    rest.heap = block.heap;
+    rest.prevPhys = b;
+    rest.nextPhys = block.nextPhys;
+    rest.free = false;
+    rest.requested = 0;
+
+    if (rest.nextPhys != None)
+        blocks[rest.nextPhys].prevPhys = r;
+
+    block.size = size;
+    block.nextPhys = r;
+    return r;
+}
+
+// -------------------------------------------------------------------------------
+
+uint HeapAllocator::AddHeap(ullong minimum)
+{
+    ullong size = minimum > heapSize ? minimum : heapSize;
+
+    if (stats.budget && stats.reserved + size > stats.budget)
+        return None;
+
+    void * handle = memory.Create(size);
+    if (!handle)
+        return None;
+
+    // reaproveita a entrada de uma heap já liberada
+    uint h = 0;
+    while (h < heaps.size() && heaps[h].memory)
+        ++h;
+    if (h == heaps.size())
+        heaps.push_back({});
+
+    uint b = NewBlock();
+    Block & block = blocks[b];
+    block.offset = 0;
+    block.size = size;
+    block.heap = h;
+    block.prevPhys = None;
+    block.nextPhys = None;
+    block.requested = 0;
+
+    heaps[h] = { handle, size, b };
+    InsertFree(b);
+
+    ++stats.heaps;
+    stats.reserved += size;
+    return b;
+}
+
+// -------------------------------------------------------------------------------
+
+bool HeapAllocator::Allocate(ullong size, ullong alignment, HeapBlock * result)
+{
+    ullong requested = size;
+    size = size ? (size + granularity - 1) & ~(granularity - 1) : granularity;
+    if (alignment < granularity)
+        alignment = granularity;
+
+    // o pior caso de um alinhamento maior desperdiça alignment - granularity bytes
+    ullong search = size + (alignment - granularity);
+
+    // sem bloco livre adequado: o único bloco de uma heap nova
+    uint b = FindFree(search);
+    if (b == None && (b = AddHeap(search)) == None)
+    {
+        ++stats.failures;
+        return false;
+    }
+
+    RemoveFree(b);
+
+    // espaço inicial até o alinhamento volta para as listas livres
+    ullong aligned = (blocks[b].offset + alignment - 1) & ~(alignment - 1);
+    if (aligned != blocks[b].offset)
+    {
+        uint front = b;
+        b = Split(front, aligned - blocks[front].offset);
+        InsertFree(front);
+    }
+
+    // a sobra do bloco também
+    if (blocks[b].size > size)
+        InsertFree(Split(b, size));
+
+    Block & block = blocks[b];
+    block.requested = requested;
+
+    ++stats.allocations;
+    ++stats.totalAllocations;
+    stats.used += block.size;
+    stats.requested += requested;
+
+    *result = { heaps[block.heap].memory, block.offset, block.size, b };
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void HeapAllocator::Free(const HeapBlock & allocation)
+{
+    uint b = allocation.id;
+    if (b >= blocks.size() || blocks[b].free)
+        return;
+
+    stats.used -= blocks[b].size;
+    stats.requested -= blocks[b].requested;
+    --stats.allocations;
+    ++stats.totalFrees;
+
+    // une com o vizinho seguinte
+    uint next = blocks[b].nextPhys;
+    if (next != None && blocks[next].free)
+    {
+        RemoveFree(next);
+        blocks[b].size += blocks[next].size;
+        blocks[b].nextPhys = blocks[next].nextPhys;
+        if (blocks[b].nextPhys != None)
+            blocks[blocks[b].nextPhys].prevPhys = b;
+        unusedBlocks.push_back(next);
+    }
+
+    // une com o vizinho anterior
+    uint prev = blocks[b].prevPhys;
+    if (prev != None && blocks[prev].free)
+    {
+        RemoveFree(prev);
+        blocks[prev].size += blocks[b].size;
+        blocks[prev].nextPhys = blocks[b].nextPhys;
+        if (blocks[prev].nextPhys != None)
+            blocks[blocks[prev].nextPhys].prevPhys = prev;
+        unusedBlocks.push_back(b);
+        b = prev;
+    }
+
+    blocks[b].requested = 0;
+    InsertFree(b);
+}
+
+// -------------------------------------------------------------------------------
+
+uint HeapAllocator::Trim()
+{
+    uint released = 0;
+
+    for (Heap & heap : heaps)
+    {
+        // uma heap vazia tem um único bloco livre do seu tamanho
+        if (heap.memory && blocks[heap.first].free && blocks[heap.first].size == heap.size)
+        {
+            RemoveFree(heap.first);
+            unusedBlocks.push_back(heap.first);
+            memory.Release(heap.memory);
+
+            --stats.heaps;
+            stats.reserved -= heap.size;
+            heap.memory = nullptr;
+            heap.first = None;
+            ++released;
+        }
+    }
+
+    return released;
+}
+
+// -------------------------------------------------------------------------------
+
+HeapAllocatorStats HeapAllocator::Stats() const
+{
+    HeapAllocatorStats result = stats;
+
+    // o maior bloco livre está na maior lista não vazia
+    result.largestFree = 0;
+    if (flBitmap)
+    {
+        uint fl = HighestBit(flBitmap);
+        uint sl = HighestBit(slBitmap[fl]);
+        for (uint b = lists[fl][sl]; b != None; b = blocks[b].nextFree)
+        {
+            if (blocks[b].size > result.largestFree)
+                result.largestFree = blocks[b].size;
+        }
+    }
+
+    // um bloco nunca passa do tamanho de uma heap: esse é o melhor caso
+    ullong freeBytes = stats.reserved - stats.used;
+    ullong ideal = freeBytes < heapSize ? freeBytes : heapSize;
+    result.fragmentation = ideal > result.largestFree ? 1.0 - double(result.largestFree) / ideal : 0.0;
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+// Medição com malhas sendo criadas e destruídas
+
+string HeapChurnBenchmark::ToString() const
+{
+    const double MB = 1048576.0;
+
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << operations << " operações em " << seconds * 1000.0 << " ms ("
+         << operationsPerSec / 1e6 << " milhões/s), pico de " << peakReserved / MB
+         << " MB em heaps e " << peakUsed / MB << " MB em uso, fragmentação máxima "
+         << peakFragmentation * 100.0 << "%; " << stats.ToString();
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+HeapChurnBenchmark BenchmarkHeapChurn(ullong operations, uint liveMeshes)
+{
+    Timer timer;
+
+    VirtualHeapMemory memory;
+    HeapAllocator allocator(memory);
+
+    HeapChurnBenchmark result = {};
+    result.operations = operations;
+    if (liveMeshes == 0)
+        liveMeshes = 1;
+
+    // cada malha tem um vertex buffer e um index buffer
+    vector<HeapBlock> live;
+    live.reserve(liveMeshes * 2);
+
+    // gerador congruencial: tamanhos em escala logarítmica de 4KB a 1MB
+    uint seed = 12345;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+    auto size = [&next]() { return (4096ull << (next() % 9)) + (next() % 4096) * 16; };
+
+    timer.Start();
+
+    for (ullong i = 0; i < operations; ++i)
+    {
+        // metade do tempo abaixo da população alvo cria malhas, acima destrói
+        bool create = live.size() < liveMeshes * 2 ? (live.size() < liveMeshes || (next() & 1)) : false;
+
+        if (create)
+        {
+            HeapBlock block;
+            if (allocator.Allocate(size(), 0, &block))
+                live.push_back(block);
+        }
+        else
+        {
+            uint victim = next() % uint(live.size());
+            allocator.Free(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+
+        // amostra o estado sem pesar na medição
+        if ((i & 4095) == 0)
+        {
+            HeapAllocatorStats stats = allocator.Stats();
+            if (stats.fragmentation > result.peakFragmentation)
+                result.peakFragmentation = stats.fragmentation;
+            if (stats.reserved > result.peakReserved)
+                result.peakReserved = stats.reserved;
+            if (stats.used > result.peakUsed)
+                result.peakUsed = stats.used;
+        }
+    }
+
+    result.seconds = timer.Elapsed();
+    result.operationsPerSec = result.seconds > 0.0 ? operations / result.seconds : 0.0;
+    result.stats = allocator.Stats();
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+// Verificação do subalocador
+
+SelfTestReport TestHeapAllocator()
+{
+    SelfTestReport report("Subalocador de heaps");
+    const ullong KB = 1024;
+    const ullong MB = 1024 * KB;
+
+    VirtualHeapMemory memory;
+    HeapAllocator allocator(memory, 1 * MB, 64 * KB);
+
+    // divisão: cada bloco sai do início do bloco livre e a sobra volta à lista
+    HeapBlock a, b, c, d;
+    allocator.Allocate(64 * KB, 0, &a);
+    allocator.Allocate(100 * KB, 0, &b);
+    allocator.Allocate(64 * KB, 0, &c);
+    report.Check(a.offset == 0 && b.offset == 64 * KB && c.offset == 192 * KB, "blocos divididos em sequência");
+    report.Check(b.size == 128 * KB, "tamanho arredondado para a granularidade");
+
+    HeapAllocatorStats stats = allocator.Stats();
+    report.Check(stats.heaps == 1 && stats.freeBlocks == 1 && stats.largestFree == 768 * KB, "sobra da heap em um único bloco livre");
+    report.Check(stats.used == 256 * KB && stats.requested == 228 * KB, "bytes em uso e pedidos");
+
+    // um buraco de 128KB e a sobra de 768KB: fragmentação de 1 - 768/896
+    allocator.Free(b);
+    stats = allocator.Stats();
+    report.Check(stats.freeBlocks == 2, "bloco liberado entre dois blocos em uso");
+    report.Check(stats.fragmentation > 1.0 / 7.0 - 1e-9 && stats.fragmentation < 1.0 / 7.0 + 1e-9, "fragmentação com um buraco");
+
+    // a menor faixa que serve é a do buraco, não a da sobra
+    allocator.Allocate(64 * KB, 0, &d);
+    report.Check(d.offset == 64 * KB, "bloco pequeno colocado no buraco");
+
+    // união: o bloco liberado junta-se aos vizinhos livres dos dois lados
+    allocator.Free(a);
+    allocator.Free(d);
+    stats = allocator.Stats();
+    report.Check(stats.freeBlocks == 2 && allocator.Stats().largestFree == 768 * KB, "união de três blocos vizinhos");
+    allocator.Free(c);
+    stats = allocator.Stats();
+    report.Check(stats.freeBlocks == 1 && stats.largestFree == 1 * MB && stats.fragmentation == 0.0, "heap inteira livre depois de todas as liberações");
+    report.Check(stats.used == 0 && stats.requested == 0 && stats.allocations == 0, "nenhum byte em uso");
+
+    // alinhamento maior: o espaço inicial volta para as listas livres
+    allocator.Allocate(64 * KB, 0, &a);
+    allocator.Allocate(64 * KB, 256 * KB, &b);
+    stats = allocator.Stats();
+    report.Check(b.offset == 256 * KB, "bloco alinhado a 256KB");
+    report.Check(stats.freeBlocks == 2 && stats.used == 128 * KB, "espaço antes do alinhamento devolvido");
+    allocator.Free(a);
+    allocator.Free(b);
+    report.Check(allocator.Stats().freeBlocks == 1, "espaço do alinhamento unido de volta");
+
+    // blocos maiores que a heap padrão ganham uma heap do seu tamanho
+    allocator.Allocate(3 * MB, 0, &a);
+    stats = allocator.Stats();
+    report.Check(stats.heaps == 2 && stats.reserved == 4 * MB && a.offset == 0, "heap extra para um bloco grande");
+    allocator.Free(a);
+    report.Check(allocator.Trim() == 2 && allocator.Stats().heaps == 0 && allocator.Stats().reserved == 0, "heaps vazias liberadas");
+
+    // orçamento de duas heaps: a terceira é recusada
+    allocator.Budget(2 * MB);
+    bool first = allocator.Allocate(1 * MB, 0, &a);
+    bool second = allocator.Allocate(1 * MB, 0, &b);
+    bool third = allocator.Allocate(64 * KB, 0, &c);
+    stats = allocator.Stats();
+    report.Check(first && second && !third && stats.failures == 1 && stats.heaps == 2, "alocação além do orçamento recusada");
+    allocator.Free(a);
+    allocator.Free(b);
+    allocator.Trim();
+    allocator.Budget(0);
+
+    // alocações e liberações aleatórias: blocos vivos nunca se sobrepõem
+    vector<HeapBlock> live;
+    uint seed = 6789;
+    uint overlaps = 0;
+    uint misaligned = 0;
+    uint failures = 0;
+
+    for (uint i = 0; i < 4000; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        if (live.size() < 64 && ((seed >> 12) & 3) != 0)
+        {
+            seed = seed * 1664525 + 1013904223;
+            ullong size = 1 + (seed >> 8) % (640 * KB);
+            ullong alignment = (64 * KB) << ((seed >> 4) % 3);
+
+            HeapBlock block;
+            if (!allocator.Allocate(size, alignment, &block))
+            {
+                ++failures;
+                continue;
+            }
+
+            if (block.offset % alignment)
+                ++misaligned;
+
+            for (const HeapBlock & other : live)
+                if (other.heap == block.heap && block.offset < other.offset + other.size && other.offset < block.offset + block.size)
+                    ++overlaps;
+
+            live.push_back(block);
+        }
+        else if (!live.empty())
+        {
+            size_t k = (seed >> 8) % live.size();
+            allocator.Free(live[k]);
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+
+    report.Check(failures == 0, "alocações sem orçamento sempre atendidas");
+    report.Check(overlaps == 0, "nenhuma sobreposição entre blocos vivos (" + std::to_string(overlaps) + ")");
+    report.Check(misaligned == 0, "alinhamentos de 64KB a 256KB respeitados");
+
+    // liberados todos os blocos, cada heap volta a ser um único bloco livre
+    for (const HeapBlock & block : live)
+        allocator.Free(block);
+
+    stats = allocator.Stats();
+    report.Check(stats.used == 0 && stats.allocations == 0, "nenhum bloco vivo no fim");
+    report.Check(stats.freeBlocks == stats.heaps && stats.fragmentation == 0.0, "cada heap unida em um único bloco livre");
+    report.Check(allocator.Trim() == stats.heaps && allocator.Stats().reserved == 0, "todas as heaps liberadas");
+
+    return report;
+}
+
+// -------------------------------------------------------------------------------
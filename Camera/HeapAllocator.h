@@ -0,0 +1,210 @@
+/**********************************************************************************
+// HeapAllocator (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Subalocador de heaps para buffers estáticos da GPU (TLSF).
+//
+//              Em vez de um recurso comprometido (com heap implícita) por
+//              buffer, os buffers são colocados em heaps grandes e
+//              compartilhadas. Os blocos livres ficam em listas separadas
+//              por classe de tamanho em dois níveis: o primeiro é a
+//              potência de dois do tamanho e o segundo divide cada potência
+//              em 16 faixas. Mapas de bits indicam as listas não vazias, de
+//              modo que alocar e liberar custam tempo constante. Ao liberar,
+//              o bloco é unido aos vizinhos livres da mesma heap.
+//
+//              Todo tamanho e deslocamento é múltiplo da granularidade
+//              (64KB para recursos colocados no Direct3D); alinhamentos
+//              maiores reservam um espaço inicial que volta para as listas.
+//              Novas heaps só são criadas dentro do orçamento de memória.
+//
+//              A contabilidade não depende do Direct3D: as heaps são obtidas
+//              por uma interface e podem ser apenas simbólicas nos testes.
+//
+**********************************************************************************/
+
+#ifndef DXUT_HEAPALLOCATOR_H
+#define DXUT_HEAPALLOCATOR_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "SelfTest.h"                   // verificações de -selftest
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// origem das heaps compartilhadas
+class HeapMemory
+{
+public:
+    virtual ~HeapMemory() {}
+
+    // cria uma heap com size bytes (nulo se não houver memória)
+    virtual void * Create(ullong size) = 0;
+
+    // libera uma heap criada por Create
+    virtual void Release(void * heap) = 0;
+};
+
+// -------------------------------------------------------------------------------
+
+// heaps apenas simbólicas (testes e medições sem GPU)
+class VirtualHeapMemory : public HeapMemory
+{
+private:
+    ullong created;                     // heaps criadas até agora
+
+public:
+    VirtualHeapMemory();
+
+    void * Create(ullong size);
+    void Release(void * heap);
+};
+
+// -------------------------------------------------------------------------------
+
+// região de uma heap entregue a um recurso
+struct HeapBlock
+{
+    void * heap;                        // heap onde o recurso é colocado
+    ullong offset;                      // deslocamento dentro da heap
+    ullong size;                        // bytes reservados (múltiplo da granularidade)
+    uint   id;                          // identificador usado na liberação
+};
+
+// estatísticas do subalocador
+struct HeapAllocatorStats
+{
+    ullong heaps;                       // heaps criadas
+    ullong reserved;                    // bytes em heaps
+    ullong used;                        // bytes em blocos alocados
+    ullong requested;                   // bytes pedidos pelos blocos alocados
+    ullong budget;                      // limite de bytes em heaps (0 sem limite)
+    ullong allocations;                 // blocos alocados
+    ullong freeBlocks;                  // blocos livres
+    ullong largestFree;                 // maior bloco livre
+    double fragmentation;               // 1 - maior bloco livre / bytes livres (até uma heap)
+    ullong totalAllocations;            // alocações feitas desde a criação
+    ullong totalFrees;                  // liberações feitas desde a criação
+    ullong failures;                    // alocações recusadas pelo orçamento
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class HeapAllocator
+{
+private:
+    static const uint SlBits = 4;                   // bits do segundo nível
+    static const uint SlCount = 1 << SlBits;        // faixas por potência de dois
+    static const uint FlCount = 48;                 // potências de dois atendidas
+    static const uint None = 0xffffffff;            // bloco inexistente
+
+    struct Block
+    {
+        ullong offset;                  // deslocamento na heap
+        ullong size;                    // tamanho em bytes
+        uint   heap;                    // índice da heap
+        uint   prevPhys;                // bloco anterior na heap
+        uint   nextPhys;                // bloco seguinte na heap
+        uint   prevFree;                // anterior na lista livre
+        uint   nextFree;                // seguinte na lista livre
+        bool   free;                    // está em uma lista livre
+        ullong requested;               // bytes pedidos (blocos alocados)
+    };
+
+    struct Heap
+    {
+        void * memory;                  // heap obtida de HeapMemory (nula se liberada)
+        ullong size;                    // tamanho em bytes
+        uint   first;                   // primeiro bloco da heap
+    };
+
+    HeapMemory & memory;                // origem das heaps
+    ullong heapSize;                    // tamanho padrão de uma nova heap
+    ullong granularity;                 // alinhamento mínimo (potência de dois)
+    uint   shift;                       // log2 da granularidade
+
+    vector<Block> blocks;               // todos os blocos
+    vector<uint> unusedBlocks;          // entradas livres em blocks
+    vector<Heap> heaps;                 // heaps criadas
+
+    ullong flBitmap;                    // primeiros níveis com listas não vazias
+    uint   slBitmap[FlCount];           // listas não vazias de cada primeiro nível
+    uint   lists[FlCount][SlCount];     // primeiro bloco de cada lista livre
+
+    HeapAllocatorStats stats;           // estatísticas mantidas incrementalmente
+
+    static void Mapping(ullong units, uint & fl, uint & sl);
+    uint NewBlock();
+    void InsertFree(uint b);
+    void RemoveFree(uint b);
+    uint FindFree(ullong size);
+    uint Split(uint b, ullong size);
+    uint AddHeap(ullong minimum);
+
+public:
+    HeapAllocator(HeapMemory & memory,
+                  ullong heapSize = 64ull << 20,
+                  ullong granularity = 64ull << 10,
+                  ullong budget = 0);
+    ~HeapAllocator();
+
+    // reserva size bytes com o alinhamento pedido (potência de dois);
+    // retorna falso se o orçamento não permite uma nova heap
+    bool Allocate(ullong size, ullong alignment, HeapBlock * block);
+
+    void Free(const HeapBlock & block); // devolve o bloco e une com os vizinhos livres
+    uint Trim();                        // libera heaps vazias e retorna quantas
+    void Budget(ullong bytes);          // define o limite de bytes em heaps (0 sem limite)
+    ullong Granularity() const;         // alinhamento mínimo dos blocos
+
+    HeapAllocatorStats Stats() const;   // estatísticas, com a fragmentação atual
+};
+
+// -------------------------------------------------------------------------------
+
+// medição da vazão e da fragmentação com malhas sendo criadas e destruídas
+struct HeapChurnBenchmark
+{
+    ullong operations;                  // alocações e liberações medidas
+    double seconds;                     // duração
+    double operationsPerSec;            // vazão
+    double peakFragmentation;           // maior fragmentação observada
+    ullong peakReserved;                // maior número de bytes em heaps
+    ullong peakUsed;                    // maior número de bytes em blocos
+    HeapAllocatorStats stats;           // estado ao final
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// mantém cerca de liveMeshes malhas vivas com buffers de 4KB a 1MB, trocando-as ao acaso
+HeapChurnBenchmark BenchmarkHeapChurn(ullong operations = 2000000, uint liveMeshes = 1000);
+
+// confere a divisão dos blocos, a escolha da menor faixa que serve, a união
+// com os vizinhos, a fragmentação, o alinhamento, o orçamento e, com
+// alocações aleatórias, que os blocos vivos nunca se sobrepõem
+SelfTestReport TestHeapAllocator();
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// define o limite de bytes em heaps
+inline void HeapAllocator::Budget(ullong bytes)
+{ stats.budget = bytes; }
+
+// alinhamento mínimo dos blocos
+inline ullong HeapAllocator::Granularity() const
+{ return granularity; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -1,11 +1,11 @@
 /**********************************************************************************
-// Input (Cdigo Fonte)
+// Input (Código Fonte)
 //
-// Criao:     06 Jan 2020
-// Atualizao: 17 Ago 2021
+// Criação:     06 Jan 2020
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   A classe Input concentra todas as tarefas relacionadas
+// Descrição:   A classe Input concentra todas as tarefas relacionadas
 //              aos dispositivos de entrada do tipo teclado e mouse.
 //
 **********************************************************************************/
@@ -13,21 +13,18 @@
 #include "Input.h"
 
 // -------------------------------------------------------------------------------
-// inicializao de membros estticos da classe
+// inicialização de membros estáticos da classe
 
-bool Input::keys[256] = { 0 };              // estado do teclado/mouse
-bool Input::ctrl[256] = { 0 };              // controle de liberao das teclas
+InputState Input::state = { };              // estado do teclado/mouse
+InputBuffer Input::buffer;                  // eventos ainda não aplicados
+bool Input::ctrl[256] = { 0 };              // controle de liberação das teclas
 string Input::text;                         // guarda caracteres digitados
 
-int Input::mouseX = 0;                      // posio do mouse no eixo x
-int Input::mouseY = 0;                      // posio do mouse no eixo y
-short Input::mouseWheel = 0;                // valor da roda do mouse
-                                    
 // -------------------------------------------------------------------------------
 
 Input::Input()
 {
-    // ATENO: supe que a janela j foi criada com uma chamada a window->Create();
+    // ATENÇÂO: supõe que a janela já foi criada com uma chamada a window->Create();
     // altera a window procedure da janela ativa para InputProc
     SetWindowLongPtr(GetActiveWindow(), GWLP_WNDPROC, (LONG_PTR)Input::InputProc);
 }
@@ -64,13 +61,22 @@ bool Input::KeyPress(int vkcode)
 
 short Input::MouseWheel()
 {
-    short val = mouseWheel;
-    mouseWheel = 0;
+    short val = short(state.wheel);
+    state.wheel = 0;
     return val;
 }
 
 // -------------------------------------------------------------------------------
 
+void Input::BeginFrame()
+{
+    // todas as amostras do lote são aplicadas em ordem; o estado final,
+    // o deslocamento acumulado e cada evento ficam disponíveis no quadro
+    state.Apply(buffer.Flush());
+}
+
+// -------------------------------------------------------------------------------
+
 void Input::Read()
 {
     // apaga texto armazenado
@@ -118,60 +124,60 @@ LRESULT CALLBACK Input::Reader(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam
 
 LRESULT CALLBACK Input::InputProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    // os eventos são gravados e aplicados no início do próximo quadro
     switch (msg)
     {
         // tecla pressionada
     case WM_KEYDOWN:
-        keys[wParam] = true;
+        buffer.Push(INPUT_KEYDOWN, int(wParam));
         return 0;
 
         // tecla liberada
     case WM_KEYUP:
-        keys[wParam] = false;
+        buffer.Push(INPUT_KEYUP, int(wParam));
         return 0;
 
         // movimento do mouse
     case WM_MOUSEMOVE:
-        mouseX = GET_X_LPARAM(lParam);
-        mouseY = GET_Y_LPARAM(lParam);
+        buffer.Push(INPUT_MOUSEMOVE, 0, GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
         return 0;
 
         // movimento da roda do mouse
     case WM_MOUSEWHEEL:
-        mouseWheel = GET_WHEEL_DELTA_WPARAM(wParam);
+        buffer.Push(INPUT_MOUSEWHEEL, 0, GET_WHEEL_DELTA_WPARAM(wParam));
         return 0;
 
-        // boto esquerdo do mouse pressionado
+        // botão esquerdo do mouse pressionado
     case WM_LBUTTONDOWN:
     case WM_LBUTTONDBLCLK:
-        keys[VK_LBUTTON] = true;
+        buffer.Push(INPUT_KEYDOWN, VK_LBUTTON);
         return 0;
 
-        // boto do meio do mouse pressionado
+        // botão do meio do mouse pressionado
     case WM_MBUTTONDOWN:
     case WM_MBUTTONDBLCLK:
-        keys[VK_MBUTTON] = true;
+        buffer.Push(INPUT_KEYDOWN, VK_MBUTTON);
         return 0;
 
-        // boto direito do mouse pressionado
+        // botão direito do mouse pressionado
     case WM_RBUTTONDOWN:
     case WM_RBUTTONDBLCLK:
-        keys[VK_RBUTTON] = true;
+        buffer.Push(INPUT_KEYDOWN, VK_RBUTTON);
         return 0;
 
-        // boto esquerdo do mouse liberado
+        // botão esquerdo do mouse liberado
     case WM_LBUTTONUP:
-        keys[VK_LBUTTON] = false;
+        buffer.Push(INPUT_KEYUP, VK_LBUTTON);
         return 0;
 
-        // boto do meio do mouse liberado
+        // botão do meio do mouse liberado
     case WM_MBUTTONUP:
-        keys[VK_MBUTTON] = false;
+        buffer.Push(INPUT_KEYUP, VK_MBUTTON);
         return 0;
 
-        // boto direito do mouse liberado
+        // botão direito do mouse liberado
     case WM_RBUTTONUP:
-        keys[VK_RBUTTON] = false;
+        buffer.Push(INPUT_KEYUP, VK_RBUTTON);
         return 0;
     }
 
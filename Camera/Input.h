@@ -1,13 +1,17 @@
 /**********************************************************************************
-// Input (Arquivo de Cabealho)
+// Input (Arquivo de Cabeçalho)
 //
-// Criao:     06 Jan 2020
-// Atualizao: 07 Ago 2021
+// Criação:     06 Jan 2020
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   A classe Input concentra todas as tarefas relacionadas 
+// Descrição:   A classe Input concentra todas as tarefas relacionadas 
 //              aos dispositivos de entrada do tipo teclado e mouse.
 //
+//              Os eventos recebidos pela window procedure são gravados com
+//              marca de tempo e aplicados em lote no início de cada quadro,
+//              depois que o laço principal esvaziou a fila de mensagens.
+//
 **********************************************************************************/
 
 #ifndef DXUT_INPUT_H
@@ -16,34 +20,38 @@
 // ---------------------------------------------------------------------------------
 
 #include "Window.h"
+#include "EventSource.h"
 
 // ---------------------------------------------------------------------------------
 
 class Input
 {
 private:
-    static bool keys[256];              // estado das teclas do teclado/mouse
-    static bool ctrl[256];              // controle da liberao de teclas
+    static InputState state;            // estado do teclado/mouse após o último lote
+    static InputBuffer buffer;          // eventos recebidos desde o último quadro
+    static bool ctrl[256];              // controle da liberação de teclas
     static string text;                 // armazenamento para os caracteres
 
-    static int mouseX;                  // posio do mouse eixo x
-    static int mouseY;                  // posio do mouse eixo y
-    static short mouseWheel;            // valor da roda do mouse
-
 public:
     Input();                            // construtor
     ~Input();                           // destrutor
 
-    bool KeyDown(int vkcode);           // retorna se tecla est pressionada
-    bool KeyUp(int vkcode);             // retorna se tecla est liberada
-    bool KeyPress(int vkcode);          // novo pressionamento somente aps liberao        
+    bool KeyDown(int vkcode);           // retorna se tecla está pressionada
+    bool KeyUp(int vkcode);             // retorna se tecla está liberada
+    bool KeyPress(int vkcode);          // novo pressionamento somente após liberação        
     
-    int   MouseX();                     // retorna posio x do mouse
-    int   MouseY();                     // retorna posio y do mouse
-    short MouseWheel();                 // retorna rotao da roda do mouse
+    int   MouseX();                     // retorna posição x do mouse
+    int   MouseY();                     // retorna posição y do mouse
+    short MouseWheel();                 // retorna rotação da roda do mouse
+    int   MouseDeltaX();                // deslocamento x do mouse no quadro
+    int   MouseDeltaY();                // deslocamento y do mouse no quadro
 
-    void  Read();                       // armazena texto digitado at o prximo ENTER ou TAB
-    static const char* Text();          // retorna endereo do texto armazenada
+    void  BeginFrame();                 // aplica os eventos recebidos desde o último quadro
+    const vector<InputEvent> & Events();// eventos do quadro, em ordem de chegada
+    static InputBuffer & Buffer();      // destino dos eventos das fontes
+
+    void  Read();                       // armazena texto digitado até o próximo ENTER ou TAB
+    static const char* Text();          // retorna endereço do texto armazenada
 
     // trata eventos do Windows
     static LRESULT CALLBACK Reader(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -51,25 +59,41 @@ public:
 };
 
 // ---------------------------------------------------------------------------------
-// Funes Membro Inline
+// Funções Membro Inline
 
-// retorna verdadeiro se a tecla est pressionada
+// retorna verdadeiro se a tecla está pressionada
 inline bool Input::KeyDown(int vkcode)
-{ return keys[vkcode]; }
+{ return state.keys[vkcode]; }
 
-// retorna verdadeiro se a tecla est liberada
+// retorna verdadeiro se a tecla está liberada
 inline bool Input::KeyUp(int vkcode)
-{ return !(keys[vkcode]); }
+{ return !(state.keys[vkcode]); }
 
-// retorna a posio do mouse no eixo x
+// retorna a posição do mouse no eixo x
 inline int Input::MouseX()
-{ return mouseX; }
+{ return state.mouseX; }
 
-// retorna a posio do mouse no eixo y
+// retorna a posição do mouse no eixo y
 inline int Input::MouseY()
-{ return mouseY; }
+{ return state.mouseY; }
+
+// retorna o deslocamento x do mouse acumulado no quadro
+inline int Input::MouseDeltaX()
+{ return state.deltaX; }
+
+// retorna o deslocamento y do mouse acumulado no quadro
+inline int Input::MouseDeltaY()
+{ return state.deltaY; }
+
+// retorna todas as amostras do quadro
+inline const vector<InputEvent> & Input::Events()
+{ return buffer.Batch(); }
+
+// retorna o buffer que recebe os eventos
+inline InputBuffer & Input::Buffer()
+{ return buffer; }
 
-// retorna contedo do texto lido
+// retorna conteúdo do texto lido
 inline const char* Input::Text()
 { return text.c_str(); }
 
@@ -0,0 +1,320 @@
+/**********************************************************************************
+// InstanceTransform (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Transformações de milhares de instâncias de uma malha.
+//
+**********************************************************************************/
+
+#include "InstanceTransform.h"
+#include "Timer.h"
+#include <immintrin.h>                  // SSE e AVX
+#include <cmath>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+void InstanceTransforms::Resize(uint count)
+{
+    for (vector<float> & element : m)
+        element.resize(count, 0.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+void InstanceTransforms::Set(uint i, const XMFLOAT4X4 & world)
+{
+    for (uint r = 0; r < 3; ++r)
+        for (uint c = 0; c < 3; ++c)
+            m[3 * r + c][i] = world.m[r][c];
+
+    for (uint c = 0; c < 3; ++c)
+        m[9 + c][i] = world.m[3][c];
+}
+
+// -------------------------------------------------------------------------------
+
+XMFLOAT4X4 InstanceTransforms::Get(uint i) const
+{
+    return XMFLOAT4X4(
+        m[0][i], m[1][i], m[2][i], 0.0f,
+        m[3][i], m[4][i], m[5][i], 0.0f,
+        m[6][i], m[7][i], m[8][i], 0.0f,
+        m[9][i], m[10][i], m[11][i], 1.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+// Cada linha r da saída transposta é a coluna r da matriz combinada:
+//   saída[r][e] = soma(mundo[e][k] * viewProj[k][r]), com mundo[3][3] = 1
+
+// A saída i vem da instância first + i ou, com uma lista, da instância indices[i].
+
+static void TransformScalar(const float * const m[12], const XMFLOAT4X4 & vp, XMFLOAT4X4 * out,
+                            uint first, const uint * indices, uint count)
+{
+    for (uint i = 0; i < count; ++i)
+    {
+        uint s = indices ? indices[i] : first + i;
+        for (uint r = 0; r < 4; ++r)
+        {
+            for (uint e = 0; e < 3; ++e)
+                out[i].m[r][e] = m[3 * e][s] * vp.m[0][r] + m[3 * e + 1][s] * vp.m[1][r] + m[3 * e + 2][s] * vp.m[2][r];
+
+            out[i].m[r][3] = m[9][s] * vp.m[0][r] + m[10][s] * vp.m[1][r] + m[11][s] * vp.m[2][r] + vp.m[3][r];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+static uint TransformSse(const float * const m[12], const XMFLOAT4X4 & vp, XMFLOAT4X4 * out,
+                         uint first, const uint * indices, uint count)
+{
+    // elementos da viewProj replicados nas 4 posições
+    __m128 v[4][4];
+    for (uint k = 0; k < 4; ++k)
+        for (uint r = 0; r < 4; ++r)
+            v[k][r] = _mm_set1_ps(vp.m[k][r]);
+
+    uint blocks = count / 4;
+    for (uint b = 0; b < blocks; ++b)
+    {
+        // mesmo elemento de 4 instâncias em cada registrador
+        __m128 a[12];
+        if (indices)
+        {
+            const uint * k = indices + b * 4;
+            for (uint j = 0; j < 12; ++j)
+                a[j] = _mm_setr_ps(m[j][k[0]], m[j][k[1]], m[j][k[2]], m[j][k[3]]);
+        }
+        else
+        {
+            uint s = first + b * 4;
+            for (uint j = 0; j < 12; ++j)
+                a[j] = _mm_loadu_ps(m[j] + s);
+        }
+
+        for (uint r = 0; r < 4; ++r)
+        {
+            __m128 e0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], v[0][r]), _mm_mul_ps(a[1], v[1][r])), _mm_mul_ps(a[2], v[2][r]));
+            __m128 e1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[3], v[0][r]), _mm_mul_ps(a[4], v[1][r])), _mm_mul_ps(a[5], v[2][r]));
+            __m128 e2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[6], v[0][r]), _mm_mul_ps(a[7], v[1][r])), _mm_mul_ps(a[8], v[2][r]));
+            __m128 e3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[9], v[0][r]), _mm_mul_ps(a[10], v[1][r])),
+                                   _mm_add_ps(_mm_mul_ps(a[11], v[2][r]), v[3][r]));
+
+            // de um elemento por registrador para uma linha por instância
+            _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+
+            XMFLOAT4X4 * dst = out + b * 4;
+            _mm_storeu_ps(&dst[0].m[r][0], e0);
+            _mm_storeu_ps(&dst[1].m[r][0], e1);
+            _mm_storeu_ps(&dst[2].m[r][0], e2);
+            _mm_storeu_ps(&dst[3].m[r][0], e3);
+        }
+    }
+
+    return blocks * 4;
+}
+
+// -------------------------------------------------------------------------------
+
+DXUT_TARGET_AVX
+static uint TransformAvx(const float * const m[12], const XMFLOAT4X4 & vp, XMFLOAT4X4 * out,
+                         uint first, const uint * indices, uint count)
+{
+    // elementos da viewProj replicados nas 8 posições
+    __m256 v[4][4];
+    for (uint k = 0; k < 4; ++k)
+        for (uint r = 0; r < 4; ++r)
+            v[k][r] = _mm256_set1_ps(vp.m[k][r]);
+
+    uint blocks = count / 8;
+    for (uint b = 0; b < blocks; ++b)
+    {
+        // mesmo elemento de 8 instâncias em cada registrador
+        __m256 a[12];
+        if (indices)
+        {
+            const uint * k = indices + b * 8;
+            for (uint j = 0; j < 12; ++j)
+                a[j] = _mm256_setr_ps(m[j][k[0]], m[j][k[1]], m[j][k[2]], m[j][k[3]],
+                                      m[j][k[4]], m[j][k[5]], m[j][k[6]], m[j][k[7]]);
+        }
+        else
+        {
+            uint s = first + b * 8;
+            for (uint j = 0; j < 12; ++j)
+                a[j] = _mm256_loadu_ps(m[j] + s);
+        }
+
+        for (uint r = 0; r < 4; ++r)
+        {
+            __m256 e0 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], v[0][r]), _mm256_mul_ps(a[1], v[1][r])), _mm256_mul_ps(a[2], v[2][r]));
+            __m256 e1 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[3], v[0][r]), _mm256_mul_ps(a[4], v[1][r])), _mm256_mul_ps(a[5], v[2][r]));
+            __m256 e2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[6], v[0][r]), _mm256_mul_ps(a[7], v[1][r])), _mm256_mul_ps(a[8], v[2][r]));
+            __m256 e3 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[9], v[0][r]), _mm256_mul_ps(a[10], v[1][r])),
+                                      _mm256_add_ps(_mm256_mul_ps(a[11], v[2][r]), v[3][r]));
+
+            // transposição 4x4 em cada metade: instâncias 0-3 embaixo e 4-7 em cima
+            __m256 t0 = _mm256_unpacklo_ps(e0, e1);
+            __m256 t1 = _mm256_unpackhi_ps(e0, e1);
+            __m256 t2 = _mm256_unpacklo_ps(e2, e3);
+            __m256 t3 = _mm256_unpackhi_ps(e2, e3);
+            __m256 i0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 i1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 i2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 i3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+            XMFLOAT4X4 * dst = out + b * 8;
+            _mm_storeu_ps(&dst[0].m[r][0], _mm256_castps256_ps128(i0));
+            _mm_storeu_ps(&dst[1].m[r][0], _mm256_castps256_ps128(i1));
+            _mm_storeu_ps(&dst[2].m[r][0], _mm256_castps256_ps128(i2));
+            _mm_storeu_ps(&dst[3].m[r][0], _mm256_castps256_ps128(i3));
+            _mm_storeu_ps(&dst[4].m[r][0], _mm256_extractf128_ps(i0, 1));
+            _mm_storeu_ps(&dst[5].m[r][0], _mm256_extractf128_ps(i1, 1));
+            _mm_storeu_ps(&dst[6].m[r][0], _mm256_extractf128_ps(i2, 1));
+            _mm_storeu_ps(&dst[7].m[r][0], _mm256_extractf128_ps(i3, 1));
+        }
+    }
+
+    // evita a penalidade de transição entre AVX e SSE no código seguinte
+    _mm256_zeroupper();
+    return blocks * 8;
+}
+
+// -------------------------------------------------------------------------------
+
+static void Transform(const InstanceTransforms & instances, const XMFLOAT4X4 & viewProj,
+                      XMFLOAT4X4 * out, uint first, const uint * indices, uint count, SimdKernel kernel)
+{
+    const float * m[12];
+    for (uint j = 0; j < 12; ++j)
+        m[j] = instances.m[j].data();
+
+    kernel = SupportedSimdKernel(kernel);
+
+    // blocos completos no núcleo SIMD, o restante no escalar
+    uint done = 0;
+    if (kernel == SIMD_AVX)
+        done = TransformAvx(m, viewProj, out, first, indices, count);
+    else if (kernel == SIMD_SSE)
+        done = TransformSse(m, viewProj, out, first, indices, count);
+
+    TransformScalar(m, viewProj, out + done, first + done, indices ? indices + done : nullptr, count - done);
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformInstances(const InstanceTransforms & instances, const XMFLOAT4X4 & viewProj,
+                        XMFLOAT4X4 * out, uint first, uint count, SimdKernel kernel)
+{
+    Transform(instances, viewProj, out, first, nullptr, count, kernel);
+}
+
+// -------------------------------------------------------------------------------
+
+void TransformInstanceList(const InstanceTransforms & instances, const XMFLOAT4X4 & viewProj,
+                           XMFLOAT4X4 * out, const uint * indices, uint count, SimdKernel kernel)
+{
+    Transform(instances, viewProj, out, 0, indices, count, kernel);
+}
+
+// -------------------------------------------------------------------------------
+// Medição do cálculo em lote
+
+string InstanceTransformBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << instances << " instâncias x " << repeats << ": DirectXMath "
+         << directXMathPerSec / 1e6 << " milhões de matrizes/s, escalar SoA "
+         << scalarPerSec / 1e6 << " (" << scalarPerSec / directXMathPerSec << "x), SSE "
+         << ssePerSec / 1e6 << " (" << ssePerSec / directXMathPerSec << "x), AVX ";
+    if (avxPerSec > 0.0)
+        text << avxPerSec / 1e6 << " (" << avxPerSec / directXMathPerSec << "x)";
+    else
+        text << "sem suporte";
+    text.precision(7);
+    text << ", maior diferença " << maxError;
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+InstanceTransformBenchmark BenchmarkInstanceTransform(uint instances, uint repeats)
+{
+    Timer timer;
+
+    InstanceTransformBenchmark result = {};
+    result.instances = instances ? instances : 1;
+    result.repeats = repeats ? repeats : 1;
+
+    // instâncias em grade com giro e escala variados (AoS e SoA)
+    InstanceTransforms soa;
+    soa.Resize(result.instances);
+    vector<XMFLOAT4X4> aos(result.instances);
+
+    uint side = uint(std::ceil(std::sqrt(double(result.instances))));
+    for (uint i = 0; i < result.instances; ++i)
+    {
+        XMMATRIX world = XMMatrixScaling(0.5f + (i % 7) * 0.1f, 0.5f + (i % 7) * 0.1f, 0.5f + (i % 7) * 0.1f)
+            * XMMatrixRotationY(float(i) * 0.37f)
+            * XMMatrixTranslation(float(i % side) * 3.0f, 0.0f, float(i / side) * 3.0f);
+        XMStoreFloat4x4(&aos[i], world);
+        soa.Set(i, aos[i]);
+    }
+
+    XMFLOAT4X4 viewProj;
+    XMStoreFloat4x4(&viewProj,
+        XMMatrixLookAtLH(XMVectorSet(0.0f, 50.0f, -50.0f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f))
+        * XMMatrixPerspectiveFovLH(XMConvertToRadians(45.0f), 16.0f / 9.0f, 1.0f, 1000.0f));
+
+    vector<XMFLOAT4X4> reference(result.instances);
+    vector<XMFLOAT4X4> output(result.instances);
+    double total = double(result.instances) * result.repeats;
+
+    // laço escalar do DirectXMath, como no desenho de um único objeto
+    timer.Start();
+    for (uint rep = 0; rep < result.repeats; ++rep)
+    {
+        XMMATRIX vp = XMLoadFloat4x4(&viewProj);
+        for (uint i = 0; i < result.instances; ++i)
+            XMStoreFloat4x4(&reference[i], XMMatrixTranspose(XMLoadFloat4x4(&aos[i]) * vp));
+    }
+    result.directXMathPerSec = total / timer.Elapsed();
+
+    // núcleos em lote sobre a estrutura de vetores
+    auto measure = [&](SimdKernel kernel)
+    {
+        timer.Start();
+        for (uint rep = 0; rep < result.repeats; ++rep)
+            TransformInstances(soa, viewProj, output.data(), 0, result.instances, kernel);
+        double rate = total / timer.Elapsed();
+
+        for (uint i = 0; i < result.instances; ++i)
+            for (uint r = 0; r < 4; ++r)
+                for (uint c = 0; c < 4; ++c)
+                {
+                    double error = std::fabs(double(output[i].m[r][c]) - reference[i].m[r][c]);
+                    if (error > result.maxError)
+                        result.maxError = error;
+                }
+
+        return rate;
+    };
+
+    result.scalarPerSec = measure(SIMD_SCALAR);
+    result.ssePerSec = measure(SIMD_SSE);
+    if (BestSimdKernel() == SIMD_AVX)
+        result.avxPerSec = measure(SIMD_AVX);
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+/**********************************************************************************
+// InstanceTransform (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Transformações de milhares de instâncias de uma malha.
+//
+//              As matrizes de mundo (afins) ficam em estrutura de vetores
+//              (SoA): cada um dos 12 elementos úteis tem seu próprio vetor,
+//              de modo que um registrador SIMD carrega o mesmo elemento de
+//              4 (SSE) ou 8 (AVX) instâncias. A matriz combinada de cada
+//              instância (mundo x visão x projeção) é calculada em lote e
+//              gravada transposta, no layout lido pelos shaders, direto no
+//              buffer por instância.
+//
+//              O núcleo AVX só é usado se o processador e o sistema
+//              operacional o suportam; caso contrário o SSE é usado.
+//
+**********************************************************************************/
+
+#ifndef DXUT_INSTANCETRANSFORM_H
+#define DXUT_INSTANCETRANSFORM_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Simd.h"                       // escolha do núcleo SIMD
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// matrizes de mundo afins das instâncias em estrutura de vetores
+struct InstanceTransforms
+{
+    // m[3 * linha + coluna] para as linhas 0 a 2 (eixos) e m[9 + coluna] para
+    // a linha 3 (translação); a última coluna é sempre (0, 0, 0, 1)
+    vector<float> m[12];
+
+    void Resize(uint count);                        // ajusta o número de instâncias
+    uint Count() const;                             // número de instâncias
+    void Set(uint i, const XMFLOAT4X4 & world);     // grava a matriz de uma instância
+    XMFLOAT4X4 Get(uint i) const;                   // lê a matriz de uma instância
+};
+
+// -------------------------------------------------------------------------------
+
+// calcula transposta(mundo x viewProj) das instâncias [first, first + count)
+// e grava em out[0, count)
+void TransformInstances(const InstanceTransforms & instances,
+                        const XMFLOAT4X4 & viewProj,
+                        XMFLOAT4X4 * out,
+                        uint first, uint count,
+                        SimdKernel kernel = SIMD_AUTO);
+
+// calcula transposta(mundo x viewProj) das instâncias indices[0, count)
+// e grava em out[0, count) (instâncias visíveis de uma lista compacta)
+void TransformInstanceList(const InstanceTransforms & instances,
+                           const XMFLOAT4X4 & viewProj,
+                           XMFLOAT4X4 * out,
+                           const uint * indices, uint count,
+                           SimdKernel kernel = SIMD_AUTO);
+
+// -------------------------------------------------------------------------------
+
+// medição do cálculo em lote contra o laço escalar do DirectXMath
+struct InstanceTransformBenchmark
+{
+    uint   instances;                   // instâncias por repetição
+    uint   repeats;                     // repetições
+    double directXMathPerSec;           // matrizes/s com XMMATRIX (AoS)
+    double scalarPerSec;                // matrizes/s do núcleo escalar (SoA)
+    double ssePerSec;                   // matrizes/s do núcleo SSE (SoA)
+    double avxPerSec;                   // matrizes/s do núcleo AVX (0 sem suporte)
+    double maxError;                    // maior diferença para o DirectXMath
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// transforma instances instâncias repeats vezes com cada implementação
+InstanceTransformBenchmark BenchmarkInstanceTransform(uint instances = 100000, uint repeats = 50);
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// número de instâncias
+inline uint InstanceTransforms::Count() const
+{ return uint(m[0].size()); }
+
+// -------------------------------------------------------------------------------
+
+#endif
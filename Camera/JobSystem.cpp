@@ -0,0 +1,834 @@
+/**********************************************************************************
+// JobSystem (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Sistema de trabalhos com roubo de tarefas.
+//
+**********************************************************************************/
+
+#include "JobSystem.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <sstream>
+using std::lock_guard;
+using std::unique_lock;
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// trabalho publicado
+struct Job
+{
+    JobFunction function;               // função do trabalho
+    void * data;                        // dados da função
+    uint begin;                         // primeiro índice da faixa
+    uint end;                           // fim da faixa
+    uint grain;                         // maior faixa executada sem divisão
+    JobCounter * counter;               // contador do grupo
+    bool pooled;                        // reservado no conjunto de uma thread
+    atomic<bool> available;             // posição do conjunto livre para reuso
+
+    Job() : available(true) {}
+};
+
+// estado de uma thread de trabalho
+struct alignas(64) JobSystem::Worker
+{
+    WorkDeque deque;                    // trabalhos prontos desta thread
+    Job pool[PoolSize];                 // trabalhos reservados por esta thread
+    uint next;                          // próxima posição do conjunto
+    uint seed;                          // gerador das vítimas de roubo
+
+    // contadores escritos só pela própria thread
+    atomic<ullong> executed;            // trabalhos executados
+    atomic<ullong> steals;              // trabalhos roubados
+    atomic<ullong> overflows;           // trabalhos executados por fila cheia
+    atomic<ullong> sleeps;              // vezes que dormiu
+
+    Worker(uint index) : next(0), seed(index * 2654435761u + 1), executed(0), steals(0), overflows(0), sleeps(0) {}
+};
+
+// thread atual no sistema de trabalhos
+static thread_local const JobSystem * threadSystem = nullptr;
+static thread_local uint threadIndex = 0;
+
+// tentativas de encontrar trabalho antes de dormir
+static const uint SpinRounds = 64;
+
+// incrementa um contador escrito por uma única thread
+static inline void Increment(atomic<ullong> & counter)
+{ counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+// -------------------------------------------------------------------------------
+
+JobCounter::JobCounter() : pending(0)
+{
+}
+
+// -------------------------------------------------------------------------------
+
+JobCounter::~JobCounter()
+{
+}
+
+// -------------------------------------------------------------------------------
+
+WorkDeque::WorkDeque() : top(0), bottom(0)
+{
+    for (uint i = 0; i < Capacity; ++i)
+        items[i].store(nullptr, std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------
+
+bool WorkDeque::Push(Job * job)
+{
+    llong b = bottom.load(std::memory_order_relaxed);
+    llong t = top.load(std::memory_order_acquire);
+
+    if (b - t >= llong(Capacity))
+        return false;
+
+    items[b & Mask].store(job, std::memory_order_relaxed);
+
+    // publica o trabalho antes da nova posição da dona
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+Job * WorkDeque::Pop()
+{
+    // reserva o último trabalho antes de olhar o topo
+    llong b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    llong t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        // fila vazia
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job * job = items[b & Mask].load(std::memory_order_relaxed);
+
+    if (t == b)
+    {
+        // último trabalho: disputa com as outras threads pelo topo
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+// -------------------------------------------------------------------------------
+
+Job * WorkDeque::Steal()
+{
+    llong t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    llong b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+        return nullptr;
+
+    Job * job = items[t & Mask].load(std::memory_order_relaxed);
+
+    // outra thread (ou a dona) levou o trabalho primeiro
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+
+    return job;
+}
+
+// -------------------------------------------------------------------------------
+
+uint WorkDeque::Size() const
+{
+    llong b = bottom.load(std::memory_order_relaxed);
+    llong t = top.load(std::memory_order_relaxed);
+    return b > t ? uint(b - t) : 0;
+}
+
+// -------------------------------------------------------------------------------
+
+string JobSystemStats::ToString() const
+{
+    stringstream text;
+    text << threads << " threads, " << executed << " trabalhos executados, "
+         << steals << " roubados, " << overflows << " com fila cheia, "
+         << sleeps << " esperas sem trabalho";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+JobSystem::JobSystem(uint threadCount) : injectedCount(0), queued(0), sleeping(0), quit(false)
+{
+    uint count = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    count = std::min(count, uint(MaxThreads));
+
+    for (uint i = 0; i < count; ++i)
+        workers.push_back(new Worker(i));
+
+    // a thread que cria o sistema é a de índice 0
+    previousSystem = threadSystem;
+    previousIndex = threadIndex;
+    threadSystem = this;
+    threadIndex = 0;
+
+    for (uint i = 1; i < count; ++i)
+        threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+// -------------------------------------------------------------------------------
+
+JobSystem::~JobSystem()
+{
+    quit.store(true);
+    {
+        lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_all();
+    }
+
+    for (std::thread & t : threads)
+        t.join();
+
+    threadSystem = previousSystem;
+    threadIndex = previousIndex;
+
+    for (Worker * worker : workers)
+        delete worker;
+
+    for (Job * job : injected)
+        if (!job->pooled)
+            delete job;
+}
+
+// -------------------------------------------------------------------------------
+
+int JobSystem::Current() const
+{
+    return threadSystem == this ? int(threadIndex) : -1;
+}
+
+// -------------------------------------------------------------------------------
+
+Job * JobSystem::Allocate(int worker)
+{
+    // threads externas não têm conjunto próprio
+    if (worker < 0)
+    {
+        Job * job = new Job();
+        job->pooled = false;
+        return job;
+    }
+
+    Worker & w = *workers[worker];
+    Job * job = &w.pool[w.next++ & (PoolSize - 1)];
+
+    // a posição ainda está em uso: ajuda a executar até ela ser liberada
+    while (!job->available.load(std::memory_order_acquire))
+    {
+        if (Job * other = Take(worker))
+            Execute(other, worker);
+        else
+            std::this_thread::yield();
+    }
+
+    job->available.store(false, std::memory_order_relaxed);
+    job->pooled = true;
+    return job;
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Push(Job * job, int worker)
+{
+    if (worker >= 0)
+    {
+        // fila cheia: executa na própria thread
+        if (!workers[worker]->deque.Push(job))
+        {
+            Increment(workers[worker]->overflows);
+            Execute(job, worker);
+            return;
+        }
+    }
+    else
+    {
+        lock_guard<std::mutex> lock(injectMutex);
+        injected.push_back(job);
+        injectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // quem vai dormir incrementa sleeping e relê queued: uma das duas
+    // threads sempre vê a escrita da outra e nenhum aviso se perde
+    queued.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst) > 0)
+    {
+        lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Schedule(Job * job, int worker, const JobCounter * after)
+{
+    if (after)
+    {
+        // a chegada a zero acontece com a trava: ou o trabalho entra na
+        // lista antes dela ou vê o contador já zerado
+        lock_guard<std::mutex> lock(after->mutex);
+        if (after->pending.load(std::memory_order_acquire) != 0)
+        {
+            after->waiting.push_back(job);
+            return;
+        }
+    }
+
+    Push(job, worker);
+}
+
+// -------------------------------------------------------------------------------
+
+Job * JobSystem::Take(int worker)
+{
+    // trabalhos próprios, do mais recente (ainda no cache) para o mais antigo
+    if (worker >= 0)
+    {
+        if (Job * job = workers[worker]->deque.Pop())
+        {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // trabalhos publicados por threads externas
+    if (injectedCount.load(std::memory_order_relaxed))
+    {
+        lock_guard<std::mutex> lock(injectMutex);
+        if (!injected.empty())
+        {
+            Job * job = injected.front();
+            injected.pop_front();
+            injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // rouba de uma vítima ao acaso, percorrendo as demais a partir dela
+    uint count = uint(workers.size());
+    uint start = 0;
+    if (worker >= 0)
+    {
+        uint & seed = workers[worker]->seed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        start = seed % count;
+    }
+
+    for (uint i = 0; i < count; ++i)
+    {
+        uint victim = (start + i) % count;
+        if (int(victim) == worker)
+            continue;
+
+        if (Job * job = workers[victim]->deque.Steal())
+        {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            if (worker >= 0)
+                Increment(workers[worker]->steals);
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Execute(Job * job, int worker)
+{
+    uint begin = job->begin;
+    uint end = job->end;
+
+    // divide a faixa ao meio: a metade de cima fica disponível para
+    // roubo e a de baixo continua nesta thread
+    while (end - begin > job->grain)
+    {
+        uint middle = begin + (end - begin) / 2;
+
+        Job * half = Allocate(worker);
+        half->function = job->function;
+        half->data = job->data;
+        half->begin = middle;
+        half->end = end;
+        half->grain = job->grain;
+        half->counter = job->counter;
+
+        job->counter->pending.fetch_add(1, std::memory_order_relaxed);
+        Push(half, worker);
+
+        end = middle;
+    }
+
+    job->function(job->data, begin, end);
+
+    // libera a posição antes de avisar o contador
+    JobCounter * counter = job->counter;
+    if (job->pooled)
+        job->available.store(true, std::memory_order_release);
+    else
+        delete job;
+
+    if (worker >= 0)
+        Increment(workers[worker]->executed);
+
+    Finish(counter, worker);
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Finish(JobCounter * counter, int worker)
+{
+    // sem chegar a zero não há dependências a liberar
+    uint pending = counter->pending.load(std::memory_order_acquire);
+    while (pending > 1)
+    {
+        if (counter->pending.compare_exchange_weak(pending, pending - 1,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+            return;
+    }
+
+    // possivelmente o último: zera com a trava para que nenhuma dependência
+    // seja registrada entre a liberação da lista e a chegada a zero
+    vector<Job*> ready;
+    {
+        lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            ready.swap(counter->waiting);
+    }
+
+    // o contador pode deixar de existir aqui: só os trabalhos são usados
+    for (Job * job : ready)
+        Push(job, worker);
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::WorkerLoop(uint worker)
+{
+    threadSystem = this;
+    threadIndex = worker;
+
+    uint idle = 0;
+
+    while (!quit.load(std::memory_order_relaxed))
+    {
+        if (Job * job = Take(int(worker)))
+        {
+            Execute(job, int(worker));
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < SpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // dorme até um novo trabalho ser publicado
+        sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (queued.load(std::memory_order_seq_cst) <= 0)
+        {
+            unique_lock<std::mutex> lock(sleepMutex);
+            Increment(workers[worker]->sleeps);
+            wake.wait(lock, [this] { return queued.load() > 0 || quit.load(); });
+        }
+        sleeping.fetch_sub(1, std::memory_order_seq_cst);
+        idle = 0;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Submit(JobFunction function, void * data, uint begin, uint end, uint grain,
+                       JobCounter & counter, const JobCounter * after)
+{
+    if (begin >= end)
+        return;
+
+    // conta o trabalho antes de qualquer execução
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+    int worker = Current();
+
+    Job * job = Allocate(worker);
+    job->function = function;
+    job->data = data;
+    job->begin = begin;
+    job->end = end;
+    job->grain = grain ? grain : 1;
+    job->counter = &counter;
+
+    Schedule(job, worker, after);
+}
+
+// -------------------------------------------------------------------------------
+
+void JobSystem::Wait(JobCounter & counter)
+{
+    int worker = Current();
+
+    while (!counter.Done())
+    {
+        if (Job * job = Take(worker))
+            Execute(job, worker);
+        else
+            std::this_thread::yield();
+    }
+
+    // quem zerou o contador pode ainda estar com a trava
+    lock_guard<std::mutex> lock(counter.mutex);
+}
+
+// -------------------------------------------------------------------------------
+
+JobSystemStats JobSystem::Stats() const
+{
+    JobSystemStats stats = {};
+    stats.threads = uint(workers.size());
+
+    for (const Worker * worker : workers)
+    {
+        stats.executed += worker->executed.load(std::memory_order_relaxed);
+        stats.steals += worker->steals.load(std::memory_order_relaxed);
+        stats.overflows += worker->overflows.load(std::memory_order_relaxed);
+        stats.sleeps += worker->sleeps.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+// Medição da escala
+
+// objeto da atualização sintética
+struct SimObject
+{
+    float position[3];                  // posição
+    float velocity[3];                  // velocidade
+    float angle;                        // orientação ao redor de y
+    float spin;                         // velocidade angular
+};
+
+// -------------------------------------------------------------------------------
+
+// atualiza um objeto com custo variável (2 a 9 passos), como objetos
+// de tipos diferentes em uma cena
+static void UpdateObject(SimObject & obj, uint index, float dt)
+{
+    uint steps = 2 + ((index * 2654435761u) >> 29);
+    float h = dt / steps;
+
+    for (uint s = 0; s < steps; ++s)
+    {
+        // mola em direção à origem no referencial girado do objeto
+        float c = cosf(obj.angle);
+        float n = sinf(obj.angle);
+        float fx = -(c * obj.position[0] - n * obj.position[2]);
+        float fz = -(n * obj.position[0] + c * obj.position[2]);
+        float fy = -obj.position[1] - 9.8f * 0.01f;
+
+        obj.velocity[0] += fx * h;
+        obj.velocity[1] += fy * h;
+        obj.velocity[2] += fz * h;
+
+        float drag = 1.0f / (1.0f + 0.1f * h * sqrtf(obj.velocity[0] * obj.velocity[0]
+                   + obj.velocity[1] * obj.velocity[1] + obj.velocity[2] * obj.velocity[2]));
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            obj.velocity[k] *= drag;
+            obj.position[k] += obj.velocity[k] * h;
+        }
+
+        obj.angle += obj.spin * h;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+static vector<SimObject> InitialObjects(uint count)
+{
+    vector<SimObject> objects(count);
+    for (uint i = 0; i < count; ++i)
+    {
+        float t = float(i);
+        objects[i] = { { sinf(t) * 10.0f, cosf(t * 0.5f), cosf(t) * 10.0f },
+                       { 0.0f, 0.0f, 0.0f },
+                       t * 0.01f, 1.0f + (i % 7) * 0.25f };
+    }
+    return objects;
+}
+
+// -------------------------------------------------------------------------------
+
+string JobScalingBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << objects << " objetos x " << frames << " quadros, " << cores << " núcleos; "
+         << "laço simples: " << serialPerSec / 1e6 << " milhões/s";
+
+    for (const JobScalingRow & row : rows)
+    {
+        text << "\n" << row.threads << " threads: " << row.objectsPerSec / 1e6
+             << " milhões/s, " << row.speedup << "x, eficiência "
+             << row.efficiency * 100.0 << "%, " << row.steals << " roubos";
+    }
+
+    if (mismatches)
+        text << "\n" << mismatches << " objetos diferentes do laço simples!";
+
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+JobScalingBenchmark BenchmarkJobScaling(uint objects, uint frames, uint maxThreads)
+{
+    Timer timer;
+
+    const float dt = 1.0f / 60.0f;
+    const uint grain = 256;
+
+    JobScalingBenchmark result = {};
+    result.objects = objects;
+    result.frames = frames;
+    result.cores = std::max(1u, std::thread::hardware_concurrency());
+
+    vector<SimObject> initial = InitialObjects(objects);
+
+    // referência: laço simples na thread atual
+    vector<SimObject> reference = initial;
+    timer.Start();
+    for (uint f = 0; f < frames; ++f)
+        for (uint i = 0; i < objects; ++i)
+            UpdateObject(reference[i], i, dt);
+    result.serialPerSec = double(objects) * frames / timer.Elapsed();
+
+    maxThreads = std::min(std::max(maxThreads, 1u), uint(JobSystem::MaxThreads));
+
+    for (uint threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        JobSystem jobs(threads);
+        vector<SimObject> current = initial;
+
+        auto update = [&](uint begin, uint end)
+        {
+            for (uint i = begin; i < end; ++i)
+                UpdateObject(current[i], i, dt);
+        };
+
+        timer.Start();
+        for (uint f = 0; f < frames; ++f)
+            jobs.ParallelFor(objects, grain, update);
+        double seconds = timer.Elapsed();
+
+        for (uint i = 0; i < objects; ++i)
+            if (memcmp(&current[i], &reference[i], sizeof(SimObject)) != 0)
+                ++result.mismatches;
+
+        JobScalingRow row = {};
+        row.threads = threads;
+        row.objectsPerSec = double(objects) * frames / seconds;
+        row.steals = jobs.Stats().steals;
+        result.rows.push_back(row);
+    }
+
+    for (JobScalingRow & row : result.rows)
+    {
+        row.speedup = row.objectsPerSec / result.rows[0].objectsPerSec;
+        row.efficiency = row.speedup / row.threads;
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+// Teste de grafos de tarefas
+
+// camada do grafo: um grupo de trabalhos com um contador próprio
+struct StressLayer
+{
+    JobSystem * jobs;                   // sistema em teste
+    JobCounter counter;                 // trabalhos da camada
+    StressLayer * after;                // camada que deve terminar antes (ou nula)
+    uint size;                          // trabalhos publicados diretamente
+    uint expected;                      // trabalhos com os aninhados
+    atomic<uint> completed;             // trabalhos concluídos
+    std::unique_ptr<atomic<uint>[]> runs;   // execuções de cada índice
+    atomic<ullong> * errors;            // erros da rodada
+    atomic<ullong> * dependencies;      // dependências verificadas
+
+    StressLayer() : completed(0) {}
+};
+
+// -------------------------------------------------------------------------------
+
+// trabalho aninhado: publicado de dentro de um trabalho da camada
+static void StressNested(void * data, uint begin, uint end)
+{
+    StressLayer & layer = *static_cast<StressLayer*>(data);
+    layer.completed.fetch_add(end - begin, std::memory_order_acq_rel);
+}
+
+// -------------------------------------------------------------------------------
+
+static void StressJob(void * data, uint begin, uint end)
+{
+    StressLayer & layer = *static_cast<StressLayer*>(data);
+
+    for (uint i = begin; i < end; ++i)
+    {
+        // a camada anterior no grafo já deve ter concluído tudo
+        if (layer.after)
+        {
+            layer.dependencies->fetch_add(1, std::memory_order_relaxed);
+            if (layer.after->completed.load(std::memory_order_acquire) != layer.after->expected)
+                layer.errors->fetch_add(1, std::memory_order_relaxed);
+        }
+
+        layer.runs[i].fetch_add(1, std::memory_order_relaxed);
+
+        // trabalhos aninhados no mesmo contador
+        if (i % 3 == 0)
+            layer.jobs->Submit(&StressNested, &layer, 0, 2, 1, layer.counter);
+
+        // espera dentro de um trabalho por um laço paralelo
+        if (i % 5 == 0)
+        {
+            atomic<uint> sum(0);
+            layer.jobs->ParallelFor(64, 4, [&sum](uint b, uint e)
+            {
+                for (uint k = b; k < e; ++k)
+                    sum.fetch_add(k, std::memory_order_relaxed);
+            });
+
+            if (sum.load() != 64 * 63 / 2)
+                layer.errors->fetch_add(1, std::memory_order_relaxed);
+        }
+
+        layer.completed.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+string JobStressReport::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << rounds << " grafos, " << jobs << " trabalhos, " << dependencies
+         << " dependências verificadas em " << seconds * 1000.0 << " ms: "
+         << (Passed() ? "sem erros" : "erros: ");
+    if (!Passed())
+        text << errors;
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+JobStressReport StressJobGraph(uint rounds, uint maxThreads)
+{
+    Timer timer;
+    timer.Start();
+
+    JobStressReport report = {};
+    report.rounds = rounds;
+
+    maxThreads = std::min(std::max(maxThreads, 1u), uint(JobSystem::MaxThreads));
+
+    atomic<ullong> errors(0);
+    atomic<ullong> dependencies(0);
+    uint seed = 12345;
+    auto random = [&seed](uint range)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % range;
+    };
+
+    for (uint r = 0; r < rounds; ++r)
+    {
+        JobSystem jobs(1 + r % maxThreads);
+
+        uint count = 4 + random(12);
+        vector<StressLayer> layers(count);
+
+        for (uint k = 0; k < count; ++k)
+        {
+            StressLayer & layer = layers[k];
+            layer.jobs = &jobs;
+            layer.after = (k > 0 && random(4) != 0) ? &layers[random(k)] : nullptr;
+            layer.size = 1 + random(64);
+            layer.expected = layer.size + 2 * ((layer.size + 2) / 3);
+            layer.runs.reset(new atomic<uint>[layer.size]);
+            for (uint i = 0; i < layer.size; ++i)
+                layer.runs[i].store(0);
+            layer.errors = &errors;
+            layer.dependencies = &dependencies;
+        }
+
+        // as camadas são publicadas em ordem, com grãos variados, cada
+        // uma possivelmente dependendo de uma camada anterior qualquer
+        for (uint k = 0; k < count; ++k)
+        {
+            StressLayer & layer = layers[k];
+            jobs.Submit(&StressJob, &layer, 0, layer.size, 1 + random(8), layer.counter,
+                        layer.after ? &layer.after->counter : nullptr);
+        }
+
+        for (StressLayer & layer : layers)
+            jobs.Wait(layer.counter);
+
+        // cada índice exatamente uma vez e todos os aninhados concluídos
+        for (StressLayer & layer : layers)
+        {
+            if (layer.completed.load() != layer.expected)
+                errors.fetch_add(1);
+
+            for (uint i = 0; i < layer.size; ++i)
+                if (layer.runs[i].load() != 1)
+                    errors.fetch_add(1);
+        }
+
+        report.jobs += jobs.Stats().executed;
+    }
+
+    report.errors = errors.load();
+    report.dependencies = dependencies.load();
+    report.seconds = timer.Elapsed();
+    return report;
+}
+
+// -------------------------------------------------------------------------------
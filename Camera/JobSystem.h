@@ -0,0 +1,280 @@
+/**********************************************************************************
+// JobSystem (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Sistema de trabalhos com roubo de tarefas.
+//
+//              Há uma thread de trabalho por núcleo; a thread que cria o
+//              sistema (a do laço principal) é a de índice 0 e também
+//              executa trabalhos enquanto espera por eles. Cada thread tem
+//              uma fila dupla de Chase-Lev: a dona empilha e desempilha no
+//              fundo sem travas e as demais roubam do topo com uma única
+//              comparação atômica. Threads sem trabalho roubam de vítimas
+//              escolhidas ao acaso e, depois de algumas tentativas, dormem
+//              até que um novo trabalho seja publicado.
+//
+//              Um trabalho processa uma faixa de índices [begin, end). Faixas
+//              maiores que o grão são divididas ao meio ao executar: a metade
+//              de cima vai para a fila (onde pode ser roubada) e a de baixo
+//              continua na mesma thread, o que forma o laço paralelo.
+//
+//              Cada trabalho pertence a um contador, que conta os trabalhos
+//              ainda não concluídos. Um trabalho pode depender de outro
+//              contador: ele só entra nas filas quando esse contador chega a
+//              zero, o que permite montar grafos de tarefas.
+//
+**********************************************************************************/
+
+#ifndef DXUT_JOBSYSTEM_H
+#define DXUT_JOBSYSTEM_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using std::atomic;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// função de um trabalho: processa os índices [begin, end)
+typedef void (*JobFunction)(void * data, uint begin, uint end);
+
+struct Job;
+
+// -------------------------------------------------------------------------------
+
+// trabalhos pendentes de um grupo
+class JobCounter
+{
+    friend class JobSystem;
+
+private:
+    atomic<uint> pending;               // trabalhos não concluídos
+    mutable std::mutex mutex;           // protege a chegada a zero e a lista abaixo
+    mutable vector<Job*> waiting;       // trabalhos que dependem deste contador
+
+public:
+    JobCounter();                       // construtor
+    ~JobCounter();                      // destrutor
+
+    JobCounter(const JobCounter &) = delete;
+    JobCounter & operator=(const JobCounter &) = delete;
+
+    bool Done() const;                  // todos os trabalhos concluídos
+    uint Pending() const;               // trabalhos não concluídos
+};
+
+// -------------------------------------------------------------------------------
+
+// fila dupla de Chase-Lev com capacidade fixa
+class WorkDeque
+{
+public:
+    static const uint Capacity = 4096;  // trabalhos na fila (potência de dois)
+
+private:
+    static const uint Mask = Capacity - 1;
+
+    alignas(64) atomic<llong> top;      // posição de roubo (outras threads)
+    alignas(64) atomic<llong> bottom;   // posição da dona
+    atomic<Job*> items[Capacity];       // trabalhos na fila
+
+public:
+    WorkDeque();                        // construtor
+
+    bool Push(Job * job);               // dona: falso se a fila está cheia
+    Job * Pop();                        // dona: trabalho mais recente (nulo se vazia)
+    Job * Steal();                      // outras threads: mais antigo (nulo se vazia ou disputado)
+    uint Size() const;                  // trabalhos na fila (aproximado)
+};
+
+// -------------------------------------------------------------------------------
+
+// contadores do sistema de trabalhos
+struct JobSystemStats
+{
+    uint   threads;                     // threads de trabalho (com a principal)
+    ullong executed;                    // trabalhos executados
+    ullong steals;                      // trabalhos roubados de outras filas
+    ullong overflows;                   // trabalhos executados direto por fila cheia
+    ullong sleeps;                      // vezes que uma thread dormiu sem trabalho
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class JobSystem
+{
+public:
+    static const uint MaxThreads = 64;  // limite de threads de trabalho
+    static const uint PoolSize = 4096;  // trabalhos reservados por thread
+
+private:
+    struct Worker;
+
+    vector<Worker*> workers;            // estado de cada thread (0 é a principal)
+    vector<std::thread> threads;        // threads além da principal
+
+    std::mutex injectMutex;             // protege a fila abaixo
+    std::deque<Job*> injected;          // trabalhos de threads externas
+    atomic<uint> injectedCount;         // tamanho da fila externa
+
+    atomic<int>  queued;                // trabalhos prontos em todas as filas
+    atomic<uint> sleeping;              // threads dormindo
+    std::mutex sleepMutex;              // protege a espera abaixo
+    std::condition_variable wake;       // acorda threads sem trabalho
+    atomic<bool> quit;                  // encerra as threads
+
+    const JobSystem * previousSystem;   // sistema da thread principal antes deste
+    uint previousIndex;                 // índice da thread principal antes deste
+
+    int  Current() const;               // índice da thread atual (-1 se externa)
+    Job * Allocate(int worker);         // reserva um trabalho
+    void Push(Job * job, int worker);   // publica um trabalho pronto
+    void Schedule(Job * job, int worker, const JobCounter * after);
+    Job * Take(int worker);             // próximo trabalho para a thread
+    void Execute(Job * job, int worker);// executa (e divide) um trabalho
+    void Finish(JobCounter * counter, int worker);
+    void WorkerLoop(uint worker);       // laço das threads de trabalho
+
+    template <class Func>
+    static void Invoke(void * data, uint begin, uint end);
+
+public:
+    JobSystem(uint threads = 0);        // threads = 0 usa todos os núcleos
+    ~JobSystem();                       // espera as threads terminarem
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem & operator=(const JobSystem &) = delete;
+
+    // publica function(data, i, j) sobre [begin, end) em partes de até grain
+    // índices; counter conta o trabalho e after (se houver) deve chegar a zero
+    // antes dele começar (os trabalhos de after já devem ter sido publicados)
+    void Submit(JobFunction function, void * data, uint begin, uint end, uint grain,
+                JobCounter & counter, const JobCounter * after = nullptr);
+
+    // publica func(begin, end) sobre [0, count); func deve existir até o fim
+    template <class Func>
+    void Run(const Func & func, uint count, uint grain,
+             JobCounter & counter, const JobCounter * after = nullptr);
+
+    // executa func(begin, end) sobre [0, count) e espera o fim
+    template <class Func>
+    void ParallelFor(uint count, uint grain, const Func & func);
+
+    // executa trabalhos até o contador chegar a zero
+    void Wait(JobCounter & counter);
+
+    uint Threads() const;               // threads de trabalho (com a principal)
+    JobSystemStats Stats() const;       // contadores acumulados
+};
+
+// -------------------------------------------------------------------------------
+
+// vazão de uma atualização de objetos com um número de threads
+struct JobScalingRow
+{
+    uint   threads;                     // threads de trabalho
+    double objectsPerSec;               // objetos atualizados por segundo
+    double speedup;                     // vazão / vazão com uma thread
+    double efficiency;                  // speedup / threads
+    ullong steals;                      // trabalhos roubados
+};
+
+// medição da escala do laço paralelo de 1 a 64 threads
+struct JobScalingBenchmark
+{
+    uint   objects;                     // objetos atualizados por quadro
+    uint   frames;                      // quadros por medição
+    uint   cores;                       // núcleos do processador
+    double serialPerSec;                // vazão do laço simples, sem trabalhos
+    ullong mismatches;                  // objetos diferentes do laço simples
+    vector<JobScalingRow> rows;         // uma linha por número de threads
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// atualiza objects objetos com custo variável por frames quadros com 1, 2, 4 ... maxThreads threads
+JobScalingBenchmark BenchmarkJobScaling(uint objects = 100000, uint frames = 20, uint maxThreads = 64);
+
+// -------------------------------------------------------------------------------
+
+// resultado do teste de grafos de tarefas sob carga
+struct JobStressReport
+{
+    uint   rounds;                      // grafos executados
+    ullong jobs;                        // trabalhos executados nos grafos
+    ullong dependencies;                // dependências entre contadores verificadas
+    ullong errors;                      // trabalhos que começaram antes da dependência
+                                        // ou que não executaram exatamente uma vez
+    double seconds;                     // duração
+
+    bool Passed() const;                // nenhum erro encontrado
+    string ToString() const;            // resumo em formato texto
+};
+
+// monta rounds grafos aleatórios em camadas, com trabalhos aninhados e esperas
+// dentro de trabalhos, com 1 até maxThreads threads
+JobStressReport StressJobGraph(uint rounds = 200, uint maxThreads = 16);
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// todos os trabalhos concluídos
+inline bool JobCounter::Done() const
+{ return pending.load(std::memory_order_acquire) == 0; }
+
+// trabalhos não concluídos
+inline uint JobCounter::Pending() const
+{ return pending.load(std::memory_order_acquire); }
+
+// threads de trabalho (com a principal)
+inline uint JobSystem::Threads() const
+{ return uint(workers.size()); }
+
+// nenhum erro encontrado
+inline bool JobStressReport::Passed() const
+{ return errors == 0; }
+
+// -------------------------------------------------------------------------------
+
+template <class Func>
+void JobSystem::Invoke(void * data, uint begin, uint end)
+{
+    (*static_cast<const Func*>(data))(begin, end);
+}
+
+// -------------------------------------------------------------------------------
+
+template <class Func>
+void JobSystem::Run(const Func & func, uint count, uint grain,
+                    JobCounter & counter, const JobCounter * after)
+{
+    Submit(&Invoke<Func>, const_cast<Func*>(&func), 0, count, grain, counter, after);
+}
+
+// -------------------------------------------------------------------------------
+
+template <class Func>
+void JobSystem::ParallelFor(uint count, uint grain, const Func & func)
+{
+    JobCounter counter;
+    Run(func, count, grain, counter);
+    Wait(counter);
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,158 @@
+/**********************************************************************************
+// MappedFile (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Mapeia um arquivo em memória somente para leitura
+//
+**********************************************************************************/
+
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>                      // open
+#include <unistd.h>                     // close
+#include <sys/mman.h>                   // mmap, munmap
+#include <sys/stat.h>                   // fstat
+#endif
+
+// -------------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+{
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mapHandle = nullptr;
+#else
+    fileDesc = -1;
+#endif
+    data = nullptr;
+    size = 0;
+    opened = false;
+}
+
+// -------------------------------------------------------------------------------
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+// -------------------------------------------------------------------------------
+
+bool MappedFile::Open(const string & fileName)
+{
+    // descarta mapeamento anterior
+    Close();
+
+#ifdef _WIN32
+    fileHandle = CreateFile(
+        fileName.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+        Close();
+        return false;
+    }
+
+    size = ullong(fileSize.QuadPart);
+
+    // um arquivo vazio não pode ser mapeado, mas é um arquivo válido
+    if (size > 0)
+    {
+        mapHandle = CreateFileMapping(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mapHandle)
+        {
+            Close();
+            return false;
+        }
+
+        data = (const char*) MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+
+        if (!data)
+        {
+            Close();
+            return false;
+        }
+    }
+#else
+    fileDesc = open(fileName.c_str(), O_RDONLY);
+
+    if (fileDesc < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fileDesc, &info) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    size = ullong(info.st_size);
+
+    // um arquivo vazio não pode ser mapeado, mas é um arquivo válido
+    if (size > 0)
+    {
+        void * view = mmap(nullptr, size_t(size), PROT_READ, MAP_PRIVATE, fileDesc, 0);
+
+        if (view == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+
+        // a leitura será sequencial
+        madvise(view, size_t(size), MADV_SEQUENTIAL);
+        data = (const char*) view;
+    }
+#endif
+
+    opened = true;
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (data)
+        UnmapViewOfFile(data);
+
+    if (mapHandle)
+        CloseHandle(mapHandle);
+
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+
+    fileHandle = INVALID_HANDLE_VALUE;
+    mapHandle = nullptr;
+#else
+    if (data)
+        munmap((void*) data, size_t(size));
+
+    if (fileDesc >= 0)
+        close(fileDesc);
+
+    fileDesc = -1;
+#endif
+
+    data = nullptr;
+    size = 0;
+    opened = false;
+}
+
+// -------------------------------------------------------------------------------
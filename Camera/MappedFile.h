@@ -0,0 +1,68 @@
+/**********************************************************************************
+// MappedFile (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Mapeia um arquivo em memória somente para leitura
+//
+**********************************************************************************/
+
+#ifndef DXUT_MAPPEDFILE_H
+#define DXUT_MAPPEDFILE_H
+
+// -------------------------------------------------------------------------------
+
+#ifdef _WIN32
+#include <windows.h>                    // mapeamento de arquivos do Windows
+#endif
+#include "Types.h"                      // tipos específicos do motor
+#include <string>                       // nome do arquivo
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+class MappedFile
+{
+private:
+#ifdef _WIN32
+    HANDLE fileHandle;                  // arquivo aberto
+    HANDLE mapHandle;                   // objeto de mapeamento
+#else
+    int    fileDesc;                    // descritor do arquivo aberto
+#endif
+    const char * data;                  // início do arquivo na memória
+    ullong size;                        // tamanho do arquivo em bytes
+    bool   opened;                      // estado do mapeamento
+
+public:
+    MappedFile();                       // construtor
+    ~MappedFile();                      // destrutor
+
+    bool Open(const string & fileName); // mapeia arquivo na memória
+    void Close();                       // desfaz o mapeamento
+
+    const char * Data() const;          // retorna início do arquivo
+    ullong Size() const;                // retorna tamanho do arquivo
+    bool IsOpen() const;                // verifica se há arquivo mapeado
+};
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// retorna início do arquivo na memória
+inline const char * MappedFile::Data() const
+{ return data; }
+
+// retorna tamanho do arquivo em bytes
+inline ullong MappedFile::Size() const
+{ return size; }
+
+// verifica se há arquivo mapeado
+inline bool MappedFile::IsOpen() const
+{ return opened; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -1,15 +1,17 @@
 /**********************************************************************************
-// Mesh (Cdigo Fonte)
+// Mesh (Código Fonte)
 //
-// Criao:     28 Abr 2016
-// Atualizao: 25 Set 2021
+// Criação:     28 Abr 2016
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Representa uma malha 3D
+// Descrição:   Representa uma malha 3D
 //
 **********************************************************************************/
 
 #include "Mesh.h"
+#include <climits>
+#include <algorithm>
 
 // -------------------------------------------------------------------------------
 
@@ -19,11 +21,9 @@ Mesh::Mesh(string name)
 
     vertexBufferCPU = nullptr;
     vertexBufferGPU = nullptr;
-    vertexBufferUpload = nullptr;
 
     indexBufferCPU = nullptr;
     indexBufferGPU = nullptr;
-    indexBufferUpload = nullptr;
 
     ZeroMemory(&vertexBufferView, sizeof(D3D12_VERTEX_BUFFER_VIEW));
     ZeroMemory(&indexBufferView, sizeof(D3D12_INDEX_BUFFER_VIEW));
@@ -37,11 +37,9 @@ Mesh::Mesh(string name)
 
 Mesh::~Mesh()
 {
-    if (vertexBufferUpload) vertexBufferUpload->Release();
     if (vertexBufferGPU) vertexBufferGPU->Release();
     if (vertexBufferCPU) vertexBufferCPU->Release();
 
-    if (indexBufferUpload) indexBufferUpload->Release();
     if (indexBufferGPU) indexBufferGPU->Release();
     if (indexBufferCPU) indexBufferCPU->Release();
 }
@@ -70,3 +68,142 @@ D3D12_INDEX_BUFFER_VIEW * Mesh::IndexBufferView()
 
 // -------------------------------------------------------------------------------
 
+DXGI_FORMAT SelectIndexFormat(
+    vector<Vertex> & vertices,
+    const vector<uint> & indices,
+    bool split,
+    vector<ushort> & indices16,
+    vector<SubMesh> & subMeshes,
+    vector<MeshLod> & lods)
+{
+    // maior número de vértices endereçáveis com 16 bits
+    const uint MaxVertices16 = 65536;
+
+    uint indexCount = uint(indices.size());
+
+    indices16.clear();
+    subMeshes.clear();
+
+    // malha sem níveis de detalhe
+    if (lods.empty())
+        lods.push_back({ 0, indexCount, 0, 0, 0.0f });
+
+    // malhas pequenas mantêm o buffer menor
+    if (vertices.size() <= MaxVertices16)
+    {
+        indices16.assign(indices.begin(), indices.end());
+        for (MeshLod & lod : lods)
+        {
+            lod.firstSubMesh = uint(subMeshes.size());
+            lod.subMeshCount = 1;
+            subMeshes.push_back({ lod.indexCount, lod.startIndex, 0 });
+        }
+        return DXGI_FORMAT_R16_UINT;
+    }
+
+    // malhas grandes sem divisão usam 32 bits
+    if (!split)
+    {
+        for (MeshLod & lod : lods)
+        {
+            lod.firstSubMesh = uint(subMeshes.size());
+            lod.subMeshCount = 1;
+            subMeshes.push_back({ lod.indexCount, lod.startIndex, 0 });
+        }
+        return DXGI_FORMAT_R32_UINT;
+    }
+
+    // ----------------------------------------------------------------------
+    // Divide os triângulos, na ordem original, em submalhas cujos índices
+    // cabem em uma faixa de 65536 vértices. O início da faixa se torna o
+    // vértice base da submalha e os índices passam a ser relativos a ele.
+    // ----------------------------------------------------------------------
+
+    indices16.reserve(indexCount);
+
+    vector<uint> pending;               // índices da submalha em construção
+    vector<uint> wide;                  // triângulos que não cabem em nenhuma faixa
+    uint low = UINT_MAX;                // menor índice da submalha em construção
+    uint high = 0;                      // maior índice da submalha em construção
+
+    // converte a submalha em construção para 16 bits
+    auto flush = [&]()
+    {
+        if (pending.empty())
+            return;
+
+        subMeshes.push_back({ uint(pending.size()), uint(indices16.size()), int(low) });
+        for (uint index : pending)
+            indices16.push_back(ushort(index - low));
+
+        pending.clear();
+        low = UINT_MAX;
+        high = 0;
+    };
+
+    for (MeshLod & lod : lods)
+    {
+        lod.firstSubMesh = uint(subMeshes.size());
+        wide.clear();
+
+        uint end = lod.startIndex + lod.indexCount;
+
+        for (uint i = lod.startIndex; i + 2 < end; i += 3)
+        {
+            uint a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            uint triLow = std::min(a, std::min(b, c));
+            uint triHigh = std::max(a, std::max(b, c));
+
+            // o triângulo sozinho ultrapassa a faixa de 16 bits
+            if (triHigh - triLow >= MaxVertices16)
+            {
+                wide.push_back(i);
+                continue;
+            }
+
+            // a submalha atual não comporta o triângulo
+            if (std::max(high, triHigh) - std::min(low, triLow) >= MaxVertices16)
+                flush();
+
+            low = std::min(low, triLow);
+            high = std::max(high, triHigh);
+            pending.push_back(a);
+            pending.push_back(b);
+            pending.push_back(c);
+        }
+
+        flush();
+
+        // triângulos largos recebem cópias contíguas dos seus vértices
+        if (!wide.empty())
+        {
+            vertices.reserve(vertices.size() + wide.size() * 3);
+
+            const uint TrianglesPerPart = (MaxVertices16 - 1) / 3;
+
+            for (size_t first = 0; first < wide.size(); first += TrianglesPerPart)
+            {
+                size_t last = std::min(wide.size(), first + TrianglesPerPart);
+                uint baseVertex = uint(vertices.size());
+
+                subMeshes.push_back({ uint(last - first) * 3, uint(indices16.size()), int(baseVertex) });
+
+                for (size_t t = first; t < last; ++t)
+                {
+                    for (uint k = 0; k < 3; ++k)
+                    {
+                        Vertex copy = vertices[indices[wide[t] + k]];
+                        indices16.push_back(ushort(vertices.size() - baseVertex));
+                        vertices.push_back(copy);
+                    }
+                }
+            }
+        }
+
+        lod.subMeshCount = uint(subMeshes.size()) - lod.firstSubMesh;
+    }
+
+    return DXGI_FORMAT_R16_UINT;
+}
+
+// -------------------------------------------------------------------------------
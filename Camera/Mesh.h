@@ -1,11 +1,11 @@
 /**********************************************************************************
-// Mesh (Arquivo de Cabealho)
+// Mesh (Arquivo de Cabeçalho)
 //
-// Criao:     28 Abr 2016
-// Atualizao: 25 Set 2021
+// Criação:     28 Abr 2016
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Representa uma malha 3D
+// Descrição:   Representa uma malha 3D
 //
 **********************************************************************************/
 
@@ -16,8 +16,45 @@
 
 #include <d3d12.h>
 #include "Types.h"
+#include "Vertex.h"
 #include <string>
+#include <vector>
 using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// faixa do index buffer desenhada com uma única chamada
+struct SubMesh
+{
+    uint indexCount;                    // número de índices
+    uint startIndex;                    // posição do primeiro índice
+    int  baseVertex;                    // valor somado a cada índice
+};
+
+// nível de detalhe: faixa de índices e as submalhas que a desenham
+struct MeshLod
+{
+    uint  startIndex;                   // primeiro índice do nível (lista de 32 bits)
+    uint  indexCount;                   // número de índices do nível (lista de 32 bits)
+    uint  firstSubMesh;                 // primeira submalha do nível
+    uint  subMeshCount;                 // número de submalhas do nível
+    float error;                        // erro geométrico nas unidades do objeto
+    uint  firstMeshlet;                 // primeiro agrupamento do nível
+    uint  meshletCount;                 // número de agrupamentos do nível
+};
+
+// agrupamento de triângulos contíguos na lista de índices (meshlet)
+struct Meshlet
+{
+    uint     startIndex;                // primeiro índice (lista de 32 bits)
+    uint     indexCount;                // número de índices
+    uint     vertexCount;               // vértices distintos referenciados
+    float    radius;                    // raio da esfera envolvente
+    XMFLOAT3 center;                    // centro da esfera envolvente
+    float    coneCutoff;                // seno do semiângulo do cone de normais (1 desativa)
+    XMFLOAT3 coneAxis;                  // direção média das normais
+};
 
 // -------------------------------------------------------------------------------
 
@@ -30,10 +67,6 @@ struct Mesh
     ID3DBlob* vertexBufferCPU;
     ID3DBlob* indexBufferCPU;
 
-    // buffers de Upload CPU -> GPU
-    ID3D12Resource* vertexBufferUpload;
-    ID3D12Resource* indexBufferUpload;
-
     // buffers na GPU
     ID3D12Resource* vertexBufferGPU;
     ID3D12Resource* indexBufferGPU;
@@ -42,14 +75,23 @@ struct Mesh
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
     D3D12_INDEX_BUFFER_VIEW indexBufferView;
 
-    // caractersticas do vertex buffer
+    // características do vertex buffer
     uint vertexByteStride;
     uint vertexBufferSize;
 
-    // caractersticas do index buffer
+    // características do index buffer
     DXGI_FORMAT indexFormat;
     uint indexBufferSize;
 
+    // partes da malha (uma para malhas que não foram divididas)
+    vector<SubMesh> subMeshes;
+
+    // níveis de detalhe, do mais detalhado ao mais simples
+    vector<MeshLod> lods;
+
+    // agrupamentos de triângulos de todos os níveis (vazio se não gerados)
+    vector<Meshlet> meshlets;
+
     // construtor e destrutor
     Mesh(string name);
     ~Mesh();
@@ -61,5 +103,23 @@ struct Mesh
 
 // -------------------------------------------------------------------------------
 
+// Escolhe a largura dos índices de uma malha. Malhas com até 65536 vértices
+// usam índices de 16 bits, copiados para indices16. Malhas maiores usam os
+// índices de 32 bits originais ou, se split for verdadeiro, são divididas em
+// submalhas de 16 bits, cada uma com seu deslocamento de vértice base.
+// Cada nível de lods é dividido separadamente e recebe a faixa das suas
+// submalhas. Se lods estiver vazio, um único nível com todos os índices
+// é criado.
+
+DXGI_FORMAT SelectIndexFormat(
+    vector<Vertex> & vertices,
+    const vector<uint> & indices,
+    bool split,
+    vector<ushort> & indices16,
+    vector<SubMesh> & subMeshes,
+    vector<MeshLod> & lods);
+
+// -------------------------------------------------------------------------------
+
 #endif
 
@@ -0,0 +1,429 @@
+/**********************************************************************************
+// MeshCache (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cache binário de malhas prontas para a GPU. O arquivo é
+//              formado por um cabeçalho, a descrição do layout dos
+//              vértices, as submalhas, os níveis de detalhe, os
+//              agrupamentos de triângulos e os blocos de vértices e índices
+//              alinhados para cópia direta. A leitura mapeia o arquivo
+//              em memória e entrega ponteiros para os blocos, sem cópias
+//              intermediárias. O cache é invalidado quando muda a versão
+//              do formato, o conteúdo do arquivo de origem (hash), as
+//              opções de processamento ou o layout dos vértices.
+//
+**********************************************************************************/
+
+#include "MeshCache.h"
+#include "ObjLoader.h"
+#include "Timer.h"
+#include <fstream>
+#include <sstream>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cfloat>
+using std::fstream;
+using std::ofstream;
+using std::stringstream;
+
+#ifndef _WIN32
+#include <sys/stat.h>                   // stat
+#endif
+
+// -------------------------------------------------------------------------------
+
+// arredonda para o próximo múltiplo do alinhamento
+static inline ullong AlignUp(ullong value, ullong alignment)
+{ return (value + alignment - 1) & ~(alignment - 1); }
+
+// -------------------------------------------------------------------------------
+
+MeshCache::MeshCache()
+{
+    header = nullptr;
+    seconds = 0.0;
+    hashed = false;
+    restamp = {};
+    pending = false;
+}
+
+// -------------------------------------------------------------------------------
+
+bool MeshCache::Open(const string & fileName, const string & sourceName, uint flags,
+                     const VertexElement * layout, uint elementCount)
+{
+    Timer timer;
+    timer.Start();
+
+    Close();
+    hashed = false;
+
+    if (!file.Open(fileName) || file.Size() < sizeof(MeshCacheHeader))
+    {
+        file.Close();
+        return false;
+    }
+
+    const MeshCacheHeader * h = (const MeshCacheHeader*) file.Data();
+
+    // cache de outra versão ou com outras opções
+    if (h->magic != Magic || h->version != Version
+        || h->flags != flags || h->elementCount != elementCount)
+    {
+        file.Close();
+        return false;
+    }
+
+    // blocos precisam estar dentro do arquivo
+    ullong size = file.Size();
+    if (h->elementOffset + ullong(h->elementCount) * sizeof(VertexElement) > size
+        || h->subMeshOffset + ullong(h->subMeshCount) * sizeof(SubMesh) > size
+        || h->lodOffset + ullong(h->lodCount) * sizeof(MeshLod) > size
+        || h->meshletOffset + ullong(h->meshletCount) * sizeof(Meshlet) > size
+        || h->vertexOffset + h->vertexSize > size
+        || h->indexOffset + h->indexSize > size)
+    {
+        file.Close();
+        return false;
+    }
+
+    // layout dos vértices precisa ser o mesmo esperado pela aplicação
+    if (memcmp(file.Data() + h->elementOffset, layout, elementCount * sizeof(VertexElement)) != 0)
+    {
+        file.Close();
+        return false;
+    }
+
+    // origem com o tamanho e a data gravados: o conteúdo não precisa ser lido
+    SourceStamp stamp;
+    if (!StampFile(sourceName, stamp) || stamp.size != h->sourceSize)
+    {
+        file.Close();
+        return false;
+    }
+
+    if (stamp.time != h->sourceTime)
+    {
+        // data diferente: só o hash diz se o conteúdo mudou
+        hashed = true;
+        if (HashFile(sourceName) != h->sourceHash)
+        {
+            file.Close();
+            return false;
+        }
+
+        // conteúdo igual: a data nova é gravada no fechamento
+        cacheName = fileName;
+        restamp = stamp;
+        pending = true;
+    }
+
+    header = h;
+    seconds = timer.Elapsed();
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+void MeshCache::Close()
+{
+    file.Close();
+    header = nullptr;
+
+    // grava o tamanho e a data atuais da origem depois de desfazer o
+    // mapeamento, para que as próximas aberturas não calculem o hash
+    if (pending)
+    {
+        fstream io(cacheName, std::ios::in | std::ios::out | std::ios::binary);
+        if (io.is_open())
+        {
+            io.seekp(offsetof(MeshCacheHeader, sourceSize));
+            io.write((const char*) &restamp.size, sizeof(restamp.size));
+            io.write((const char*) &restamp.time, sizeof(restamp.time));
+        }
+        pending = false;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+vector<SubMesh> MeshCache::SubMeshes() const
+{
+    const SubMesh * first = (const SubMesh*) (file.Data() + header->subMeshOffset);
+    return vector<SubMesh>(first, first + header->subMeshCount);
+}
+
+// -------------------------------------------------------------------------------
+
+vector<MeshLod> MeshCache::Lods() const
+{
+    const MeshLod * first = (const MeshLod*) (file.Data() + header->lodOffset);
+    return vector<MeshLod>(first, first + header->lodCount);
+}
+
+// -------------------------------------------------------------------------------
+
+vector<Meshlet> MeshCache::Meshlets() const
+{
+    const Meshlet * first = (const Meshlet*) (file.Data() + header->meshletOffset);
+    return vector<Meshlet>(first, first + header->meshletCount);
+}
+
+// -------------------------------------------------------------------------------
+
+bool MeshCache::Write(const string & fileName, const string & sourceName, uint flags,
+                      const VertexElement * layout, uint elementCount,
+                      const void * vertices, uint vertexCount, uint vertexStride,
+                      const void * indices, uint indexCount, DXGI_FORMAT indexFormat,
+                      const vector<SubMesh> & subMeshes,
+                      const vector<MeshLod> & lods,
+                      const vector<Meshlet> & meshlets,
+                      const float * boundsMin, const float * boundsMax)
+{
+    uint indexStride = (indexFormat == DXGI_FORMAT_R16_UINT) ? sizeof(ushort) : sizeof(uint);
+
+    // identificação da origem: conteúdo, tamanho e data
+    SourceStamp stamp;
+    ullong sourceHash = HashFile(sourceName);
+    if (!sourceHash || !StampFile(sourceName, stamp))
+        return false;
+
+    MeshCacheHeader h = {};
+    h.magic = Magic;
+    h.version = Version;
+    h.sourceHash = sourceHash;
+    h.sourceSize = stamp.size;
+    h.sourceTime = stamp.time;
+    h.flags = flags;
+    h.vertexCount = vertexCount;
+    h.vertexStride = vertexStride;
+    h.indexCount = indexCount;
+    h.indexFormat = uint(indexFormat);
+    h.elementCount = elementCount;
+    h.subMeshCount = uint(subMeshes.size());
+    h.lodCount = uint(lods.size());
+    h.meshletCount = uint(meshlets.size());
+
+    // posição dos blocos no arquivo
+    h.elementOffset = sizeof(MeshCacheHeader);
+    h.subMeshOffset = h.elementOffset + ullong(elementCount) * sizeof(VertexElement);
+    h.lodOffset = h.subMeshOffset + subMeshes.size() * sizeof(SubMesh);
+    h.meshletOffset = h.lodOffset + lods.size() * sizeof(MeshLod);
+    h.vertexOffset = AlignUp(h.meshletOffset + meshlets.size() * sizeof(Meshlet), Alignment);
+    h.vertexSize = ullong(vertexCount) * vertexStride;
+    h.indexOffset = AlignUp(h.vertexOffset + h.vertexSize, Alignment);
+    h.indexSize = ullong(indexCount) * indexStride;
+
+    // caixa envolvente a partir do atributo de posição
+    for (uint i = 0; i < 3; ++i)
+    {
+        h.boundsMin[i] = vertexCount ? FLT_MAX : 0.0f;
+        h.boundsMax[i] = vertexCount ? -FLT_MAX : 0.0f;
+    }
+
+    for (uint e = 0; e < elementCount && !boundsMin; ++e)
+    {
+        if (strcmp(layout[e].semantic, "POSITION") != 0 || layout[e].format != DXGI_FORMAT_R32G32B32_FLOAT)
+            continue;
+
+        const char * pos = (const char*) vertices + layout[e].offset;
+        for (uint v = 0; v < vertexCount; ++v, pos += vertexStride)
+        {
+            float xyz[3];
+            memcpy(xyz, pos, sizeof(xyz));
+
+            for (uint i = 0; i < 3; ++i)
+            {
+                if (xyz[i] < h.boundsMin[i]) h.boundsMin[i] = xyz[i];
+                if (xyz[i] > h.boundsMax[i]) h.boundsMax[i] = xyz[i];
+            }
+        }
+    }
+
+    // caixa envolvente informada por quem gravou vértices compactos
+    if (boundsMin && boundsMax)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            h.boundsMin[i] = boundsMin[i];
+            h.boundsMax[i] = boundsMax[i];
+        }
+    }
+
+    // grava em um arquivo temporário para nunca deixar um cache incompleto
+    string tempName = fileName + ".tmp";
+    {
+        ofstream fout(tempName, std::ios::binary | std::ios::trunc);
+        if (!fout.is_open())
+            return false;
+
+        const char zeros[Alignment] = {};
+
+        fout.write((const char*) &h, sizeof(h));
+        fout.write((const char*) layout, std::streamsize(elementCount) * sizeof(VertexElement));
+        fout.write((const char*) subMeshes.data(), std::streamsize(subMeshes.size() * sizeof(SubMesh)));
+        fout.write((const char*) lods.data(), std::streamsize(lods.size() * sizeof(MeshLod)));
+        fout.write((const char*) meshlets.data(), std::streamsize(meshlets.size() * sizeof(Meshlet)));
+        fout.write(zeros, std::streamsize(h.vertexOffset - (h.meshletOffset + meshlets.size() * sizeof(Meshlet))));
+        fout.write((const char*) vertices, std::streamsize(h.vertexSize));
+        fout.write(zeros, std::streamsize(h.indexOffset - (h.vertexOffset + h.vertexSize)));
+        fout.write((const char*) indices, std::streamsize(h.indexSize));
+
+        if (!fout.good())
+        {
+            fout.close();
+            remove(tempName.c_str());
+            return false;
+        }
+    }
+
+    remove(fileName.c_str());
+    return rename(tempName.c_str(), fileName.c_str()) == 0;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong MeshCache::HashFile(const string & fileName)
+{
+    MappedFile source;
+    if (!source.Open(fileName))
+        return 0;
+
+    const ullong Prime1 = 0x9E3779B185EBCA87ull;
+    const ullong Prime2 = 0xC2B2AE3D27D4EB4Full;
+
+    const char * p = source.Data();
+    ullong size = source.Size();
+    ullong hash = Prime1 ^ (size * Prime2);
+
+    // processa 8 bytes por vez
+    ullong words = size / 8;
+    for (ullong i = 0; i < words; ++i, p += 8)
+    {
+        ullong word;
+        memcpy(&word, p, sizeof(word));
+        hash ^= word * Prime2;
+        hash = ((hash << 31) | (hash >> 33)) * Prime1;
+    }
+
+    // bytes restantes
+    for (ullong i = words * 8; i < size; ++i, ++p)
+    {
+        hash ^= ullong(byte(*p)) * Prime1;
+        hash = ((hash << 11) | (hash >> 53)) * Prime2;
+    }
+
+    // mistura final
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+
+    // zero é reservado para arquivo ilegível
+    return hash ? hash : 1;
+}
+
+// -------------------------------------------------------------------------------
+
+bool MeshCache::StampFile(const string & fileName, SourceStamp & stamp)
+{
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExA(fileName.c_str(), GetFileExInfoStandard, &info))
+        return false;
+
+    stamp.size = (ullong(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    stamp.time = (ullong(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+#else
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0)
+        return false;
+
+    stamp.size = ullong(info.st_size);
+    stamp.time = ullong(info.st_mtim.tv_sec) * 1000000000ull + ullong(info.st_mtim.tv_nsec);
+#endif
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+string MeshCacheBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << vertices << " vértices, .obj " << sourceBytes / 1048576.0 << " MB, cache "
+         << cacheBytes / 1048576.0 << " MB: sem cache " << parseMs + writeMs << " ms (leitura "
+         << parseMs << " ms + gravação " << writeMs << " ms), com cache " << warmMs
+         << " ms (" << (warmMs > 0.0 ? parseMs / warmMs : 0.0) << "x mais rápido que a leitura), "
+         << "data alterada +" << hashMs << " ms de hash"
+         << (identical ? "" : ", CACHE DIFERENTE da malha lida");
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+MeshCacheBenchmark BenchmarkMeshCache(uint vertices, const string & sourceName, const string & cacheName)
+{
+    MeshCacheBenchmark result = {};
+    if (!WriteGridObj(sourceName, vertices))
+        return result;
+
+    // partida sem cache: leitura do texto
+    ObjLoader loader;
+    vector<Vertex> listVertex;
+    vector<uint> listIndex;
+    loader.Load(sourceName, listVertex, listIndex);
+    result.vertices = uint(listVertex.size());
+    result.sourceBytes = loader.Stats().bytes;
+    result.parseMs = loader.Stats().seconds * 1000.0;
+
+    // layout do vértice completo em ponto flutuante
+    VertexElement layout[2] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0 },
+        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 12 } };
+
+    // gravação do cache, com o hash do .obj
+    Timer timer;
+    timer.Start();
+    MeshCache::Write(cacheName, sourceName, 0, layout, 2,
+        listVertex.data(), uint(listVertex.size()), sizeof(Vertex),
+        listIndex.data(), uint(listIndex.size()), DXGI_FORMAT_R32_UINT,
+        {}, {}, {});
+    result.writeMs = timer.Elapsed() * 1000.0;
+
+    // custo que uma data alterada acrescenta à abertura
+    timer.Start();
+    MeshCache::HashFile(sourceName);
+    result.hashMs = timer.Elapsed() * 1000.0;
+
+    // partida com cache: abertura e cópia dos blocos, como em Graphics::Copy
+    timer.Start();
+    MeshCache cache;
+    if (cache.Open(cacheName, sourceName, 0, layout, 2))
+    {
+        const MeshCacheHeader & header = cache.Header();
+        const byte * vertexBlock = (const byte*) cache.Vertices();
+        const byte * indexBlock = (const byte*) cache.Indices();
+        vector<byte> vertexCopy(vertexBlock, vertexBlock + header.vertexSize);
+        vector<byte> indexCopy(indexBlock, indexBlock + header.indexSize);
+        result.warmMs = timer.Elapsed() * 1000.0;
+        result.cacheBytes = header.indexOffset + header.indexSize;
+
+        result.identical = !cache.Hashed()
+            && vertexCopy.size() == listVertex.size() * sizeof(Vertex)
+            && indexCopy.size() == listIndex.size() * sizeof(uint)
+            && memcmp(vertexCopy.data(), listVertex.data(), vertexCopy.size()) == 0
+            && memcmp(indexCopy.data(), listIndex.data(), indexCopy.size()) == 0;
+        cache.Close();
+    }
+
+    remove(cacheName.c_str());
+    remove(sourceName.c_str());
+    return result;
+}
+
+// -------------------------------------------------------------------------------
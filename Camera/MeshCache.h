@@ -0,0 +1,194 @@
+/**********************************************************************************
+// MeshCache (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cache binário de malhas prontas para a GPU. O arquivo é
+//              formado por um cabeçalho, a descrição do layout dos
+//              vértices, as submalhas, os níveis de detalhe, os
+//              agrupamentos de triângulos e os blocos de vértices e índices
+//              alinhados para cópia direta. A leitura mapeia o arquivo
+//              em memória e entrega ponteiros para os blocos, sem cópias
+//              intermediárias. O cache é invalidado quando muda a versão
+//              do formato, o conteúdo do arquivo de origem (hash), as
+//              opções de processamento ou o layout dos vértices.
+//
+//              Para não ler a origem inteira a cada execução, o cache
+//              também guarda o tamanho e a data de modificação dela. O
+//              hash só é calculado quando esses valores não conferem; se
+//              o conteúdo não mudou, o cache recebe o tamanho e a data
+//              novos ao ser fechado.
+//
+**********************************************************************************/
+
+#ifndef DXUT_MESHCACHE_H
+#define DXUT_MESHCACHE_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "MappedFile.h"                 // arquivo mapeado em memória
+#include "Mesh.h"                       // submalhas e formato dos índices
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// descrição de um atributo de vértice gravada no cache
+struct VertexElement
+{
+    char semantic[16];                  // nome da semântica (POSITION, COLOR, ...)
+    uint semanticIndex;                 // índice da semântica
+    uint format;                        // formato DXGI do atributo
+    uint offset;                        // deslocamento dentro do vértice
+};
+
+// cabeçalho do arquivo de cache
+struct MeshCacheHeader
+{
+    uint   magic;                       // identificador do formato
+    uint   version;                     // versão do formato
+    ullong sourceHash;                  // hash do conteúdo do arquivo de origem
+    ullong sourceSize;                  // tamanho do arquivo de origem
+    ullong sourceTime;                  // data de modificação do arquivo de origem
+    uint   flags;                       // opções usadas no processamento
+    uint   vertexCount;                 // número de vértices
+    uint   vertexStride;                // tamanho de cada vértice
+    uint   indexCount;                  // número de índices
+    uint   indexFormat;                 // formato DXGI dos índices
+    uint   elementCount;                // número de atributos do vértice
+    uint   subMeshCount;                // número de submalhas
+    uint   lodCount;                    // número de níveis de detalhe
+    uint   meshletCount;                // número de agrupamentos de triângulos
+    float  boundsMin[4];                // canto mínimo da caixa envolvente
+    float  boundsMax[4];                // canto máximo da caixa envolvente
+    ullong elementOffset;               // posição dos atributos no arquivo
+    ullong subMeshOffset;               // posição das submalhas no arquivo
+    ullong vertexOffset;                // posição dos vértices no arquivo
+    ullong vertexSize;                  // tamanho do bloco de vértices
+    ullong indexOffset;                 // posição dos índices no arquivo
+    ullong indexSize;                   // tamanho do bloco de índices
+    ullong lodOffset;                   // posição dos níveis de detalhe no arquivo
+    ullong meshletOffset;               // posição dos agrupamentos no arquivo
+};
+
+// identificação rápida de um arquivo: tamanho e data de modificação
+struct SourceStamp
+{
+    ullong size;                        // tamanho em bytes
+    ullong time;                        // data de modificação (unidades do sistema)
+};
+
+// tempos de carga de uma malha com e sem cache
+struct MeshCacheBenchmark
+{
+    uint   vertices;                    // vértices da malha
+    ullong sourceBytes;                 // tamanho do .obj
+    ullong cacheBytes;                  // tamanho do cache
+    double parseMs;                     // leitura do .obj (partida sem cache)
+    double writeMs;                     // gravação do cache (hash incluído)
+    double hashMs;                      // hash do .obj (partida com data alterada)
+    double warmMs;                      // abertura do cache e cópia dos blocos
+    bool   identical;                   // blocos do cache iguais à malha lida
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class MeshCache
+{
+private:
+    MappedFile file;                    // arquivo de cache mapeado
+    const MeshCacheHeader * header;     // cabeçalho dentro do mapeamento
+    double seconds;                     // tempo da última abertura
+    bool hashed;                        // a abertura precisou calcular o hash da origem
+    string cacheName;                   // arquivo de cache aberto
+    SourceStamp restamp;                // tamanho e data gravados no cache ao fechar
+    bool pending;                       // há tamanho e data novos para gravar
+
+public:
+    static const uint Magic = 0x4348534D;       // "MSHC"
+    static const uint Version = 4;              // versão atual do formato
+    static const uint Alignment = 256;          // alinhamento dos blocos
+
+    MeshCache();                        // construtor
+
+    // mapeia o cache e valida versão, origem, opções e layout dos vértices
+    // (o hash de sourceName só é calculado se o tamanho ou a data mudaram)
+    bool Open(const string & fileName, const string & sourceName, uint flags,
+              const VertexElement * layout, uint elementCount);
+    void Close();                       // desfaz o mapeamento
+
+    // grava um novo arquivo de cache para a origem sourceName; sem caixa
+    // envolvente informada, ela é calculada a partir de um atributo
+    // POSITION em ponto flutuante
+    static bool Write(const string & fileName, const string & sourceName, uint flags,
+                      const VertexElement * layout, uint elementCount,
+                      const void * vertices, uint vertexCount, uint vertexStride,
+                      const void * indices, uint indexCount, DXGI_FORMAT indexFormat,
+                      const vector<SubMesh> & subMeshes,
+                      const vector<MeshLod> & lods,
+                      const vector<Meshlet> & meshlets,
+                      const float * boundsMin = nullptr, const float * boundsMax = nullptr);
+
+    // hash de 64 bits do conteúdo de um arquivo (0 se não puder ser lido)
+    static ullong HashFile(const string & fileName);
+
+    // tamanho e data de modificação de um arquivo
+    static bool StampFile(const string & fileName, SourceStamp & stamp);
+
+    bool IsOpen() const;                // há cache válido mapeado
+    double Seconds() const;             // tempo da última abertura
+    bool Hashed() const;                // a abertura calculou o hash da origem
+
+    const void * Vertices() const;      // início do bloco de vértices
+    const void * Indices() const;       // início do bloco de índices
+    const MeshCacheHeader & Header() const;     // cabeçalho do cache
+    vector<SubMesh> SubMeshes() const;  // cópia das submalhas
+    vector<MeshLod> Lods() const;       // cópia dos níveis de detalhe
+    vector<Meshlet> Meshlets() const;   // cópia dos agrupamentos de triângulos
+};
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// verifica se há um cache válido mapeado
+inline bool MeshCache::IsOpen() const
+{ return header != nullptr; }
+
+// retorna o tempo da última abertura em segundos
+inline double MeshCache::Seconds() const
+{ return seconds; }
+
+// verifica se a última abertura calculou o hash da origem
+inline bool MeshCache::Hashed() const
+{ return hashed; }
+
+// retorna o início do bloco de vértices
+inline const void * MeshCache::Vertices() const
+{ return file.Data() + header->vertexOffset; }
+
+// retorna o início do bloco de índices
+inline const void * MeshCache::Indices() const
+{ return file.Data() + header->indexOffset; }
+
+// retorna o cabeçalho do cache
+inline const MeshCacheHeader & MeshCache::Header() const
+{ return *header; }
+
+// -------------------------------------------------------------------------------
+
+// gera um .obj com cerca de "vertices" vértices e mede a partida sem cache
+// (leitura do texto e gravação do cache) e com cache (abertura e cópia)
+MeshCacheBenchmark BenchmarkMeshCache(uint vertices = 1000000,
+                                      const string & sourceName = "cachebench.obj",
+                                      const string & cacheName = "cachebench.mesh");
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,533 @@
+/**********************************************************************************
+// MeshOptimizer (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Otimizações de malhas executadas antes do envio para a GPU.
+//
+//              A ordenação para o cache de vértices pós-transformação usa
+//              o algoritmo Tipsify (Sander, Nehab e Barczak, 2007), de
+//              tempo linear. Um simulador de cache FIFO mede a ACMR (falhas
+//              por triângulo) e a ATVR (transformações por vértice) para
+//              comparar a ordem dos índices antes e depois da otimização.
+//
+//              A ordenação para overdraw divide a sequência otimizada em
+//              agrupamentos de triângulos e desenha primeiro os que estão
+//              voltados para fora da malha. Um limiar controla quanto da
+//              eficiência do cache pode ser sacrificado. Um rasterizador
+//              simples em software estima o overdraw vendo a malha ao
+//              longo dos três eixos. Por último, os vértices são
+//              renumerados na ordem do primeiro uso para localidade de
+//              leitura da memória.
+//
+**********************************************************************************/
+
+#include "MeshOptimizer.h"
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+using std::vector;
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+// Adjacência vértice -> triângulos
+
+struct Adjacency
+{
+    vector<uint> counts;                // triângulos ainda não emitidos por vértice
+    vector<uint> offsets;               // início da lista de cada vértice
+    vector<uint> triangles;             // listas de triângulos concatenadas
+};
+
+static void BuildAdjacency(const uint * indices, uint indexCount, uint vertexCount, Adjacency & adj)
+{
+    adj.counts.assign(vertexCount, 0);
+    adj.offsets.assign(size_t(vertexCount) + 1, 0);
+    adj.triangles.resize(indexCount);
+
+    for (uint i = 0; i < indexCount; ++i)
+        ++adj.counts[indices[i]];
+
+    // soma prefixada define o início de cada lista
+    for (uint v = 0; v < vertexCount; ++v)
+        adj.offsets[v + 1] = adj.offsets[v] + adj.counts[v];
+
+    vector<uint> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+    for (uint i = 0; i < indexCount; ++i)
+        adj.triangles[fill[indices[i]]++] = i / 3;
+}
+
+// -------------------------------------------------------------------------------
+// Simulação do cache
+
+string VertexCacheStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << "ACMR " << acmr << ", ATVR " << atvr
+         << " (" << misses << " transformações, "
+         << triangles << " triângulos)";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+VertexCacheStats SimulateVertexCache(const uint * indices, uint indexCount, uint vertexCount, uint cacheSize)
+{
+    VertexCacheStats stats = {};
+
+    // momento em que cada vértice entrou no cache (FIFO)
+    vector<uint> timestamps(vertexCount, 0);
+    vector<bool> referenced(vertexCount, false);
+    uint time = cacheSize + 1;
+
+    for (uint i = 0; i < indexCount; ++i)
+    {
+        uint v = indices[i];
+
+        if (!referenced[v])
+        {
+            referenced[v] = true;
+            ++stats.vertices;
+        }
+
+        // o vértice já saiu do cache
+        if (time - timestamps[v] > cacheSize)
+        {
+            timestamps[v] = time++;
+            ++stats.misses;
+        }
+    }
+
+    stats.triangles = indexCount / 3;
+    stats.acmr = stats.triangles ? double(stats.misses) / stats.triangles : 0.0;
+    stats.atvr = stats.vertices ? double(stats.misses) / stats.vertices : 0.0;
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+// Tipsify
+
+void OptimizeVertexCache(uint * indices, uint indexCount, uint vertexCount, uint cacheSize)
+{
+    const uint None = 0xFFFFFFFF;
+    uint triangleCount = indexCount / 3;
+
+    if (triangleCount == 0 || vertexCount == 0)
+        return;
+
+    Adjacency adj;
+    BuildAdjacency(indices, triangleCount * 3, vertexCount, adj);
+    vector<uint> & live = adj.counts;
+
+    vector<uint> cacheTime(vertexCount, 0);         // momento em que entrou no cache
+    vector<bool> emitted(triangleCount, false);     // triângulo já emitido
+    vector<uint> deadEnd;                           // vértices recentes para retomada
+    vector<uint> candidates;                        // vértices do leque atual
+    vector<uint> output(indexCount);                // nova ordem dos índices
+
+    deadEnd.reserve(indexCount);
+    candidates.reserve(64);
+
+    uint time = cacheSize + 1;          // relógio do cache simulado
+    uint cursor = 0;                    // varredura sequencial de vértices
+    uint written = 0;                   // índices emitidos
+    uint fan = indices[0];              // vértice em torno do qual se emite o leque
+
+    while (fan != None)
+    {
+        candidates.clear();
+
+        // emite todos os triângulos ainda pendentes em torno do vértice
+        for (uint k = adj.offsets[fan]; k < adj.offsets[fan + 1]; ++k)
+        {
+            uint t = adj.triangles[k];
+            if (emitted[t])
+                continue;
+
+            emitted[t] = true;
+
+            for (uint c = 0; c < 3; ++c)
+            {
+                uint v = indices[3 * t + c];
+                output[written++] = v;
+
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+
+                if (time - cacheTime[v] > cacheSize)
+                    cacheTime[v] = time++;
+            }
+        }
+
+        // próximo leque: vértice ainda no cache com maior prioridade
+        uint next = None;
+        uint best = 0;
+
+        for (uint v : candidates)
+        {
+            if (live[v] == 0)
+                continue;
+
+            // vértices que continuarão no cache depois do leque são preferidos
+            uint priority = 1;
+            if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                priority = time - cacheTime[v] + 1;
+
+            if (priority > best)
+            {
+                best = priority;
+                next = v;
+            }
+        }
+
+        // beco sem saída: retoma pelos vértices recentes ou pela varredura
+        if (next == None)
+        {
+            while (!deadEnd.empty() && next == None)
+            {
+                uint v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0)
+                    next = v;
+            }
+
+            while (next == None && cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                    next = cursor;
+                else
+                    ++cursor;
+            }
+        }
+
+        fan = next;
+    }
+
+    memcpy(indices, output.data(), size_t(written) * sizeof(uint));
+}
+
+// -------------------------------------------------------------------------------
+// Overdraw
+
+string OverdrawStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << "overdraw " << overdraw
+         << " (" << shaded << " pixels sombreados, "
+         << covered << " cobertos)";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+// posição de um vértice dentro do vetor de vértices
+static inline const float * Position(const float * positions, uint stride, uint v)
+{ return (const float*) ((const char*) positions + size_t(v) * stride); }
+
+// -------------------------------------------------------------------------------
+
+// cache FIFO simulado; avançar o relógio além do tamanho o esvazia
+struct FifoCache
+{
+    vector<uint> timestamps;
+    uint time;
+    uint size;
+
+    FifoCache(uint vertexCount, uint cacheSize)
+        : timestamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+    void Clear() { time += size + 1; }
+
+    uint Triangle(const uint * tri)
+    {
+        uint misses = 0;
+        for (uint c = 0; c < 3; ++c)
+        {
+            if (time - timestamps[tri[c]] > size)
+            {
+                timestamps[tri[c]] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+void OptimizeOverdraw(uint * indices, uint indexCount,
+                      const float * positions, uint positionStride, uint vertexCount,
+                      float threshold, uint cacheSize)
+{
+    uint triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+        return;
+
+    FifoCache cache(vertexCount, cacheSize);
+
+    // agrupamentos rígidos: o cache recomeça do zero (as 3 arestas falham)
+    vector<uint> hard;
+    for (uint t = 0; t < triangleCount; ++t)
+        if (cache.Triangle(indices + 3 * t) == 3 || t == 0)
+            hard.push_back(t);
+    hard.push_back(triangleCount);
+
+    // agrupamentos flexíveis: divide quando a ACMR acumulada já está
+    // dentro do limiar da ACMR do agrupamento rígido inteiro
+    vector<uint> clusters;
+    for (size_t h = 0; h + 1 < hard.size(); ++h)
+    {
+        uint start = hard[h];
+        uint end = hard[h + 1];
+
+        cache.Clear();
+        uint misses = 0;
+        for (uint t = start; t < end; ++t)
+            misses += cache.Triangle(indices + 3 * t);
+
+        double limit = threshold * double(misses) / (end - start);
+
+        cache.Clear();
+        clusters.push_back(start);
+        uint clusterMisses = 0;
+        uint clusterSize = 0;
+
+        for (uint t = start; t + 1 < end; ++t)
+        {
+            clusterMisses += cache.Triangle(indices + 3 * t);
+            ++clusterSize;
+
+            if (double(clusterMisses) / clusterSize <= limit)
+            {
+                clusters.push_back(t + 1);
+                cache.Clear();
+                clusterMisses = 0;
+                clusterSize = 0;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    uint clusterCount = uint(clusters.size() - 1);
+
+    // centróide e normal média (ponderados pela área) de cada agrupamento
+    vector<float> centroids(size_t(clusterCount) * 3, 0.0f);
+    vector<float> normals(size_t(clusterCount) * 3, 0.0f);
+    double meshCenter[3] = { 0.0, 0.0, 0.0 };
+    double meshArea = 0.0;
+
+    for (uint c = 0; c < clusterCount; ++c)
+    {
+        double center[3] = { 0.0, 0.0, 0.0 };
+        double normal[3] = { 0.0, 0.0, 0.0 };
+        double area = 0.0;
+
+        for (uint t = clusters[c]; t < clusters[c + 1]; ++t)
+        {
+            const float * a = Position(positions, positionStride, indices[3 * t]);
+            const float * b = Position(positions, positionStride, indices[3 * t + 1]);
+            const float * d = Position(positions, positionStride, indices[3 * t + 2]);
+
+            double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            double e2[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+            double n[3] = {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0] };
+
+            double w = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+            for (uint i = 0; i < 3; ++i)
+            {
+                center[i] += w * (a[i] + b[i] + d[i]) / 3.0;
+                normal[i] += n[i];
+            }
+            area += w;
+        }
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            meshCenter[i] += center[i];
+            centroids[3 * c + i] = area > 0.0 ? float(center[i] / area) : 0.0f;
+        }
+        meshArea += area;
+
+        double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (uint i = 0; i < 3; ++i)
+            normals[3 * c + i] = length > 0.0 ? float(normal[i] / length) : 0.0f;
+    }
+
+    for (uint i = 0; i < 3; ++i)
+        meshCenter[i] = meshArea > 0.0 ? meshCenter[i] / meshArea : 0.0;
+
+    // agrupamentos mais afastados do centro e voltados para fora vêm primeiro
+    vector<float> keys(clusterCount);
+    for (uint c = 0; c < clusterCount; ++c)
+    {
+        keys[c] = 0.0f;
+        for (uint i = 0; i < 3; ++i)
+            keys[c] += float((centroids[3 * c + i] - meshCenter[i]) * normals[3 * c + i]);
+    }
+
+    vector<uint> order(clusterCount);
+    for (uint c = 0; c < clusterCount; ++c)
+        order[c] = c;
+
+    std::stable_sort(order.begin(), order.end(),
+        [&keys](uint a, uint b) { return keys[a] > keys[b]; });
+
+    vector<uint> output(size_t(triangleCount) * 3);
+    uint written = 0;
+
+    for (uint c : order)
+    {
+        uint first = 3 * clusters[c];
+        uint count = 3 * (clusters[c + 1] - clusters[c]);
+        memcpy(output.data() + written, indices + first, size_t(count) * sizeof(uint));
+        written += count;
+    }
+
+    memcpy(indices, output.data(), size_t(written) * sizeof(uint));
+}
+
+// -------------------------------------------------------------------------------
+
+OverdrawStats EstimateOverdraw(const uint * indices, uint indexCount,
+                               const float * positions, uint positionStride, uint vertexCount,
+                               uint resolution)
+{
+    OverdrawStats stats = {};
+    uint triangleCount = indexCount / 3;
+
+    if (triangleCount == 0 || vertexCount == 0 || resolution == 0)
+        return stats;
+
+    // caixa envolvente para mapear a malha na grade de pixels
+    float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (uint v = 0; v < vertexCount; ++v)
+    {
+        const float * p = Position(positions, positionStride, v);
+        for (uint i = 0; i < 3; ++i)
+        {
+            minimum[i] = std::min(minimum[i], p[i]);
+            maximum[i] = std::max(maximum[i], p[i]);
+        }
+    }
+
+    float extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+    float scale = extent > 0.0f ? (resolution - 1) / extent : 0.0f;
+
+    vector<float> depth(size_t(resolution) * resolution);
+
+    // cada eixo é visto pelos dois lados com eliminação de faces traseiras
+    for (uint axis = 0; axis < 3; ++axis)
+    {
+        // (u, v, eixo) formam um sistema de mão direita
+        uint u = (axis + 1) % 3;
+        uint w = (axis + 2) % 3;
+
+        for (int side = -1; side <= 1; side += 2)
+        {
+            std::fill(depth.begin(), depth.end(), FLT_MAX);
+
+            for (uint t = 0; t < triangleCount; ++t)
+            {
+                float x[3], y[3], z[3];
+                for (uint c = 0; c < 3; ++c)
+                {
+                    const float * p = Position(positions, positionStride, indices[3 * t + c]);
+                    x[c] = (p[u] - minimum[u]) * scale;
+                    y[c] = (p[w] - minimum[w]) * scale;
+                    z[c] = side * (p[axis] - minimum[axis]) * scale;
+                }
+
+                // a câmera olha de -side ao longo do eixo
+                float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+                if (area * side >= 0.0f)
+                    continue;
+
+                int x0 = std::max(int(std::min(x[0], std::min(x[1], x[2]))), 0);
+                int y0 = std::max(int(std::min(y[0], std::min(y[1], y[2]))), 0);
+                int x1 = std::min(int(std::max(x[0], std::max(x[1], x[2]))), int(resolution) - 1);
+                int y1 = std::min(int(std::max(y[0], std::max(y[1], y[2]))), int(resolution) - 1);
+
+                float inverse = 1.0f / area;
+
+                for (int py = y0; py <= y1; ++py)
+                {
+                    for (int px = x0; px <= x1; ++px)
+                    {
+                        float sx = px + 0.5f;
+                        float sy = py + 0.5f;
+
+                        // coordenadas baricêntricas pelo centro do pixel
+                        float b0 = ((x[1] - sx) * (y[2] - sy) - (x[2] - sx) * (y[1] - sy)) * inverse;
+                        float b1 = ((x[2] - sx) * (y[0] - sy) - (x[0] - sx) * (y[2] - sy)) * inverse;
+                        float b2 = 1.0f - b0 - b1;
+
+                        if (b0 < 0.0f || b1 < 0.0f || b2 < 0.0f)
+                            continue;
+
+                        float d = b0 * z[0] + b1 * z[1] + b2 * z[2];
+                        float & stored = depth[size_t(py) * resolution + px];
+
+                        if (d < stored)
+                        {
+                            if (stored == FLT_MAX)
+                                ++stats.covered;
+                            stored = d;
+                            ++stats.shaded;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    stats.overdraw = stats.covered ? double(stats.shaded) / stats.covered : 0.0;
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+// Leitura dos vértices
+
+uint OptimizeVertexFetch(void * vertices, uint vertexCount, uint vertexStride,
+                         uint * indices, uint indexCount)
+{
+    const uint None = 0xFFFFFFFF;
+
+    // nova posição de cada vértice na ordem do primeiro uso
+    vector<uint> remap(vertexCount, None);
+    uint next = 0;
+
+    for (uint i = 0; i < indexCount; ++i)
+    {
+        uint & target = remap[indices[i]];
+        if (target == None)
+            target = next++;
+        indices[i] = target;
+    }
+
+    vector<byte> source((byte*) vertices, (byte*) vertices + size_t(vertexCount) * vertexStride);
+    byte * dest = (byte*) vertices;
+
+    for (uint v = 0; v < vertexCount; ++v)
+        if (remap[v] != None)
+            memcpy(dest + size_t(remap[v]) * vertexStride, source.data() + size_t(v) * vertexStride, vertexStride);
+
+    return next;
+}
+
+// -------------------------------------------------------------------------------
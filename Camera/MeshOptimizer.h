@@ -0,0 +1,99 @@
+/**********************************************************************************
+// MeshOptimizer (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Otimizações de malhas executadas antes do envio para a GPU.
+//
+//              A ordenação para o cache de vértices pós-transformação usa
+//              o algoritmo Tipsify (Sander, Nehab e Barczak, 2007), de
+//              tempo linear. Um simulador de cache FIFO mede a ACMR (falhas
+//              por triângulo) e a ATVR (transformações por vértice) para
+//              comparar a ordem dos índices antes e depois da otimização.
+//
+//              A ordenação para overdraw divide a sequência otimizada em
+//              agrupamentos de triângulos e desenha primeiro os que estão
+//              voltados para fora da malha. Um limiar controla quanto da
+//              eficiência do cache pode ser sacrificado. Um rasterizador
+//              simples em software estima o overdraw vendo a malha ao
+//              longo dos três eixos. Por último, os vértices são
+//              renumerados na ordem do primeiro uso para localidade de
+//              leitura da memória.
+//
+**********************************************************************************/
+
+#ifndef DXUT_MESHOPTIMIZER_H
+#define DXUT_MESHOPTIMIZER_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include <string>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+// resultado da simulação do cache de vértices
+struct VertexCacheStats
+{
+    uint   triangles;                   // triângulos simulados
+    uint   vertices;                    // vértices distintos referenciados
+    uint   misses;                      // transformações de vértices
+    double acmr;                        // falhas por triângulo (0.5 a 3.0)
+    double atvr;                        // transformações por vértice (1.0 é ótimo)
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// resultado da estimativa de overdraw
+struct OverdrawStats
+{
+    ullong covered;                     // pixels cobertos pela malha
+    ullong shaded;                      // pixels sombreados (passaram no teste de profundidade)
+    double overdraw;                    // sombreados por coberto (1.0 é ótimo)
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// tamanho de cache usado por padrão (FIFO típico do hardware)
+const uint VertexCacheSize = 16;
+
+// simula um cache FIFO de vértices pós-transformação
+VertexCacheStats SimulateVertexCache(
+    const uint * indices, uint indexCount, uint vertexCount,
+    uint cacheSize = VertexCacheSize);
+
+// reordena triângulos para reaproveitar o cache de vértices (Tipsify)
+void OptimizeVertexCache(
+    uint * indices, uint indexCount, uint vertexCount,
+    uint cacheSize = VertexCacheSize);
+
+// limiar padrão: aceita até 5% a mais de falhas no cache de vértices
+const float OverdrawThreshold = 1.05f;
+
+// reordena agrupamentos de triângulos para reduzir o overdraw
+// (os índices devem vir da otimização para o cache de vértices)
+void OptimizeOverdraw(
+    uint * indices, uint indexCount,
+    const float * positions, uint positionStride, uint vertexCount,
+    float threshold = OverdrawThreshold, uint cacheSize = VertexCacheSize);
+
+// estima o overdraw rasterizando a malha vista ao longo dos três eixos
+OverdrawStats EstimateOverdraw(
+    const uint * indices, uint indexCount,
+    const float * positions, uint positionStride, uint vertexCount,
+    uint resolution = 256);
+
+// renumera os vértices na ordem do primeiro uso pelos índices,
+// descarta os não referenciados e retorna o novo número de vértices
+uint OptimizeVertexFetch(
+    void * vertices, uint vertexCount, uint vertexStride,
+    uint * indices, uint indexCount);
+
+// -------------------------------------------------------------------------------
+
+#endif
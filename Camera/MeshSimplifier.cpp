@@ -0,0 +1,607 @@
+/**********************************************************************************
+// MeshSimplifier (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Gera uma cadeia de níveis de detalhe (LOD) por simplificação
+//              com métricas de erro quádricas (Garland e Heckbert, 1997).
+//              Cada colapso move um vértice sobre um vizinho já existente,
+//              de modo que todos os níveis compartilham o mesmo vertex
+//              buffer e diferem apenas nos índices. Vértices de borda e de
+//              costura (mesma posição em vértices distintos) ficam fixos.
+//              As arestas candidatas ficam em um heap compacto com
+//              remoção preguiçosa: o custo é recalculado quando a aresta
+//              sai do heap e ela volta se tiver ficado mais cara.
+//
+**********************************************************************************/
+
+#include "MeshSimplifier.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+string SimplifyStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << levels << " níveis em " << seconds * 1000.0 << " ms ("
+         << collapses << " colapsos, " << rejected << " recusados, "
+         << locked << " vértices fixos)";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+// Quádricas
+
+// soma ponderada dos quadrados das distâncias a um conjunto de planos
+struct Quadric
+{
+    double a00, a01, a02, a11, a12, a22;    // matriz simétrica n * nT
+    double b0, b1, b2;                      // vetor d * n
+    double c;                               // constante d * d
+    double w;                               // peso total (área)
+
+    void Add(const Quadric & q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02;
+        a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c; w += q.w;
+    }
+
+    // distância quadrática média até os planos
+    double Error(const float * p) const
+    {
+        double x = p[0], y = p[1], z = p[2];
+        double r = a00 * x * x + a11 * y * y + a22 * z * z
+                 + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                 + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        r = r > 0.0 ? r : 0.0;
+        return w > 0.0 ? r / w : r;
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+// aresta candidata ao colapso: from se move para a posição de to
+struct HeapEdge
+{
+    float cost;
+    uint  from;
+    uint  to;
+};
+
+// -------------------------------------------------------------------------------
+// Heap de mínimo com 4 filhos por nó: metade da altura de um heap binário e
+// os irmãos ocupam a mesma linha de cache, o que reduz as falhas de cache
+// em heaps com milhões de arestas
+
+static void HeapUp(vector<HeapEdge> & heap, size_t i)
+{
+    HeapEdge e = heap[i];
+    while (i > 0)
+    {
+        size_t parent = (i - 1) / 4;
+        if (heap[parent].cost <= e.cost)
+            break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = e;
+}
+
+static void HeapDown(vector<HeapEdge> & heap, size_t i)
+{
+    size_t size = heap.size();
+    HeapEdge e = heap[i];
+
+    for (;;)
+    {
+        size_t first = 4 * i + 1;
+        if (first >= size)
+            break;
+
+        size_t last = std::min(first + 4, size);
+        size_t best = first;
+        for (size_t c = first + 1; c < last; ++c)
+            if (heap[c].cost < heap[best].cost)
+                best = c;
+
+        if (heap[best].cost >= e.cost)
+            break;
+
+        heap[i] = heap[best];
+        i = best;
+    }
+    heap[i] = e;
+}
+
+static void HeapPush(vector<HeapEdge> & heap, const HeapEdge & e)
+{
+    heap.push_back(e);
+    HeapUp(heap, heap.size() - 1);
+}
+
+static HeapEdge HeapPop(vector<HeapEdge> & heap)
+{
+    HeapEdge top = heap[0];
+    heap[0] = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+        HeapDown(heap, 0);
+    return top;
+}
+
+static void HeapBuild(vector<HeapEdge> & heap)
+{
+    for (size_t i = heap.size() / 4 + 1; i-- > 0; )
+        if (i < heap.size())
+            HeapDown(heap, i);
+}
+
+// -------------------------------------------------------------------------------
+
+// estado compartilhado durante a simplificação
+struct Simplifier
+{
+    const float * positions;
+    uint stride;
+    uint vertexCount;
+
+    vector<uint> corners;               // vértices atuais de cada triângulo
+    vector<byte> alive;                 // triângulo ainda existe
+    uint aliveCount;                    // número de triângulos vivos
+
+    vector<uint> offsets;               // adjacência vértice -> triângulos (original)
+    vector<uint> triangles;
+    vector<uint> chain;                 // lista circular dos vértices fundidos
+    vector<byte> collapsed;             // vértice já foi colapsado
+    vector<byte> locked;                // vértice de borda ou costura
+
+    vector<Quadric> quadrics;
+    vector<HeapEdge> heap;
+    vector<uint> marks;                 // marca de visita por vértice
+    vector<uint> moved;                 // vizinhos que ganharam arestas novas
+    uint stamp;
+
+    const float * Position(uint v) const
+    { return (const float*) ((const char*) positions + size_t(v) * stride); }
+
+    // custo de mover from para a posição de to
+    float Cost(uint from, uint to) const
+    {
+        Quadric q = quadrics[from];
+        q.Add(quadrics[to]);
+        return float(q.Error(Position(to)));
+    }
+
+    // escolhe a direção mais barata permitida para a aresta
+    bool Candidate(uint a, uint b, HeapEdge & edge) const
+    {
+        bool ab = !locked[a];
+        bool ba = !locked[b];
+
+        if (!ab && !ba)
+            return false;
+
+        float costAB = ab ? Cost(a, b) : 0.0f;
+        float costBA = ba ? Cost(b, a) : 0.0f;
+
+        if (ab && (!ba || costAB <= costBA))
+            edge = { costAB, a, b };
+        else
+            edge = { costBA, b, a };
+
+        return true;
+    }
+
+    // insere a aresta no heap
+    void Push(uint a, uint b)
+    {
+        HeapEdge edge;
+        if (Candidate(a, b, edge))
+            HeapPush(heap, edge);
+    }
+
+    // visita os triângulos vivos que usam o vértice v
+    template<class Visit>
+    void ForEachTriangle(uint v, Visit visit)
+    {
+        uint w = v;
+        do
+        {
+            for (uint k = offsets[w]; k < offsets[w + 1]; ++k)
+                if (alive[triangles[k]])
+                    visit(triangles[k]);
+            w = chain[w];
+        }
+        while (w != v);
+    }
+
+    // tenta colapsar a aresta; falha se ela não existe ou inverte faces
+    bool Collapse(uint from, uint to)
+    {
+        const float * target = Position(to);
+        uint shared = 0;
+        bool flips = false;
+
+        ForEachTriangle(from, [&](uint t)
+        {
+            const uint * tri = &corners[3 * t];
+
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+            {
+                ++shared;
+                return;
+            }
+
+            // normais antes e depois de mover from
+            const float * p[3];
+            const float * q[3];
+            for (uint c = 0; c < 3; ++c)
+            {
+                p[c] = Position(tri[c]);
+                q[c] = tri[c] == from ? target : p[c];
+            }
+
+            double n0[3], n1[3];
+            Normal(p, n0);
+            Normal(q, n1);
+
+            double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+            double len0 = n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2];
+            double len1 = n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2];
+
+            // o triângulo girou mais de ~75 graus ou degenerou
+            if (len1 <= 0.0 || dot <= 0.25 * sqrt(len0 * len1))
+                flips = true;
+        });
+
+        if (shared == 0 || flips)
+            return false;
+
+        ++stamp;
+        marks[to] = stamp;
+        moved.clear();
+
+        ForEachTriangle(from, [&](uint t)
+        {
+            uint * tri = &corners[3 * t];
+
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+            {
+                alive[t] = 0;
+                --aliveCount;
+                return;
+            }
+
+            for (uint c = 0; c < 3; ++c)
+            {
+                if (tri[c] == from)
+                    tri[c] = to;
+                else if (marks[tri[c]] != stamp)
+                {
+                    marks[tri[c]] = stamp;
+                    moved.push_back(tri[c]);
+                }
+            }
+        });
+
+        quadrics[to].Add(quadrics[from]);
+        collapsed[from] = 1;
+        std::swap(chain[from], chain[to]);
+
+        // as arestas que já ligavam to aos vizinhos ficam no heap e têm o
+        // custo corrigido quando saírem; só as arestas de from são novas
+        for (uint n : moved)
+            Push(to, n);
+
+        return true;
+    }
+
+    static void Normal(const float * const * p, double * n)
+    {
+        double e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+        double e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+        n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+};
+
+// -------------------------------------------------------------------------------
+
+// chave de uma aresta orientada
+static inline ullong EdgeKey(uint a, uint b)
+{ return (ullong(a) << 32) | b; }
+
+// -------------------------------------------------------------------------------
+
+SimplifyStats BuildLodChain(vector<uint> & indices,
+                            const float * positions, uint positionStride, uint vertexCount,
+                            const float * ratios, uint ratioCount,
+                            vector<MeshLod> & lods)
+{
+    Timer timer;
+    timer.Start();
+
+    SimplifyStats stats = {};
+    uint indexCount = uint(indices.size()) / 3 * 3;
+    uint triangleCount = indexCount / 3;
+
+    indices.resize(indexCount);
+    lods.clear();
+    lods.push_back({ 0, indexCount, 0, 0, 0.0f });
+    stats.levels = 1;
+
+    if (triangleCount == 0 || vertexCount == 0)
+        return stats;
+
+    Simplifier s;
+    s.positions = positions;
+    s.stride = positionStride;
+    s.vertexCount = vertexCount;
+    s.corners.assign(indices.begin(), indices.begin() + indexCount);
+    s.alive.assign(triangleCount, 1);
+    s.aliveCount = 0;
+    s.stamp = 0;
+
+    for (uint t = 0; t < triangleCount; ++t)
+    {
+        const uint * tri = &s.corners[3 * t];
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+            s.alive[t] = 0;
+        else
+            ++s.aliveCount;
+    }
+
+    // ------------------------------------------------------------------
+    // Adjacência vértice -> triângulos
+    // ------------------------------------------------------------------
+
+    s.offsets.assign(size_t(vertexCount) + 1, 0);
+    for (uint i = 0; i < indexCount; ++i)
+        ++s.offsets[s.corners[i] + 1];
+    for (uint v = 0; v < vertexCount; ++v)
+        s.offsets[v + 1] += s.offsets[v];
+
+    s.triangles.resize(indexCount);
+    {
+        vector<uint> fill(s.offsets.begin(), s.offsets.end() - 1);
+        for (uint i = 0; i < indexCount; ++i)
+            s.triangles[fill[s.corners[i]]++] = i / 3;
+    }
+
+    s.chain.resize(vertexCount);
+    for (uint v = 0; v < vertexCount; ++v)
+        s.chain[v] = v;
+
+    s.collapsed.assign(vertexCount, 0);
+    s.locked.assign(vertexCount, 0);
+    s.marks.assign(vertexCount, 0);
+
+    // ------------------------------------------------------------------
+    // Vértices com a mesma posição (costuras de atributos)
+    // ------------------------------------------------------------------
+
+    vector<uint> canonical(vertexCount);
+    {
+        uint capacity = 1;
+        while (capacity < vertexCount * 2)
+            capacity <<= 1;
+
+        const uint Empty = 0xFFFFFFFF;
+        vector<uint> table(capacity, Empty);
+
+        for (uint v = 0; v < vertexCount; ++v)
+        {
+            uint bits[3];
+            memcpy(bits, s.Position(v), sizeof(bits));
+
+            uint hash = bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u;
+            uint slot = hash & (capacity - 1);
+
+            while (table[slot] != Empty && memcmp(s.Position(table[slot]), bits, sizeof(bits)) != 0)
+                slot = (slot + 1) & (capacity - 1);
+
+            if (table[slot] == Empty)
+            {
+                table[slot] = v;
+                canonical[v] = v;
+            }
+            else
+            {
+                // os dois vértices fazem parte de uma costura
+                canonical[v] = table[slot];
+                s.locked[v] = 1;
+                s.locked[table[slot]] = 1;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Bordas: arestas sem a aresta oposta no sentido inverso
+    // ------------------------------------------------------------------
+
+    vector<ullong> canonicalEdges;
+    canonicalEdges.reserve(indexCount);
+
+    for (uint t = 0; t < triangleCount; ++t)
+    {
+        if (!s.alive[t])
+            continue;
+
+        for (uint c = 0; c < 3; ++c)
+        {
+            uint a = s.corners[3 * t + c];
+            uint b = s.corners[3 * t + (c + 1) % 3];
+            canonicalEdges.push_back(EdgeKey(canonical[a], canonical[b]));
+        }
+    }
+
+    std::sort(canonicalEdges.begin(), canonicalEdges.end());
+
+    for (ullong key : canonicalEdges)
+    {
+        uint a = uint(key >> 32);
+        uint b = uint(key);
+
+        if (!std::binary_search(canonicalEdges.begin(), canonicalEdges.end(), EdgeKey(b, a)))
+        {
+            s.locked[a] = 1;
+            s.locked[b] = 1;
+        }
+    }
+
+    // os vértices da costura seguem o representante da posição
+    for (uint v = 0; v < vertexCount; ++v)
+        s.locked[v] |= s.locked[canonical[v]];
+
+    for (uint v = 0; v < vertexCount; ++v)
+        stats.locked += s.locked[v];
+
+    canonicalEdges.clear();
+    canonicalEdges.shrink_to_fit();
+
+    // ------------------------------------------------------------------
+    // Quádricas dos planos dos triângulos ponderadas pela área
+    // ------------------------------------------------------------------
+
+    s.quadrics.assign(vertexCount, Quadric{});
+
+    for (uint t = 0; t < triangleCount; ++t)
+    {
+        if (!s.alive[t])
+            continue;
+
+        const uint * tri = &s.corners[3 * t];
+        const float * p[3] = { s.Position(tri[0]), s.Position(tri[1]), s.Position(tri[2]) };
+
+        double n[3];
+        Simplifier::Normal(p, n);
+
+        double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length == 0.0)
+            continue;
+
+        double area = 0.5 * length;
+        n[0] /= length; n[1] /= length; n[2] /= length;
+        double d = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+
+        Quadric q;
+        q.a00 = area * n[0] * n[0]; q.a01 = area * n[0] * n[1]; q.a02 = area * n[0] * n[2];
+        q.a11 = area * n[1] * n[1]; q.a12 = area * n[1] * n[2]; q.a22 = area * n[2] * n[2];
+        q.b0 = area * d * n[0]; q.b1 = area * d * n[1]; q.b2 = area * d * n[2];
+        q.c = area * d * d;
+        q.w = area;
+
+        for (uint c = 0; c < 3; ++c)
+            s.quadrics[tri[c]].Add(q);
+    }
+
+    // ------------------------------------------------------------------
+    // Heap inicial: cada aresta interna aparece nos dois sentidos e entra
+    // uma única vez; arestas em um só sentido são bordas ou costuras, com
+    // as duas pontas fixas
+    // ------------------------------------------------------------------
+
+    s.heap.reserve(indexCount / 2 + 1);
+
+    for (uint t = 0; t < triangleCount; ++t)
+    {
+        if (!s.alive[t])
+            continue;
+
+        for (uint c = 0; c < 3; ++c)
+        {
+            uint a = s.corners[3 * t + c];
+            uint b = s.corners[3 * t + (c + 1) % 3];
+            if (a < b)
+                s.heap.push_back({ 0.0f, a, b });
+        }
+    }
+
+    {
+        size_t count = 0;
+        for (const HeapEdge & e : s.heap)
+            if (s.Candidate(e.from, e.to, s.heap[count]))
+                ++count;
+
+        s.heap.resize(count);
+        HeapBuild(s.heap);
+    }
+
+    // ------------------------------------------------------------------
+    // Colapsos até atingir cada nível pedido
+    // ------------------------------------------------------------------
+
+    double maxError = 0.0;
+    uint previous = s.aliveCount;
+
+    for (uint level = 0; level < ratioCount; ++level)
+    {
+        uint target = uint(double(ratios[level]) * triangleCount);
+
+        while (s.aliveCount > target && !s.heap.empty())
+        {
+            HeapEdge e = HeapPop(s.heap);
+
+            if (s.collapsed[e.from] || s.collapsed[e.to])
+                continue;
+
+            // o custo só é confiável se não aumentou desde a inserção
+            float cost = s.Cost(e.from, e.to);
+            if (cost > e.cost)
+            {
+                HeapPush(s.heap, { cost, e.from, e.to });
+                continue;
+            }
+
+            if (!s.Collapse(e.from, e.to))
+            {
+                ++stats.rejected;
+                continue;
+            }
+
+            ++stats.collapses;
+            maxError = std::max(maxError, double(cost));
+        }
+
+        // nada mais pode ser colapsado
+        if (s.aliveCount >= previous)
+            break;
+
+        previous = s.aliveCount;
+
+        MeshLod lod = { uint(indices.size()), s.aliveCount * 3, 0, 0, float(sqrt(maxError)) };
+        indices.resize(size_t(lod.startIndex) + lod.indexCount);
+
+        uint * out = indices.data() + lod.startIndex;
+        for (uint t = 0; t < triangleCount; ++t)
+        {
+            if (s.alive[t])
+            {
+                out[0] = s.corners[3 * t];
+                out[1] = s.corners[3 * t + 1];
+                out[2] = s.corners[3 * t + 2];
+                out += 3;
+            }
+        }
+
+        lods.push_back(lod);
+        ++stats.levels;
+    }
+
+    stats.seconds = timer.Elapsed();
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+/**********************************************************************************
+// MeshSimplifier (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Gera uma cadeia de níveis de detalhe (LOD) por simplificação
+//              com métricas de erro quádricas (Garland e Heckbert, 1997).
+//              Cada colapso move um vértice sobre um vizinho já existente,
+//              de modo que todos os níveis compartilham o mesmo vertex
+//              buffer e diferem apenas nos índices. Vértices de borda e de
+//              costura (mesma posição em vértices distintos) ficam fixos.
+//              As arestas candidatas ficam em um heap compacto com
+//              remoção preguiçosa: o custo é recalculado quando a aresta
+//              sai do heap e ela volta se tiver ficado mais cara.
+//
+**********************************************************************************/
+
+#ifndef DXUT_MESHSIMPLIFIER_H
+#define DXUT_MESHSIMPLIFIER_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Mesh.h"                       // níveis de detalhe da malha
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// resultado da geração da cadeia de níveis
+struct SimplifyStats
+{
+    uint   levels;                      // níveis gerados (incluindo o original)
+    uint   collapses;                   // colapsos de arestas aplicados
+    uint   rejected;                    // colapsos recusados (inversão de faces)
+    uint   locked;                      // vértices fixos (borda ou costura)
+    double seconds;                     // tempo total da simplificação
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// Simplifica a malha formada por indices e acrescenta ao final do vetor os
+// índices de cada nível pedido em ratios (fração dos triângulos originais,
+// em ordem decrescente). lods recebe a faixa de índices e o erro geométrico
+// (distância nas unidades do objeto) de cada nível, começando pelo original.
+// Níveis que não reduzem o anterior não são gerados.
+
+SimplifyStats BuildLodChain(
+    vector<uint> & indices,
+    const float * positions, uint positionStride, uint vertexCount,
+    const float * ratios, uint ratioCount,
+    vector<MeshLod> & lods);
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,321 @@
+/**********************************************************************************
+// Meshlet (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Divide os triângulos de cada nível de detalhe em agrupamentos
+//              (meshlets) com esfera envolvente e cone de normais, e
+//              descarta na CPU os agrupamentos invisíveis para a câmera.
+//
+**********************************************************************************/
+
+#include "Meshlet.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// lê a posição de um vértice
+static inline XMFLOAT3 Position(const float * positions, uint stride, uint index)
+{
+    XMFLOAT3 p;
+    memcpy(&p, (const char*) positions + size_t(index) * stride, sizeof(p));
+    return p;
+}
+
+// carrega a posição de um vértice em um registrador
+static inline XMVECTOR LoadPosition(const float * positions, uint stride, uint index)
+{
+    XMFLOAT3 p = Position(positions, stride, index);
+    return XMLoadFloat3(&p);
+}
+
+// -------------------------------------------------------------------------------
+
+string MeshletStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << meshlets << " agrupamentos, "
+         << (meshlets ? double(triangles) / meshlets : 0.0) << " triângulos e "
+         << (meshlets ? double(vertices) / meshlets : 0.0) << " vértices em média, "
+         << openCones << " sem cone, " << seconds * 1000.0 << " ms";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+string MeshletCullStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << visible << "/" << meshlets << " agrupamentos em " << ranges << " faixas, "
+         << frustumCulled << " triângulos fora da visão e "
+         << coneCulled << " de costas (de " << triangles << "), "
+         << seconds * 1000.0 << " ms";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+// Esfera envolvente (Ritter, 1990)
+
+static void BoundingSphere(const vector<XMFLOAT3> & points, XMFLOAT3 & center, float & radius)
+{
+    // pontos extremos em cada eixo
+    uint minIndex[3] = { 0, 0, 0 };
+    uint maxIndex[3] = { 0, 0, 0 };
+
+    for (uint i = 1; i < points.size(); ++i)
+    {
+        const float * p = &points[i].x;
+        for (uint k = 0; k < 3; ++k)
+        {
+            if (p[k] < (&points[minIndex[k]].x)[k]) minIndex[k] = i;
+            if (p[k] > (&points[maxIndex[k]].x)[k]) maxIndex[k] = i;
+        }
+    }
+
+    // o par de extremos mais afastado define a esfera inicial
+    uint axis = 0;
+    float widest = -1.0f;
+    for (uint k = 0; k < 3; ++k)
+    {
+        XMVECTOR d = XMLoadFloat3(&points[maxIndex[k]]) - XMLoadFloat3(&points[minIndex[k]]);
+        float length = XMVectorGetX(XMVector3LengthSq(d));
+        if (length > widest)
+        {
+            widest = length;
+            axis = k;
+        }
+    }
+
+    XMVECTOR a = XMLoadFloat3(&points[minIndex[axis]]);
+    XMVECTOR b = XMLoadFloat3(&points[maxIndex[axis]]);
+    XMVECTOR c = (a + b) * 0.5f;
+    float r = 0.5f * sqrtf(widest);
+
+    // cresce a esfera até conter todos os pontos
+    for (const XMFLOAT3 & point : points)
+    {
+        XMVECTOR p = XMLoadFloat3(&point);
+        float distance = XMVectorGetX(XMVector3Length(p - c));
+
+        if (distance > r)
+        {
+            float grown = 0.5f * (r + distance);
+            c += (p - c) * ((grown - r) / distance);
+            r = grown;
+        }
+    }
+
+    XMStoreFloat3(&center, c);
+    radius = r;
+}
+
+// -------------------------------------------------------------------------------
+// Geração dos agrupamentos
+
+MeshletStats BuildMeshlets(
+    const uint * indices, uint startIndex, uint indexCount,
+    const float * positions, uint positionStride, uint vertexCount,
+    vector<Meshlet> & meshlets,
+    uint maxVertices, uint maxTriangles)
+{
+    MeshletStats stats = {};
+
+    Timer timer;
+    timer.Start();
+
+    // marca do último agrupamento que recebeu cada vértice (zero é nenhum)
+    vector<uint> owner(vertexCount, 0);
+    vector<XMFLOAT3> points;            // posições dos vértices do agrupamento
+    points.reserve(maxVertices);
+
+    uint first = startIndex;            // primeiro índice do agrupamento atual
+    uint stamp = 1;
+
+    // fecha o agrupamento formado pelos índices [first, end)
+    auto close = [&](uint end)
+    {
+        if (end == first)
+            return;
+
+        Meshlet m = {};
+        m.startIndex = first;
+        m.indexCount = end - first;
+        m.vertexCount = uint(points.size());
+        BoundingSphere(points, m.center, m.radius);
+
+        // eixo do cone: média das normais ponderada pela área
+        XMVECTOR axis = XMVectorZero();
+        for (uint i = first; i + 2 < end; i += 3)
+        {
+            XMVECTOR a = LoadPosition(positions, positionStride, indices[i]);
+            XMVECTOR b = LoadPosition(positions, positionStride, indices[i + 1]);
+            XMVECTOR c = LoadPosition(positions, positionStride, indices[i + 2]);
+            axis += XMVector3Cross(b - a, c - a);
+        }
+
+        float axisLength = XMVectorGetX(XMVector3Length(axis));
+        m.coneCutoff = 1.0f;
+
+        if (axisLength > 0.0f)
+        {
+            axis /= axisLength;
+
+            // menor cosseno entre o eixo e a normal de cada triângulo
+            float minDot = 1.0f;
+            for (uint i = first; i + 2 < end; i += 3)
+            {
+                XMVECTOR a = LoadPosition(positions, positionStride, indices[i]);
+                XMVECTOR b = LoadPosition(positions, positionStride, indices[i + 1]);
+                XMVECTOR c = LoadPosition(positions, positionStride, indices[i + 2]);
+                XMVECTOR normal = XMVector3Cross(b - a, c - a);
+
+                // triângulos degenerados não restringem o cone
+                if (XMVectorGetX(XMVector3LengthSq(normal)) > 0.0f)
+                    minDot = std::min(minDot, XMVectorGetX(XMVector3Dot(XMVector3Normalize(normal), axis)));
+            }
+
+            // cone mais aberto que um hemisfério nunca fica todo de costas
+            // (o corte é o seno do semiângulo: -cos(a + 90) = sin(a))
+            if (minDot > 0.1f)
+                m.coneCutoff = sqrtf(1.0f - minDot * minDot);
+        }
+
+        XMStoreFloat3(&m.coneAxis, axis);
+
+        if (m.coneCutoff >= 1.0f)
+            ++stats.openCones;
+
+        stats.triangles += m.indexCount / 3;
+        stats.vertices += m.vertexCount;
+        ++stats.meshlets;
+
+        meshlets.push_back(m);
+        points.clear();
+        first = end;
+        ++stamp;
+    };
+
+    uint end = startIndex + indexCount - indexCount % 3;
+
+    for (uint i = startIndex; i < end; i += 3)
+    {
+        // vértices do triângulo que ainda não estão no agrupamento
+        uint a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        uint added = (owner[a] != stamp) + (owner[b] != stamp && b != a) + (owner[c] != stamp && c != a && c != b);
+
+        if (points.size() + added > maxVertices || (i - first) / 3 + 1 > maxTriangles)
+            close(i);
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            uint v = indices[i + k];
+            if (owner[v] != stamp)
+            {
+                owner[v] = stamp;
+                points.push_back(Position(positions, positionStride, v));
+            }
+        }
+    }
+
+    close(end);
+
+    stats.seconds = timer.Elapsed();
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+// Descarte dos agrupamentos
+
+MeshletCullStats CullMeshlets(
+    const Meshlet * meshlets, uint meshletCount,
+    const XMFLOAT4X4 & worldViewProj, const XMFLOAT3 & eye,
+    bool cones, vector<SubMesh> & ranges)
+{
+    MeshletCullStats stats = {};
+
+    Timer timer;
+    timer.Start();
+
+    ranges.clear();
+
+    // planos do volume de visão no espaço do objeto (Gribb e Hartmann):
+    // esquerdo, direito, inferior, superior, próximo e distante
+    const XMFLOAT4X4 & m = worldViewProj;
+    XMVECTOR col0 = XMVectorSet(m._11, m._21, m._31, m._41);
+    XMVECTOR col1 = XMVectorSet(m._12, m._22, m._32, m._42);
+    XMVECTOR col2 = XMVectorSet(m._13, m._23, m._33, m._43);
+    XMVECTOR col3 = XMVectorSet(m._14, m._24, m._34, m._44);
+
+    XMVECTOR planes[6] =
+    {
+        col3 + col0, col3 - col0,
+        col3 + col1, col3 - col1,
+        col2,        col3 - col2
+    };
+
+    for (XMVECTOR & plane : planes)
+        plane = XMPlaneNormalize(plane);
+
+    XMVECTOR camera = XMLoadFloat3(&eye);
+
+    for (uint i = 0; i < meshletCount; ++i)
+    {
+        const Meshlet & ml = meshlets[i];
+        uint triangles = ml.indexCount / 3;
+        stats.triangles += triangles;
+
+        XMVECTOR center = XMLoadFloat3(&ml.center);
+        center = XMVectorSetW(center, 1.0f);
+
+        // esfera inteiramente atrás de algum plano
+        bool outside = false;
+        for (uint p = 0; p < 6 && !outside; ++p)
+            outside = XMVectorGetX(XMVector4Dot(planes[p], center)) < -ml.radius;
+
+        if (outside)
+        {
+            stats.frustumCulled += triangles;
+            continue;
+        }
+
+        // todos os triângulos de costas para a câmera
+        if (cones && ml.coneCutoff < 1.0f)
+        {
+            XMVECTOR view = center - camera;
+            float along = XMVectorGetX(XMVector3Dot(view, XMLoadFloat3(&ml.coneAxis)));
+            float distance = XMVectorGetX(XMVector3Length(view));
+
+            if (along >= ml.coneCutoff * distance + ml.radius)
+            {
+                stats.coneCulled += triangles;
+                continue;
+            }
+        }
+
+        ++stats.visible;
+
+        // agrupamentos vizinhos na lista de índices viram uma só faixa
+        if (!ranges.empty() && ranges.back().startIndex + ranges.back().indexCount == ml.startIndex)
+            ranges.back().indexCount += ml.indexCount;
+        else
+            ranges.push_back({ ml.indexCount, ml.startIndex, 0 });
+    }
+
+    stats.meshlets = meshletCount;
+    stats.ranges = uint(ranges.size());
+    stats.seconds = timer.Elapsed();
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
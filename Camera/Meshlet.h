@@ -0,0 +1,96 @@
+/**********************************************************************************
+// Meshlet (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Divide os triângulos de cada nível de detalhe em agrupamentos
+//              (meshlets) de até 64 vértices e 124 triângulos. A divisão
+//              percorre os índices na ordem já otimizada para o cache de
+//              vértices e fecha um agrupamento quando um dos limites seria
+//              ultrapassado, de modo que cada agrupamento é uma faixa
+//              contígua da lista de índices e a ordem dos triângulos não
+//              muda. Cada agrupamento guarda uma esfera envolvente (Ritter)
+//              e um cone com as normais dos seus triângulos.
+//
+//              O descarte na CPU testa as esferas contra os planos do volume
+//              de visão e os cones contra a posição da câmera, descartando
+//              agrupamentos cujos triângulos estão todos de costas. Os
+//              agrupamentos visíveis e vizinhos na lista de índices são
+//              unidos em faixas de desenho.
+//
+**********************************************************************************/
+
+#ifndef DXUT_MESHLET_H
+#define DXUT_MESHLET_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Mesh.h"                       // agrupamentos e faixas de desenho
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// resultado da geração dos agrupamentos
+struct MeshletStats
+{
+    uint   meshlets;                    // agrupamentos gerados
+    uint   triangles;                   // triângulos agrupados
+    uint   vertices;                    // soma dos vértices de cada agrupamento
+    uint   openCones;                   // agrupamentos sem cone útil (normais muito abertas)
+    double seconds;                     // tempo da geração
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// resultado do descarte de agrupamentos
+struct MeshletCullStats
+{
+    uint   meshlets;                    // agrupamentos testados
+    uint   visible;                     // agrupamentos desenhados
+    uint   triangles;                   // triângulos testados
+    uint   frustumCulled;               // triângulos fora do volume de visão
+    uint   coneCulled;                  // triângulos de costas para a câmera
+    uint   ranges;                      // faixas de desenho geradas
+    double seconds;                     // tempo do descarte
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// limites por agrupamento (os mesmos usados por mesh shaders)
+const uint MeshletMaxVertices = 64;
+const uint MeshletMaxTriangles = 124;
+
+// Divide os triângulos da faixa [startIndex, startIndex + indexCount) da
+// lista de índices em agrupamentos acrescentados ao final de meshlets.
+// As normais seguem a ordem dos índices (b - a) x (c - a).
+
+MeshletStats BuildMeshlets(
+    const uint * indices, uint startIndex, uint indexCount,
+    const float * positions, uint positionStride, uint vertexCount,
+    vector<Meshlet> & meshlets,
+    uint maxVertices = MeshletMaxVertices, uint maxTriangles = MeshletMaxTriangles);
+
+// Descarta agrupamentos fora do volume de visão e, se cones for verdadeiro,
+// os que estão de costas para a câmera. worldViewProj leva do espaço do
+// objeto ao espaço de recorte (convenção de vetores linha do DirectXMath)
+// e eye é a posição da câmera no espaço do objeto. ranges recebe as faixas
+// de índices a desenhar, com vértice base zero.
+
+MeshletCullStats CullMeshlets(
+    const Meshlet * meshlets, uint meshletCount,
+    const XMFLOAT4X4 & worldViewProj, const XMFLOAT3 & eye,
+    bool cones, vector<SubMesh> & ranges);
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,974 @@
+/**********************************************************************************
+// ObjLoader (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Carrega malhas no formato Wavefront OBJ a partir de um
+//              arquivo mapeado em memória. O arquivo é percorrido duas
+//              vezes: a primeira conta os elementos para pré-alocar os
+//              vetores de saída e a segunda converte os valores direto
+//              para os vértices e índices, sem alocações intermediárias
+//              e sem depender da localidade (locale) do sistema.
+//
+//              Arquivos grandes são divididos em trechos terminados em
+//              quebra de linha e processados em paralelo pelas threads do
+//              sistema de trabalhos. Uma soma prefixada das contagens de
+//              cada trecho define onde cada um escreve, de forma que a
+//              saída é idêntica à da leitura sequencial, inclusive para
+//              índices negativos.
+//
+//              Com a soldagem ativada, cada tripla (v, vt, vn) distinta
+//              das faces vira um único vértice de saída, encontrado por
+//              uma tabela hash de endereçamento aberto dimensionada pelo
+//              número de cantos das faces.
+//
+**********************************************************************************/
+
+#include "ObjLoader.h"
+#include "MappedFile.h"
+#include "Timer.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+using std::ifstream;
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+// Tokenizador
+
+// contagem dos elementos de um trecho do arquivo
+struct ObjCounts
+{
+    uint positions;                     // linhas "v"
+    uint texcoords;                     // linhas "vt"
+    uint normals;                       // linhas "vn"
+    uint faces;                         // linhas "f"
+    uint indices;                       // índices gerados pela triangulação
+};
+
+// índice ausente em uma tripla (v, vt, vn)
+static const uint ObjNone = 0xFFFFFFFF;
+
+// tipos de linha reconhecidos
+enum ObjLine { OBJ_OTHER, OBJ_POSITION, OBJ_TEXCOORD, OBJ_NORMAL, OBJ_FACE };
+
+static inline bool IsSpace(char c)
+{ return c == ' ' || c == '\t' || c == '\r'; }
+
+static inline bool IsDigit(char c)
+{ return unsigned(c - '0') < 10u; }
+
+static inline const char * SkipSpaces(const char * p, const char * end)
+{
+    while (p < end && IsSpace(*p)) ++p;
+    return p;
+}
+
+static inline const char * SkipToken(const char * p, const char * end)
+{
+    while (p < end && !IsSpace(*p)) ++p;
+    return p;
+}
+
+// identifica o tipo da linha e avança o cursor para depois do prefixo
+static inline ObjLine Classify(const char * & p, const char * end)
+{
+    p = SkipSpaces(p, end);
+
+    if (end - p < 2)
+        return OBJ_OTHER;
+
+    if (p[0] == 'v')
+    {
+        if (IsSpace(p[1])) { p += 1; return OBJ_POSITION; }
+
+        if (end - p >= 3 && IsSpace(p[2]))
+        {
+            if (p[1] == 't') { p += 2; return OBJ_TEXCOORD; }
+            if (p[1] == 'n') { p += 2; return OBJ_NORMAL; }
+        }
+    }
+    else if (p[0] == 'f' && IsSpace(p[1]))
+    {
+        p += 1;
+        return OBJ_FACE;
+    }
+
+    return OBJ_OTHER;
+}
+
+// potência de 10 exata para expoentes pequenos
+static inline double Pow10(int e)
+{
+    static const double table[23] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    return (e >= 0 && e <= 22) ? table[e] : pow(10.0, e);
+}
+
+// converte um número real sem depender da localidade do sistema
+static const char * ParseFloat(const char * p, const char * end, float & value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    ullong mantissa = 0;                // dígitos significativos
+    int digits = 0;                     // quantidade de dígitos significativos
+    int exponent = 0;                   // expoente decimal
+
+    // parte inteira
+    for (; p < end && IsDigit(*p); ++p)
+    {
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) ++digits;
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+
+    // parte fracionária
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && IsDigit(*p); ++p)
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) ++digits;
+                --exponent;
+            }
+        }
+    }
+
+    // notação científica
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negExp = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negExp = (*p++ == '-');
+
+        int e = 0;
+        for (; p < end && IsDigit(*p); ++p)
+            if (e < 10000) e = e * 10 + (*p - '0');
+
+        exponent += negExp ? -e : e;
+    }
+
+    // a divisão por uma potência exata mantém o resultado corretamente arredondado
+    double result = double(mantissa);
+    if (exponent < 0)
+        result /= Pow10(-exponent);
+    else if (exponent > 0)
+        result *= Pow10(exponent);
+
+    value = float(negative ? -result : result);
+    return p;
+}
+
+// converte um número inteiro com sinal
+static inline const char * ParseInt(const char * p, const char * end, int & value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    int result = 0;
+    for (; p < end && IsDigit(*p); ++p)
+        result = result * 10 + (*p - '0');
+
+    value = negative ? -result : result;
+    return p;
+}
+
+// -------------------------------------------------------------------------------
+// Passagens sobre o arquivo
+
+// primeira passagem: conta elementos para pré-alocar a saída
+static ObjCounts CountElements(const char * begin, const char * end)
+{
+    ObjCounts counts = {};
+
+    const char * line = begin;
+    while (line < end)
+    {
+        const char * eol = (const char*) memchr(line, '\n', size_t(end - line));
+        if (!eol) eol = end;
+
+        const char * p = line;
+        switch (Classify(p, eol))
+        {
+        case OBJ_POSITION: ++counts.positions; break;
+        case OBJ_TEXCOORD: ++counts.texcoords; break;
+        case OBJ_NORMAL:   ++counts.normals;   break;
+        case OBJ_FACE:
+        {
+            // conta os cantos da face
+            uint corners = 0;
+            for (p = SkipSpaces(p, eol); p < eol; p = SkipSpaces(SkipToken(p, eol), eol))
+                ++corners;
+
+            ++counts.faces;
+            if (corners >= 3)
+                counts.indices += 3 * (corners - 2);
+            break;
+        }
+        default: break;
+        }
+
+        line = eol + 1;
+    }
+
+    return counts;
+}
+
+// destino da segunda passagem
+struct ObjOutput
+{
+    Vertex   * vertices;                // posições gravadas direto nos vértices
+    XMFLOAT3 * positions;               // posições brutas (com soldagem)
+    XMFLOAT2 * texcoords;               // coordenadas de textura (com soldagem)
+    XMFLOAT3 * normals;                 // normais (com soldagem)
+    uint     * indices;                 // índices de posição (sem soldagem)
+    uint     * corners;                 // triplas (v, vt, vn) por canto (com soldagem)
+    ObjCounts  total;                   // elementos do arquivo inteiro
+};
+
+// resolve um índice do arquivo (1..n ou negativo) para a faixa [0, count)
+static inline bool ResolveIndex(int index, uint read, uint count, uint & resolved)
+{
+    // índices negativos são relativos ao último elemento lido
+    llong value = -1;
+    if (index > 0) value = llong(index) - 1;
+    else if (index < 0) value = llong(read) + index;
+
+    if (value < 0 || value >= llong(count))
+    {
+        resolved = 0;
+        return false;
+    }
+
+    resolved = uint(value);
+    return true;
+}
+
+// segunda passagem: converte os elementos do trecho direto para os vetores de saída
+// (first indica quantos elementos de cada tipo existem antes do trecho)
+static bool ParseElements(const char * begin, const char * end, const ObjCounts & first, const ObjOutput & out)
+{
+    const XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+
+    uint positions = first.positions;   // posições lidas até a linha atual
+    uint texcoords = first.texcoords;   // coordenadas de textura lidas até a linha atual
+    uint normals = first.normals;       // normais lidas até a linha atual
+    uint * indices = out.indices ? out.indices + first.indices : nullptr;
+    uint * corners = out.corners ? out.corners + 3 * size_t(first.indices) : nullptr;
+    bool valid = true;                  // todos os índices dentro dos limites
+
+    const char * line = begin;
+    while (line < end)
+    {
+        const char * eol = (const char*) memchr(line, '\n', size_t(end - line));
+        if (!eol) eol = end;
+
+        const char * p = line;
+        switch (Classify(p, eol))
+        {
+        case OBJ_POSITION:
+        {
+            XMFLOAT3 & pos = out.vertices ? out.vertices[positions].Pos : out.positions[positions];
+            p = ParseFloat(SkipSpaces(p, eol), eol, pos.x);
+            p = ParseFloat(SkipSpaces(p, eol), eol, pos.y);
+            p = ParseFloat(SkipSpaces(p, eol), eol, pos.z);
+
+            if (out.vertices)
+                out.vertices[positions].Color = white;
+
+            ++positions;
+            break;
+        }
+        case OBJ_TEXCOORD:
+        {
+            if (out.texcoords)
+            {
+                XMFLOAT2 & tex = out.texcoords[texcoords];
+                p = ParseFloat(SkipSpaces(p, eol), eol, tex.x);
+                p = ParseFloat(SkipSpaces(p, eol), eol, tex.y);
+            }
+
+            ++texcoords;
+            break;
+        }
+        case OBJ_NORMAL:
+        {
+            if (out.normals)
+            {
+                XMFLOAT3 & normal = out.normals[normals];
+                p = ParseFloat(SkipSpaces(p, eol), eol, normal.x);
+                p = ParseFloat(SkipSpaces(p, eol), eol, normal.y);
+                p = ParseFloat(SkipSpaces(p, eol), eol, normal.z);
+            }
+
+            ++normals;
+            break;
+        }
+        case OBJ_FACE:
+        {
+            uint start[3] = {}, previous[3] = {}, corner = 0;
+
+            // cada canto tem a forma v, v/t, v//n ou v/t/n
+            for (p = SkipSpaces(p, eol); p < eol; p = SkipSpaces(SkipToken(p, eol), eol))
+            {
+                int index;
+                uint current[3] = { 0, ObjNone, ObjNone };
+
+                const char * q = ParseInt(p, eol, index);
+                valid &= ResolveIndex(index, positions, out.total.positions, current[0]);
+
+                // coordenada de textura e normal são opcionais
+                if (corners && q < eol && *q == '/')
+                {
+                    if (++q < eol && *q != '/')
+                    {
+                        q = ParseInt(q, eol, index);
+                        valid &= ResolveIndex(index, texcoords, out.total.texcoords, current[1]);
+                    }
+
+                    if (q < eol && *q == '/')
+                    {
+                        q = ParseInt(q + 1, eol, index);
+                        valid &= ResolveIndex(index, normals, out.total.normals, current[2]);
+                    }
+                }
+
+                // triangulação em leque
+                if (corner == 0)
+                {
+                    start[0] = current[0]; start[1] = current[1]; start[2] = current[2];
+                }
+                else if (corner >= 2)
+                {
+                    if (corners)
+                    {
+                        const uint * triangle[3] = { start, previous, current };
+                        for (const uint * c : triangle)
+                        {
+                            *corners++ = c[0];
+                            *corners++ = c[1];
+                            *corners++ = c[2];
+                        }
+                    }
+                    else
+                    {
+                        *indices++ = start[0];
+                        *indices++ = previous[0];
+                        *indices++ = current[0];
+                    }
+                }
+
+                previous[0] = current[0]; previous[1] = current[1]; previous[2] = current[2];
+                ++corner;
+            }
+            break;
+        }
+        default: break;
+        }
+
+        line = eol + 1;
+    }
+
+    return valid;
+}
+
+// -------------------------------------------------------------------------------
+// Soldagem de vértices
+
+// espalha os bits da tripla para a tabela hash
+static inline uint HashCorner(const uint * c)
+{
+    uint h = c[0] * 0x9E3779B1u;
+    h ^= c[1] * 0x85EBCA77u;
+    h ^= c[2] * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 13;
+    return h;
+}
+
+// Atribui um vértice de saída para cada tripla (v, vt, vn) distinta, na ordem
+// do primeiro uso. A tabela usa endereçamento aberto com sondagem linear e
+// capacidade de pelo menos o dobro do número de cantos, que é o limite
+// superior para o número de triplas distintas. Cada posição guarda a tripla
+// junto com o vértice para que a comparação não saia da linha de cache.
+// Retorna ObjNone se a tabela não cabe na memória endereçável.
+static uint WeldCorners(const uint * corners, uint cornerCount, uint * indices, vector<uint> & firstCorner)
+{
+    struct Slot { uint key[3]; uint vertex; };
+
+    // o hash tem 32 bits: mais posições que isso nunca seriam usadas
+    const ullong maxCapacity = std::min(1ull << 32, ullong(SIZE_MAX / sizeof(Slot)));
+
+    size_t capacity = 16;
+    while (capacity < cornerCount * 2ull && capacity * 2ull <= maxCapacity)
+        capacity <<= 1;
+
+    // a sondagem só termina se sobrar ao menos uma posição livre
+    if (capacity <= cornerCount)
+        return ObjNone;
+
+    const size_t mask = capacity - 1;
+    vector<Slot> table(capacity, Slot{ { 0, 0, 0 }, ObjNone });
+
+    firstCorner.clear();
+    firstCorner.reserve(cornerCount);
+
+    for (uint i = 0; i < cornerCount; ++i)
+    {
+        const uint * key = corners + 3 * size_t(i);
+        size_t index = HashCorner(key) & mask;
+
+        for (;;)
+        {
+            Slot & slot = table[index];
+
+            // tripla inédita: cria um novo vértice
+            if (slot.vertex == ObjNone)
+            {
+                slot.key[0] = key[0];
+                slot.key[1] = key[1];
+                slot.key[2] = key[2];
+                slot.vertex = uint(firstCorner.size());
+                firstCorner.push_back(i);
+                indices[i] = slot.vertex;
+                break;
+            }
+
+            // tripla já vista: reaproveita o vértice
+            if (slot.key[0] == key[0] && slot.key[1] == key[1] && slot.key[2] == key[2])
+            {
+                indices[i] = slot.vertex;
+                break;
+            }
+
+            index = (index + 1) & mask;
+        }
+    }
+
+    return uint(firstCorner.size());
+}
+
+// -------------------------------------------------------------------------------
+// Divisão em trechos
+
+// trecho do arquivo processado por uma thread
+struct ObjChunk
+{
+    const char * begin;                 // primeiro caractere do trecho
+    const char * end;                   // fim do trecho (após uma quebra de linha)
+    ObjCounts counts;                   // elementos dentro do trecho
+    ObjCounts first;                    // elementos de todos os trechos anteriores
+    bool valid;                         // índices dentro dos limites
+};
+
+// executa func(i) para i em [0, count), em paralelo se houver sistema de trabalhos
+template<class Func>
+static void RunChunks(JobSystem * jobs, uint count, const Func & func)
+{
+    if (!jobs || count < 2)
+    {
+        for (uint i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    // um trecho por trabalho: as mesmas threads atendem as duas passagens
+    jobs->ParallelFor(count, 1, [&func](uint begin, uint end)
+    {
+        for (uint i = begin; i < end; ++i)
+            func(i);
+    });
+}
+
+// divide o arquivo em até "count" trechos terminados em quebra de linha
+static vector<ObjChunk> SplitChunks(const char * begin, const char * end, uint count)
+{
+    vector<ObjChunk> chunks;
+    chunks.reserve(count);
+
+    const char * start = begin;
+    for (uint i = 1; i <= count && start < end; ++i)
+    {
+        const char * stop = end;
+
+        if (i < count)
+        {
+            // avança a divisão ideal até o fim da linha corrente
+            stop = begin + (end - begin) * llong(i) / count;
+            if (stop < start) stop = start;
+
+            const char * eol = (const char*) memchr(stop, '\n', size_t(end - stop));
+            stop = eol ? eol + 1 : end;
+        }
+
+        if (stop > start)
+            chunks.push_back({ start, stop, {}, {}, true });
+
+        start = stop;
+    }
+
+    return chunks;
+}
+
+// -------------------------------------------------------------------------------
+// ObjStats
+
+double ObjStats::MBps() const
+{ return seconds > 0.0 ? (bytes / 1048576.0) / seconds : 0.0; }
+
+double ObjStats::VerticesPerSec() const
+{ return seconds > 0.0 ? positions / seconds : 0.0; }
+
+double ObjStats::UniqueRatio() const
+{ return triangles ? vertices / (triangles * 3.0) : 0.0; }
+
+string ObjStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+
+    text << "---> OBJ: " << positions << " v, "
+         << texcoords << " vt, "
+         << normals << " vn, "
+         << faces << " f, "
+         << triangles << " triângulos, "
+         << threads << " thread(s)\n"
+         << "---> OBJ: " << seconds * 1000.0 << " ms, "
+         << MBps() << " MB/s, "
+         << VerticesPerSec() / 1e6 << " milhões de vértices/s\n";
+
+    if (weldSeconds > 0.0)
+    {
+        // memória dos vértices com um vértice por canto e após a soldagem
+        double cornerBytes = triangles * 3.0 * sizeof(Vertex);
+        double weldBytes = vertices * double(sizeof(Vertex));
+
+        text << "---> OBJ: soldagem " << vertices << " vértices únicos ("
+             << UniqueRatio() * 100.0 << "% dos cantos), "
+             << weldSeconds * 1000.0 << " ms, "
+             << (cornerBytes - weldBytes) / 1048576.0 << " MB economizados\n";
+    }
+
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+// ObjLoader
+
+ObjLoader::ObjLoader()
+{
+    stats = {};
+    jobs = nullptr;
+    threads = 0;
+    weld = false;
+}
+
+// -------------------------------------------------------------------------------
+
+bool ObjLoader::Load(const string & fileName, vector<Vertex> & vertices, vector<uint> & indices, ObjAttributes * attributes)
+{
+    Timer timer;
+    timer.Start();
+
+    stats = {};
+
+    MappedFile file;
+    if (!file.Open(fileName))
+        return false;
+
+    const char * begin = file.Data();
+    const char * end = begin + file.Size();
+
+    // número de trechos: arquivos pequenos não compensam a divisão
+    uint count = threads ? threads : (jobs ? jobs->Threads() : 1);
+    count = uint(std::min(ullong(count), std::max(1ull, file.Size() / MinChunkSize)));
+
+    vector<ObjChunk> chunks = SplitChunks(begin, end, count);
+
+    // primeira passagem: cada trecho conta seus elementos
+    RunChunks(jobs, uint(chunks.size()), [&](uint i) {
+        chunks[i].counts = CountElements(chunks[i].begin, chunks[i].end);
+    });
+
+    // soma prefixada define onde cada trecho escreve sua saída
+    ObjCounts total = {};
+    for (ObjChunk & c : chunks)
+    {
+        c.first = total;
+        total.positions += c.counts.positions;
+        total.texcoords += c.counts.texcoords;
+        total.normals += c.counts.normals;
+        total.faces += c.counts.faces;
+        total.indices += c.counts.indices;
+    }
+
+    // pré-aloca a saída com base na contagem
+    vector<XMFLOAT3> positions;
+    vector<XMFLOAT2> texcoords;
+    vector<XMFLOAT3> normals;
+    vector<uint> corners;
+
+    ObjOutput out = {};
+    out.total = total;
+
+    if (weld)
+    {
+        positions.resize(total.positions);
+        texcoords.resize(total.texcoords);
+        normals.resize(total.normals);
+        corners.resize(3 * size_t(total.indices));
+
+        out.positions = positions.data();
+        out.texcoords = texcoords.data();
+        out.normals = normals.data();
+        out.corners = corners.data();
+    }
+    else
+    {
+        vertices.resize(total.positions);
+        out.vertices = vertices.data();
+    }
+
+    indices.resize(total.indices);
+    out.indices = indices.data();
+
+    // segunda passagem: cada trecho escreve na sua faixa dos vetores de saída,
+    // o que torna o resultado idêntico ao da leitura com uma única thread
+    RunChunks(jobs, uint(chunks.size()), [&](uint i) {
+        ObjChunk & c = chunks[i];
+        c.valid = ParseElements(c.begin, c.end, c.first, out);
+    });
+
+    bool valid = true;
+    for (const ObjChunk & c : chunks)
+        valid = valid && c.valid;
+
+    // índices inválidos (ou faces sem posições) não podem ser soldados
+    if (weld && !valid)
+    {
+        vertices.clear();
+        indices.clear();
+        return false;
+    }
+
+    // soldagem: um vértice de saída por tripla (v, vt, vn) distinta
+    if (weld)
+    {
+        Timer weldTimer;
+        weldTimer.Start();
+
+        vector<uint> firstCorner;
+        uint unique = WeldCorners(corners.data(), total.indices, indices.data(), firstCorner);
+        if (unique == ObjNone)
+        {
+            vertices.clear();
+            indices.clear();
+            return false;
+        }
+
+        const XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+        vertices.resize(unique);
+
+        if (attributes)
+        {
+            attributes->texcoords.assign(total.texcoords ? unique : 0, XMFLOAT2(0.0f, 0.0f));
+            attributes->normals.assign(total.normals ? unique : 0, XMFLOAT3(0.0f, 0.0f, 0.0f));
+        }
+
+        for (uint v = 0; v < unique; ++v)
+        {
+            const uint * key = corners.data() + 3 * size_t(firstCorner[v]);
+
+            vertices[v].Pos = positions[key[0]];
+            vertices[v].Color = white;
+
+            if (attributes && key[1] != ObjNone && !attributes->texcoords.empty())
+                attributes->texcoords[v] = texcoords[key[1]];
+
+            if (attributes && key[2] != ObjNone && !attributes->normals.empty())
+                attributes->normals[v] = normals[key[2]];
+        }
+
+        stats.weldSeconds = weldTimer.Elapsed();
+    }
+
+    stats.bytes = file.Size();
+    stats.positions = total.positions;
+    stats.texcoords = total.texcoords;
+    stats.normals = total.normals;
+    stats.faces = total.faces;
+    stats.triangles = total.indices / 3;
+    stats.vertices = uint(vertices.size());
+    stats.threads = jobs ? std::min(jobs->Threads(), uint(chunks.size())) : 1;
+    stats.seconds = timer.Elapsed();
+
+    return valid;
+}
+
+// -------------------------------------------------------------------------------
+// Medição
+
+bool WriteGridObj(const string & fileName, uint vertices, bool relative)
+{
+    uint side = std::max(2u, uint(sqrt(double(vertices))));
+
+    FILE * file = fopen(fileName.c_str(), "wb");
+    if (!file)
+        return false;
+
+    vector<char> buffer(1 << 20);
+    setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+    // índice a (a partir de 1) como absoluto ou relativo às posições já gravadas
+    uint written = 0;
+    auto index = [&](uint a) { return relative ? llong(a) - 1 - written : llong(a); };
+
+    auto faces = [&](uint z)
+    {
+        for (uint x = 0; x + 1 < side; ++x)
+        {
+            uint a = z * side + x + 1;
+            uint b = a + side;
+            fprintf(file, "f %lld %lld %lld\nf %lld %lld %lld\n", index(a), index(b), index(a + 1),
+                    index(a + 1), index(b), index(b + 1));
+        }
+    };
+
+    for (uint z = 0; z < side; ++z)
+    {
+        for (uint x = 0; x < side; ++x)
+            fprintf(file, "v %.6f %.6f %.6f\n", x * 0.01f, 0.1f * sinf(x * 0.05f) * cosf(z * 0.05f), z * 0.01f);
+        written += side;
+
+        if (relative && z > 0)
+            faces(z - 1);
+    }
+
+    if (!relative)
+        for (uint z = 0; z + 1 < side; ++z)
+            faces(z);
+
+    fclose(file);
+    return true;
+}
+
+// leitura antiga de Camera::readObject: um stringstream e várias cópias da
+// linha por linha, valores lidos com iostreams (índices de 32 bits para
+// que as malhas grandes tenham a mesma saída do ObjLoader)
+static bool LoadObjStream(const string & fileName, vector<Vertex> & vertices, vector<uint> & indices)
+{
+    ifstream fin(fileName);
+    if (!fin.is_open())
+        return false;
+
+    const XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    string line;
+
+    while (fin.good())
+    {
+        getline(fin, line);
+        stringstream flush(line, stringstream::in);
+
+        string s;
+        flush >> s;
+
+        if (flush.str().size() < 2)
+            continue;
+
+        if (flush.str()[0] == 'v' && (flush.str()[1] == 'n' || flush.str()[1] == 't'))
+            continue;
+
+        if (flush.str()[0] == 'v')
+        {
+            Vertex v;
+            v.Color = white;
+            flush >> v.Pos.x >> v.Pos.y >> v.Pos.z;
+            vertices.push_back(v);
+        }
+        else if (flush.str()[0] == 'f')
+        {
+            uint index;
+            while (flush >> index)
+                indices.push_back(index - 1);
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+string ObjBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+
+    for (const ObjBenchmarkRow & row : rows)
+    {
+        text << row.vertices << " vértices (" << row.bytes / 1048576.0 << " MB): stringstream "
+             << row.streamMBps << " MB/s " << row.streamVerticesPerSec / 1e6 << " milhões de vértices/s, ObjLoader "
+             << row.loaderMBps << " MB/s " << row.loaderVerticesPerSec / 1e6 << " milhões de vértices/s ("
+             << (row.streamMBps > 0.0 ? row.loaderMBps / row.streamMBps : 0.0) << "x), "
+             << row.mismatches << " diferenças\n";
+    }
+
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+ObjBenchmark BenchmarkObjLoader(uint minVertices, uint maxVertices, const string & fileName)
+{
+    ObjBenchmark result;
+
+    for (ullong target = std::max(minVertices, 4u); target <= maxVertices; target *= 10)
+    {
+        if (!WriteGridObj(fileName, uint(target)))
+            break;
+
+        ObjBenchmarkRow row = {};
+
+        // leitura antiga
+        vector<Vertex> streamVertices;
+        vector<uint> streamIndices;
+        Timer timer;
+        timer.Start();
+        LoadObjStream(fileName, streamVertices, streamIndices);
+        double streamSeconds = timer.Elapsed();
+
+        // leitura nova em uma thread
+        ObjLoader loader;
+        loader.Threads(1);
+        vector<Vertex> vertices;
+        vector<uint> indices;
+        loader.Load(fileName, vertices, indices);
+        const ObjStats & stats = loader.Stats();
+
+        row.vertices = stats.positions;
+        row.bytes = stats.bytes;
+        row.streamMBps = streamSeconds > 0.0 ? (stats.bytes / 1048576.0) / streamSeconds : 0.0;
+        row.streamVerticesPerSec = streamSeconds > 0.0 ? stats.positions / streamSeconds : 0.0;
+        row.loaderMBps = stats.MBps();
+        row.loaderVerticesPerSec = stats.VerticesPerSec();
+
+        // as duas leituras devem produzir os mesmos vértices e índices
+        if (streamVertices.size() != vertices.size() || streamIndices.size() != indices.size())
+        {
+            row.mismatches = uint(std::max(streamVertices.size(), vertices.size()));
+        }
+        else
+        {
+            for (size_t i = 0; i < vertices.size(); ++i)
+                if (memcmp(&vertices[i].Pos, &streamVertices[i].Pos, sizeof(XMFLOAT3)) != 0)
+                    ++row.mismatches;
+
+            for (size_t i = 0; i < indices.size(); ++i)
+                if (indices[i] != streamIndices[i])
+                    ++row.mismatches;
+        }
+
+        result.rows.push_back(row);
+    }
+
+    remove(fileName.c_str());
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+
+string ObjScalingBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << vertices << " vértices (" << bytes / 1048576.0 << " MB):";
+
+    for (const ObjScalingRow & row : rows)
+    {
+        text << "\n" << row.threads << " thread(s): " << row.seconds * 1000.0 << " ms, "
+             << row.MBps << " MB/s, " << row.speedup << "x ("
+             << 100.0 * row.speedup / row.threads << "% de eficiência)"
+             << (row.identical ? "" : ", SAÍDA DIFERENTE da sequencial");
+    }
+
+    text << "\n";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+ObjScalingBenchmark BenchmarkObjScaling(uint vertices, uint maxThreads, const string & fileName)
+{
+    ObjScalingBenchmark result = {};
+    if (!WriteGridObj(fileName, std::max(vertices, 4u), true))
+        return result;
+
+    // leitura sequencial de referência
+    ObjLoader serial;
+    vector<Vertex> serialVertices;
+    vector<uint> serialIndices;
+    serial.Load(fileName, serialVertices, serialIndices);
+
+    result.vertices = serial.Stats().positions;
+    result.bytes = serial.Stats().bytes;
+
+    maxThreads = std::min(std::max(maxThreads, 1u), uint(JobSystem::MaxThreads));
+    double oneThread = 0.0;
+
+    for (uint threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        // um único conjunto de threads atende as duas passagens
+        JobSystem pool(threads);
+        ObjLoader loader;
+        loader.Jobs(&pool);
+
+        // o arquivo já está no cache do sistema após a leitura de referência
+        vector<Vertex> loadedVertices;
+        vector<uint> loadedIndices;
+        loader.Load(fileName, loadedVertices, loadedIndices);
+
+        ObjScalingRow row = {};
+        row.threads = threads;
+        row.seconds = loader.Stats().seconds;
+        row.MBps = loader.Stats().MBps();
+        if (threads == 1)
+            oneThread = row.seconds;
+        row.speedup = row.seconds > 0.0 ? oneThread / row.seconds : 0.0;
+        row.identical = loadedVertices.size() == serialVertices.size()
+            && loadedIndices == serialIndices
+            && memcmp(loadedVertices.data(), serialVertices.data(), serialVertices.size() * sizeof(Vertex)) == 0;
+
+        result.rows.push_back(row);
+    }
+
+    remove(fileName.c_str());
+    return result;
+}
+
+// -------------------------------------------------------------------------------
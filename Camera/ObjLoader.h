@@ -0,0 +1,180 @@
+/**********************************************************************************
+// ObjLoader (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Carrega malhas no formato Wavefront OBJ a partir de um
+//              arquivo mapeado em memória. O arquivo é percorrido duas
+//              vezes: a primeira conta os elementos para pré-alocar os
+//              vetores de saída e a segunda converte os valores direto
+//              para os vértices e índices, sem alocações intermediárias
+//              e sem depender da localidade (locale) do sistema.
+//
+//              Arquivos grandes são divididos em trechos terminados em
+//              quebra de linha e processados em paralelo pelas threads do
+//              sistema de trabalhos. Uma soma prefixada das contagens de
+//              cada trecho define onde cada um escreve, de forma que a
+//              saída é idêntica à da leitura sequencial, inclusive para
+//              índices negativos.
+//
+//              Com a soldagem ativada, cada tripla (v, vt, vn) distinta
+//              das faces vira um único vértice de saída, encontrado por
+//              uma tabela hash de endereçamento aberto dimensionada pelo
+//              número de cantos das faces.
+//
+**********************************************************************************/
+
+#ifndef DXUT_OBJLOADER_H
+#define DXUT_OBJLOADER_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Vertex.h"                     // formato dos vértices
+#include "JobSystem.h"                  // leitura dos trechos em paralelo
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+struct ObjStats
+{
+    ullong bytes;                       // tamanho do arquivo em bytes
+    uint   positions;                   // número de linhas "v"
+    uint   texcoords;                   // número de linhas "vt"
+    uint   normals;                     // número de linhas "vn"
+    uint   faces;                       // número de linhas "f"
+    uint   triangles;                   // triângulos gerados pelas faces
+    uint   threads;                     // threads usadas na leitura
+    uint   vertices;                    // vértices de saída
+    double seconds;                     // tempo total de carga
+    double weldSeconds;                 // tempo da soldagem de vértices
+
+    double MBps() const;                // vazão em megabytes por segundo
+    double VerticesPerSec() const;      // vazão em vértices por segundo
+    double UniqueRatio() const;         // vértices únicos por canto de triângulo
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// atributos por vértice de saída (preenchidos apenas com soldagem)
+struct ObjAttributes
+{
+    vector<XMFLOAT2> texcoords;         // vazio se o arquivo não tem "vt"
+    vector<XMFLOAT3> normals;           // vazio se o arquivo não tem "vn"
+};
+
+// -------------------------------------------------------------------------------
+
+class ObjLoader
+{
+private:
+    ObjStats stats;                     // estatísticas da última carga
+    JobSystem * jobs;                   // threads que leem os trechos (nulo = sequencial)
+    uint threads;                       // trechos do arquivo (0 = um por thread de jobs)
+    bool weld;                          // solda triplas (v, vt, vn) em vértices únicos
+
+public:
+    static const ullong MinChunkSize = 1 << 20;   // menor trecho dado a uma thread
+
+    ObjLoader();                        // construtor
+
+    void Jobs(JobSystem * pool);        // sistema de trabalhos usado nas passagens
+    void Threads(uint count);           // define número de trechos (0 = automático)
+    void Weld(bool enable);             // liga/desliga a soldagem de vértices
+
+    // carrega vértices e triângulos do arquivo (faces são trianguladas em leque)
+    bool Load(const string & fileName, vector<Vertex> & vertices, vector<uint> & indices,
+              ObjAttributes * attributes = nullptr);
+
+    const ObjStats & Stats() const;     // estatísticas da última carga
+};
+
+// -------------------------------------------------------------------------------
+
+// grava uma grade de aproximadamente "vertices" vértices como um terreno
+// ondulado, com linhas "v x y z" e faces "f a b c"; com relative as faces
+// de cada fileira vêm logo após as posições dela, com índices negativos
+bool WriteGridObj(const string & fileName, uint vertices, bool relative = false);
+
+// -------------------------------------------------------------------------------
+
+// vazão das duas leituras sobre uma malha gerada
+struct ObjBenchmarkRow
+{
+    uint   vertices;                    // vértices da malha
+    ullong bytes;                       // tamanho do arquivo
+    double streamMBps;                  // leitura antiga: um stringstream por linha
+    double streamVerticesPerSec;
+    double loaderMBps;                  // ObjLoader com uma thread
+    double loaderVerticesPerSec;
+    uint   mismatches;                  // vértices ou índices diferentes entre as leituras
+};
+
+// comparação do ObjLoader com a leitura antiga de Camera::readObject
+struct ObjBenchmark
+{
+    vector<ObjBenchmarkRow> rows;       // uma linha por tamanho de malha
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// grava malhas em grade de minVertices até maxVertices vértices (multiplicando
+// por 10) em fileName e mede as duas leituras sobre cada uma
+ObjBenchmark BenchmarkObjLoader(uint minVertices = 1000, uint maxVertices = 10000000,
+                                const string & fileName = "objbench.obj");
+
+// -------------------------------------------------------------------------------
+
+// tempo de leitura com um número de threads
+struct ObjScalingRow
+{
+    uint   threads;                     // threads do sistema de trabalhos
+    double seconds;                     // tempo da carga
+    double MBps;                        // vazão em megabytes por segundo
+    double speedup;                     // tempo com uma thread / tempo
+    bool   identical;                   // saída idêntica à leitura sequencial
+};
+
+// escala da leitura em trechos paralelos
+struct ObjScalingBenchmark
+{
+    uint   vertices;                    // vértices da malha
+    ullong bytes;                       // tamanho do arquivo
+    vector<ObjScalingRow> rows;         // uma linha por número de threads
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// grava uma grade de "vertices" vértices com faces de índices negativos
+// intercaladas às posições e a lê com 1, 2, 4 ... maxThreads threads
+ObjScalingBenchmark BenchmarkObjScaling(uint vertices = 10000000, uint maxThreads = 16,
+                                        const string & fileName = "objbench.obj");
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// sistema de trabalhos usado nas duas passagens (nulo = sequencial)
+inline void ObjLoader::Jobs(JobSystem * pool)
+{ jobs = pool; }
+
+// define número de trechos lidos em paralelo (0 = automático)
+inline void ObjLoader::Threads(uint count)
+{ threads = count; }
+
+// liga/desliga a soldagem de vértices
+inline void ObjLoader::Weld(bool enable)
+{ weld = enable; }
+
+// retorna estatísticas da última carga
+inline const ObjStats & ObjLoader::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
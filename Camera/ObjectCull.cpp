@@ -0,0 +1,437 @@
+/**********************************************************************************
+// ObjectCull (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Descarte de objetos fora do volume de visão.
+//
+**********************************************************************************/
+
+#include "ObjectCull.h"
+#include "Timer.h"
+#include <immintrin.h>                  // SSE e AVX
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+Frustum ExtractFrustum(const XMFLOAT4X4 & viewProj)
+{
+    // com vetores linha, cada plano combina colunas da matriz:
+    // esquerdo, direito, inferior, superior, próximo (z >= 0) e distante
+    const XMFLOAT4X4 & m = viewProj;
+    XMVECTOR col0 = XMVectorSet(m._11, m._21, m._31, m._41);
+    XMVECTOR col1 = XMVectorSet(m._12, m._22, m._32, m._42);
+    XMVECTOR col2 = XMVectorSet(m._13, m._23, m._33, m._43);
+    XMVECTOR col3 = XMVectorSet(m._14, m._24, m._34, m._44);
+
+    XMVECTOR planes[6] =
+    {
+        col3 + col0, col3 - col0,
+        col3 + col1, col3 - col1,
+        col2,        col3 - col2
+    };
+
+    Frustum frustum;
+    for (uint p = 0; p < 6; ++p)
+        XMStoreFloat4(&frustum.planes[p], XMPlaneNormalize(planes[p]));
+
+    return frustum;
+}
+
+// -------------------------------------------------------------------------------
+
+void ObjectBounds::Resize(uint count)
+{
+    for (vector<float> * element : { &x, &y, &z, &radius, &ex, &ey, &ez })
+        element->resize(count, 0.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+void ObjectBounds::SetSphere(uint i, const XMFLOAT3 & center, float r)
+{
+    x[i] = center.x;
+    y[i] = center.y;
+    z[i] = center.z;
+    radius[i] = r;
+    ex[i] = ey[i] = ez[i] = r;
+}
+
+// -------------------------------------------------------------------------------
+
+void ObjectBounds::SetBox(uint i, const XMFLOAT3 & center, const XMFLOAT3 & extents)
+{
+    x[i] = center.x;
+    y[i] = center.y;
+    z[i] = center.z;
+    ex[i] = extents.x;
+    ey[i] = extents.y;
+    ez[i] = extents.z;
+    radius[i] = std::sqrt(extents.x * extents.x + extents.y * extents.y + extents.z * extents.z);
+}
+
+// -------------------------------------------------------------------------------
+
+void ObjectBounds::SetBox(uint i, const XMFLOAT3 & center, const XMFLOAT3 & extents, const XMFLOAT4X4 & world)
+{
+    // o centro é transformado e cada meia extensão é a soma dos eixos
+    // transformados em valor absoluto (Arvo, 1990)
+    const float * c = &center.x;
+    const float * e = &extents.x;
+
+    XMFLOAT3 worldCenter;
+    XMFLOAT3 worldExtents;
+    float * wc = &worldCenter.x;
+    float * we = &worldExtents.x;
+
+    for (uint j = 0; j < 3; ++j)
+    {
+        wc[j] = world.m[3][j];
+        we[j] = 0.0f;
+        for (uint k = 0; k < 3; ++k)
+        {
+            wc[j] += c[k] * world.m[k][j];
+            we[j] += e[k] * std::fabs(world.m[k][j]);
+        }
+    }
+
+    SetBox(i, worldCenter, worldExtents);
+}
+
+// -------------------------------------------------------------------------------
+
+string ObjectCullStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << visible << "/" << objects << " objetos visíveis, "
+         << culled << " fora da visão, "
+         << seconds * 1000.0 << " ms";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+// Esfera: centro a mais de -raio de todos os planos.
+// Caixa: distância do centro mais a projeção da meia extensão sobre a normal
+// (em valor absoluto) não negativa em todos os planos.
+//
+// A lista é gravada sem desvios: cada objeto grava seu índice na próxima
+// posição e só avança a posição se for visível.
+
+static uint CullScalar(const Frustum & f, const ObjectBounds & b, CullVolume volume,
+                       uint first, uint count, uint * visible)
+{
+    uint n = 0;
+    for (uint i = 0; i < count; ++i)
+    {
+        uint s = first + i;
+        bool inside = true;
+
+        for (uint p = 0; p < 6; ++p)
+        {
+            const XMFLOAT4 & pl = f.planes[p];
+            float d = b.x[s] * pl.x + b.y[s] * pl.y + b.z[s] * pl.z + pl.w;
+
+            if (volume == CULL_SPHERE)
+                inside &= d >= -b.radius[s];
+            else
+                inside &= d + (b.ex[s] * std::fabs(pl.x) + b.ey[s] * std::fabs(pl.y) + b.ez[s] * std::fabs(pl.z)) >= 0.0f;
+        }
+
+        visible[n] = s;
+        n += inside;
+    }
+
+    return n;
+}
+
+// -------------------------------------------------------------------------------
+
+static uint CullSse(const Frustum & f, const ObjectBounds & b, CullVolume volume,
+                    uint first, uint count, uint * visible, uint & done)
+{
+    // coeficientes de cada plano replicados nas 4 posições
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (uint p = 0; p < 6; ++p)
+    {
+        px[p] = _mm_set1_ps(f.planes[p].x);
+        py[p] = _mm_set1_ps(f.planes[p].y);
+        pz[p] = _mm_set1_ps(f.planes[p].z);
+        pw[p] = _mm_set1_ps(f.planes[p].w);
+    }
+
+    uint n = 0;
+    uint blocks = count / 4;
+    for (uint k = 0; k < blocks; ++k)
+    {
+        uint s = first + k * 4;
+
+        // mesmo componente de 4 objetos em cada registrador
+        __m128 cx = _mm_loadu_ps(&b.x[s]);
+        __m128 cy = _mm_loadu_ps(&b.y[s]);
+        __m128 cz = _mm_loadu_ps(&b.z[s]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        if (volume == CULL_SPHERE)
+        {
+            __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(&b.radius[s]), sign);
+            for (uint p = 0; p < 6; ++p)
+            {
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, px[p]), _mm_mul_ps(cy, py[p])), _mm_mul_ps(cz, pz[p])), pw[p]);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negRadius));
+            }
+        }
+        else
+        {
+            __m128 hx = _mm_loadu_ps(&b.ex[s]);
+            __m128 hy = _mm_loadu_ps(&b.ey[s]);
+            __m128 hz = _mm_loadu_ps(&b.ez[s]);
+            for (uint p = 0; p < 6; ++p)
+            {
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, px[p]), _mm_mul_ps(cy, py[p])), _mm_mul_ps(cz, pz[p])), pw[p]);
+                __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, _mm_andnot_ps(sign, px[p])), _mm_mul_ps(hy, _mm_andnot_ps(sign, py[p]))),
+                                      _mm_mul_ps(hz, _mm_andnot_ps(sign, pz[p])));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(d, e), _mm_setzero_ps()));
+            }
+        }
+
+        // um bit por objeto visível
+        int mask = _mm_movemask_ps(inside);
+        for (uint j = 0; j < 4; ++j)
+        {
+            visible[n] = s + j;
+            n += (mask >> j) & 1;
+        }
+    }
+
+    done = blocks * 4;
+    return n;
+}
+
+// -------------------------------------------------------------------------------
+
+DXUT_TARGET_AVX
+static uint CullAvx(const Frustum & f, const ObjectBounds & b, CullVolume volume,
+                    uint first, uint count, uint * visible, uint & done)
+{
+    // coeficientes de cada plano replicados nas 8 posições
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 px[6], py[6], pz[6], pw[6];
+    for (uint p = 0; p < 6; ++p)
+    {
+        px[p] = _mm256_set1_ps(f.planes[p].x);
+        py[p] = _mm256_set1_ps(f.planes[p].y);
+        pz[p] = _mm256_set1_ps(f.planes[p].z);
+        pw[p] = _mm256_set1_ps(f.planes[p].w);
+    }
+
+    uint n = 0;
+    uint blocks = count / 8;
+    for (uint k = 0; k < blocks; ++k)
+    {
+        uint s = first + k * 8;
+
+        // mesmo componente de 8 objetos em cada registrador
+        __m256 cx = _mm256_loadu_ps(&b.x[s]);
+        __m256 cy = _mm256_loadu_ps(&b.y[s]);
+        __m256 cz = _mm256_loadu_ps(&b.z[s]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        if (volume == CULL_SPHERE)
+        {
+            __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(&b.radius[s]), sign);
+            for (uint p = 0; p < 6; ++p)
+            {
+                __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, px[p]), _mm256_mul_ps(cy, py[p])), _mm256_mul_ps(cz, pz[p])), pw[p]);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negRadius, _CMP_GE_OQ));
+            }
+        }
+        else
+        {
+            __m256 hx = _mm256_loadu_ps(&b.ex[s]);
+            __m256 hy = _mm256_loadu_ps(&b.ey[s]);
+            __m256 hz = _mm256_loadu_ps(&b.ez[s]);
+            for (uint p = 0; p < 6; ++p)
+            {
+                __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, px[p]), _mm256_mul_ps(cy, py[p])), _mm256_mul_ps(cz, pz[p])), pw[p]);
+                __m256 e = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(hx, _mm256_andnot_ps(sign, px[p])), _mm256_mul_ps(hy, _mm256_andnot_ps(sign, py[p]))),
+                                         _mm256_mul_ps(hz, _mm256_andnot_ps(sign, pz[p])));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(d, e), _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+        }
+
+        // um bit por objeto visível
+        int mask = _mm256_movemask_ps(inside);
+        for (uint j = 0; j < 8; ++j)
+        {
+            visible[n] = s + j;
+            n += (mask >> j) & 1;
+        }
+    }
+
+    // evita a penalidade de transição entre AVX e SSE no código seguinte
+    _mm256_zeroupper();
+    done = blocks * 8;
+    return n;
+}
+
+// -------------------------------------------------------------------------------
+
+uint CullObjects(const Frustum & frustum, const ObjectBounds & bounds, CullVolume volume,
+                 uint first, uint count, uint * visible, SimdKernel kernel)
+{
+    kernel = SupportedSimdKernel(kernel);
+
+    // blocos completos no núcleo SIMD, o restante no escalar
+    uint done = 0;
+    uint n = 0;
+    if (kernel == SIMD_AVX)
+        n = CullAvx(frustum, bounds, volume, first, count, visible, done);
+    else if (kernel == SIMD_SSE)
+        n = CullSse(frustum, bounds, volume, first, count, visible, done);
+
+    return n + CullScalar(frustum, bounds, volume, first + done, count - done, visible + n);
+}
+
+// -------------------------------------------------------------------------------
+// Medição do descarte em lote
+
+string ObjectCullBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << objects << " objetos x " << repeats << ": esferas ("
+         << 100.0 * visibleSpheres / objects << "% visíveis) DirectXMath "
+         << directXMathMs << " ms, escalar SoA " << sphereScalarMs << " ms, SSE "
+         << sphereSseMs << " ms, AVX ";
+    if (sphereAvxMs > 0.0)
+        text << sphereAvxMs << " ms";
+    else
+        text << "sem suporte";
+
+    text << "; caixas (" << 100.0 * visibleBoxes / objects << "% visíveis) escalar SoA "
+         << boxScalarMs << " ms, SSE " << boxSseMs << " ms, AVX ";
+    if (boxAvxMs > 0.0)
+        text << boxAvxMs << " ms";
+    else
+        text << "sem suporte";
+
+    text << "; " << mismatches << " listas diferentes do escalar";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+ObjectCullBenchmark BenchmarkObjectCull(uint objects, uint repeats)
+{
+    Timer timer;
+
+    ObjectCullBenchmark result = {};
+    result.objects = objects ? objects : 1;
+    result.repeats = repeats ? repeats : (20000000 + result.objects - 1) / result.objects;
+
+    uint seed = 2463534242u;
+    auto random = [&seed]()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    };
+    auto uniform = [&random](float low, float high)
+    {
+        return low + (high - low) * float(random() % 65536) / 65535.0f;
+    };
+
+    // objetos espalhados em volta da câmera, com caixas de proporções variadas
+    ObjectBounds spheres;
+    ObjectBounds boxes;
+    spheres.Resize(result.objects);
+    boxes.Resize(result.objects);
+    vector<XMFLOAT4> aos(result.objects);
+
+    for (uint i = 0; i < result.objects; ++i)
+    {
+        XMFLOAT3 center(uniform(-600.0f, 600.0f), uniform(-600.0f, 600.0f), uniform(-200.0f, 1000.0f));
+        XMFLOAT3 extents(uniform(0.5f, 8.0f), uniform(0.5f, 8.0f), uniform(0.5f, 8.0f));
+        boxes.SetBox(i, center, extents);
+        spheres.SetSphere(i, center, boxes.radius[i]);
+        aos[i] = XMFLOAT4(center.x, center.y, center.z, boxes.radius[i]);
+    }
+
+    XMFLOAT4X4 viewProj;
+    XMStoreFloat4x4(&viewProj,
+        XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.2f, 0.1f, 1.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f))
+        * XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 1.0f, 1000.0f));
+    Frustum frustum = ExtractFrustum(viewProj);
+
+    vector<uint> reference(result.objects);
+    vector<uint> output(result.objects);
+
+    // laço com DirectXMath, como no descarte de agrupamentos
+    XMVECTOR planes[6];
+    for (uint p = 0; p < 6; ++p)
+        planes[p] = XMLoadFloat4(&frustum.planes[p]);
+
+    timer.Start();
+    for (uint rep = 0; rep < result.repeats; ++rep)
+    {
+        uint n = 0;
+        for (uint i = 0; i < result.objects; ++i)
+        {
+            XMVECTOR center = XMVectorSetW(XMLoadFloat4(&aos[i]), 1.0f);
+            bool outside = false;
+            for (uint p = 0; p < 6 && !outside; ++p)
+                outside = XMVectorGetX(XMVector4Dot(planes[p], center)) < -aos[i].w;
+
+            if (!outside)
+                output[n++] = i;
+        }
+    }
+    result.directXMathMs = timer.Elapsed() * 1000.0 / result.repeats;
+
+    // núcleos em lote; as listas SIMD devem ser iguais à do escalar
+    auto measure = [&](const ObjectBounds & bounds, CullVolume volume, SimdKernel kernel, uint & visible)
+    {
+        uint n = 0;
+        timer.Start();
+        for (uint rep = 0; rep < result.repeats; ++rep)
+            n = CullObjects(frustum, bounds, volume, 0, result.objects, output.data(), kernel);
+        double ms = timer.Elapsed() * 1000.0 / result.repeats;
+
+        if (kernel == SIMD_SCALAR)
+        {
+            visible = n;
+            reference.assign(output.begin(), output.begin() + n);
+        }
+        else if (n != visible || !std::equal(reference.begin(), reference.end(), output.begin()))
+        {
+            ++result.mismatches;
+        }
+
+        return ms;
+    };
+
+    result.sphereScalarMs = measure(spheres, CULL_SPHERE, SIMD_SCALAR, result.visibleSpheres);
+    result.sphereSseMs = measure(spheres, CULL_SPHERE, SIMD_SSE, result.visibleSpheres);
+    if (BestSimdKernel() == SIMD_AVX)
+        result.sphereAvxMs = measure(spheres, CULL_SPHERE, SIMD_AVX, result.visibleSpheres);
+
+    result.boxScalarMs = measure(boxes, CULL_BOX, SIMD_SCALAR, result.visibleBoxes);
+    result.boxSseMs = measure(boxes, CULL_BOX, SIMD_SSE, result.visibleBoxes);
+    if (BestSimdKernel() == SIMD_AVX)
+        result.boxAvxMs = measure(boxes, CULL_BOX, SIMD_AVX, result.visibleBoxes);
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
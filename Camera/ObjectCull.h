@@ -0,0 +1,134 @@
+/**********************************************************************************
+// ObjectCull (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Descarte de objetos fora do volume de visão.
+//
+//              Os seis planos do volume são extraídos da matriz de visão e
+//              projeção. Os volumes envolventes dos objetos (esfera e caixa
+//              alinhada aos eixos com o mesmo centro) ficam em estrutura de
+//              vetores, e cada plano é testado contra 4 (SSE) ou 8 (AVX)
+//              objetos de uma vez. Os índices dos objetos visíveis são
+//              gravados em uma lista compacta, na ordem original, que
+//              alimenta o envio dos comandos de desenho.
+//
+//              O núcleo AVX só é usado com suporte do processador e do
+//              sistema (Simd.h).
+//
+**********************************************************************************/
+
+#ifndef DXUT_OBJECTCULL_H
+#define DXUT_OBJECTCULL_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Simd.h"                       // escolha do núcleo SIMD
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// volume envolvente testado contra os planos
+enum CullVolume { CULL_SPHERE, CULL_BOX };
+
+// -------------------------------------------------------------------------------
+
+// planos normalizados do volume de visão (dentro: ax + by + cz + d >= 0)
+struct Frustum
+{
+    // esquerdo, direito, inferior, superior, próximo e distante
+    XMFLOAT4 planes[6];
+};
+
+// extrai os planos de uma matriz de visão e projeção (Gribb e Hartmann); com
+// mundo x visão x projeção os planos ficam no espaço do objeto
+Frustum ExtractFrustum(const XMFLOAT4X4 & viewProj);
+
+// -------------------------------------------------------------------------------
+
+// volumes envolventes de objetos em estrutura de vetores
+struct ObjectBounds
+{
+    vector<float> x, y, z;              // centro
+    vector<float> radius;               // raio da esfera envolvente
+    vector<float> ex, ey, ez;           // meia extensão da caixa alinhada aos eixos
+
+    void Resize(uint count);            // ajusta o número de objetos
+    uint Count() const;                 // número de objetos
+
+    // esfera (a caixa é o cubo que a contém)
+    void SetSphere(uint i, const XMFLOAT3 & center, float r);
+
+    // caixa alinhada aos eixos (a esfera é a que a contém)
+    void SetBox(uint i, const XMFLOAT3 & center, const XMFLOAT3 & extents);
+
+    // caixa local levada pela matriz de mundo (caixa alinhada que a contém)
+    void SetBox(uint i, const XMFLOAT3 & center, const XMFLOAT3 & extents, const XMFLOAT4X4 & world);
+};
+
+// -------------------------------------------------------------------------------
+
+// resultado do descarte de objetos
+struct ObjectCullStats
+{
+    uint   objects;                     // objetos testados
+    uint   visible;                     // objetos desenhados
+    uint   culled;                      // objetos fora do volume de visão
+    double seconds;                     // tempo do descarte
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// Testa os objetos [first, first + count) contra o volume de visão e grava
+// em visible (com espaço para count índices) os índices dos que tocam o
+// volume, na ordem original. Retorna o número de objetos visíveis.
+
+uint CullObjects(const Frustum & frustum, const ObjectBounds & bounds, CullVolume volume,
+                 uint first, uint count, uint * visible,
+                 SimdKernel kernel = SIMD_AUTO);
+
+// -------------------------------------------------------------------------------
+
+// medição do descarte em lote contra o laço com DirectXMath
+struct ObjectCullBenchmark
+{
+    uint   objects;                     // objetos por repetição
+    uint   repeats;                     // repetições
+    uint   visibleSpheres;              // esferas visíveis
+    uint   visibleBoxes;                // caixas visíveis
+    double directXMathMs;               // esferas com XMVECTOR (AoS), ms por passada
+    double sphereScalarMs;              // esferas, núcleo escalar (SoA)
+    double sphereSseMs;                 // esferas, núcleo SSE
+    double sphereAvxMs;                 // esferas, núcleo AVX (0 sem suporte)
+    double boxScalarMs;                 // caixas, núcleo escalar (SoA)
+    double boxSseMs;                    // caixas, núcleo SSE
+    double boxAvxMs;                    // caixas, núcleo AVX (0 sem suporte)
+    uint   mismatches;                  // listas diferentes da do núcleo escalar
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// descarta objects objetos espalhados ao redor da câmera repeats vezes
+// com cada implementação (repeats = 0 mantém cerca de 20 milhões de testes)
+ObjectCullBenchmark BenchmarkObjectCull(uint objects = 100000, uint repeats = 0);
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// número de objetos
+inline uint ObjectBounds::Count() const
+{ return uint(x.size()); }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -1,12 +1,12 @@
 /**********************************************************************************
 // Pixel (Arquivo de Sombreamento)
 //
-// Criao:     22 Jul 2020
-// Atualizao: 14 Ago 2021
+// Criação:     22 Jul 2020
+// Atualização: 14 Ago 2021
 // Compilador:  D3DCompiler
 //
-// Descrio:   Um pixel shader simples que apenas passa a cor do pixel
-//              para frente sem realizar nenhuma modificao.
+// Descrição:   Um pixel shader simples que apenas passa a cor do pixel
+//              para frente sem realizar nenhuma modificação.
 //
 **********************************************************************************/
 
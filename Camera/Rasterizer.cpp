@@ -0,0 +1,1045 @@
+/**********************************************************************************
+// Rasterizer (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Renderizador em software para máquinas sem GPU. Transforma,
+//              recorta e distribui os triângulos em tiles a cada desenho e
+//              rasteriza os tiles em paralelo na apresentação do quadro.
+//
+**********************************************************************************/
+
+#include "Rasterizer.h"
+#include <DirectXPackedVector.h>
+#include <emmintrin.h>                  // SSE2
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+using std::stringstream;
+using std::function;
+using std::lock_guard;
+using std::unique_lock;
+
+// -------------------------------------------------------------------------------
+
+// bits de subpixel das coordenadas de tela (1/16 de pixel)
+static const int SubBits = 4;
+static const int SubPixel = 1 << SubBits;
+
+// maior distância ao centro da tela, em pixels, coberta pela banda de guarda
+static const float GuardPixels = 16384.0f;
+
+// triângulos mínimos por trecho de um desenho dividido entre threads
+static const uint MinChunkTriangles = 1024;
+
+// vértices por item da transformação paralela
+static const uint TransformBlock = 4096;
+
+// maior valor de profundidade em 24 bits
+static const uint DepthMax = 0xFFFFFF;
+
+// segundos transcorridos desde um instante
+static inline double Seconds(std::chrono::steady_clock::time_point start)
+{ return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+
+// -------------------------------------------------------------------------------
+
+string RasterStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << triangles << " triângulos (" << culled << " descartados, "
+         << clipped << " recortados), " << binned << " em tiles, "
+         << pixels << " pixels, distribuição " << binSeconds * 1000.0
+         << " ms, rasterização " << rasterSeconds * 1000.0 << " ms";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+string RasterBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << width << "x" << height << ", " << threads << " thread(s): "
+         << trianglesPerSec / 1e6 << " Mtri/s (" << meshFrameMs << " ms/quadro), "
+         << pixelsPerSec / 1e6 << " Mpixels/s (" << fillFrameMs << " ms/quadro)";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+Rasterizer::Rasterizer()
+{
+    width = height = pitch = 0;
+    tilesX = tilesY = 0;
+    guard = 1.0f;
+    clearColor = 0;
+    clearPending = false;
+
+    vertexData = nullptr;
+    vertexStride = 0;
+    vertexCount = 0;
+    vertexFormat = VERTEX_FLOAT;
+    indexData = nullptr;
+    indexSize = 4;
+    memset(constants, 0, sizeof(constants));
+    constants[0] = constants[5] = constants[10] = constants[15] = 1.0f;
+    instanceData = nullptr;
+    instanceTotal = 0;
+    transformMatrix = nullptr;
+    transformValid = false;
+
+    order = 0;
+    stats = {};
+    last = {};
+
+    job = nullptr;
+    next = 0;
+    jobCount = 0;
+    busy = 0;
+    generation = 0;
+    quit = false;
+}
+
+// -------------------------------------------------------------------------------
+
+Rasterizer::~Rasterizer()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+
+    for (std::thread & t : workers)
+        t.join();
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::Initialize(uint w, uint h, uint threads)
+{
+    width = std::min(std::max(w, 1u), MaxSize);
+    height = std::min(std::max(h, 1u), MaxSize);
+    pitch = (width + 3) & ~3u;
+    tilesX = (width + TileSize - 1) / TileSize;
+    tilesY = (height + TileSize - 1) / TileSize;
+
+    // a banda de guarda mantém as coordenadas em subpixels abaixo de 2^18
+    guard = 2.0f * GuardPixels / std::max(width, height) - 1.0f;
+
+    color.assign(size_t(pitch) * height, 0);
+    depth.assign(size_t(pitch) * height, DepthMax);
+
+    // threads de trabalho (a chamadora também trabalha)
+    uint count = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    count = std::min(count, MaxThreads);
+
+    if (count != workers.size() + 1)
+    {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_all();
+
+        for (std::thread & t : workers)
+            t.join();
+
+        workers.clear();
+        quit = false;
+        generation = 0;
+
+        for (uint i = 1; i < count; ++i)
+            workers.emplace_back(&Rasterizer::WorkerLoop, this, i);
+    }
+
+    setup.assign(count, {});
+    bins.assign(count, vector<vector<uint>>(size_t(tilesX) * tilesY));
+    order = 0;
+}
+
+// -------------------------------------------------------------------------------
+// Threads de trabalho
+
+void Rasterizer::WorkerLoop(uint worker)
+{
+    uint seen = 0;
+
+    for (;;)
+    {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return quit || generation != seen; });
+            if (quit)
+                return;
+            seen = generation;
+        }
+
+        Work(worker);
+
+        {
+            lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)
+                done.notify_one();
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::Work(uint worker)
+{
+    for (uint i = next++; i < jobCount; i = next++)
+        (*job)(i, worker);
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::Parallel(uint count, const function<void(uint, uint)> & func)
+{
+    if (count == 0)
+        return;
+
+    // trabalho pequeno não compensa acordar as threads
+    if (workers.empty() || count == 1)
+    {
+        for (uint i = 0; i < count; ++i)
+            func(i, 0);
+        return;
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        job = &func;
+        jobCount = count;
+        next = 0;
+        busy = uint(workers.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    Work(0);
+
+    unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+// -------------------------------------------------------------------------------
+// Entrada
+
+void Rasterizer::SetVertexBuffer(const void * vertices, uint stride, uint count, VertexFormatType format)
+{
+    vertexData = (const byte*) vertices;
+    vertexStride = stride;
+    vertexCount = count;
+    vertexFormat = format;
+    transformValid = false;
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::SetIndexBuffer(const void * indices, DXGI_FORMAT format)
+{
+    indexData = (const byte*) indices;
+    indexSize = (format == DXGI_FORMAT_R16_UINT) ? sizeof(ushort) : sizeof(uint);
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::SetConstants(const void * objectConstants)
+{
+    // mesmo layout do cbuffer: float4x4 WorldViewProj, float4 PosScale, float4 PosBias
+    memcpy(constants, objectConstants, sizeof(constants));
+    transformValid = false;
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::SetInstances(const XMFLOAT4X4 * matrices, uint count)
+{
+    instanceData = matrices;
+    instanceTotal = matrices ? count : 0;
+    transformValid = false;
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::Clear(const float rgba[4])
+{
+    // a limpeza é feita por tile na rasterização
+    clearColor = PackColor(XMFLOAT4(rgba));
+    clearPending = true;
+
+    // desenhos anteriores à limpeza não aparecem no quadro
+    for (uint c = 0; c < setup.size(); ++c)
+    {
+        setup[c].clear();
+        for (vector<uint> & bin : bins[c])
+            bin.clear();
+    }
+}
+
+// -------------------------------------------------------------------------------
+// Vertex shader
+
+void Rasterizer::Transform(const float * m)
+{
+    transformed.resize(vertexCount);
+
+    // as linhas da matriz gravada (transposta) são as colunas da matriz combinada
+    const float * scale = constants + 16;
+    const float * bias = constants + 20;
+
+    Parallel((vertexCount + TransformBlock - 1) / TransformBlock, [&](uint item, uint)
+    {
+        uint first = item * TransformBlock;
+        uint last = std::min(vertexCount, first + TransformBlock);
+
+        for (uint v = first; v < last; ++v)
+        {
+            const byte * src = vertexData + size_t(v) * vertexStride;
+            float pos[3];
+            XMFLOAT4 rgba;
+
+            if (vertexFormat == VERTEX_FLOAT)
+            {
+                // Vertex.hlsl: posição e cor em ponto flutuante
+                memcpy(pos, src + offsetof(Vertex, Pos), sizeof(pos));
+                memcpy(&rgba, src + offsetof(Vertex, Color), sizeof(rgba));
+            }
+            else
+            {
+                // VertexPacked.hlsl: posição normalizada na caixa envolvente
+                ushort q[4];
+                uint packed;
+                memcpy(q, src + offsetof(PackedVertex, Pos), sizeof(q));
+                memcpy(&packed, src + offsetof(PackedVertex, Color), sizeof(packed));
+
+                for (uint i = 0; i < 3; ++i)
+                {
+                    float n = (vertexFormat == VERTEX_HALF)
+                        ? PackedVector::XMConvertHalfToFloat(q[i])
+                        : q[i] / 65535.0f;
+                    pos[i] = bias[i] + scale[i] * n;
+                }
+
+                rgba = UnpackColor(packed);
+            }
+
+            ClipVertex & out = transformed[v];
+            out.x = m[0] * pos[0] + m[1] * pos[1] + m[2] * pos[2] + m[3];
+            out.y = m[4] * pos[0] + m[5] * pos[1] + m[6] * pos[2] + m[7];
+            out.z = m[8] * pos[0] + m[9] * pos[1] + m[10] * pos[2] + m[11];
+            out.w = m[12] * pos[0] + m[13] * pos[1] + m[14] * pos[2] + m[15];
+            out.r = rgba.x;
+            out.g = rgba.y;
+            out.b = rgba.z;
+            out.a = rgba.w;
+        }
+    });
+}
+
+// -------------------------------------------------------------------------------
+// Recorte
+
+// planos de recorte na forma dot(plano, (x, y, z, w)) >= 0
+enum ClipPlane { CLIP_NEAR, CLIP_FAR, CLIP_LEFT, CLIP_RIGHT, CLIP_BOTTOM, CLIP_TOP, CLIP_PLANES };
+
+// distância com sinal do vértice a um plano de recorte
+static inline float PlaneDistance(const ClipVertex & v, uint plane, float g)
+{
+    switch (plane)
+    {
+    case CLIP_NEAR:   return v.z;
+    case CLIP_FAR:    return v.w - v.z;
+    case CLIP_LEFT:   return v.x + g * v.w;
+    case CLIP_RIGHT:  return g * v.w - v.x;
+    case CLIP_BOTTOM: return v.y + g * v.w;
+    default:          return g * v.w - v.y;
+    }
+}
+
+// bits dos planos que o vértice viola (g é a extensão em x e y)
+static inline uint OutCode(const ClipVertex & v, float g)
+{
+    uint code = 0;
+    for (uint p = 0; p < CLIP_PLANES; ++p)
+        if (PlaneDistance(v, p, g) < 0.0f)
+            code |= 1 << p;
+    return code;
+}
+
+// recorta um polígono convexo contra um plano (Sutherland-Hodgman)
+static uint ClipPolygon(const ClipVertex * in, uint count, ClipVertex * out, uint plane, float g)
+{
+    uint written = 0;
+
+    for (uint i = 0; i < count; ++i)
+    {
+        const ClipVertex & a = in[i];
+        const ClipVertex & b = in[(i + 1) % count];
+        float da = PlaneDistance(a, plane, g);
+        float db = PlaneDistance(b, plane, g);
+
+        if (da >= 0.0f)
+            out[written++] = a;
+
+        // a aresta cruza o plano
+        if ((da >= 0.0f) != (db >= 0.0f))
+        {
+            float t = da / (da - db);
+            const float * pa = &a.x;
+            const float * pb = &b.x;
+            float * po = &out[written++].x;
+            for (uint k = 0; k < 8; ++k)
+                po[k] = pa[k] + t * (pb[k] - pa[k]);
+        }
+    }
+
+    return written;
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::BinTriangle(const ClipVertex * v, uint chunk, uint triangleOrder, RasterStats & counters)
+{
+    // inteiramente fora do volume de visão
+    if (OutCode(v[0], 1.0f) & OutCode(v[1], 1.0f) & OutCode(v[2], 1.0f))
+    {
+        ++counters.culled;
+        return;
+    }
+
+    uint needs = OutCode(v[0], guard) | OutCode(v[1], guard) | OutCode(v[2], guard);
+
+    if (!needs)
+    {
+        SetupTriangle(v[0], v[1], v[2], chunk, triangleOrder, counters);
+        return;
+    }
+
+    // recorta contra os planos violados (até 3 + 6 vértices)
+    ClipVertex polygon[2][12];
+    uint count = 3;
+    uint current = 0;
+    memcpy(polygon[0], v, 3 * sizeof(ClipVertex));
+
+    for (uint p = 0; p < CLIP_PLANES && count >= 3; ++p)
+    {
+        if (needs & (1 << p))
+        {
+            count = ClipPolygon(polygon[current], count, polygon[current ^ 1], p, guard);
+            current ^= 1;
+        }
+    }
+
+    ++counters.clipped;
+
+    if (count < 3)
+    {
+        ++counters.culled;
+        return;
+    }
+
+    // leque de triângulos com a mesma ordem de envio
+    for (uint i = 1; i + 1 < count; ++i)
+        SetupTriangle(polygon[current][0], polygon[current][i], polygon[current][i + 1], chunk, triangleOrder, counters);
+}
+
+// -------------------------------------------------------------------------------
+// Preparação dos triângulos
+
+void Rasterizer::SetupTriangle(const ClipVertex & v0, const ClipVertex & v1, const ClipVertex & v2,
+                               uint chunk, uint triangleOrder, RasterStats & counters)
+{
+    const ClipVertex * v[3] = { &v0, &v1, &v2 };
+
+    // divisão perspectiva e viewport, com posições em subpixels
+    int X[3], Y[3];
+    float Z[3], IW[3];
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        IW[i] = 1.0f / v[i]->w;
+        float sx = (v[i]->x * IW[i] * 0.5f + 0.5f) * width;
+        float sy = (0.5f - v[i]->y * IW[i] * 0.5f) * height;
+        X[i] = int(floorf(sx * SubPixel + 0.5f));
+        Y[i] = int(floorf(sy * SubPixel + 0.5f));
+        Z[i] = v[i]->z * IW[i];
+    }
+
+    llong area = llong(X[1] - X[0]) * (Y[2] - Y[0]) - llong(Y[1] - Y[0]) * (X[2] - X[0]);
+
+    // triângulo degenerado depois do ajuste à grade de subpixels
+    if (area == 0)
+    {
+        ++counters.culled;
+        return;
+    }
+
+    // o pipeline não descarta faces: vira a ordem dos de área negativa
+    if (area < 0)
+    {
+        std::swap(v[1], v[2]);
+        std::swap(X[1], X[2]);
+        std::swap(Y[1], Y[2]);
+        std::swap(Z[1], Z[2]);
+        std::swap(IW[1], IW[2]);
+        area = -area;
+    }
+
+    RasterTriangle tri;
+
+    // pixels cujos centros podem estar dentro do triângulo
+    int minSX = std::min(X[0], std::min(X[1], X[2]));
+    int maxSX = std::max(X[0], std::max(X[1], X[2]));
+    int minSY = std::min(Y[0], std::min(Y[1], Y[2]));
+    int maxSY = std::max(Y[0], std::max(Y[1], Y[2]));
+
+    const int Half = SubPixel / 2;
+    tri.minX = std::max(0, (minSX - Half + SubPixel - 1) >> SubBits);
+    tri.minY = std::max(0, (minSY - Half + SubPixel - 1) >> SubBits);
+    tri.maxX = std::min(int(width) - 1, (maxSX - Half) >> SubBits);
+    tri.maxY = std::min(int(height) - 1, (maxSY - Half) >> SubBits);
+
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+    {
+        ++counters.culled;
+        return;
+    }
+
+    // arestas opostas a cada vértice: E(p) = (b - a) x (p - a)
+    for (uint e = 0; e < 3; ++e)
+    {
+        uint a = (e + 1) % 3;
+        uint b = (e + 2) % 3;
+
+        tri.edgeA[e] = Y[a] - Y[b];
+        tri.edgeB[e] = X[b] - X[a];
+        tri.edgeC[e] = llong(X[a]) * Y[b] - llong(Y[a]) * X[b];
+
+        // regra top-left: pixels sobre arestas que não são superiores
+        // nem esquerdas ficam de fora
+        int dx = X[b] - X[a];
+        int dy = Y[b] - Y[a];
+        bool topLeft = (dy == 0 && dx > 0) || dy < 0;
+        if (!topLeft)
+            tri.edgeC[e] -= 1;
+    }
+
+    // planos dos atributos em pixels a partir do primeiro vértice
+    float x0 = X[0] / float(SubPixel), y0 = Y[0] / float(SubPixel);
+    float dx1 = X[1] / float(SubPixel) - x0, dy1 = Y[1] / float(SubPixel) - y0;
+    float dx2 = X[2] / float(SubPixel) - x0, dy2 = Y[2] / float(SubPixel) - y0;
+    float invArea = 1.0f / (dx1 * dy2 - dy1 * dx2);
+
+    float attributes[6][3] =
+    {
+        { Z[0], Z[1], Z[2] },
+        { IW[0], IW[1], IW[2] },
+        { v[0]->r * IW[0], v[1]->r * IW[1], v[2]->r * IW[2] },
+        { v[0]->g * IW[0], v[1]->g * IW[1], v[2]->g * IW[2] },
+        { v[0]->b * IW[0], v[1]->b * IW[1], v[2]->b * IW[2] },
+        { v[0]->a * IW[0], v[1]->a * IW[1], v[2]->a * IW[2] }
+    };
+
+    for (uint k = 0; k < 6; ++k)
+    {
+        float d1 = attributes[k][1] - attributes[k][0];
+        float d2 = attributes[k][2] - attributes[k][0];
+        tri.plane[k][0] = attributes[k][0];
+        tri.plane[k][1] = (d1 * dy2 - d2 * dy1) * invArea;
+        tri.plane[k][2] = (d2 * dx1 - d1 * dx2) * invArea;
+    }
+
+    tri.refX = x0;
+    tri.refY = y0;
+    tri.order = triangleOrder;
+
+    // distribui nos tiles cobertos pela caixa envolvente
+    vector<RasterTriangle> & list = setup[chunk];
+    uint index = uint(list.size());
+    list.push_back(tri);
+
+    for (uint ty = tri.minY / TileSize; ty <= uint(tri.maxY) / TileSize; ++ty)
+    {
+        for (uint tx = tri.minX / TileSize; tx <= uint(tri.maxX) / TileSize; ++tx)
+        {
+            bins[chunk][ty * tilesX + tx].push_back(index);
+            ++counters.binned;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+// Desenho
+
+void Rasterizer::DrawIndexedInstanced(uint indexCount, uint instanceCount,
+                                      uint startIndex, int baseVertex, uint startInstance)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    uint triangleCount = indexCount / 3;
+    if (triangleCount == 0 || !indexData)
+        return;
+
+    // trechos contíguos da lista de índices, um por item paralelo
+    uint chunks = std::min(uint(setup.size()), std::max(1u, triangleCount / MinChunkTriangles));
+
+    for (uint instance = 0; instance < instanceCount; ++instance)
+    {
+        // Instances[SV_InstanceID] dos shaders (sem matrizes das instâncias
+        // vale WorldViewProj do buffer constante para todas as instâncias)
+        const float * m = constants;
+        if (instanceData)
+        {
+            uint id = startInstance + instance;
+            if (id >= instanceTotal)
+            {
+                stats.culled += triangleCount;
+                continue;
+            }
+            m = &instanceData[id]._11;
+        }
+
+        if (!transformValid || m != transformMatrix)
+        {
+            Transform(m);
+            transformMatrix = m;
+            transformValid = true;
+        }
+
+        uint base = order;
+        order += triangleCount;
+
+        Parallel(chunks, [&](uint chunk, uint)
+        {
+            uint first = uint(ullong(triangleCount) * chunk / chunks);
+            uint last = uint(ullong(triangleCount) * (chunk + 1) / chunks);
+            RasterStats counters = {};
+            ClipVertex tri[3];
+
+            for (uint t = first; t < last; ++t)
+            {
+                bool valid = true;
+
+                for (uint k = 0; k < 3; ++k)
+                {
+                    const byte * src = indexData + size_t(startIndex + t * 3 + k) * indexSize;
+                    uint index = 0;
+
+                    if (indexSize == sizeof(ushort))
+                    {
+                        ushort index16;
+                        memcpy(&index16, src, sizeof(index16));
+                        index = index16;
+                    }
+                    else
+                    {
+                        memcpy(&index, src, sizeof(index));
+                    }
+
+                    llong vertex = llong(index) + baseVertex;
+                    if (vertex < 0 || vertex >= llong(vertexCount))
+                    {
+                        valid = false;
+                        break;
+                    }
+
+                    tri[k] = transformed[size_t(vertex)];
+                }
+
+                if (valid)
+                    BinTriangle(tri, chunk, base + t, counters);
+                else
+                    ++counters.culled;
+            }
+
+            lock_guard<std::mutex> lock(mutex);
+            stats.culled += counters.culled;
+            stats.clipped += counters.clipped;
+            stats.binned += counters.binned;
+        });
+    }
+
+    stats.triangles += triangleCount * instanceCount;
+    stats.binSeconds += Seconds(start);
+}
+
+// -------------------------------------------------------------------------------
+// Rasterização
+
+// máscaras de 4 pixels para cada combinação de bits
+static const __m128i LaneMasks[16] =
+{
+    _mm_setr_epi32( 0,  0,  0,  0), _mm_setr_epi32(-1,  0,  0,  0),
+    _mm_setr_epi32( 0, -1,  0,  0), _mm_setr_epi32(-1, -1,  0,  0),
+    _mm_setr_epi32( 0,  0, -1,  0), _mm_setr_epi32(-1,  0, -1,  0),
+    _mm_setr_epi32( 0, -1, -1,  0), _mm_setr_epi32(-1, -1, -1,  0),
+    _mm_setr_epi32( 0,  0,  0, -1), _mm_setr_epi32(-1,  0,  0, -1),
+    _mm_setr_epi32( 0, -1,  0, -1), _mm_setr_epi32(-1, -1,  0, -1),
+    _mm_setr_epi32( 0,  0, -1, -1), _mm_setr_epi32(-1,  0, -1, -1),
+    _mm_setr_epi32( 0, -1, -1, -1), _mm_setr_epi32(-1, -1, -1, -1)
+};
+
+// número de bits de uma máscara de 4 pixels
+static const uint LaneCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// rasteriza um triângulo dentro da região [x0, x1) x [y0, y1)
+static ullong DrawTriangle(const RasterTriangle & tri, int x0, int y0, int x1, int y1,
+                           uint * color, uint * depth, uint pitch)
+{
+    int rx0 = std::max(tri.minX, x0), rx1 = std::min(tri.maxX, x1 - 1);
+    int ry0 = std::max(tri.minY, y0), ry1 = std::min(tri.maxY, y1 - 1);
+
+    if (rx0 > rx1 || ry0 > ry1)
+        return 0;
+
+    // grupos de 4 pixels alinhados ao início da linha
+    int gx0 = rx0 & ~3;
+
+    // funções de aresta no primeiro centro de pixel da região; arestas
+    // que cobrem toda a região são trocadas por constantes positivas,
+    // o que mantém as demais dentro de 32 bits
+    int start[3], stepX[3], stepY[3];
+
+    for (uint e = 0; e < 3; ++e)
+    {
+        llong A = tri.edgeA[e];
+        llong B = tri.edgeB[e];
+        llong E = A * (llong(gx0) * SubPixel + SubPixel / 2) + B * (llong(ry0) * SubPixel + SubPixel / 2) + tri.edgeC[e];
+        llong spanX = A * SubPixel * (rx1 + 3 - gx0);
+        llong spanY = B * SubPixel * (ry1 - ry0);
+        llong low = E + std::min(0ll, spanX) + std::min(0ll, spanY);
+        llong high = E + std::max(0ll, spanX) + std::max(0ll, spanY);
+
+        if (high < 0)
+            return 0;
+
+        if (low >= 0)
+        {
+            start[e] = stepX[e] = stepY[e] = 0;
+        }
+        else
+        {
+            start[e] = int(E);
+            stepX[e] = int(A * SubPixel);
+            stepY[e] = int(B * SubPixel);
+        }
+    }
+
+    __m128i laneX[3], groupX[3];
+    for (uint e = 0; e < 3; ++e)
+    {
+        laneX[e] = _mm_setr_epi32(0, stepX[e], 2 * stepX[e], 3 * stepX[e]);
+        groupX[e] = _mm_set1_epi32(4 * stepX[e]);
+    }
+
+    const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 depthScale = _mm_set1_ps(float(DepthMax));
+    const __m128 colorScale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    ullong shaded = 0;
+    int rowEdge[3] = { start[0], start[1], start[2] };
+
+    for (int y = ry0; y <= ry1; ++y)
+    {
+        __m128i edge[3];
+        for (uint e = 0; e < 3; ++e)
+        {
+            edge[e] = _mm_add_epi32(_mm_set1_epi32(rowEdge[e]), laneX[e]);
+            rowEdge[e] += stepY[e];
+        }
+
+        float fy = y + 0.5f - tri.refY;
+
+        // valores dos planos no início da linha
+        __m128 value[6], stepPixel[6];
+        for (uint k = 0; k < 6; ++k)
+        {
+            float base = tri.plane[k][0] + tri.plane[k][2] * fy + tri.plane[k][1] * (gx0 - tri.refX);
+            value[k] = _mm_add_ps(_mm_set1_ps(base), _mm_mul_ps(_mm_set1_ps(tri.plane[k][1]), offsets));
+            stepPixel[k] = _mm_set1_ps(tri.plane[k][1] * 4.0f);
+        }
+
+        uint * colorRow = color + size_t(y) * pitch;
+        uint * depthRow = depth + size_t(y) * pitch;
+
+        for (int gx = gx0; gx <= rx1; gx += 4)
+        {
+            // pixels dentro das três arestas e da região
+            __m128i inside = _mm_or_si128(edge[0], _mm_or_si128(edge[1], edge[2]));
+            uint covered = ~uint(_mm_movemask_ps(_mm_castsi128_ps(inside))) & 0xF;
+
+            int lo = std::max(0, rx0 - gx);
+            int hi = std::min(3, rx1 - gx);
+            covered &= (0xFu << lo) & (0xFu >> (3 - hi));
+
+            if (covered)
+            {
+                // profundidade em 24 bits e teste LESS
+                __m128 z = _mm_min_ps(_mm_max_ps(value[0], zero), one);
+                __m128i d = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(z, depthScale), half));
+                __m128i oldDepth = _mm_loadu_si128((const __m128i*) (depthRow + gx));
+                uint pass = uint(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(d, oldDepth)))) & covered;
+
+                if (pass)
+                {
+                    __m128i mask = LaneMasks[pass];
+
+                    // cor com correção de perspectiva, saturada em RGBA8
+                    __m128 w = _mm_div_ps(one, value[1]);
+                    __m128i rgba = _mm_setzero_si128();
+                    for (uint k = 0; k < 4; ++k)
+                    {
+                        __m128 c = _mm_min_ps(_mm_max_ps(_mm_mul_ps(value[2 + k], w), zero), one);
+                        __m128i channel = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, colorScale), half));
+                        rgba = _mm_or_si128(rgba, _mm_slli_epi32(channel, int(8 * k)));
+                    }
+
+                    __m128i oldColor = _mm_loadu_si128((const __m128i*) (colorRow + gx));
+                    __m128i newColor = _mm_or_si128(_mm_and_si128(mask, rgba), _mm_andnot_si128(mask, oldColor));
+                    __m128i newDepth = _mm_or_si128(_mm_and_si128(mask, d), _mm_andnot_si128(mask, oldDepth));
+                    _mm_storeu_si128((__m128i*) (colorRow + gx), newColor);
+                    _mm_storeu_si128((__m128i*) (depthRow + gx), newDepth);
+
+                    shaded += LaneCount[pass];
+                }
+            }
+
+            for (uint e = 0; e < 3; ++e)
+                edge[e] = _mm_add_epi32(edge[e], groupX[e]);
+            for (uint k = 0; k < 6; ++k)
+                value[k] = _mm_add_ps(value[k], stepPixel[k]);
+        }
+    }
+
+    return shaded;
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::RasterTile(uint tile, ullong & pixels)
+{
+    int x0 = int(tile % tilesX) * TileSize;
+    int y0 = int(tile / tilesX) * TileSize;
+    int x1 = std::min(int(width), x0 + int(TileSize));
+    int y1 = std::min(int(height), y0 + int(TileSize));
+
+    if (clearPending)
+    {
+        for (int y = y0; y < y1; ++y)
+        {
+            std::fill_n(color.begin() + size_t(y) * pitch + x0, x1 - x0, clearColor);
+            std::fill_n(depth.begin() + size_t(y) * pitch + x0, x1 - x0, DepthMax);
+        }
+    }
+
+    // intercala as listas dos trechos pela ordem de envio
+    uint chunks = uint(setup.size());
+    uint cursor[MaxThreads] = {};
+
+    for (;;)
+    {
+        uint best = chunks;
+        uint bestOrder = UINT_MAX;
+
+        for (uint c = 0; c < chunks; ++c)
+        {
+            const vector<uint> & bin = bins[c][tile];
+            if (cursor[c] < bin.size() && setup[c][bin[cursor[c]]].order < bestOrder)
+            {
+                best = c;
+                bestOrder = setup[c][bin[cursor[c]]].order;
+            }
+        }
+
+        if (best == chunks)
+            break;
+
+        const RasterTriangle & tri = setup[best][bins[best][tile][cursor[best]++]];
+        pixels += DrawTriangle(tri, x0, y0, x1, y1, color.data(), depth.data(), pitch);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Rasterizer::Present()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // um trabalhador por tile, na ordem das linhas de tiles
+    vector<ullong> pixels(workers.size() + 1, 0);
+    Parallel(tilesX * tilesY, [&](uint tile, uint worker) { RasterTile(tile, pixels[worker]); });
+
+    for (ullong count : pixels)
+        stats.pixels += count;
+
+    stats.rasterSeconds = Seconds(start);
+
+    // prepara o próximo quadro
+    for (uint c = 0; c < setup.size(); ++c)
+    {
+        setup[c].clear();
+        for (vector<uint> & bin : bins[c])
+            bin.clear();
+    }
+
+    clearPending = false;
+    order = 0;
+    last = stats;
+    stats = {};
+}
+
+// -------------------------------------------------------------------------------
+// Medição de desempenho
+
+RasterBenchmark BenchmarkRasterizer(uint width, uint height, uint frames, uint threads)
+{
+    RasterBenchmark result = {};
+
+    Rasterizer raster;
+    raster.Initialize(width, height, threads);
+
+    result.width = raster.Width();
+    result.height = raster.Height();
+    result.threads = raster.Threads();
+    result.frames = frames;
+
+    const float background[4] = { 0.12f, 0.12f, 0.12f, 1.0f };
+    float aspect = float(raster.Width()) / raster.Height();
+    XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(45.0f), aspect, 1.0f, 100.0f);
+
+    // ---------------------------------------------------------------
+    // malha densa: esfera com cerca de um milhão de triângulos
+    // ---------------------------------------------------------------
+
+    const uint Rings = 500, Segments = 1000;
+    vector<Vertex> vertices;
+    vector<uint> indices;
+    vertices.reserve((Rings + 1) * (Segments + 1));
+    indices.reserve(Rings * Segments * 6);
+
+    for (uint r = 0; r <= Rings; ++r)
+    {
+        for (uint s = 0; s <= Segments; ++s)
+        {
+            float theta = XM_PI * r / Rings;
+            float phi = XM_2PI * s / Segments;
+            Vertex v;
+            v.Pos = XMFLOAT3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+            v.Color = XMFLOAT4(float(r & 1), float(s & 1), 0.5f, 1.0f);
+            vertices.push_back(v);
+        }
+    }
+
+    for (uint r = 0; r < Rings; ++r)
+    {
+        for (uint s = 0; s < Segments; ++s)
+        {
+            uint a = r * (Segments + 1) + s;
+            uint b = a + 1, c = a + Segments + 1, d = c + 1;
+            indices.insert(indices.end(), { a, b, c, b, d, c });
+        }
+    }
+
+    XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, -2.5f, 1.0f), XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    XMFLOAT4X4 constants[2] = {};
+    XMStoreFloat4x4(&constants[0], XMMatrixTranspose(view * proj));
+
+    raster.SetVertexBuffer(vertices.data(), sizeof(Vertex), uint(vertices.size()), VERTEX_FLOAT);
+    raster.SetIndexBuffer(indices.data(), DXGI_FORMAT_R32_UINT);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint f = 0; f <= frames; ++f)
+    {
+        // o primeiro quadro aquece caches e alocações
+        if (f == 1)
+            start = std::chrono::steady_clock::now();
+
+        raster.SetConstants(constants);
+        raster.Clear(background);
+        raster.DrawIndexedInstanced(uint(indices.size()), 1, 0, 0, 0);
+        raster.Present();
+    }
+
+    double seconds = frames ? Seconds(start) : 0.0;
+    if (seconds > 0.0)
+    {
+        result.trianglesPerSec = double(indices.size() / 3) * frames / seconds;
+        result.meshFrameMs = seconds * 1000.0 / frames;
+    }
+
+    // ---------------------------------------------------------------
+    // preenchimento: camadas de tela cheia de trás para frente
+    // ---------------------------------------------------------------
+
+    const uint Layers = 16;
+    vertices.clear();
+    indices.clear();
+
+    for (uint i = 0; i < Layers; ++i)
+    {
+        // cada camada mais próxima que a anterior passa no teste
+        float z = 0.9f - 0.8f * i / Layers;
+        XMFLOAT4 tint(float(i) / Layers, 0.5f, 1.0f - float(i) / Layers, 1.0f);
+        uint base = uint(vertices.size());
+
+        Vertex corners[4] =
+        {
+            { XMFLOAT3(-1.0f,  1.0f, z), tint }, { XMFLOAT3(1.0f,  1.0f, z), tint },
+            { XMFLOAT3(-1.0f, -1.0f, z), tint }, { XMFLOAT3(1.0f, -1.0f, z), tint }
+        };
+
+        vertices.insert(vertices.end(), corners, corners + 4);
+        indices.insert(indices.end(), { base, base + 1, base + 2, base + 1, base + 3, base + 2 });
+    }
+
+    // posições já em espaço de recorte
+    XMStoreFloat4x4(&constants[0], XMMatrixIdentity());
+
+    raster.SetVertexBuffer(vertices.data(), sizeof(Vertex), uint(vertices.size()), VERTEX_FLOAT);
+    raster.SetIndexBuffer(indices.data(), DXGI_FORMAT_R32_UINT);
+
+    ullong pixels = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint f = 0; f <= frames; ++f)
+    {
+        if (f == 1)
+        {
+            start = std::chrono::steady_clock::now();
+            pixels = 0;
+        }
+
+        raster.SetConstants(constants);
+        raster.Clear(background);
+        raster.DrawIndexedInstanced(uint(indices.size()), 1, 0, 0, 0);
+        raster.Present();
+        pixels += raster.Stats().pixels;
+    }
+
+    seconds = frames ? Seconds(start) : 0.0;
+    if (seconds > 0.0)
+    {
+        result.pixelsPerSec = pixels / seconds;
+        result.fillFrameMs = seconds * 1000.0 / frames;
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
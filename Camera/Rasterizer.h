@@ -0,0 +1,224 @@
+/**********************************************************************************
+// Rasterizer (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Renderizador em software para máquinas sem GPU. Segue o mesmo
+//              fluxo de Graphics (Clear, DrawIndexedInstanced e Present) e
+//              lê os mesmos vertex e index buffers, o mesmo buffer
+//              constante e as mesmas matrizes das instâncias da aplicação,
+//              reproduzindo Vertex.hlsl ou VertexPacked.hlsl seguidos de
+//              Pixel.hlsl.
+//
+//              Cada instância de um desenho transforma os vértices com a
+//              sua matriz, recorta os triângulos em coordenadas homogêneas
+//              (planos próximo e distante e uma banda de guarda em x e y) e
+//              distribui os triângulos em tiles de 64 x 64 pixels. Em
+//              Present os tiles são rasterizados em paralelo com funções de
+//              aresta inteiras avaliadas 4 pixels por vez (SSE2), regra
+//              top-left, teste de profundidade LESS em 24 bits e
+//              interpolação de cor com correção de perspectiva.
+//              Os triângulos de cada tile são processados na ordem de envio,
+//              de modo que o resultado não depende do número de threads.
+//
+**********************************************************************************/
+
+#ifndef DXUT_RASTERIZER_H
+#define DXUT_RASTERIZER_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "VertexFormat.h"               // formatos dos vértices
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// contadores de um quadro
+struct RasterStats
+{
+    uint   triangles;                   // triângulos recebidos
+    uint   culled;                      // triângulos descartados (fora da visão ou sem pixels)
+    uint   clipped;                     // triângulos que precisaram de recorte
+    uint   binned;                      // referências de triângulos em tiles
+    ullong pixels;                      // pixels que passaram no teste de profundidade
+    double binSeconds;                  // tempo de transformação e distribuição
+    double rasterSeconds;               // tempo de rasterização dos tiles
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// resultado da medição de desempenho
+struct RasterBenchmark
+{
+    uint   width;                       // largura do alvo
+    uint   height;                      // altura do alvo
+    uint   threads;                     // threads usadas
+    uint   frames;                      // quadros medidos em cada cena
+    double trianglesPerSec;             // vazão de triângulos (cena de malha densa)
+    double pixelsPerSec;                // taxa de preenchimento (cena de camadas)
+    double meshFrameMs;                 // tempo por quadro da malha densa
+    double fillFrameMs;                 // tempo por quadro das camadas
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// vértice depois do vertex shader (espaço de recorte e cor)
+struct ClipVertex
+{
+    float x, y, z, w;
+    float r, g, b, a;
+};
+
+// triângulo pronto para rasterização
+struct RasterTriangle
+{
+    int   edgeA[3];                     // coeficientes das funções de aresta (subpixels)
+    int   edgeB[3];
+    llong edgeC[3];                     // termo constante já com a regra top-left
+    int   minX, minY, maxX, maxY;       // pixels cobertos pela caixa envolvente
+    float refX, refY;                   // origem dos planos de atributos (pixels)
+    float plane[6][3];                  // z, 1/w e cor/w: valor na origem, d/dx e d/dy
+    uint  order;                        // ordem de envio dentro do quadro
+};
+
+// -------------------------------------------------------------------------------
+
+class Rasterizer
+{
+private:
+    // alvo de renderização
+    uint width;                         // largura em pixels
+    uint height;                        // altura em pixels
+    uint pitch;                         // pixels por linha (múltiplo de 4)
+    uint tilesX, tilesY;                // número de tiles em cada direção
+    float guard;                        // banda de guarda em coordenadas normalizadas
+    vector<uint> color;                 // cor RGBA8 (R no byte menos significativo)
+    vector<uint> depth;                 // profundidade em 24 bits
+    uint clearColor;                    // cor da limpeza pendente
+    bool clearPending;                  // limpeza adiada para a rasterização
+
+    // entrada dos desenhos
+    const byte * vertexData;            // vertex buffer
+    uint vertexStride;                  // tamanho de cada vértice
+    uint vertexCount;                   // número de vértices
+    VertexFormatType vertexFormat;      // formato da posição e da cor
+    const byte * indexData;             // index buffer
+    uint indexSize;                     // bytes por índice (2 ou 4)
+    float constants[24];                // WorldViewProj (transposta), PosScale e PosBias
+    const XMFLOAT4X4 * instanceData;    // matrizes das instâncias (nulo usa WorldViewProj)
+    uint instanceTotal;                 // matrizes em instanceData
+    vector<ClipVertex> transformed;     // saída do vertex shader
+    const float * transformMatrix;      // matriz usada em transformed
+    bool transformValid;                // saída corresponde à entrada atual
+
+    // triângulos do quadro
+    vector<vector<RasterTriangle>> setup;       // triângulos por trecho de desenho
+    vector<vector<vector<uint>>> bins;          // [trecho][tile] -> triângulos
+    uint order;                         // próxima ordem de envio
+    RasterStats stats;                  // contadores do quadro atual
+    RasterStats last;                   // contadores do último quadro apresentado
+
+    // threads de trabalho
+    vector<std::thread> workers;        // threads além da chamadora
+    std::mutex mutex;                   // protege o estado abaixo
+    std::condition_variable wake;       // sinaliza um novo trabalho
+    std::condition_variable done;       // sinaliza o fim do trabalho
+    const std::function<void(uint, uint)> * job;  // trabalho atual
+    std::atomic<uint> next;             // próximo item a processar
+    uint jobCount;                      // itens do trabalho atual
+    uint busy;                          // threads ainda trabalhando
+    uint generation;                    // contador de trabalhos
+    bool quit;                          // encerra as threads
+
+    void WorkerLoop(uint worker);       // laço das threads de trabalho
+    void Work(uint worker);             // processa itens do trabalho atual
+    void Parallel(uint count, const std::function<void(uint, uint)> & func);
+
+    void Transform(const float * m);    // executa o vertex shader com a matriz m (transposta)
+    void BinTriangle(const ClipVertex * v, uint chunk, uint triangleOrder, RasterStats & counters);
+    void SetupTriangle(const ClipVertex & v0, const ClipVertex & v1, const ClipVertex & v2,
+                       uint chunk, uint triangleOrder, RasterStats & counters);
+    void RasterTile(uint tile, ullong & pixels);
+
+public:
+    static const uint TileSize = 64;    // lado de um tile em pixels
+    static const uint MaxThreads = 64;  // limite de threads de rasterização
+    static const uint MaxSize = 8192;   // maior largura ou altura do alvo
+
+    Rasterizer();                       // construtor
+    ~Rasterizer();                      // destrutor
+
+    // cria o alvo de renderização (threads = 0 usa todos os núcleos)
+    void Initialize(uint width, uint height, uint threads = 0);
+
+    void Clear(const float rgba[4]);    // limpa cor e profundidade (1.0)
+    void Present();                     // rasteriza os tiles e conclui o quadro
+
+    // entrada no mesmo formato dos buffers da GPU
+    void SetVertexBuffer(const void * vertices, uint stride, uint count, VertexFormatType format);
+    void SetIndexBuffer(const void * indices, DXGI_FORMAT format);
+    void SetConstants(const void * objectConstants);
+
+    // matrizes combinadas das instâncias (transpostas), lidas como o
+    // StructuredBuffer dos shaders: a instância i do desenho usa
+    // matrices[startInstance + i]; nulo volta a usar WorldViewProj
+    void SetInstances(const XMFLOAT4X4 * matrices, uint count);
+
+    // mesmos parâmetros de ID3D12GraphicsCommandList::DrawIndexedInstanced
+    void DrawIndexedInstanced(uint indexCount, uint instanceCount,
+                              uint startIndex, int baseVertex, uint startInstance);
+
+    uint Width() const;                 // largura do alvo
+    uint Height() const;                // altura do alvo
+    uint Pitch() const;                 // pixels por linha do alvo
+    uint Threads() const;               // threads de rasterização
+    const uint * Pixels() const;        // cor do último quadro apresentado
+    const RasterStats & Stats() const;  // contadores do último quadro apresentado
+};
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// retorna a largura do alvo
+inline uint Rasterizer::Width() const
+{ return width; }
+
+// retorna a altura do alvo
+inline uint Rasterizer::Height() const
+{ return height; }
+
+// retorna o número de pixels por linha do alvo
+inline uint Rasterizer::Pitch() const
+{ return pitch; }
+
+// retorna o número de threads de rasterização
+inline uint Rasterizer::Threads() const
+{ return uint(workers.size()) + 1; }
+
+// retorna a cor do último quadro apresentado
+inline const uint * Rasterizer::Pixels() const
+{ return color.data(); }
+
+// retorna os contadores do último quadro apresentado
+inline const RasterStats & Rasterizer::Stats() const
+{ return last; }
+
+// -------------------------------------------------------------------------------
+
+// mede vazão de triângulos e taxa de preenchimento em uma resolução
+RasterBenchmark BenchmarkRasterizer(uint width, uint height, uint frames = 20, uint threads = 0);
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,556 @@
+/**********************************************************************************
+// Scene (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cena em hierarquia com transformações em estrutura de vetores.
+//
+**********************************************************************************/
+
+#include "Scene.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// nós recalculados por trabalho na atualização paralela
+static const uint SceneGrain = 1024;
+
+// -------------------------------------------------------------------------------
+
+string SceneUpdateStats::ToString() const
+{
+    stringstream text;
+    text << nodes << " nós em " << levels << " níveis, " << dirty << " alterados, "
+         << updated << " matrizes recalculadas em " << ranges << " faixas"
+         << (sorted ? " (reordenada)" : "");
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+Scene::Scene()
+{
+    frame = 0;
+    sorted = true;
+    stats = {};
+}
+
+// -------------------------------------------------------------------------------
+
+uint Scene::Add(uint parentNode, const XMFLOAT3 & pos, const XMFLOAT4 & rot, const XMFLOAT3 & scl)
+{
+    // o pai já existe, portanto tem identificador menor que o novo nó
+    uint node = Count();
+    uint at = uint(position.size());
+
+    slot.push_back(at);
+    parentId.push_back(parentNode);
+
+    position.push_back(pos);
+    rotation.push_back(rot);
+    scale.push_back(scl);
+    parent.push_back(parentNode == None ? None : slot[parentNode]);
+    firstChild.push_back(0);
+    childCount.push_back(0);
+    world.push_back(XMFLOAT4X4(1.0f, 0.0f, 0.0f, 0.0f,
+                               0.0f, 1.0f, 0.0f, 0.0f,
+                               0.0f, 0.0f, 1.0f, 0.0f,
+                               0.0f, 0.0f, 0.0f, 1.0f));
+    stamp.push_back(None);
+    dirty.push_back(0);
+    id.push_back(node);
+
+    // a nova posição só vale até a próxima atualização
+    sorted = false;
+    return node;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Reserve(uint count)
+{
+    slot.reserve(count);
+    parentId.reserve(count);
+    position.reserve(count);
+    rotation.reserve(count);
+    scale.reserve(count);
+    parent.reserve(count);
+    firstChild.reserve(count);
+    childCount.reserve(count);
+    world.reserve(count);
+    stamp.reserve(count);
+    dirty.reserve(count);
+    id.reserve(count);
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Clear()
+{
+    slot.clear();
+    parentId.clear();
+    position.clear();
+    rotation.clear();
+    scale.clear();
+    parent.clear();
+    firstChild.clear();
+    childCount.clear();
+    world.clear();
+    stamp.clear();
+    dirty.clear();
+    id.clear();
+    levelStart.clear();
+    dirtyList.clear();
+    sorted = true;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Sort()
+{
+    uint count = Count();
+
+    // filhos de cada identificador em ordem de criação
+    vector<uint> childStart(count + 1, 0);
+    for (uint node = 0; node < count; ++node)
+        if (parentId[node] != None)
+            ++childStart[parentId[node] + 1];
+    for (uint node = 0; node < count; ++node)
+        childStart[node + 1] += childStart[node];
+
+    vector<uint> children(childStart[count]);
+    vector<uint> cursor(childStart.begin(), childStart.end() - 1);
+    for (uint node = 0; node < count; ++node)
+        if (parentId[node] != None)
+            children[cursor[parentId[node]]++] = node;
+
+    // ordem em largura: raízes, depois os filhos de cada nó do nível
+    // anterior na ordem em que seus pais aparecem
+    vector<uint> order;
+    order.reserve(count);
+    for (uint node = 0; node < count; ++node)
+        if (parentId[node] == None)
+            order.push_back(node);
+
+    vector<uint> first(count), counts(count);
+    levelStart.assign(1, 0);
+
+    uint levelBegin = 0;
+    while (levelBegin < order.size())
+    {
+        uint levelEnd = uint(order.size());
+        levelStart.push_back(levelEnd);
+
+        for (uint p = levelBegin; p < levelEnd; ++p)
+        {
+            uint node = order[p];
+            first[p] = uint(order.size());
+            counts[p] = childStart[node + 1] - childStart[node];
+            order.insert(order.end(), children.begin() + childStart[node], children.begin() + childStart[node + 1]);
+        }
+
+        levelBegin = levelEnd;
+    }
+
+    // reorganiza os componentes na nova ordem
+    vector<XMFLOAT3> newPosition(count), newScale(count);
+    vector<XMFLOAT4> newRotation(count);
+    vector<XMFLOAT4X4> newWorld(count);
+    vector<uint> newSlot(count);
+
+    for (uint p = 0; p < count; ++p)
+    {
+        uint old = slot[order[p]];
+        newPosition[p] = position[old];
+        newRotation[p] = rotation[old];
+        newScale[p] = scale[old];
+        newWorld[p] = world[old];
+        newSlot[order[p]] = p;
+    }
+
+    position.swap(newPosition);
+    rotation.swap(newRotation);
+    scale.swap(newScale);
+    world.swap(newWorld);
+    slot.swap(newSlot);
+
+    for (uint p = 0; p < count; ++p)
+        parent[p] = parentId[order[p]] == None ? None : slot[parentId[order[p]]];
+
+    firstChild.swap(first);
+    childCount.swap(counts);
+    id.swap(order);
+
+    // toda a cena é recalculada depois da reordenação
+    std::fill(stamp.begin(), stamp.end(), None);
+    std::fill(dirty.begin(), dirty.end(), byte(0));
+    dirtyList.clear();
+    sorted = true;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Touch(uint node)
+{
+    uint s = slot[node];
+    if (!dirty[s])
+    {
+        dirty[s] = 1;
+        dirtyList.push_back(s);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Position(uint node, const XMFLOAT3 & pos)
+{
+    position[slot[node]] = pos;
+    Touch(node);
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Rotation(uint node, const XMFLOAT4 & rot)
+{
+    rotation[slot[node]] = rot;
+    Touch(node);
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Scale(uint node, const XMFLOAT3 & scl)
+{
+    scale[slot[node]] = scl;
+    Touch(node);
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::UpdateNode(uint i)
+{
+    // matriz local afim: escala x rotação (quatérnio) x translação, com
+    // as mesmas linhas de XMMatrixRotationQuaternion escaladas
+    const XMFLOAT4 & q = rotation[i];
+    const XMFLOAT3 & s = scale[i];
+    const XMFLOAT3 & t = position[i];
+
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float xw = q.x * q.w, yw = q.y * q.w, zw = q.z * q.w;
+
+    float local[4][3] =
+    {
+        { (1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy + zw) * s.x, 2.0f * (xz - yw) * s.x },
+        { 2.0f * (xy - zw) * s.y, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz + xw) * s.y },
+        { 2.0f * (xz + yw) * s.z, 2.0f * (yz - xw) * s.z, (1.0f - 2.0f * (xx + yy)) * s.z },
+        { t.x, t.y, t.z }
+    };
+
+    XMFLOAT4X4 & w = world[i];
+
+    if (parent[i] == None)
+    {
+        for (uint r = 0; r < 4; ++r)
+        {
+            w.m[r][0] = local[r][0];
+            w.m[r][1] = local[r][1];
+            w.m[r][2] = local[r][2];
+            w.m[r][3] = 0.0f;
+        }
+    }
+    else
+    {
+        // produto afim com a matriz de mundo do pai (última coluna 0, 0, 0, 1)
+        const XMFLOAT4X4 & p = world[parent[i]];
+
+        for (uint r = 0; r < 4; ++r)
+        {
+            for (uint c = 0; c < 3; ++c)
+                w.m[r][c] = local[r][0] * p.m[0][c] + local[r][1] * p.m[1][c] + local[r][2] * p.m[2][c];
+            w.m[r][3] = 0.0f;
+        }
+
+        w.m[3][0] += p.m[3][0];
+        w.m[3][1] += p.m[3][1];
+        w.m[3][2] += p.m[3][2];
+    }
+
+    w.m[3][3] = 1.0f;
+    stamp[i] = frame;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::UpdateRanges(JobSystem * jobs)
+{
+    // posição de cada faixa na sequência de todos os nós do nível
+    offsets.resize(ranges.size() + 1);
+    uint total = 0;
+    for (size_t r = 0; r < ranges.size(); ++r)
+    {
+        offsets[r] = total;
+        total += ranges[r].end - ranges[r].begin;
+    }
+    offsets[ranges.size()] = total;
+
+    stats.updated += total;
+    stats.ranges += uint(ranges.size());
+
+    auto work = [this](uint begin, uint end)
+    {
+        // faixa que contém o primeiro nó do trabalho
+        uint r = uint(std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin()) - 1;
+
+        while (begin < end)
+        {
+            uint stop = std::min(end, offsets[r + 1]);
+            uint first = ranges[r].begin + (begin - offsets[r]);
+
+            for (uint i = first; i < first + (stop - begin); ++i)
+                UpdateNode(i);
+
+            begin = stop;
+            ++r;
+        }
+    };
+
+    // os nós de um nível só dependem do nível anterior, já concluído
+    if (jobs && total > SceneGrain)
+        jobs->ParallelFor(total, SceneGrain, work);
+    else
+        work(0, total);
+}
+
+// -------------------------------------------------------------------------------
+
+void Scene::Update(JobSystem * jobs)
+{
+    ++frame;
+
+    stats = {};
+    stats.nodes = Count();
+    stats.dirty = uint(dirtyList.size());
+
+    if (!sorted)
+    {
+        // novos nós: reordena e recalcula todos os níveis
+        Sort();
+        stats.sorted = true;
+        stats.levels = Levels();
+
+        for (uint level = 0; level < Levels(); ++level)
+        {
+            ranges.assign(1, { levelStart[level], levelStart[level + 1] });
+            UpdateRanges(jobs);
+        }
+        return;
+    }
+
+    uint levels = Levels();
+    stats.levels = levels;
+
+    // posições alteradas em ordem: agrupadas por nível e em endereços crescentes
+    std::sort(dirtyList.begin(), dirtyList.end());
+    for (uint s : dirtyList)
+        dirty[s] = 0;
+
+    ranges.clear();
+    size_t next = 0;
+
+    for (uint level = 0; level < levels; ++level)
+    {
+        // nós alterados do nível cujo pai não foi recalculado (os demais
+        // já estão nas faixas de filhos vindas do nível anterior)
+        uint levelEnd = levelStart[level + 1];
+        for (; next < dirtyList.size() && dirtyList[next] < levelEnd; ++next)
+        {
+            uint s = dirtyList[next];
+            if (parent[s] != None && stamp[parent[s]] == frame)
+                continue;
+
+            if (!ranges.empty() && ranges.back().end == s)
+                ++ranges.back().end;
+            else
+                ranges.push_back({ s, s + 1 });
+        }
+
+        if (ranges.empty())
+            continue;
+
+        UpdateRanges(jobs);
+
+        // os filhos de uma faixa de nós formam uma faixa no nível seguinte
+        nextRanges.clear();
+        for (const Range & range : ranges)
+        {
+            uint begin = firstChild[range.begin];
+            uint end = firstChild[range.end - 1] + childCount[range.end - 1];
+
+            if (begin < end)
+            {
+                if (!nextRanges.empty() && nextRanges.back().end == begin)
+                    nextRanges.back().end = end;
+                else
+                    nextRanges.push_back({ begin, end });
+            }
+        }
+
+        ranges.swap(nextRanges);
+    }
+
+    dirtyList.clear();
+}
+
+// -------------------------------------------------------------------------------
+
+string SceneBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+    text << nodes << " nós em " << levels << " níveis, " << threads << " threads, "
+         << dirtyFraction * 100.0 << "% alterados por atualização ("
+         << uint(updatedPerFrame) << " matrizes recalculadas): "
+         << partialMs << " ms (" << partialSerialMs << " ms em uma thread); "
+         << "cena inteira: " << fullMs << " ms (" << fullSerialMs << " ms em uma thread); "
+         << "erro máximo " << maxError;
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+SceneBenchmark BenchmarkScene(uint nodes, double dirtyFraction, uint frames, uint threads)
+{
+    Timer timer;
+
+    JobSystem jobs(threads);
+
+    uint seed = 2463534242u;
+    auto random = [&seed]()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    };
+
+    // floresta com uma raiz para cada 1000 nós e até 4 filhos por nó em
+    // média, com os pais sorteados no nível anterior
+    Scene scene;
+    scene.Reserve(nodes);
+
+    uint levelBegin = 0;
+    uint levelEnd = std::max(1u, std::min(nodes, nodes / 1000));
+    for (uint i = 0; i < levelEnd; ++i)
+        scene.Add(Scene::None, XMFLOAT3(float(i % 100) * 10.0f, 0.0f, float(i / 100) * 10.0f));
+
+    while (scene.Count() < nodes)
+    {
+        uint size = std::min(nodes - scene.Count(), (levelEnd - levelBegin) * 4);
+        for (uint i = 0; i < size; ++i)
+        {
+            uint parentNode = levelBegin + random() % (levelEnd - levelBegin);
+            XMFLOAT4 rot;
+            XMStoreFloat4(&rot, XMQuaternionRotationRollPitchYaw(0.0f, float(random() % 628) * 0.01f, 0.0f));
+            scene.Add(parentNode, XMFLOAT3(float(random() % 9) - 4.0f, 1.0f, float(random() % 9) - 4.0f),
+                      rot, XMFLOAT3(0.9f, 0.9f, 0.9f));
+        }
+        levelBegin = levelEnd;
+        levelEnd = scene.Count();
+    }
+
+    // primeira atualização: ordenação e todas as matrizes
+    scene.Update(&jobs);
+
+    SceneBenchmark result = {};
+    result.nodes = scene.Count();
+    result.levels = scene.Levels();
+    result.threads = jobs.Threads();
+    result.frames = frames;
+    result.dirtyFraction = dirtyFraction;
+
+    uint dirtyCount = uint(nodes * dirtyFraction);
+    double updated = 0.0;
+
+    // subárvores sujas com e sem as threads de trabalho
+    for (uint pass = 0; pass < 2; ++pass)
+    {
+        double seconds = 0.0;
+        for (uint f = 0; f < frames; ++f)
+        {
+            for (uint i = 0; i < dirtyCount; ++i)
+            {
+                XMFLOAT4 rot;
+                XMStoreFloat4(&rot, XMQuaternionRotationRollPitchYaw(0.0f, float(f) * 0.1f, 0.0f));
+                scene.Rotation(random() % result.nodes, rot);
+            }
+
+            timer.Start();
+            scene.Update(pass == 0 ? &jobs : nullptr);
+            seconds += timer.Elapsed();
+
+            if (pass == 0)
+                updated += scene.Stats().updated;
+        }
+
+        (pass == 0 ? result.partialMs : result.partialSerialMs) = seconds * 1000.0 / frames;
+    }
+    result.updatedPerFrame = updated / frames;
+
+    // cena inteira: todas as raízes alteradas
+    uint roots = std::max(1u, std::min(nodes, nodes / 1000));
+    for (uint pass = 0; pass < 2; ++pass)
+    {
+        double seconds = 0.0;
+        uint fullFrames = std::max(1u, frames / 10);
+        for (uint f = 0; f < fullFrames; ++f)
+        {
+            for (uint r = 0; r < roots; ++r)
+                scene.Position(r, scene.Position(r));
+
+            timer.Start();
+            scene.Update(pass == 0 ? &jobs : nullptr);
+            seconds += timer.Elapsed();
+        }
+
+        (pass == 0 ? result.fullMs : result.fullSerialMs) = seconds * 1000.0 / fullFrames;
+    }
+
+    // confere as matrizes com o cálculo completo do DirectXMath, nó a nó
+    // (pais têm identificadores menores que os filhos)
+    for (uint pass = 0; pass < 3; ++pass)
+    {
+        // algumas alterações pendentes antes da última atualização
+        for (uint i = 0; i < dirtyCount; ++i)
+            scene.Scale(random() % result.nodes, XMFLOAT3(1.0f, 1.1f, 1.0f));
+        scene.Update(&jobs);
+    }
+
+    vector<XMFLOAT4X4> reference(result.nodes);
+    for (uint node = 0; node < result.nodes; ++node)
+    {
+        XMMATRIX local = XMMatrixScalingFromVector(XMLoadFloat3(&scene.Scale(node)))
+                       * XMMatrixRotationQuaternion(XMLoadFloat4(&scene.Rotation(node)))
+                       * XMMatrixTranslationFromVector(XMLoadFloat3(&scene.Position(node)));
+
+        if (scene.Parent(node) != Scene::None)
+            local = local * XMLoadFloat4x4(&reference[scene.Parent(node)]);
+
+        XMStoreFloat4x4(&reference[node], local);
+
+        const XMFLOAT4X4 & w = scene.World(node);
+        for (uint r = 0; r < 4; ++r)
+            for (uint c = 0; c < 4; ++c)
+                result.maxError = std::max(result.maxError, double(fabsf(w.m[r][c] - reference[node].m[r][c])));
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
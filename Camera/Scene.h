@@ -0,0 +1,199 @@
+/**********************************************************************************
+// Scene (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Cena em hierarquia com transformações em estrutura de vetores.
+//
+//              Posição, rotação (quatérnio), escala, pai e matriz de mundo
+//              de cada nó ficam em vetores separados, ordenados por nível de
+//              profundidade e, dentro de um nível, pela posição do pai: os
+//              pais vêm antes dos filhos e os filhos de nós consecutivos são
+//              consecutivos no nível seguinte. Os nós são identificados por
+//              um índice estável, traduzido para a posição ordenada.
+//
+//              Alterar um nó apenas o marca como sujo. A atualização visita
+//              os níveis em ordem e recalcula somente as subárvores sujas:
+//              os filhos de uma faixa de nós recalculados formam uma única
+//              faixa no nível seguinte, então o trabalho de cada nível é uma
+//              lista de faixas, processada em paralelo pelo sistema de
+//              trabalhos. O custo é proporcional aos nós recalculados e não
+//              ao tamanho da cena.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SCENE_H
+#define DXUT_SCENE_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "JobSystem.h"                  // trabalhos paralelos
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+using namespace DirectX;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// contadores da última atualização
+struct SceneUpdateStats
+{
+    uint nodes;                         // nós na cena
+    uint levels;                        // níveis de profundidade
+    uint dirty;                         // nós alterados desde a atualização anterior
+    uint updated;                       // matrizes de mundo recalculadas
+    uint ranges;                        // faixas de nós processadas
+    bool sorted;                        // a cena foi reordenada (novos nós)
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class Scene
+{
+public:
+    static constexpr uint None = 0xffffffff;    // nó inexistente (pai das raízes)
+
+private:
+    // faixa de posições [begin, end) em um nível
+    struct Range
+    {
+        uint begin;
+        uint end;
+    };
+
+    // componentes em ordem de nível (índices são posições ordenadas)
+    vector<XMFLOAT3> position;          // translação local
+    vector<XMFLOAT4> rotation;          // rotação local (quatérnio)
+    vector<XMFLOAT3> scale;             // escala local
+    vector<uint> parent;                // posição do pai (None nas raízes)
+    vector<uint> firstChild;            // posição do primeiro filho no nível seguinte
+    vector<uint> childCount;            // número de filhos
+    vector<XMFLOAT4X4> world;           // matriz de mundo
+    vector<uint> stamp;                 // atualização em que a matriz foi recalculada
+    vector<byte> dirty;                 // nó alterado e já na lista de sujos
+    vector<uint> id;                    // identificador de cada posição
+
+    // identificadores estáveis
+    vector<uint> slot;                  // posição ordenada de cada identificador
+    vector<uint> parentId;              // pai de cada identificador
+
+    vector<uint> levelStart;            // primeira posição de cada nível (e o fim)
+    vector<uint> dirtyList;             // posições alteradas (cada uma uma vez)
+    vector<Range> ranges;               // faixas do nível atual
+    vector<Range> nextRanges;           // faixas do nível seguinte
+    vector<uint> offsets;               // soma dos tamanhos das faixas
+    uint frame;                         // número da atualização atual
+    bool sorted;                        // posições correspondem aos nós
+    SceneUpdateStats stats;             // contadores da última atualização
+
+    void Sort();                        // ordena os nós por nível e pai
+    void Touch(uint node);              // marca um nó como alterado
+    void UpdateNode(uint i);            // recalcula a matriz de mundo de uma posição
+    void UpdateRanges(JobSystem * jobs);// recalcula as faixas do nível atual
+
+public:
+    Scene();                            // construtor
+
+    // acrescenta um nó filho de parent (None para uma raiz) e retorna seu identificador
+    uint Add(uint parentNode = None,
+             const XMFLOAT3 & pos = XMFLOAT3(0.0f, 0.0f, 0.0f),
+             const XMFLOAT4 & rot = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f),
+             const XMFLOAT3 & scl = XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+    void Reserve(uint count);           // reserva espaço para count nós
+    void Clear();                       // remove todos os nós
+
+    void Position(uint node, const XMFLOAT3 & pos);     // altera a translação local
+    void Rotation(uint node, const XMFLOAT4 & rot);     // altera a rotação local
+    void Scale(uint node, const XMFLOAT3 & scl);        // altera a escala local
+
+    const XMFLOAT3 & Position(uint node) const;         // translação local
+    const XMFLOAT4 & Rotation(uint node) const;         // rotação local
+    const XMFLOAT3 & Scale(uint node) const;            // escala local
+    uint Parent(uint node) const;                       // pai (None nas raízes)
+
+    // recalcula as matrizes de mundo das subárvores alteradas
+    // (em paralelo por nível se jobs não for nulo)
+    void Update(JobSystem * jobs = nullptr);
+
+    const XMFLOAT4X4 & World(uint node) const;          // matriz de mundo (após Update)
+    bool Changed(uint node) const;                      // recalculada na última atualização
+
+    uint Count() const;                                 // número de nós
+    uint Levels() const;                                // níveis de profundidade
+    const SceneUpdateStats & Stats() const;             // contadores da última atualização
+};
+
+// -------------------------------------------------------------------------------
+
+// medição da atualização de uma cena grande com uma fração de nós alterados
+struct SceneBenchmark
+{
+    uint   nodes;                       // nós na cena
+    uint   levels;                      // níveis de profundidade
+    uint   threads;                     // threads de trabalho
+    uint   frames;                      // atualizações medidas
+    double dirtyFraction;               // fração de nós alterados por atualização
+    double updatedPerFrame;             // matrizes recalculadas por atualização (média)
+    double partialMs;                   // atualização das subárvores sujas (ms)
+    double partialSerialMs;             // idem, em uma thread (ms)
+    double fullMs;                      // atualização de todos os nós (ms)
+    double fullSerialMs;                // idem, em uma thread (ms)
+    double maxError;                    // maior diferença para o cálculo completo
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// cria uma floresta com nodes nós e altera dirtyFraction deles a cada atualização
+SceneBenchmark BenchmarkScene(uint nodes = 1000000, double dirtyFraction = 0.01,
+                              uint frames = 50, uint threads = 0);
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// translação local
+inline const XMFLOAT3 & Scene::Position(uint node) const
+{ return position[slot[node]]; }
+
+// rotação local
+inline const XMFLOAT4 & Scene::Rotation(uint node) const
+{ return rotation[slot[node]]; }
+
+// escala local
+inline const XMFLOAT3 & Scene::Scale(uint node) const
+{ return scale[slot[node]]; }
+
+// pai (None nas raízes)
+inline uint Scene::Parent(uint node) const
+{ return parentId[node]; }
+
+// matriz de mundo
+inline const XMFLOAT4X4 & Scene::World(uint node) const
+{ return world[slot[node]]; }
+
+// recalculada na última atualização
+inline bool Scene::Changed(uint node) const
+{ return stamp[slot[node]] == frame; }
+
+// número de nós
+inline uint Scene::Count() const
+{ return uint(slot.size()); }
+
+// níveis de profundidade
+inline uint Scene::Levels() const
+{ return levelStart.empty() ? 0 : uint(levelStart.size()) - 1; }
+
+// contadores da última atualização
+inline const SceneUpdateStats & Scene::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
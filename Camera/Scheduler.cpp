@@ -0,0 +1,204 @@
+/**********************************************************************************
+// Scheduler (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Agenda as atualizações e os quadros do laço principal: passo
+//              fixo com limite de recuperação, limitador de quadros híbrido
+//              e histograma dos desvios entre quadros.
+//
+**********************************************************************************/
+
+#include "Scheduler.h"
+#include <cmath>
+#include <sstream>
+#include <thread>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// limites das faixas do histograma em milissegundos
+const double JitterHistogram::Limits[Buckets] = { 0.05, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, INFINITY };
+
+// o Sleep do Windows pode acordar até um período do relógio do sistema
+// depois do pedido, mesmo com timeBeginPeriod(1)
+const double Scheduler::SpinMargin = 0.002;
+
+// -------------------------------------------------------------------------------
+
+void JitterHistogram::Add(double deviationMs)
+{
+    deviationMs = fabs(deviationMs);
+
+    uint bucket = 0;
+    while (bucket + 1 < Buckets && deviationMs >= Limits[bucket])
+        ++bucket;
+
+    ++counts[bucket];
+    ++frames;
+    sum += deviationMs;
+    sumSq += deviationMs * deviationMs;
+    if (deviationMs > worst)
+        worst = deviationMs;
+}
+
+// -------------------------------------------------------------------------------
+
+string JitterHistogram::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(3);
+
+    double mean = frames ? sum / frames : 0.0;
+    double rms = frames ? sqrt(sumSq / frames) : 0.0;
+    text << frames << " intervalos, desvio médio " << mean << " ms, rms " << rms
+         << " ms, máximo " << worst << " ms\n";
+
+    for (uint i = 0; i < Buckets; ++i)
+    {
+        double share = frames ? 100.0 * counts[i] / frames : 0.0;
+        text.precision(2);
+        text << "  ";
+        if (i + 1 < Buckets)
+            text << "< " << Limits[i] << " ms: ";
+        else
+            text << ">= " << Limits[i - 1] << " ms: ";
+
+        text.precision(1);
+        text << counts[i] << " (" << share << "%) ";
+
+        // barra proporcional à fração da faixa
+        text << string(size_t(share / 2.0 + 0.5), '#') << "\n";
+    }
+
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+Scheduler::Scheduler()
+{
+    step = 0.0;
+    maxSteps = 5;
+    accumulator = 0.0;
+    alpha = 1.0;
+    droppedSteps = 0;
+
+    period = 0.0;
+    nextFrame = 0;
+    lastFrame = 0;
+    lastInterval = 0.0;
+    jitter = {};
+}
+
+// -------------------------------------------------------------------------------
+
+void Scheduler::FixedRate(double updatesPerSec, uint maxStepsPerFrame)
+{
+    step = updatesPerSec > 0.0 ? 1.0 / updatesPerSec : 0.0;
+    maxSteps = maxStepsPerFrame ? maxStepsPerFrame : 1;
+    accumulator = 0.0;
+    alpha = step > 0.0 ? 0.0 : 1.0;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scheduler::FrameLimit(double framesPerSec)
+{
+    period = framesPerSec > 0.0 ? 1.0 / framesPerSec : 0.0;
+    nextFrame = 0;
+    ClearJitter();
+}
+
+// -------------------------------------------------------------------------------
+
+uint Scheduler::Advance(double frameTime)
+{
+    // passo variável: uma atualização com o tempo medido
+    if (step <= 0.0)
+    {
+        alpha = 1.0;
+        return 1;
+    }
+
+    accumulator += frameTime;
+
+    // um quadro muito lento descarta o atraso em vez de simular
+    // todos os passos perdidos (espiral de atualizações)
+    double limit = step * maxSteps;
+    if (accumulator > limit)
+    {
+        droppedSteps += ullong((accumulator - limit) / step);
+        accumulator = limit;
+    }
+
+    uint steps = uint(accumulator / step);
+    accumulator -= steps * step;
+
+    alpha = accumulator / step;
+    return steps;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scheduler::Wait()
+{
+    llong freq = Timer::Frequency();
+    llong now = Timer::Ticks();
+
+    if (period > 0.0)
+    {
+        llong interval = llong(period * freq);
+
+        // primeiro quadro ou atraso maior que um quadro: recomeça a agenda
+        if (nextFrame == 0 || now - nextFrame > interval)
+            nextFrame = now + interval;
+
+        // dorme enquanto faltar mais que a margem de espera ativa
+        double remaining = double(nextFrame - now) / freq;
+        if (remaining > SpinMargin)
+            std::this_thread::sleep_for(std::chrono::duration<double>(remaining - SpinMargin));
+
+        // completa a espera ativamente
+        do now = Timer::Ticks();
+        while (now < nextFrame);
+
+        nextFrame += interval;
+    }
+
+    // desvio em relação ao alvo ou, sem limite, ao intervalo anterior
+    if (lastFrame)
+    {
+        double interval = 1000.0 * (now - lastFrame) / freq;
+        double reference = period > 0.0 ? period * 1000.0 : lastInterval;
+
+        if (period > 0.0 || lastInterval > 0.0)
+            jitter.Add(interval - reference);
+
+        lastInterval = interval;
+    }
+
+    lastFrame = now;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scheduler::Restart()
+{
+    accumulator = 0.0;
+    nextFrame = 0;
+    lastFrame = 0;
+    lastInterval = 0.0;
+}
+
+// -------------------------------------------------------------------------------
+
+void Scheduler::ClearJitter()
+{
+    jitter = {};
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+/**********************************************************************************
+// Scheduler (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Agenda as atualizações e os quadros do laço principal.
+//
+//              No modo de passo fixo o tempo de cada quadro é acumulado e
+//              consumido em passos de duração constante, de modo que o
+//              custo da simulação não depende da taxa de quadros. Um limite
+//              de passos por quadro evita que um quadro lento provoque uma
+//              espiral de atualizações atrasadas, e a fração do passo que
+//              sobra no acumulador (alpha) permite interpolar o desenho
+//              entre o estado anterior e o atual.
+//
+//              O limitador de quadros dorme até pouco antes do instante do
+//              próximo quadro e completa a espera ativamente, já que o
+//              Sleep do sistema só tem precisão de um milissegundo ou mais.
+//              Os intervalos entre quadros alimentam um histograma de
+//              desvios (jitter) para comparar os modos.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SCHEDULER_H
+#define DXUT_SCHEDULER_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "Timer.h"                      // contador de alta precisão
+#include <string>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+// histograma dos desvios dos intervalos entre quadros
+struct JitterHistogram
+{
+    static const uint Buckets = 8;      // faixas do histograma
+    static const double Limits[Buckets];// limite superior de cada faixa (ms)
+
+    ullong counts[Buckets];             // intervalos em cada faixa
+    ullong frames;                      // intervalos registrados
+    double sum;                         // soma dos desvios (ms)
+    double sumSq;                       // soma dos quadrados dos desvios
+    double worst;                       // maior desvio (ms)
+
+    void Add(double deviationMs);       // registra um desvio
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class Scheduler
+{
+private:
+    // passo fixo
+    double step;                        // duração de um passo (0 é passo variável)
+    uint   maxSteps;                    // limite de passos por quadro
+    double accumulator;                 // tempo ainda não simulado
+    double alpha;                       // fração do passo restante no acumulador
+    ullong droppedSteps;                // passos descartados pelo limite
+
+    // limitador de quadros
+    double period;                      // intervalo alvo entre quadros (0 sem limite)
+    llong  nextFrame;                   // instante do próximo quadro (ticks)
+    llong  lastFrame;                   // instante do último quadro (ticks)
+    double lastInterval;                // último intervalo entre quadros (ms)
+    JitterHistogram jitter;             // desvios dos intervalos
+
+public:
+    static const double SpinMargin;     // espera ativa no fim do limitador (segundos)
+
+    Scheduler();                        // construtor
+
+    void FixedRate(double updatesPerSec, uint maxStepsPerFrame = 5);  // 0 volta ao passo variável
+    void FrameLimit(double framesPerSec);                              // 0 remove o limite
+
+    uint Advance(double frameTime);     // acumula o tempo e retorna os passos a simular
+    void Wait();                        // espera o instante do próximo quadro
+    void Restart();                     // descarta o tempo acumulado (após pausa)
+    void ClearJitter();                 // zera o histograma
+
+    bool   Fixed() const;               // modo de passo fixo ativo
+    double Step() const;                // duração de um passo
+    double Alpha() const;               // fração do passo para interpolação
+    ullong DroppedSteps() const;        // passos descartados pelo limite
+    double Period() const;              // intervalo alvo entre quadros
+    const JitterHistogram & Jitter() const;  // desvios dos intervalos
+};
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// modo de passo fixo ativo
+inline bool Scheduler::Fixed() const
+{ return step > 0.0; }
+
+// duração de um passo
+inline double Scheduler::Step() const
+{ return step; }
+
+// fração do passo para interpolação
+inline double Scheduler::Alpha() const
+{ return alpha; }
+
+// passos descartados pelo limite
+inline ullong Scheduler::DroppedSteps() const
+{ return droppedSteps; }
+
+// intervalo alvo entre quadros
+inline double Scheduler::Period() const
+{ return period; }
+
+// desvios dos intervalos entre quadros
+inline const JitterHistogram & Scheduler::Jitter() const
+{ return jitter; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,82 @@
+/**********************************************************************************
+// SelfTest (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Resultado das verificações determinísticas dos módulos.
+//
+**********************************************************************************/
+
+#include "SelfTest.h"
+#include "EventSource.h"
+#include "FrameRing.h"
+#include "HeapAllocator.h"
+#include "UploadBatch.h"
+#include "UploadRing.h"
+#include "VertexFormat.h"
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+SelfTestReport::SelfTestReport(const string & module)
+{
+    name = module;
+    checks = 0;
+    failures = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+bool SelfTestReport::Check(bool passed, const string & what)
+{
+    ++checks;
+
+    if (!passed)
+    {
+        ++failures;
+        failed += "    falhou: " + what + "\n";
+    }
+
+    return passed;
+}
+
+// -------------------------------------------------------------------------------
+
+bool SelfTestReport::Passed() const
+{
+    return failures == 0;
+}
+
+// -------------------------------------------------------------------------------
+
+string SelfTestReport::ToString() const
+{
+    stringstream text;
+    text << name << ": " << checks << " verificações, " << failures << " falhas "
+         << (Passed() ? "(APROVADO)" : "(REPROVADO)") << "\n" << failed;
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+bool RunSelfTests(string & text)
+{
+    SelfTestReport tests[] = { TestInputReplay(), TestFrameRing(), TestUploadRing(),
+                               TestHeapAllocator(), TestUploadBatch(), TestVertexFormats() };
+
+    text.clear();
+    bool passed = true;
+    for (const SelfTestReport & test : tests)
+    {
+        text += test.ToString();
+        passed = passed && test.Passed();
+    }
+
+    text += passed ? "APROVADO\n" : "REPROVADO\n";
+    return passed;
+}
+
+// -------------------------------------------------------------------------------
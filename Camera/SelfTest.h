@@ -0,0 +1,48 @@
+/**********************************************************************************
+// SelfTest (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Resultado das verificações determinísticas dos módulos
+//              executadas pela opção -selftest e pelo CameraSelfTest do
+//              build portável. Cada verificação compara um valor obtido
+//              com o esperado e as falhas são descritas no resumo, que
+//              termina com APROVADO ou REPROVADO.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SELFTEST_H
+#define DXUT_SELFTEST_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include <string>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+// verificações de um módulo
+struct SelfTestReport
+{
+    string name;                        // módulo verificado
+    uint   checks;                      // verificações feitas
+    uint   failures;                    // verificações que falharam
+    string failed;                      // descrição das falhas, uma por linha
+
+    SelfTestReport(const string & module);          // nenhum resultado ainda
+
+    bool Check(bool passed, const string & what);   // registra uma verificação
+    bool Passed() const;                // nenhuma falha
+    string ToString() const;            // resumo em formato texto
+};
+
+// executa as verificações de todos os módulos e grava o resumo em text;
+// retorna verdadeiro se nenhuma falhou
+bool RunSelfTests(string & text);
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,50 @@
+/**********************************************************************************
+// SelfTestMain (Código Fonte)
+//
+// Criação:     17 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Programa de linha de comando que executa as verificações
+//              determinísticas dos módulos portáveis, as mesmas da opção
+//              -selftest da aplicação. Usado pelo build portável
+//              (CMakeLists.txt, ctest) em máquinas sem Windows e sem GPU.
+//
+//              Com -bench também roda as medições dos quadros em andamento,
+//              do anel de upload, do subalocador de heaps e da fila de
+//              eventos, com cargas menores que as da aplicação.
+//
+//              O código de saída é 1 se alguma verificação falhar.
+//
+**********************************************************************************/
+
+#include "SelfTest.h"
+#include "EventSource.h"
+#include "FrameRing.h"
+#include "HeapAllocator.h"
+#include "UploadRing.h"
+#include <cstdio>
+#include <cstring>
+
+// -------------------------------------------------------------------------------
+
+int main(int argc, char ** argv)
+{
+    string report;
+    bool passed = RunSelfTests(report);
+
+    if (argc > 1 && strcmp(argv[1], "-bench") == 0)
+    {
+        for (uint frames = 1; frames <= 3; ++frames)
+            report += BenchmarkFramesInFlight(frames, 30).ToString() + "\n";
+
+        report += BenchmarkUploadRing(1000000).ToString() + "\n";
+        report += BenchmarkHeapChurn(200000).ToString() + "\n";
+        report += BenchmarkInputRing(1000000).ToString() + "\n";
+    }
+
+    fputs(report.c_str(), stdout);
+    return passed ? 0 : 1;
+}
+
+// -------------------------------------------------------------------------------
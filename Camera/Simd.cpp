@@ -0,0 +1,51 @@
+/**********************************************************************************
+// Simd (Código Fonte)
+//
+// Criação:     17 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Escolha do núcleo SIMD dos cálculos em lote.
+//
+**********************************************************************************/
+
+#include "Simd.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>                     // __cpuid e _xgetbv
+#else
+#include <cpuid.h>                      // __get_cpuid
+#endif
+
+// -------------------------------------------------------------------------------
+
+// verifica suporte a AVX no processador e no sistema (registradores YMM salvos)
+static bool AvxSupported()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+
+    return (_xgetbv(0) & 6) == 6;
+#else
+    uint a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || (c & (1 << 27)) == 0 || (c & (1 << 28)) == 0)
+        return false;
+
+    uint low, high;
+    __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (low & 6) == 6;
+#endif
+}
+
+// -------------------------------------------------------------------------------
+
+SimdKernel BestSimdKernel()
+{
+    static const SimdKernel best = AvxSupported() ? SIMD_AVX : SIMD_SSE;
+    return best;
+}
+
+// -------------------------------------------------------------------------------
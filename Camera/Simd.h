@@ -0,0 +1,57 @@
+/**********************************************************************************
+// Simd (Arquivo de Cabeçalho)
+//
+// Criação:     17 Out 2026
+// Atualização: 17 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Escolha do núcleo SIMD dos cálculos em lote.
+//
+//              Os módulos que processam dados em estrutura de vetores têm
+//              um núcleo escalar, um SSE e um AVX. O SSE faz parte do x64 e
+//              está sempre disponível; o AVX é compilado mesmo sem /arch:AVX
+//              (DXUT_TARGET_AVX) e só é usado se o processador e o sistema
+//              operacional o suportam.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SIMD_H
+#define DXUT_SIMD_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+
+// -------------------------------------------------------------------------------
+
+// o núcleo AVX é compilado mesmo sem /arch:AVX e só roda se houver suporte
+#if defined(__GNUC__) && !defined(__AVX__)
+#define DXUT_TARGET_AVX __attribute__((target("avx")))
+#else
+#define DXUT_TARGET_AVX
+#endif
+
+// -------------------------------------------------------------------------------
+
+// implementação do cálculo em lote
+enum SimdKernel { SIMD_SCALAR, SIMD_SSE, SIMD_AVX, SIMD_AUTO };
+
+// melhor núcleo suportado pelo processador
+SimdKernel BestSimdKernel();
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// núcleo usado para o pedido (AUTO e AVX sem suporte viram o melhor suportado)
+inline SimdKernel SupportedSimdKernel(SimdKernel kernel)
+{
+    if (kernel == SIMD_AUTO)
+        return BestSimdKernel();
+    if (kernel == SIMD_AVX && BestSimdKernel() != SIMD_AVX)
+        return SIMD_SSE;
+    return kernel;
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
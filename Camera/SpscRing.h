@@ -0,0 +1,149 @@
+/**********************************************************************************
+// SpscRing (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Fila circular sem travas para um produtor e um consumidor.
+//
+//              O produtor só escreve o índice de escrita e o consumidor só
+//              escreve o índice de leitura, portanto nenhuma operação
+//              espera pela outra: Push falha quando a fila está cheia e Pop
+//              quando está vazia. A capacidade é uma potência de dois para
+//              que o índice seja reduzido com uma máscara, e os índices ficam
+//              em linhas de cache separadas para que produtor e consumidor
+//              não disputem a mesma linha. Cada lado guarda uma cópia do
+//              índice do outro e só o relê quando a cópia indica fila cheia
+//              ou vazia.
+//
+**********************************************************************************/
+
+#ifndef DXUT_SPSCRING_H
+#define DXUT_SPSCRING_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include <atomic>
+using std::atomic;
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "a capacidade deve ser uma potência de dois");
+
+private:
+    static const uint Mask = Capacity - 1;
+
+    // lado do produtor
+    alignas(64) atomic<uint> tail;      // próxima posição de escrita
+    uint headCache;                     // última leitura do índice do consumidor
+
+    // lado do consumidor
+    alignas(64) atomic<uint> head;      // próxima posição de leitura
+    uint tailCache;                     // última leitura do índice do produtor
+
+    alignas(64) T items[Capacity];      // elementos da fila
+
+public:
+    SpscRing();                         // construtor
+
+    bool Push(const T & item);          // produtor: falso se a fila está cheia
+    bool Pop(T & item);                 // consumidor: falso se a fila está vazia
+
+    // consumidor: entrega todos os elementos disponíveis e retorna quantos
+    template <class Consume>
+    uint Drain(Consume consume);
+
+    uint Size() const;                  // elementos na fila (aproximado se concorrente)
+    static constexpr uint Limit()       // capacidade da fila
+    { return Capacity; }
+};
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+SpscRing<T, Capacity>::SpscRing() : tail(0), head(0)
+{
+    headCache = 0;
+    tailCache = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+bool SpscRing<T, Capacity>::Push(const T & item)
+{
+    uint t = tail.load(std::memory_order_relaxed);
+
+    // os índices crescem livremente; a diferença é a ocupação
+    if (t - headCache == Capacity)
+    {
+        headCache = head.load(std::memory_order_acquire);
+        if (t - headCache == Capacity)
+            return false;
+    }
+
+    items[t & Mask] = item;
+
+    // publica o elemento antes do novo índice
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+bool SpscRing<T, Capacity>::Pop(T & item)
+{
+    uint h = head.load(std::memory_order_relaxed);
+
+    if (h == tailCache)
+    {
+        tailCache = tail.load(std::memory_order_acquire);
+        if (h == tailCache)
+            return false;
+    }
+
+    item = items[h & Mask];
+
+    // libera a posição para o produtor
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+template <class Consume>
+uint SpscRing<T, Capacity>::Drain(Consume consume)
+{
+    uint h = head.load(std::memory_order_relaxed);
+    tailCache = tail.load(std::memory_order_acquire);
+
+    uint count = tailCache - h;
+    for (uint i = 0; i < count; ++i)
+        consume(items[(h + i) & Mask]);
+
+    // libera todas as posições lidas de uma vez
+    head.store(h + count, std::memory_order_release);
+    return count;
+}
+
+// -------------------------------------------------------------------------------
+
+template <class T, uint Capacity>
+uint SpscRing<T, Capacity>::Size() const
+{
+    // lê o início antes do fim para que o resultado nunca seja negativo
+    uint h = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - h;
+}
+
+// -------------------------------------------------------------------------------
+
+#endif
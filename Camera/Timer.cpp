@@ -1,35 +1,108 @@
 /**********************************************************************************
-// Timer (Cdigo Fonte)
-// 
-// Criao:     02 Abr 2011
-// Atualizao: 07 Ago 2021
+// Timer (Código Fonte)
+//
+// Criação:     02 Abr 2011
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Usa um contador de alta preciso para medir o tempo
+// Descrição:   Usa um contador de alta precisão para medir o tempo
 //
 **********************************************************************************/
 
 #include "Timer.h"
+#include <sstream>
+using std::stringstream;
+using namespace std::chrono;
+
+#ifdef _WIN32
+#include <windows.h>                        // QueryPerformanceCounter
+#else
+#include <time.h>                           // clock_gettime
+#endif
+
+#if defined(DXUT_TIMER_TSC) && !defined(_MSC_VER)
+#include <cpuid.h>                          // __get_cpuid
+#endif
 
 // ------------------------------------------------------------------------------
-// inicializao de membros estticos
 
-LARGE_INTEGER Timer::freq = { };    // frequncia do contador
+// duração da calibração do TSC
+static const milliseconds CalibrationTime(10);
 
 // ------------------------------------------------------------------------------
 
-Timer::Timer()
+#ifdef DXUT_TIMER_TSC
+
+// verifica se o TSC avança a uma taxa constante em todos os estados
+// de energia e núcleos (CPUID 8000_0007h, EDX bit 8)
+static bool InvariantTsc()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if (uint(info[0]) < 0x80000007)
+        return false;
+
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#else
+    uint a, b, c, d;
+    if (!__get_cpuid(0x80000000, &a, &b, &c, &d) || a < 0x80000007)
+        return false;
+
+    __get_cpuid(0x80000007, &a, &b, &c, &d);
+    return (d & (1 << 8)) != 0;
+#endif
+}
+
+#endif
+
+// ------------------------------------------------------------------------------
+
+TimerClock CalibrateClock(bool useTsc)
 {
-    // inicializa frequncia do contador apenas na primeira instanciao 
-    if (!freq.QuadPart)
+    // relógio monotônico da biblioteca padrão
+    TimerClock clock;
+    clock.source = TIMER_STEADY;
+    clock.freq = llong(steady_clock::period::den / steady_clock::period::num);
+
+#ifdef DXUT_TIMER_TSC
+    if (useTsc && InvariantTsc())
     {
-        // pega frequncia do contador de alta resoluo
-        QueryPerformanceFrequency(&freq);
+        // conta os ciclos durante um intervalo curto do relógio monotônico
+        steady_clock::time_point t0 = steady_clock::now();
+        llong c0 = llong(__rdtsc());
+        steady_clock::time_point t1;
+
+        do t1 = steady_clock::now();
+        while (t1 - t0 < CalibrationTime);
+
+        llong c1 = llong(__rdtsc());
+        double cycles = (c1 - c0) / duration<double>(t1 - t0).count();
+
+        // descarta frequências implausíveis (TSC virtualizado ou instável)
+        if (cycles > 1e8 && cycles < 1e11)
+        {
+            clock.freq = llong(cycles);
+            clock.source = TIMER_TSC;
+        }
     }
+#else
+    (void) useTsc;
+#endif
 
-    // zera os valores de incio e fim da contagem
-    ZeroMemory(&start, sizeof(start));
-    ZeroMemory(&end, sizeof(end));
+    return clock;
+}
+
+// ------------------------------------------------------------------------------
+
+Timer::Timer()
+{
+    // o contador é escolhido na primeira leitura, não aqui: timers
+    // estáticos não atrasam a inicialização do programa
+
+    // zera os valores de início e fim da contagem
+    start = end = 0;
 
     // timer em funcionamento
     stoped = false;
@@ -45,15 +118,14 @@ void Timer::Start()
         //
         //      <--- elapsed ---->
         // ----|------------------|------------> time
-        //    start               end     
+        //    start               end
         //
-        
+
         // tempo transcorrida antes da parada
-        llong elapsed = end.QuadPart - start.QuadPart;
-        
-        // leva em conta tempo j transcorrido antes da parada
-        QueryPerformanceCounter(&start); 
-        start.QuadPart -= elapsed;
+        llong elapsed = end - start;
+
+        // leva em conta tempo já transcorrido antes da parada
+        start = Ticks() - elapsed;
 
         // retoma contagem normal
         stoped = false;
@@ -61,7 +133,7 @@ void Timer::Start()
     else
     {
         // inicia contagem do tempo
-        QueryPerformanceCounter(&start);
+        start = Ticks();
     }
 }
 
@@ -72,7 +144,7 @@ void Timer::Stop()
     if (!stoped)
     {
         // marca o ponto de parada do tempo
-        QueryPerformanceCounter(&end);
+        end = Ticks();
         stoped = true;
     }
 }
@@ -86,36 +158,36 @@ double Timer::Reset()
     if (stoped)
     {
         // pega tempo transcorrido antes da parada
-        elapsed = end.QuadPart - start.QuadPart;
-        
+        elapsed = end - start;
+
         // reinicia contagem do tempo
-        QueryPerformanceCounter(&start); 
-        
+        start = Ticks();
+
         // contagem reativada
         stoped = false;
     }
     else
     {
         // finaliza contagem do tempo
-        QueryPerformanceCounter(&end);
+        end = Ticks();
 
         // calcula tempo transcorrido (em ciclos)
-        elapsed = end.QuadPart - start.QuadPart;
+        elapsed = end - start;
 
         // reinicia contador
         start = end;
     }
 
     // converte tempo para segundos
-    return elapsed / double(freq.QuadPart);    
+    return elapsed / double(Frequency());
 }
 
 // ------------------------------------------------------------------------------
 
 llong Timer::Stamp()
 {
-    QueryPerformanceCounter(&end);
-    return end.QuadPart;
+    end = Ticks();
+    return end;
 }
 
 // ------------------------------------------------------------------------------
@@ -126,20 +198,20 @@ double Timer::Elapsed()
 
     if (stoped)
     {
-        // pega tempo transcorrido at a parada
-        elapsed = end.QuadPart - start.QuadPart;
+        // pega tempo transcorrido até a parada
+        elapsed = end - start;
     }
     else
     {
         // finaliza contagem do tempo
-        QueryPerformanceCounter(&end);
+        end = Ticks();
 
         // calcula tempo transcorrido (em ciclos)
-        elapsed = end.QuadPart - start.QuadPart;
+        elapsed = end - start;
     }
 
     // converte tempo para segundos
-    return elapsed / double(freq.QuadPart);
+    return elapsed / double(Frequency());
 }
 
 // -------------------------------------------------------------------------------
@@ -150,21 +222,111 @@ double Timer::Elapsed(llong stamp)
 
     if (stoped)
     {
-        // pega tempo transcorrido at a pausa
-        elapsed = end.QuadPart - stamp;
+        // pega tempo transcorrido até a pausa
+        elapsed = end - stamp;
 
     }
     else
     {
         // finaliza contagem do tempo
-        QueryPerformanceCounter(&end);
+        end = Ticks();
 
         // calcula tempo transcorrido (em ciclos)
-        elapsed = end.QuadPart - stamp;
+        elapsed = end - stamp;
     }
 
     // converte tempo para segundos
-    return elapsed / double(freq.QuadPart);
+    return elapsed / double(Frequency());
 }
 
-// -------------------------------------------------------------------------------
\ No newline at end of file
+// -------------------------------------------------------------------------------
+// Medição do custo das fontes de tempo
+
+string TimerBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(2);
+    text << "steady_clock " << steadyNs << " ns, "
+#ifdef _WIN32
+         << "QueryPerformanceCounter "
+#else
+         << "clock_gettime "
+#endif
+         << systemNs << " ns, ";
+
+    if (tscNs > 0.0)
+        text << "rdtsc " << tscNs << " ns, ";
+    else
+        text << "rdtsc indisponível, ";
+
+    text << "Stamp " << stampNs << " ns ("
+         << (source == TIMER_TSC ? "TSC" : "steady_clock");
+
+    if (source == TIMER_TSC)
+        text << " a " << tscFrequency / 1e9 << " GHz";
+
+    text << ")";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+// destino das leituras medidas
+static volatile llong benchmarkSink;
+
+// tempo médio em nanossegundos de uma leitura
+template <class Read>
+static double CallCost(uint calls, Read read)
+{
+    llong sum = 0;
+    steady_clock::time_point t0 = steady_clock::now();
+
+    for (uint i = 0; i < calls; ++i)
+        sum += read();
+
+    double ns = duration<double, std::nano>(steady_clock::now() - t0).count();
+
+    // impede que o compilador descarte as leituras
+    benchmarkSink = sum;
+
+    return ns / calls;
+}
+
+TimerBenchmark BenchmarkTimer(uint calls)
+{
+    // calibra o contador antes das medições
+    Timer timer;
+    Timer::Clock();
+
+    TimerBenchmark result = {};
+    result.calls = calls ? calls : 1;
+    result.source = Timer::Source();
+    result.tscFrequency = Timer::Source() == TIMER_TSC ? double(Timer::Frequency()) : 0.0;
+
+    result.steadyNs = CallCost(result.calls, []
+        { return llong(steady_clock::now().time_since_epoch().count()); });
+
+    result.systemNs = CallCost(result.calls, []
+        {
+#ifdef _WIN32
+            LARGE_INTEGER counter;
+            QueryPerformanceCounter(&counter);
+            return llong(counter.QuadPart);
+#else
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return llong(now.tv_sec) * 1000000000 + now.tv_nsec;
+#endif
+        });
+
+#ifdef DXUT_TIMER_TSC
+    result.tscNs = CallCost(result.calls, [] { return llong(__rdtsc()); });
+#endif
+
+    result.stampNs = CallCost(result.calls, [&timer] { return timer.Stamp(); });
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------
@@ -1,11 +1,21 @@
 /**********************************************************************************
-// Timer (Arquivo de Cabealho)
-// 
-// Criao:     02 Abr 2011
-// Atualizao: 07 Ago 2021
+// Timer (Arquivo de Cabeçalho)
+//
+// Criação:     02 Abr 2011
+// Atualização: 16 Out 2026
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Usa um contador de alta preciso para medir o tempo
+// Descrição:   Usa um contador de alta precisão para medir o tempo
+//
+//              O contador é o relógio monotônico da biblioteca padrão
+//              (std::chrono::steady_clock) ou, em processadores x86 com TSC
+//              invariante, o contador de ciclos lido com rdtsc, que custa
+//              poucos nanossegundos por leitura. A frequência do TSC é
+//              calibrada contra o relógio monotônico na primeira leitura do
+//              contador (não na construção, nem durante a inicialização de
+//              timers estáticos), de forma segura entre threads, e a escolha
+//              vale para todo o programa, de modo que marcas de tempo de
+//              timers diferentes são compatíveis.
 //
 **********************************************************************************/
 
@@ -14,35 +24,86 @@
 
 // -------------------------------------------------------------------------------
 
-#include <windows.h>                          // acesso ao contador de alta preciso do Windows
-#include "Types.h"                            // tipos especficos do motor
+#include "Types.h"                            // tipos específicos do motor
+#include <chrono>                             // relógio monotônico portável
+#include <string>
+using std::string;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DXUT_TIMER_TSC                        // contador de ciclos disponível
+#ifdef _MSC_VER
+#include <intrin.h>                           // __rdtsc e __cpuid
+#else
+#include <x86intrin.h>                        // __rdtsc
+#endif
+#endif
 
 // -------------------------------------------------------------------------------
 
+// fonte do contador usado pelos timers
+enum TimerSource { TIMER_STEADY, TIMER_TSC };
+
+// contador escolhido para todo o programa
+struct TimerClock
+{
+    TimerSource source;                       // fonte do contador
+    llong freq;                               // frequência do contador
+};
+
 class Timer
 {
 private:
-    static LARGE_INTEGER freq;                // frequncia do contador
-    LARGE_INTEGER start, end;                 // valores de incio e fim do contador
+    llong start, end;                         // valores de início e fim do contador
     bool stoped;                              // estado da contagem
-    
+
 public:
     Timer();                                  // construtor
 
     void   Start();                           // inicia/retoma contagem do tempo
-    void   Stop();                            // pra contagem do tempo
+    void   Stop();                            // pára contagem do tempo
     double Reset();                           // reinicia contagem e retorna tempo transcorrido
-    double Elapsed();                         // retorna tempo transcorrido em segundos    
+    double Elapsed();                         // retorna tempo transcorrido em segundos
     bool   Elapsed(double secs);              // verifica se transcorreu "secs" segundos
 
     llong  Stamp();                           // retorna valor atual do contador
     double Elapsed(llong stamp);              // retorna tempo transcorrido desde a marca
     bool   Elapsed(llong stamp, double secs); // testa se transcorreu o tempo desde a marca
-}; 
+
+    // escolhe e calibra o contador no primeiro uso (o TSC só é usado se
+    // for invariante); leituras seguintes apenas consultam a escolha
+    static const TimerClock & Clock();
+
+    static llong Ticks();                     // valor atual do contador
+    static llong Frequency();                 // frequência do contador (ticks por segundo)
+    static TimerSource Source();              // fonte do contador
+};
+
+// escolhe a fonte do contador e mede a frequência do TSC (bloqueia
+// por alguns milissegundos); usado apenas por Timer::Clock
+TimerClock CalibrateClock(bool useTsc = true);
+
+// -------------------------------------------------------------------------------
+
+// custo por leitura de cada fonte de tempo
+struct TimerBenchmark
+{
+    uint   calls;                             // leituras medidas em cada fonte
+    double steadyNs;                          // std::chrono::steady_clock::now
+    double systemNs;                          // QueryPerformanceCounter ou clock_gettime
+    double tscNs;                             // rdtsc (zero se indisponível)
+    double stampNs;                           // Timer::Stamp com a fonte escolhida
+    double tscFrequency;                      // frequência calibrada do TSC (zero se não usado)
+    TimerSource source;                       // fonte escolhida
+
+    string ToString() const;                  // resumo em formato texto
+};
+
+// mede o custo por leitura de cada fonte de tempo
+TimerBenchmark BenchmarkTimer(uint calls = 1000000);
 
 // -------------------------------------------------------------------------------
 
-// Funes Inline
+// Funções Inline
 
 inline bool Timer::Elapsed(double secs)
 { return (Elapsed() >= secs ? true : false); }
@@ -50,6 +111,29 @@ inline bool Timer::Elapsed(double secs)
 inline bool Timer::Elapsed(llong stamp, double secs)
 { return (Elapsed(stamp) >= secs ? true : false); }
 
+inline const TimerClock & Timer::Clock()
+{
+    // inicializada na primeira chamada de qualquer thread (a inicialização
+    // de estáticos locais é sincronizada pelo compilador)
+    static const TimerClock clock = CalibrateClock();
+    return clock;
+}
+
+inline llong Timer::Frequency()
+{ return Clock().freq; }
+
+inline TimerSource Timer::Source()
+{ return Clock().source; }
+
+inline llong Timer::Ticks()
+{
+#ifdef DXUT_TIMER_TSC
+    if (Clock().source == TIMER_TSC)
+        return llong(__rdtsc());
+#endif
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
 // -------------------------------------------------------------------------------
 
-#endif
\ No newline at end of file
+#endif
@@ -1,12 +1,12 @@
 /**********************************************************************************
-// Types (Arquivo de Cabealho)
+// Types (Arquivo de Cabeçalho)
 // 
-// Criao:     02 Abr 2011
-// Atualizao: 07 Ago 2021
+// Criação:     02 Abr 2011
+// Atualização: 07 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Isola os tipos especficos da plataforma fornecendo 
-//              tipos consistentes para todo o Motor Grfico.
+// Descrição:   Isola os tipos específicos da plataforma fornecendo 
+//              tipos consistentes para todo o Motor Gráfico.
 //
 **********************************************************************************/
 
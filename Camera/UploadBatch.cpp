@@ -0,0 +1,295 @@
+/**********************************************************************************
+// UploadBatch (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Lote de envios de geometria estática para a GPU.
+//
+**********************************************************************************/
+
+#include "UploadBatch.h"
+#include <cstring>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// alinhamento de cada buffer dentro da área de upload
+static const ullong StagingAlignment = 16;
+
+// -------------------------------------------------------------------------------
+
+HostCopyQueue::HostCopyQueue()
+{
+    transitionCalls = 0;
+    barriers = 0;
+    copies = 0;
+    submits = 0;
+    bytes = 0;
+    signaled = 0;
+    completed = 0;
+    invalid = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+void HostCopyQueue::Transition(const BufferTransition * transitions, uint count)
+{
+    ++transitionCalls;
+    barriers += count;
+
+    // o estado anterior de cada barreira deve ser o estado atual do buffer
+    for (uint i = 0; i < count; ++i)
+    {
+        BufferState & state = states[transitions[i].buffer];
+        if (state != transitions[i].before)
+            ++invalid;
+        state = transitions[i].after;
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void HostCopyQueue::CopyBuffer(void * dest, ullong destOffset, byte * staging, ullong stagingOffset, ullong size)
+{
+    // a cópia só é válida depois da barreira para BUFFER_COPY_DEST
+    if (State(dest) != BUFFER_COPY_DEST)
+        ++invalid;
+
+    // o destino é memória comum
+    memcpy(static_cast<byte*>(dest) + destOffset, staging + stagingOffset, size_t(size));
+
+    ++copies;
+    bytes += size;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong HostCopyQueue::Submit()
+{
+    ++submits;
+    return ++signaled;
+}
+
+// -------------------------------------------------------------------------------
+
+ullong HostCopyQueue::Completed()
+{
+    return completed;
+}
+
+// -------------------------------------------------------------------------------
+
+void HostCopyQueue::Finish()
+{
+    completed = signaled;
+}
+
+// -------------------------------------------------------------------------------
+
+BufferState HostCopyQueue::State(void * buffer) const
+{
+    auto found = states.find(buffer);
+    return found == states.end() ? BUFFER_COMMON : found->second;
+}
+
+// -------------------------------------------------------------------------------
+
+string UploadBatchStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << "envios: " << batches << " lotes, " << buffers << " buffers, "
+         << bytes / 1024.0 << " KB (" << stagingBytes / 1024.0 << " KB em upload), "
+         << pendingStaging << " áreas aguardando a GPU";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+UploadBatch::UploadBatch(UploadMemory & mem, CopyQueue & copyQueue) : memory(mem), queue(copyQueue)
+{
+    stats = {};
+}
+
+// -------------------------------------------------------------------------------
+
+UploadBatch::~UploadBatch()
+{
+    // quem destrói o lote garante que a GPU está ociosa
+    for (const Staging & staging : pending)
+        memory.Release(staging.cpu);
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadBatch::Add(void * dest, const void * data, ullong size)
+{
+    if (size)
+        items.push_back({ dest, data, size });
+}
+
+// -------------------------------------------------------------------------------
+
+ullong UploadBatch::Submit()
+{
+    if (items.empty())
+        return 0;
+
+    // todos os envios cabem em uma única área de upload
+    ullong total = 0;
+    for (const Item & item : items)
+        total += (item.size + StagingAlignment - 1) & ~(StagingAlignment - 1);
+
+    ullong gpu;
+    byte * staging = memory.Create(total, &gpu);
+
+    vector<BufferTransition> transitions(items.size());
+    vector<ullong> offsets(items.size());
+
+    ullong offset = 0;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        memcpy(staging + offset, items[i].data, size_t(items[i].size));
+        offsets[i] = offset;
+        offset += (items[i].size + StagingAlignment - 1) & ~(StagingAlignment - 1);
+
+        transitions[i] = { items[i].dest, BUFFER_COMMON, BUFFER_COPY_DEST };
+        stats.bytes += items[i].size;
+    }
+
+    // uma barreira para todos os destinos, as cópias e outra barreira
+    queue.Transition(transitions.data(), uint(transitions.size()));
+
+    for (size_t i = 0; i < items.size(); ++i)
+        queue.CopyBuffer(items[i].dest, 0, staging, offsets[i], items[i].size);
+
+    for (BufferTransition & transition : transitions)
+    {
+        transition.before = BUFFER_COPY_DEST;
+        transition.after = BUFFER_GENERIC_READ;
+    }
+    queue.Transition(transitions.data(), uint(transitions.size()));
+
+    ullong fence = queue.Submit();
+    pending.push_back({ staging, fence });
+
+    ++stats.batches;
+    stats.buffers += items.size();
+    stats.stagingBytes += total;
+    stats.pendingStaging = pending.size();
+
+    items.clear();
+    return fence;
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadBatch::Reclaim(ullong completed)
+{
+    for (size_t i = 0; i < pending.size();)
+    {
+        if (pending[i].fence <= completed)
+        {
+            memory.Release(pending[i].cpu);
+            pending[i] = pending.back();
+            pending.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    stats.pendingStaging = pending.size();
+}
+
+// -------------------------------------------------------------------------------
+// Verificação do lote
+
+SelfTestReport TestUploadBatch()
+{
+    SelfTestReport report("Lote de envios");
+
+    HostUploadMemory memory;
+    HostCopyQueue queue;
+    UploadBatch batch(memory, queue);
+
+    // quatro buffers de tamanhos diferentes e um envio vazio
+    const ullong sizes[] = { 1, 17, 100, 4096 };
+    vector<byte> source[4];
+    vector<byte> dest[4];
+    ullong total = 0;
+    ullong aligned = 0;
+
+    uint seed = 20261016;
+    for (uint i = 0; i < 4; ++i)
+    {
+        source[i].resize(size_t(sizes[i]));
+        for (byte & value : source[i])
+        {
+            seed = seed * 1664525 + 1013904223;
+            value = byte(seed >> 24);
+        }
+        dest[i].assign(size_t(sizes[i]), byte(0));
+
+        batch.Add(dest[i].data(), source[i].data(), sizes[i]);
+        total += sizes[i];
+        aligned += (sizes[i] + StagingAlignment - 1) & ~(StagingAlignment - 1);
+    }
+    batch.Add(dest[0].data(), source[0].data(), 0);
+
+    report.Check(batch.Pending() == 4, "envio vazio ignorado");
+
+    // uma submissão com duas listas de barreiras e uma cópia por buffer
+    ullong fence = batch.Submit();
+    report.Check(fence == 1, "primeiro lote na cerca 1");
+    report.Check(batch.Pending() == 0, "lote esvaziado na submissão");
+    report.Check(queue.submits == 1, "uma única submissão por lote");
+    report.Check(queue.transitionCalls == 2, "duas listas de barreiras por lote");
+    report.Check(queue.barriers == 8, "duas mudanças de estado por buffer");
+    report.Check(queue.copies == 4, "uma cópia por buffer");
+    report.Check(queue.bytes == total, "bytes copiados");
+    report.Check(queue.invalid == 0, "estados anteriores das barreiras e das cópias");
+
+    bool copied = true;
+    bool ready = true;
+    for (uint i = 0; i < 4; ++i)
+    {
+        copied = copied && dest[i] == source[i];
+        ready = ready && queue.State(dest[i].data()) == BUFFER_GENERIC_READ;
+    }
+    report.Check(copied, "conteúdo dos buffers de destino");
+    report.Check(ready, "buffers prontos para leitura");
+
+    // uma única área de upload, com cada buffer alinhado
+    const UploadBatchStats & stats = batch.Stats();
+    report.Check(memory.created == 1, "uma área de upload por lote");
+    report.Check(stats.stagingBytes == aligned, "área de upload com buffers alinhados");
+    report.Check(stats.bytes == total && stats.buffers == 4, "estatísticas do lote");
+
+    // a área de upload só é liberada depois da cerca
+    batch.Reclaim(queue.Completed());
+    report.Check(memory.released == 0 && stats.pendingStaging == 1, "área mantida antes da cerca");
+
+    queue.Finish();
+    batch.Reclaim(queue.Completed());
+    report.Check(memory.released == 1 && stats.pendingStaging == 0, "área liberada depois da cerca");
+
+    // lote vazio não submete nada
+    report.Check(batch.Submit() == 0 && queue.submits == 1, "lote vazio sem submissão");
+
+    // o lote seguinte usa a próxima cerca e uma nova área de upload
+    vector<byte> extra(size_t(sizes[2]), byte(0));
+    batch.Add(extra.data(), source[2].data(), sizes[2]);
+    report.Check(batch.Submit() == 2, "segundo lote na cerca 2");
+    report.Check(extra == source[2] && queue.invalid == 0, "segundo lote copiado");
+    report.Check(memory.created == 2 && stats.pendingStaging == 1, "área do segundo lote pendente");
+
+    return report;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/**********************************************************************************
+// UploadBatch (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Lote de envios de geometria estática para a GPU.
+//
+//              Os buffers adicionados ao lote são empacotados em uma única
+//              área de upload. Na submissão, todos os buffers de destino
+//              mudam de estado com uma única lista de barreiras, cada um
+//              recebe uma cópia de região e outra lista de barreiras os
+//              deixa prontos para leitura. Os comandos são submetidos uma
+//              vez e a área de upload só é liberada depois da cerca.
+//
+//              Os comandos passam por uma interface de fila de cópia: uma
+//              versão em memória comum conta barreiras, cópias e submissões
+//              e acompanha o estado de cada buffer para verificar o lote
+//              sem Direct3D.
+//
+**********************************************************************************/
+
+#ifndef DXUT_UPLOADBATCH_H
+#define DXUT_UPLOADBATCH_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "UploadRing.h"                 // memória de upload
+#include "SelfTest.h"                   // verificações de -selftest
+#include <string>
+#include <unordered_map>
+#include <vector>
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// estados de um buffer de destino durante o envio
+enum BufferState { BUFFER_COMMON, BUFFER_COPY_DEST, BUFFER_GENERIC_READ };
+
+// mudança de estado de um buffer
+struct BufferTransition
+{
+    void * buffer;                      // buffer de destino
+    BufferState before;                 // estado atual
+    BufferState after;                  // novo estado
+};
+
+// -------------------------------------------------------------------------------
+
+// fila que grava e executa os comandos de cópia
+class CopyQueue
+{
+public:
+    virtual ~CopyQueue() {}
+
+    // grava uma lista de mudanças de estado (uma única barreira)
+    virtual void Transition(const BufferTransition * transitions, uint count) = 0;
+
+    // grava a cópia de size bytes da área de upload para o buffer
+    virtual void CopyBuffer(void * dest, ullong destOffset, byte * staging, ullong stagingOffset, ullong size) = 0;
+
+    // submete os comandos gravados e retorna a cerca que os conclui
+    virtual ullong Submit() = 0;
+
+    // último valor da cerca alcançado
+    virtual ullong Completed() = 0;
+};
+
+// -------------------------------------------------------------------------------
+
+// fila em memória comum: executa cópias entre ponteiros e conta os comandos
+class HostCopyQueue : public CopyQueue
+{
+private:
+    std::unordered_map<void*, BufferState> states;  // estado de cada buffer (COMMON se ausente)
+
+public:
+    uint   transitionCalls;             // listas de barreiras gravadas
+    uint   barriers;                    // mudanças de estado gravadas
+    uint   copies;                      // cópias gravadas
+    uint   submits;                     // submissões
+    ullong bytes;                       // bytes copiados
+    ullong signaled;                    // última cerca sinalizada
+    ullong completed;                   // última cerca concluída
+    uint   invalid;                     // barreiras com estado anterior errado ou cópias
+                                        // para buffers fora de BUFFER_COPY_DEST
+
+    HostCopyQueue();
+
+    void Transition(const BufferTransition * transitions, uint count);
+    void CopyBuffer(void * dest, ullong destOffset, byte * staging, ullong stagingOffset, ullong size);
+    ullong Submit();
+    ullong Completed();
+
+    void Finish();                      // conclui todas as submissões
+    BufferState State(void * buffer) const;         // estado atual de um buffer
+};
+
+// -------------------------------------------------------------------------------
+
+// estatísticas dos lotes
+struct UploadBatchStats
+{
+    ullong batches;                     // lotes submetidos
+    ullong buffers;                     // buffers enviados
+    ullong bytes;                       // bytes enviados
+    ullong stagingBytes;                // bytes em áreas de upload (com alinhamento)
+    ullong pendingStaging;              // áreas de upload aguardando a GPU
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class UploadBatch
+{
+private:
+    struct Item
+    {
+        void * dest;                    // buffer de destino
+        const void * data;              // dados na CPU
+        ullong size;                    // bytes
+    };
+
+    struct Staging
+    {
+        byte * cpu;                     // área de upload
+        ullong fence;                   // cerca da submissão que a usa
+    };
+
+    UploadMemory & memory;              // origem das áreas de upload
+    CopyQueue & queue;                  // grava e submete os comandos
+    vector<Item> items;                 // envios do lote atual
+    vector<Staging> pending;            // áreas aguardando a GPU
+    UploadBatchStats stats;             // estatísticas
+
+public:
+    UploadBatch(UploadMemory & memory, CopyQueue & queue);
+    ~UploadBatch();
+
+    // adiciona um envio ao lote (data deve continuar válido até Submit)
+    void Add(void * dest, const void * data, ullong size);
+
+    // empacota, grava e submete os envios; retorna a cerca (0 se vazio)
+    ullong Submit();
+
+    void Reclaim(ullong completed);     // libera áreas de upload já concluídas
+    uint Pending() const;               // envios ainda não submetidos
+
+    const UploadBatchStats & Stats() const;
+};
+
+// confere que um lote grava uma lista de barreiras, uma cópia por buffer e
+// outra lista de barreiras em uma única submissão, com os estados corretos,
+// os dados copiados e a área de upload liberada só depois da cerca
+SelfTestReport TestUploadBatch();
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// envios ainda não submetidos
+inline uint UploadBatch::Pending() const
+{ return uint(items.size()); }
+
+// estatísticas dos lotes
+inline const UploadBatchStats & UploadBatch::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,375 @@
+/**********************************************************************************
+// UploadRing (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Alocador linear em anel para dados enviados à GPU a cada
+//              quadro, com recuperação por cerca e crescimento.
+//
+**********************************************************************************/
+
+#include "UploadRing.h"
+#include "Timer.h"
+#include <new>
+#include <sstream>
+using std::stringstream;
+
+// -------------------------------------------------------------------------------
+
+// páginas alinhadas como os recursos do Direct3D
+static const size_t PageAlignment = 65536;
+
+// -------------------------------------------------------------------------------
+
+HostUploadMemory::HostUploadMemory()
+{
+    created = 0;
+    released = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+byte * HostUploadMemory::Create(ullong size, ullong * gpuAddress)
+{
+    ++created;
+    byte * cpu = (byte*) ::operator new(size_t(size), std::align_val_t(PageAlignment));
+    *gpuAddress = ullong(cpu);
+    return cpu;
+}
+
+// -------------------------------------------------------------------------------
+
+void HostUploadMemory::Release(byte * cpuAddress)
+{
+    ++released;
+    ::operator delete(cpuAddress, std::align_val_t(PageAlignment));
+}
+
+// -------------------------------------------------------------------------------
+
+string UploadRingStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << "anel de upload: " << capacity / 1024.0 << " KB, em uso "
+         << used / 1024.0 << " KB, pico " << highWater / 1024.0 << " KB, "
+         << allocations << " alocações (" << requested / 1024.0 << " KB), "
+         << grows << " crescimentos, " << framesInFlight << " quadros em andamento, "
+         << retiredPages << " páginas aguardando a GPU";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+UploadRing::UploadRing(UploadMemory & mem, ullong capacity) : memory(mem)
+{
+    stats = {};
+    stats.capacity = capacity ? capacity : PageAlignment;
+
+    page.capacity = stats.capacity;
+    page.cpu = memory.Create(page.capacity, &page.gpu);
+    page.fence = 0;
+
+    head = tail = 0;
+}
+
+// -------------------------------------------------------------------------------
+
+UploadRing::~UploadRing()
+{
+    // quem destrói o anel garante que a GPU está ociosa
+    for (const Page & old : retired)
+        memory.Release(old.cpu);
+
+    memory.Release(page.cpu);
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadRing::Grow(ullong minimum)
+{
+    if (tail == head)
+    {
+        // nada da página atual está em uso
+        memory.Release(page.cpu);
+    }
+    else
+    {
+        // sem alocações neste quadro a página fica livre com o quadro anterior,
+        // caso contrário a cerca é conhecida só no fim do quadro atual
+        Page old = page;
+        old.fence = (!frames.empty() && frames.back().end == tail) ? frames.back().fence : 0;
+        retired.push_back(old);
+    }
+
+    ullong capacity = page.capacity * 2;
+    while (capacity < minimum)
+        capacity *= 2;
+
+    page.capacity = capacity;
+    page.cpu = memory.Create(capacity, &page.gpu);
+    page.fence = 0;
+
+    // os quadros em andamento ficam cobertos pela cerca da página antiga
+    frames.clear();
+    head = tail = 0;
+
+    ++stats.grows;
+    stats.capacity = capacity;
+    stats.retiredPages = retired.size();
+}
+
+// -------------------------------------------------------------------------------
+
+UploadAllocation UploadRing::Allocate(ullong size, ullong alignment)
+{
+    if (alignment == 0)
+        alignment = 1;
+
+    ullong capacity = page.capacity;
+    ullong pos = tail % capacity;
+    ullong aligned = (pos + alignment - 1) & ~(alignment - 1);
+    ullong start = tail + (aligned - pos);
+
+    // a região não cabe até o fim da página: recomeça no início
+    if (aligned + size > capacity)
+        start = tail + (capacity - pos);
+
+    // o anel alcançaria regiões ainda em uso pela GPU
+    if (start + size - head > capacity)
+    {
+        Grow(size + alignment);
+        capacity = page.capacity;
+        start = 0;
+    }
+
+    tail = start + size;
+
+    ullong offset = start % capacity;
+    UploadAllocation allocation = { page.cpu + offset, page.gpu + offset, offset, size };
+
+    ++stats.allocations;
+    stats.requested += size;
+    stats.used = tail - head;
+    if (stats.used > stats.highWater)
+        stats.highWater = stats.used;
+
+    return allocation;
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadRing::FinishFrame(ullong fence)
+{
+    // páginas trocadas durante o quadro são liberadas com ele
+    for (Page & old : retired)
+    {
+        if (old.fence == 0)
+            old.fence = fence;
+    }
+
+    frames.push_back({ fence, tail });
+    stats.framesInFlight = frames.size();
+}
+
+// -------------------------------------------------------------------------------
+
+void UploadRing::Reclaim(ullong completed)
+{
+    // o início do anel avança até o fim do último quadro concluído
+    while (!frames.empty() && frames.front().fence <= completed)
+    {
+        head = frames.front().end;
+        frames.pop_front();
+    }
+
+    for (size_t i = 0; i < retired.size();)
+    {
+        if (retired[i].fence && retired[i].fence <= completed)
+        {
+            memory.Release(retired[i].cpu);
+            retired[i] = retired.back();
+            retired.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    stats.used = tail - head;
+    stats.framesInFlight = frames.size();
+    stats.retiredPages = retired.size();
+}
+
+// -------------------------------------------------------------------------------
+// Medição da vazão de alocações
+
+string UploadRingBenchmark::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << allocations << " alocações em " << seconds * 1000.0 << " ms ("
+         << allocationsPerSec / 1e6 << " milhões/s); " << stats.ToString();
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+UploadRingBenchmark BenchmarkUploadRing(ullong allocations, uint perFrame)
+{
+    Timer timer;
+
+    HostUploadMemory memory;
+    UploadRing ring(memory);
+
+    UploadRingBenchmark result = {};
+    result.allocations = allocations;
+    if (perFrame == 0)
+        perFrame = 1;
+
+    // tamanhos de 16 a 1024 bytes de um gerador congruencial
+    uint seed = 12345;
+    ullong fence = 0;
+    uint count = 0;
+
+    timer.Start();
+
+    for (ullong i = 0; i < allocations; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        ullong size = 16 + ((seed >> 16) & 1008);
+
+        UploadAllocation allocation = ring.Allocate(size);
+        allocation.cpu[0] = byte(i);
+
+        // dois quadros em andamento: a GPU já concluiu os anteriores
+        if (++count == perFrame)
+        {
+            count = 0;
+            ring.FinishFrame(++fence);
+            if (fence > 2)
+                ring.Reclaim(fence - 2);
+        }
+    }
+
+    result.seconds = timer.Elapsed();
+    result.allocationsPerSec = result.seconds > 0.0 ? allocations / result.seconds : 0.0;
+    result.stats = ring.Stats();
+    return result;
+}
+
+// -------------------------------------------------------------------------------
+// Verificação do anel
+
+SelfTestReport TestUploadRing()
+{
+    SelfTestReport report("Anel de upload");
+    const ullong KB = 1024;
+
+    HostUploadMemory memory;
+    {
+        UploadRing ring(memory, 64 * KB);
+
+        // quadro 1: três regiões seguidas, alinhadas a 256 bytes
+        UploadAllocation first = ring.Allocate(16 * KB);
+        UploadAllocation second = ring.Allocate(100);
+        UploadAllocation third = ring.Allocate(32 * KB - 256);
+        report.Check(first.offset == 0 && second.offset == 16 * KB && third.offset == 16 * KB + 256,
+            "regiões seguidas e alinhadas a 256 bytes");
+        report.Check(second.gpu - first.gpu == 16 * KB && second.cpu - first.cpu == 16 * KB,
+            "endereços na CPU e na GPU com o mesmo deslocamento");
+        ring.FinishFrame(1);
+
+        // com o quadro 1 concluído, 40KB não cabem até o fim da página
+        // e a região volta ao início, sobre a memória do quadro 1
+        ring.Reclaim(1);
+        UploadAllocation wrapped = ring.Allocate(40 * KB);
+        report.Check(wrapped.offset == 0 && wrapped.cpu == first.cpu, "volta ao início da página depois da cerca");
+        report.Check(ring.Stats().grows == 0, "sem crescimento com a região reaproveitada");
+        report.Check(ring.Stats().used == 56 * KB, "sobra do fim da página contada como em uso");
+        ring.FinishFrame(2);
+
+        // o quadro 2 continua na GPU: o anel cresce e a página antiga
+        // só é liberada com a cerca do último quadro que a usou
+        UploadAllocation grown = ring.Allocate(32 * KB);
+        const UploadRingStats & stats = ring.Stats();
+        report.Check(stats.grows == 1 && stats.capacity == 128 * KB, "página dobrada quando o anel alcança o quadro em uso");
+        report.Check(grown.offset == 0 && memory.created == 2, "alocação no início da página nova");
+        report.Check(stats.retiredPages == 1, "página antiga aguardando a GPU");
+        ring.FinishFrame(3);
+
+        ring.Reclaim(1);
+        report.Check(memory.released == 0, "página antiga mantida antes da cerca do quadro 2");
+        ring.Reclaim(2);
+        report.Check(memory.released == 1 && ring.Stats().retiredPages == 0, "página antiga liberada com a cerca do quadro 2");
+        ring.Reclaim(3);
+        report.Check(ring.Stats().used == 0 && ring.Stats().framesInFlight == 0, "anel vazio com todos os quadros concluídos");
+
+        // quadros aleatórios com 2 em andamento: nenhuma região em uso é sobrescrita
+        struct Live
+        {
+            byte * cpu;
+            ullong size;
+            ullong fence;
+        };
+        vector<Live> live;
+        uint seed = 12345;
+        uint overlaps = 0;
+        uint misaligned = 0;
+
+        for (ullong fence = 4; fence < 1004; ++fence)
+        {
+            ring.Reclaim(fence - 3);
+            for (size_t i = 0; i < live.size();)
+            {
+                if (live[i].fence <= fence - 3)
+                {
+                    live[i] = live.back();
+                    live.pop_back();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            seed = seed * 1664525 + 1013904223;
+            uint count = 1 + (seed >> 16) % 30;
+
+            for (uint k = 0; k < count; ++k)
+            {
+                seed = seed * 1664525 + 1013904223;
+                ullong size = 1 + (seed >> 8) % 6000;
+                ullong alignment = ullong(16) << ((seed >> 4) % 9);
+
+                UploadAllocation allocation = ring.Allocate(size, alignment);
+                if (allocation.gpu % alignment)
+                    ++misaligned;
+
+                for (const Live & other : live)
+                    if (allocation.cpu < other.cpu + other.size && other.cpu < allocation.cpu + size)
+                        ++overlaps;
+
+                live.push_back({ allocation.cpu, size, fence });
+            }
+
+            ring.FinishFrame(fence);
+        }
+
+        report.Check(overlaps == 0, "nenhuma sobreposição com regiões em uso (" + std::to_string(overlaps) + ")");
+        report.Check(misaligned == 0, "alinhamentos de 16 bytes a 4KB respeitados");
+
+        ring.Reclaim(1003);
+        report.Check(ring.Stats().used == 0 && ring.Stats().retiredPages == 0, "anel vazio depois da última cerca");
+    }
+
+    report.Check(memory.created == memory.released, "todas as páginas liberadas");
+    return report;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+/**********************************************************************************
+// UploadRing (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Alocador linear em anel para dados enviados à GPU a cada
+//              quadro (buffers constantes e dados dinâmicos).
+//
+//              Uma única página de memória de upload fica mapeada durante
+//              toda a execução. Cada alocação apenas avança o fim do anel,
+//              respeitando o alinhamento pedido (256 bytes para CBVs), e no
+//              fim do quadro a posição atingida é associada ao valor da
+//              cerca daquele quadro. Quando a GPU alcança a cerca, o início
+//              do anel avança até essa posição e o espaço volta a ser usado.
+//
+//              Se uma alocação não cabe no espaço livre, o anel cresce: uma
+//              página maior passa a receber as alocações e a anterior só é
+//              liberada depois da cerca do último quadro que a usou.
+//
+//              A memória das páginas é obtida por uma interface, de modo que
+//              a lógica de alocação roda sem Direct3D (memória comum).
+//
+**********************************************************************************/
+
+#ifndef DXUT_UPLOADRING_H
+#define DXUT_UPLOADRING_H
+
+// -------------------------------------------------------------------------------
+
+#include "Types.h"                      // tipos específicos do motor
+#include "SelfTest.h"                   // verificações de -selftest
+#include <deque>
+#include <string>
+#include <vector>
+using std::deque;
+using std::string;
+using std::vector;
+
+// -------------------------------------------------------------------------------
+
+// memória de upload usada pelas páginas do anel
+class UploadMemory
+{
+public:
+    virtual ~UploadMemory() {}
+
+    // cria e mapeia uma página, retornando o endereço na CPU e na GPU
+    virtual byte * Create(ullong size, ullong * gpuAddress) = 0;
+
+    // libera uma página criada por Create
+    virtual void Release(byte * cpuAddress) = 0;
+};
+
+// -------------------------------------------------------------------------------
+
+// memória comum alinhada a 64KB (testes e medições sem GPU)
+class HostUploadMemory : public UploadMemory
+{
+public:
+    ullong created;                     // páginas criadas
+    ullong released;                    // páginas liberadas
+
+    HostUploadMemory();
+
+    byte * Create(ullong size, ullong * gpuAddress);
+    void Release(byte * cpuAddress);
+};
+
+// -------------------------------------------------------------------------------
+
+// região alocada no anel
+struct UploadAllocation
+{
+    byte * cpu;                         // endereço para escrita na CPU
+    ullong gpu;                         // endereço virtual na GPU
+    ullong offset;                      // deslocamento dentro da página
+    ullong size;                        // bytes pedidos
+};
+
+// estatísticas do anel
+struct UploadRingStats
+{
+    ullong capacity;                    // tamanho da página atual
+    ullong used;                        // bytes em uso (inclui alinhamento e sobras do fim)
+    ullong highWater;                   // maior uso registrado
+    ullong allocations;                 // alocações feitas
+    ullong requested;                   // bytes pedidos
+    ullong grows;                       // trocas por uma página maior
+    ullong framesInFlight;              // quadros ainda não concluídos pela GPU
+    ullong retiredPages;                // páginas antigas aguardando a GPU
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+class UploadRing
+{
+private:
+    struct Page
+    {
+        byte * cpu;                     // endereço na CPU
+        ullong gpu;                     // endereço na GPU
+        ullong capacity;                // tamanho da página
+        ullong fence;                   // cerca do último quadro que a usou (0 pendente)
+    };
+
+    struct Frame
+    {
+        ullong fence;                   // cerca sinalizada após o quadro
+        ullong end;                     // fim do anel ao terminar o quadro
+    };
+
+    UploadMemory & memory;              // origem das páginas
+    Page page;                          // página que recebe as alocações
+    vector<Page> retired;               // páginas antigas ainda em uso pela GPU
+    deque<Frame> frames;                // quadros aguardando a GPU
+
+    // posições crescem sem limite; a posição na página é o resto pela capacidade
+    ullong head;                        // início da região em uso
+    ullong tail;                        // fim da região em uso
+
+    UploadRingStats stats;              // estatísticas
+
+    void Grow(ullong minimum);          // troca a página por uma maior
+
+public:
+    UploadRing(UploadMemory & memory, ullong capacity = 65536);
+    ~UploadRing();
+
+    // aloca size bytes alinhados (potência de dois) para o quadro atual
+    UploadAllocation Allocate(ullong size, ullong alignment = 256);
+
+    void FinishFrame(ullong fence);     // associa as alocações do quadro à cerca
+    void Reclaim(ullong completed);     // libera quadros e páginas já concluídos pela GPU
+
+    const UploadRingStats & Stats() const;
+};
+
+// -------------------------------------------------------------------------------
+
+// medição da vazão de alocações do anel
+struct UploadRingBenchmark
+{
+    ullong allocations;                 // alocações medidas
+    double seconds;                     // duração
+    double allocationsPerSec;           // vazão
+    UploadRingStats stats;              // estado do anel ao final
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// aloca constantes de tamanhos variados simulando quadros com 2 em andamento
+UploadRingBenchmark BenchmarkUploadRing(ullong allocations = 10000000, uint perFrame = 1000);
+
+// confere alinhamento, volta ao início da página, reaproveitamento após a
+// cerca, crescimento com a página antiga presa à cerca e, em quadros
+// aleatórios, que nenhuma alocação sobrepõe outra ainda em uso pela GPU
+SelfTestReport TestUploadRing();
+
+// -------------------------------------------------------------------------------
+// Funções Inline
+
+// estatísticas do anel
+inline const UploadRingStats & UploadRing::Stats() const
+{ return stats; }
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,30 @@
+/**********************************************************************************
+// Vertex (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Define o formato de vértice usado pelas malhas 3D
+//
+**********************************************************************************/
+
+#ifndef DXUT_VERTEX_H
+#define DXUT_VERTEX_H
+
+// -------------------------------------------------------------------------------
+
+#include <DirectXMath.h>
+using namespace DirectX;
+
+// -------------------------------------------------------------------------------
+
+struct Vertex
+{
+    XMFLOAT3 Pos;
+    XMFLOAT4 Color;
+};
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -1,12 +1,12 @@
 /**********************************************************************************
 // Vertex (Arquivo de Sombreamento)
 //
-// Criao:     22 Jul 2020
-// Atualizao: 25 Set 2021
+// Criação:     22 Jul 2020
+// Atualização: 16 Out 2026
 // Compilador:  D3DCompiler
 //
-// Descrio:   Um vertex shader simples que apenas passa a posio e cor
-//              do vrtice para frente sem realizar nenhuma transformao.
+// Descrição:   Um vertex shader simples que apenas passa a posição e cor
+//              do vértice para frente sem realizar nenhuma transformação.
 //
 **********************************************************************************/
 
@@ -15,6 +15,9 @@ cbuffer cbPerObject : register(b0)
     float4x4 WorldViewProj;
 };
 
+// matriz combinada de cada instância (mundo x visão x projeção)
+StructuredBuffer<float4x4> Instances : register(t0);
+
 struct VertexIn
 {
     float3 PosL  : POSITION;
@@ -27,14 +30,14 @@ struct VertexOut
     float4 Color : COLOR;
 };
 
-VertexOut main(VertexIn vin)
+VertexOut main(VertexIn vin, uint instance : SV_InstanceID)
 {
     VertexOut vout;
 
-    // transforma para espao homogneo de recorte
-    vout.PosH = mul(float4(vin.PosL, 1.0f), WorldViewProj);
+    // transforma para espaço homogêneo de recorte
+    vout.PosH = mul(float4(vin.PosL, 1.0f), Instances[instance]);
 
-    // apenas passa a cor do vrtice para o pixel shader
+    // apenas passa a cor do vértice para o pixel shader
     vout.Color = vin.Color;
 
     return vout;
@@ -0,0 +1,441 @@
+/**********************************************************************************
+// VertexFormat (Código Fonte)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Formatos compactos de vértice. As posições são quantizadas
+//              dentro da caixa envolvente da malha, em inteiros de 16 bits
+//              normalizados ou em meio-float, e recuperadas no vertex
+//              shader por escala e deslocamento. A cor é gravada em RGBA8
+//              e as normais, quando existem, em codificação octaédrica de
+//              2 x 16 bits. Cada formato tem o input layout correspondente
+//              e medidas de erro e de memória da conversão.
+//
+**********************************************************************************/
+
+#include "VertexFormat.h"
+#include <DirectXPackedVector.h>
+#include <DirectXColors.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+#include <vector>
+using std::stringstream;
+using std::vector;
+using namespace DirectX::PackedVector;
+
+// -------------------------------------------------------------------------------
+
+// limita um valor ao intervalo [0,1]
+static inline float Saturate(float x)
+{ return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x); }
+
+// converte [0,1] para inteiro normalizado de 16 bits
+static inline ushort ToUnorm16(float x)
+{ return ushort(Saturate(x) * 65535.0f + 0.5f); }
+
+// -------------------------------------------------------------------------------
+
+string PackingStats::ToString() const
+{
+    stringstream text;
+    text << std::fixed;
+    text.precision(1);
+    text << vertices << " vértices, " << sourceBytes / 1024.0 << " KB -> "
+         << packedBytes / 1024.0 << " KB ("
+         << (sourceBytes ? 100.0 * packedBytes / sourceBytes : 0.0) << "%)";
+    text.precision(3);
+    text << std::scientific
+         << ", erro de posição " << maxPosError << " máx " << avgPosError << " médio"
+         << ", cor " << maxColorError;
+    if (maxNormalError > 0.0)
+        text << std::fixed << ", normal " << maxNormalError << " graus";
+    return text.str();
+}
+
+// -------------------------------------------------------------------------------
+
+VertexQuantization ComputeQuantization(const float * boundsMin, const float * boundsMax)
+{
+    float scale[3];
+    for (uint i = 0; i < 3; ++i)
+    {
+        // eixos sem extensão usam escala unitária para não dividir por zero
+        float extent = boundsMax[i] - boundsMin[i];
+        scale[i] = extent > 0.0f ? extent : 1.0f;
+    }
+
+    VertexQuantization q;
+    q.Scale = XMFLOAT3(scale[0], scale[1], scale[2]);
+    q.Bias = XMFLOAT3(boundsMin[0], boundsMin[1], boundsMin[2]);
+    return q;
+}
+
+// -------------------------------------------------------------------------------
+
+VertexQuantization ComputeQuantization(const Vertex * vertices, uint count)
+{
+    float minimum[3] = { 0.0f, 0.0f, 0.0f };
+    float maximum[3] = { 0.0f, 0.0f, 0.0f };
+
+    if (count > 0)
+    {
+        minimum[0] = maximum[0] = vertices[0].Pos.x;
+        minimum[1] = maximum[1] = vertices[0].Pos.y;
+        minimum[2] = maximum[2] = vertices[0].Pos.z;
+    }
+
+    for (uint v = 1; v < count; ++v)
+    {
+        const float * p = &vertices[v].Pos.x;
+        for (uint i = 0; i < 3; ++i)
+        {
+            minimum[i] = std::min(minimum[i], p[i]);
+            maximum[i] = std::max(maximum[i], p[i]);
+        }
+    }
+
+    return ComputeQuantization(minimum, maximum);
+}
+
+// -------------------------------------------------------------------------------
+
+uint VertexStride(VertexFormatType format, bool normals)
+{
+    if (format == VERTEX_FLOAT)
+        return sizeof(Vertex);
+
+    return normals ? sizeof(PackedVertexNormal) : sizeof(PackedVertex);
+}
+
+// -------------------------------------------------------------------------------
+
+uint VertexLayout(VertexFormatType format, bool normals, D3D12_INPUT_ELEMENT_DESC * elements)
+{
+    const D3D12_INPUT_CLASSIFICATION perVertex = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+
+    // o formato completo não tem normais
+    if (format == VERTEX_FLOAT)
+    {
+        elements[0] = { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, perVertex, 0 };
+        elements[1] = { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, perVertex, 0 };
+        return 2;
+    }
+
+    DXGI_FORMAT position = (format == VERTEX_HALF) ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R16G16B16A16_UNORM;
+
+    elements[0] = { "POSITION", 0, position, 0, 0, perVertex, 0 };
+    elements[1] = { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 8, perVertex, 0 };
+
+    if (!normals)
+        return 2;
+
+    elements[2] = { "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 12, perVertex, 0 };
+    return 3;
+}
+
+// -------------------------------------------------------------------------------
+
+uint PackColor(const XMFLOAT4 & color)
+{
+    uint r = uint(Saturate(color.x) * 255.0f + 0.5f);
+    uint g = uint(Saturate(color.y) * 255.0f + 0.5f);
+    uint b = uint(Saturate(color.z) * 255.0f + 0.5f);
+    uint a = uint(Saturate(color.w) * 255.0f + 0.5f);
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+XMFLOAT4 UnpackColor(uint color)
+{
+    return XMFLOAT4(
+        (color & 0xFF) / 255.0f,
+        ((color >> 8) & 0xFF) / 255.0f,
+        ((color >> 16) & 0xFF) / 255.0f,
+        (color >> 24) / 255.0f);
+}
+
+// -------------------------------------------------------------------------------
+
+void OctEncode(const XMFLOAT3 & normal, short * oct)
+{
+    float sum = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+    float x = sum > 0.0f ? normal.x / sum : 0.0f;
+    float y = sum > 0.0f ? normal.y / sum : 0.0f;
+
+    // o hemisfério inferior é dobrado sobre as diagonais do octaedro
+    if (normal.z < 0.0f)
+    {
+        float fx = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float fy = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+
+    oct[0] = short(roundf(std::max(-1.0f, std::min(1.0f, x)) * 32767.0f));
+    oct[1] = short(roundf(std::max(-1.0f, std::min(1.0f, y)) * 32767.0f));
+}
+
+XMFLOAT3 OctDecode(const short * oct)
+{
+    // mesma conversão do formato SNORM no hardware
+    float x = std::max(oct[0] / 32767.0f, -1.0f);
+    float y = std::max(oct[1] / 32767.0f, -1.0f);
+    float z = 1.0f - fabsf(x) - fabsf(y);
+
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    float length = sqrtf(x * x + y * y + z * z);
+    return XMFLOAT3(x / length, y / length, z / length);
+}
+
+// -------------------------------------------------------------------------------
+
+void PackVertices(VertexFormatType format, const Vertex * vertices, const XMFLOAT3 * normals,
+                  uint count, const VertexQuantization & q, void * output)
+{
+    if (format == VERTEX_FLOAT)
+    {
+        memcpy(output, vertices, size_t(count) * sizeof(Vertex));
+        return;
+    }
+
+    uint stride = VertexStride(format, normals != nullptr);
+    byte * out = (byte*) output;
+
+    const float * scale = &q.Scale.x;
+    const float * bias = &q.Bias.x;
+
+    for (uint v = 0; v < count; ++v, out += stride)
+    {
+        // os dois formatos compactos começam como PackedVertex
+        PackedVertexNormal packed = {};
+        const float * p = &vertices[v].Pos.x;
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            float unit = (p[i] - bias[i]) / scale[i];
+            packed.Pos[i] = (format == VERTEX_HALF) ? XMConvertFloatToHalf(Saturate(unit)) : ToUnorm16(unit);
+        }
+        packed.Pos[3] = (format == VERTEX_HALF) ? XMConvertFloatToHalf(1.0f) : 65535;
+
+        packed.Color = PackColor(vertices[v].Color);
+
+        if (normals)
+            OctEncode(normals[v], packed.Normal);
+
+        memcpy(out, &packed, stride);
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+void UnpackPositions(VertexFormatType format, const void * vertices, uint stride,
+                     uint count, const VertexQuantization & q, XMFLOAT3 * positions)
+{
+    const byte * in = (const byte*) vertices;
+    const float * scale = &q.Scale.x;
+    const float * bias = &q.Bias.x;
+
+    for (uint v = 0; v < count; ++v, in += stride)
+    {
+        if (format == VERTEX_FLOAT)
+        {
+            memcpy(&positions[v], in + offsetof(Vertex, Pos), sizeof(XMFLOAT3));
+            continue;
+        }
+
+        // os dois formatos compactos começam pela posição de PackedVertex
+        ushort pos[4];
+        memcpy(pos, in + offsetof(PackedVertex, Pos), sizeof(pos));
+
+        float * p = &positions[v].x;
+        for (uint i = 0; i < 3; ++i)
+        {
+            float unit = (format == VERTEX_HALF) ? XMConvertHalfToFloat(pos[i]) : pos[i] / 65535.0f;
+            p[i] = bias[i] + scale[i] * unit;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------
+
+PackingStats MeasurePacking(VertexFormatType format, const Vertex * vertices, const XMFLOAT3 * normals,
+                            uint count, const VertexQuantization & q, const void * packed)
+{
+    PackingStats stats = {};
+    uint stride = VertexStride(format, normals != nullptr);
+
+    stats.vertices = count;
+    stats.sourceBytes = ullong(count) * (sizeof(Vertex) + (normals ? sizeof(XMFLOAT3) : 0));
+    stats.packedBytes = ullong(count) * stride;
+
+    if (format == VERTEX_FLOAT || count == 0)
+        return stats;
+
+    const byte * in = (const byte*) packed;
+    const float * scale = &q.Scale.x;
+    const float * bias = &q.Bias.x;
+    double sumPosError = 0.0;
+
+    for (uint v = 0; v < count; ++v, in += stride)
+    {
+        PackedVertexNormal item = {};
+        memcpy(&item, in, stride);
+
+        // posição reconstruída como no vertex shader
+        const float * p = &vertices[v].Pos.x;
+        double error = 0.0;
+        for (uint i = 0; i < 3; ++i)
+        {
+            float unit = (format == VERTEX_HALF) ? XMConvertHalfToFloat(item.Pos[i]) : item.Pos[i] / 65535.0f;
+            double d = double(bias[i] + scale[i] * unit) - p[i];
+            error += d * d;
+        }
+        error = sqrt(error);
+        sumPosError += error;
+        stats.maxPosError = std::max(stats.maxPosError, error);
+
+        XMFLOAT4 color = UnpackColor(item.Color);
+        const float * c0 = &vertices[v].Color.x;
+        const float * c1 = &color.x;
+        for (uint i = 0; i < 4; ++i)
+            stats.maxColorError = std::max(stats.maxColorError, double(fabsf(c0[i] - c1[i])));
+
+        if (normals)
+        {
+            const XMFLOAT3 & n0 = normals[v];
+            double length = sqrt(double(n0.x) * n0.x + double(n0.y) * n0.y + double(n0.z) * n0.z);
+            if (length > 0.0)
+            {
+                // em double e com os dois comprimentos: perto de 1 o
+                // arredondamento de float dominaria o acos
+                XMFLOAT3 n1 = OctDecode(item.Normal);
+                double length1 = sqrt(double(n1.x) * n1.x + double(n1.y) * n1.y + double(n1.z) * n1.z);
+                double dot = (double(n0.x) * n1.x + double(n0.y) * n1.y + double(n0.z) * n1.z) / (length * length1);
+                dot = std::max(-1.0, std::min(1.0, dot));
+                stats.maxNormalError = std::max(stats.maxNormalError, acos(dot) * 180.0 / 3.14159265358979323846);
+            }
+        }
+    }
+
+    stats.avgPosError = sumPosError / count;
+    return stats;
+}
+
+// -------------------------------------------------------------------------------
+// Verificação dos formatos
+
+SelfTestReport TestVertexFormats()
+{
+    SelfTestReport report("Formatos de vértice");
+
+    // posições aleatórias em uma caixa que não contém a origem, com os
+    // cantos da caixa; normais aleatórias e os seis eixos
+    const uint count = 4096;
+    const float boxMin[3] = { -3.0f, 0.25f, 2.0f };
+    const float boxMax[3] = { 5.0f, 1.75f, 40.0f };
+
+    vector<Vertex> vertices(count);
+    vector<XMFLOAT3> normals(count);
+
+    uint seed = 20261017;
+    auto random = [&seed]() { seed = seed * 1664525 + 1013904223; return (seed >> 8) / 16777216.0f; };
+
+    for (uint v = 0; v < count; ++v)
+    {
+        float * p = &vertices[v].Pos.x;
+        for (uint i = 0; i < 3; ++i)
+            p[i] = boxMin[i] + (boxMax[i] - boxMin[i]) * random();
+
+        vertices[v].Color = (v & 1) ? XMFLOAT4(Colors::Blue) : XMFLOAT4(Colors::Pink);
+
+        XMVECTOR n = XMVectorSet(random() * 2.0f - 1.0f, random() * 2.0f - 1.0f, random() * 2.0f - 1.0f, 0.0f);
+        XMStoreFloat3(&normals[v], XMVector3Normalize(n));
+    }
+
+    for (uint corner = 0; corner < 8; ++corner)
+        vertices[corner].Pos = XMFLOAT3(
+            (corner & 1) ? boxMax[0] : boxMin[0],
+            (corner & 2) ? boxMax[1] : boxMin[1],
+            (corner & 4) ? boxMax[2] : boxMin[2]);
+
+    for (uint axis = 0; axis < 6; ++axis)
+    {
+        float value = (axis & 1) ? -1.0f : 1.0f;
+        normals[axis] = XMFLOAT3(axis / 2 == 0 ? value : 0.0f, axis / 2 == 1 ? value : 0.0f, axis / 2 == 2 ? value : 0.0f);
+    }
+
+    VertexQuantization q = ComputeQuantization(vertices.data(), count);
+    report.Check(q.Bias.x == boxMin[0] && q.Bias.y == boxMin[1] && q.Bias.z == boxMin[2], "deslocamento no canto mínimo da caixa");
+    report.Check(q.Scale.x == boxMax[0] - boxMin[0] && q.Scale.z == boxMax[2] - boxMin[2], "escala igual à extensão da caixa");
+
+    const float * scale = &q.Scale.x;
+    const VertexFormatType formats[] = { VERTEX_UNORM16, VERTEX_HALF };
+    const char * names[] = { "UNORM16", "HALF" };
+
+    for (uint f = 0; f < 2; ++f)
+    {
+        VertexFormatType format = formats[f];
+        string name = string(names[f]) + ": ";
+
+        uint stride = VertexStride(format, true);
+        vector<byte> packed(size_t(count) * stride);
+        PackVertices(format, vertices.data(), normals.data(), count, q, packed.data());
+
+        // posição recuperada como no vertex shader: meio passo da grade
+        // UNORM16 ou meio ulp do meio-float em [0,1] (2^-12), por eixo
+        vector<XMFLOAT3> positions(count);
+        UnpackPositions(format, packed.data(), stride, count, q, positions.data());
+
+        double worst = 0.0;
+        for (uint v = 0; v < count; ++v)
+        {
+            const float * p0 = &vertices[v].Pos.x;
+            const float * p1 = &positions[v].x;
+            for (uint i = 0; i < 3; ++i)
+            {
+                double step = (format == VERTEX_UNORM16) ? scale[i] / 65535.0 : scale[i] / 2048.0;
+                worst = std::max(worst, fabs(double(p1[i]) - p0[i]) / (0.5 * step));
+            }
+        }
+
+        // folga para o arredondamento de float em bias + scale * unit
+        report.Check(worst <= 1.001, name + "erro de posição até meio passo de quantização");
+
+        bool corners = true;
+        for (uint corner = 0; corner < 8; ++corner)
+            for (uint i = 0; i < 3; ++i)
+                corners = corners && fabs((&positions[corner].x)[i] - (&vertices[corner].Pos.x)[i]) <= 1e-5 * scale[i];
+        report.Check(corners, name + "cantos da caixa recuperados sem erro");
+
+        PackingStats stats = MeasurePacking(format, vertices.data(), normals.data(), count, q, packed.data());
+        report.Check(stats.packedBytes == ullong(count) * sizeof(PackedVertexNormal), name + "16 bytes por vértice com normal");
+        report.Check(stats.maxColorError <= 1e-6, name + "cores da aplicação exatas em RGBA8");
+        report.Check(stats.maxNormalError < 0.005, name + "erro das normais octaédricas abaixo de 0,005 grau");
+    }
+
+    // as duas cores da aplicação têm representação exata em 8 bits por canal
+    report.Check(PackColor(XMFLOAT4(Colors::Blue)) == 0xFFFF0000, "azul em RGBA8");
+    report.Check(PackColor(XMFLOAT4(Colors::Pink)) == 0xFFCBC0FF, "rosa em RGBA8");
+
+    bool axes = true;
+    for (uint axis = 0; axis < 6; ++axis)
+    {
+        short oct[2];
+        OctEncode(normals[axis], oct);
+        XMFLOAT3 n = OctDecode(oct);
+        axes = axes && n.x == normals[axis].x && n.y == normals[axis].y && n.z == normals[axis].z;
+    }
+    report.Check(axes, "eixos exatos na codificação octaédrica");
+
+    return report;
+}
+
+// -------------------------------------------------------------------------------
@@ -0,0 +1,122 @@
+/**********************************************************************************
+// VertexFormat (Arquivo de Cabeçalho)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  Visual C++ 2019
+//
+// Descrição:   Formatos compactos de vértice. As posições são quantizadas
+//              dentro da caixa envolvente da malha, em inteiros de 16 bits
+//              normalizados ou em meio-float, e recuperadas no vertex
+//              shader por escala e deslocamento. A cor é gravada em RGBA8
+//              e as normais, quando existem, em codificação octaédrica de
+//              2 x 16 bits. Cada formato tem o input layout correspondente
+//              e medidas de erro e de memória da conversão.
+//
+**********************************************************************************/
+
+#ifndef DXUT_VERTEXFORMAT_H
+#define DXUT_VERTEXFORMAT_H
+
+// -------------------------------------------------------------------------------
+
+#ifndef _WIN32
+#include <wsl/winadapter.h>             // tipos do Windows exigidos pelo d3d12.h (DirectX-Headers)
+#endif
+#include <d3d12.h>
+#include "Types.h"                      // tipos específicos do motor
+#include "Vertex.h"                     // vértice completo em ponto flutuante
+#include "SelfTest.h"                   // verificações de -selftest
+#include <string>
+using std::string;
+
+// -------------------------------------------------------------------------------
+
+// formato das posições no vertex buffer
+enum VertexFormatType { VERTEX_FLOAT, VERTEX_UNORM16, VERTEX_HALF };
+
+// número máximo de atributos de um layout
+const uint MaxVertexElements = 3;
+
+// posição de 16 bits (w sem uso) e cor RGBA8: 12 bytes
+struct PackedVertex
+{
+    ushort Pos[4];
+    uint   Color;
+};
+
+// posição de 16 bits, cor RGBA8 e normal octaédrica: 16 bytes
+struct PackedVertexNormal
+{
+    ushort Pos[4];
+    uint   Color;
+    short  Normal[2];
+};
+
+// posição = Bias + Scale * posição quantizada
+struct VertexQuantization
+{
+    XMFLOAT3 Scale;
+    XMFLOAT3 Bias;
+};
+
+// erros de ida e volta e memória de uma conversão
+struct PackingStats
+{
+    uint   vertices;                    // vértices convertidos
+    ullong sourceBytes;                 // memória no formato completo
+    ullong packedBytes;                 // memória no formato compacto
+    double maxPosError;                 // maior erro de posição (unidades do objeto)
+    double avgPosError;                 // erro médio de posição
+    double maxColorError;               // maior erro de um canal de cor
+    double maxNormalError;              // maior erro angular das normais (graus)
+
+    string ToString() const;            // resumo em formato texto
+};
+
+// -------------------------------------------------------------------------------
+
+// quantização que cobre a caixa envolvente das posições
+VertexQuantization ComputeQuantization(const Vertex * vertices, uint count);
+
+// quantização a partir de uma caixa envolvente já conhecida
+VertexQuantization ComputeQuantization(const float * boundsMin, const float * boundsMax);
+
+// tamanho do vértice no formato
+uint VertexStride(VertexFormatType format, bool normals);
+
+// preenche o input layout do formato e retorna o número de atributos
+uint VertexLayout(VertexFormatType format, bool normals, D3D12_INPUT_ELEMENT_DESC * elements);
+
+// converte os vértices para o formato (normals pode ser nulo)
+void PackVertices(VertexFormatType format, const Vertex * vertices, const XMFLOAT3 * normals,
+                  uint count, const VertexQuantization & quantization, void * output);
+
+// recupera as posições de vértices no formato (stride é o tamanho de cada vértice)
+void UnpackPositions(VertexFormatType format, const void * vertices, uint stride,
+                     uint count, const VertexQuantization & quantization, XMFLOAT3 * positions);
+
+// compara os vértices convertidos com os originais
+PackingStats MeasurePacking(VertexFormatType format, const Vertex * vertices, const XMFLOAT3 * normals,
+                            uint count, const VertexQuantization & quantization, const void * packed);
+
+// -------------------------------------------------------------------------------
+
+// cor RGBA8 (R no byte menos significativo)
+uint PackColor(const XMFLOAT4 & color);
+XMFLOAT4 UnpackColor(uint color);
+
+// normal unitária em codificação octaédrica
+void OctEncode(const XMFLOAT3 & normal, short * oct);
+XMFLOAT3 OctDecode(const short * oct);
+
+// -------------------------------------------------------------------------------
+
+// confere o erro de ida e volta de cada formato: meio passo de quantização
+// nas posições UNORM16, meio ulp do meio-float nas posições HALF, cores da
+// aplicação exatas em RGBA8 e normais octaédricas abaixo de um ângulo fixo
+SelfTestReport TestVertexFormats();
+
+// -------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,51 @@
+/**********************************************************************************
+// VertexPacked (Arquivo de Sombreamento)
+//
+// Criação:     16 Out 2026
+// Atualização: 16 Out 2026
+// Compilador:  D3DCompiler
+//
+// Descrição:   Variante do vertex shader para vértices compactos. A posição
+//              chega normalizada em [0,1] (16 bits UNORM ou meio-float) e é
+//              recuperada com a escala e o deslocamento da caixa envolvente
+//              da malha. A cor RGBA8 chega convertida pelo input assembler.
+//
+**********************************************************************************/
+
+cbuffer cbPerObject : register(b0)
+{
+    float4x4 WorldViewProj;
+    float4   PosScale;
+    float4   PosBias;
+};
+
+// matriz combinada de cada instância (mundo x visão x projeção)
+StructuredBuffer<float4x4> Instances : register(t0);
+
+struct VertexIn
+{
+    float3 PosQ  : POSITION;
+    float4 Color : COLOR;
+};
+
+struct VertexOut
+{
+    float4 PosH  : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+VertexOut main(VertexIn vin, uint instance : SV_InstanceID)
+{
+    VertexOut vout;
+
+    // recupera a posição no espaço do objeto
+    float3 posL = PosBias.xyz + PosScale.xyz * vin.PosQ;
+
+    // transforma para espaço homogêneo de recorte
+    vout.PosH = mul(float4(posL, 1.0f), Instances[instance]);
+
+    // apenas passa a cor do vértice para o pixel shader
+    vout.Color = vin.Color;
+
+    return vout;
+}
\ No newline at end of file
@@ -1,42 +1,42 @@
 /**********************************************************************************
-// Window (Cdigo Fonte)
+// Window (Código Fonte)
 // 
-// Criao:     19 Mai 2007
-// Atualizao: 09 Ago 2021
+// Criação:     19 Mai 2007
+// Atualização: 09 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Abstrai os detalhes de configurao de uma janela
+// Descrição:   Abstrai os detalhes de configuração de uma janela
 //
 **********************************************************************************/
 
 #include "Window.h"
 
 // -------------------------------------------------------------------------------
-// inicializao de membros estticos da classe
+// inicialização de membros estáticos da classe
 
-void (*Window::inFocus)() = nullptr;                        // nenhuma ao ao ganhar foco
-void (*Window::lostFocus)() = nullptr;                      // nenhuma ao ao perder foco
+void (*Window::inFocus)() = nullptr;                        // nenhuma ação ao ganhar foco
+void (*Window::lostFocus)() = nullptr;                      // nenhuma ação ao perder foco
 
 // -------------------------------------------------------------------------------
 // construtor
 
 Window::Window()
 {
-    windowId      = 0;                                      // id nulo porque a janela ainda no existe
+    windowId      = 0;                                      // id nulo porque a janela ainda não existe
     windowWidth   = GetSystemMetrics(SM_CXSCREEN);          // a janela ocupa toda a tela (tela cheia)
     windowHeight  = GetSystemMetrics(SM_CYSCREEN);          // a janela ocupa toda a tela (tela cheia)
-    windowIcon    = LoadIcon(NULL, IDI_APPLICATION);        // cone padro de uma aplicao
-    windowCursor  = LoadCursor(NULL, IDC_ARROW);            // cursor padro de uma aplicao
-    windowColor   = RGB(0,0,0);                             // cor de fundo padro  preta
-    windowTitle   = string("Windows App");                  // ttulo padro da janela
+    windowIcon    = LoadIcon(NULL, IDI_APPLICATION);        // ícone padrão de uma aplicação
+    windowCursor  = LoadCursor(NULL, IDC_ARROW);            // cursor padrão de uma aplicação
+    windowColor   = RGB(0,0,0);                             // cor de fundo padrão é preta
+    windowTitle   = string("Windows App");                  // título padrão da janela
     windowStyle   = WS_POPUP | WS_VISIBLE;                  // estilo para tela cheia
-    windowMode    = FULLSCREEN;                             // modo padro  tela cheia
-    windowPosX    = 0;                                      // posio inicial da janela no eixo x
-    windowPosY    = 0;                                      // posio inicial da janela no eixo y
+    windowMode    = FULLSCREEN;                             // modo padrão é tela cheia
+    windowPosX    = 0;                                      // posição inicial da janela no eixo x
+    windowPosY    = 0;                                      // posição inicial da janela no eixo y
     windowCenterX = windowWidth/2;                          // centro da janela no eixo x
     windowCenterY = windowHeight/2;                         // centro da janela no eixo y
     windowHdc     = { 0 };                                  // contexto do dispositivo
-    windowRect    = { 0, 0, 0, 0 };                         // rea cliente da janela
+    windowRect    = { 0, 0, 0, 0 };                         // área cliente da janela
 }
 
 // -------------------------------------------------------------------------------
@@ -73,11 +73,11 @@ void Window::Size(int width, int height)
     windowWidth = width; 
     windowHeight = height;
 
-    // calcula a posio do centro da janela
+    // calcula a posição do centro da janela
     windowCenterX = windowWidth/2;
     windowCenterY = windowHeight/2;
 
-    // ajusta a posio da janela para o centro da tela
+    // ajusta a posição da janela para o centro da tela
     windowPosX = (GetSystemMetrics(SM_CXSCREEN)/2) - (windowWidth/2);
     windowPosY = (GetSystemMetrics(SM_CYSCREEN)/2) - (windowHeight/2);
 }
@@ -86,7 +86,7 @@ void Window::Size(int width, int height)
 
 bool Window::Create()
 {
-    // identificador da aplicao
+    // identificador da aplicação
     HINSTANCE appId = GetModuleHandle(NULL);
     
     // definindo uma classe de janela
@@ -112,40 +112,40 @@ bool Window::Create()
     windowId = CreateWindowEx(
         NULL,                              // estilos extras
         "AppWindow",                       // nome da classe da janela
-        windowTitle.c_str(),               // ttulo da janela
+        windowTitle.c_str(),               // título da janela
         windowStyle,                       // estilo da janela
-        windowPosX, windowPosY,            // posio (x,y) inicial
+        windowPosX, windowPosY,            // posição (x,y) inicial
         windowWidth, windowHeight,         // largura e altura da janela
         NULL,                              // identificador da janela pai
         NULL,                              // identificador do menu
-        appId,                             // identificador da aplicao
-        NULL);                             // parmetros de criao
+        appId,                             // identificador da aplicação
+        NULL);                             // parâmetros de criação
 
-    // Ao usar o modo em janela  preciso levar em conta que as barras 
-    // e bordas ocupam espao na janela. O cdigo abaixo ajusta o tamanho
-    // da janela de forma que a rea cliente fique com tamanho 
+    // Ao usar o modo em janela é preciso levar em conta que as barras 
+    // e bordas ocupam espaço na janela. O código abaixo ajusta o tamanho
+    // da janela de forma que a área cliente fique com tamanho 
     // (windowWidth x windowHeight)
 
     if (windowMode == WINDOWED)
     {
-        // retngulo com o tamanho da rea cliente desejada
+        // retângulo com o tamanho da área cliente desejada
         RECT rect = {0, 0, windowWidth, windowHeight};
 
-        // ajusta o tamanho do retngulo
+        // ajusta o tamanho do retângulo
         AdjustWindowRectEx(&rect,
             GetWindowStyle(windowId),
             GetMenu(windowId) != NULL,
             GetWindowExStyle(windowId));
 
-        // atualiza posio da janela
+        // atualiza posição da janela
         windowPosX = (GetSystemMetrics(SM_CXSCREEN)/2) - ((rect.right - rect.left)/2);
         windowPosY = (GetSystemMetrics(SM_CYSCREEN)/2) - ((rect.bottom - rect.top)/2);
 
         // redimensiona janela com uma chamada a MoveWindow
         MoveWindow(
             windowId,                      // identificador da janela
-            windowPosX,                    // posio x
-            windowPosY,                    // posio y
+            windowPosX,                    // posição x
+            windowPosY,                    // posição y
             rect.right - rect.left,        // largura
             rect.bottom - rect.top,        // altura
             TRUE);                         // repintar
@@ -154,10 +154,10 @@ bool Window::Create()
     // captura contexto do dispositivo
     windowHdc = GetDC(windowId);
 
-    // pega tamanho da rea cliente
+    // pega tamanho da área cliente
     GetClientRect(windowId, &windowRect);
 
-    // retorna estado da inicializao (bem sucedida ou no)
+    // retorna estado da inicialização (bem sucedida ou não)
     return (windowId ? true : false);
 }
 
@@ -1,11 +1,11 @@
 /**********************************************************************************
-// Window (Arquivo de Cabealho)
+// Window (Arquivo de Cabeçalho)
 // 
-// Criao:     19 Mai 2007
-// Atualizao: 15 Ago 2021
+// Criação:     19 Mai 2007
+// Atualização: 15 Ago 2021
 // Compilador:  Visual C++ 2019
 //
-// Descrio:   Abstrai os detalhes de configurao de uma janela 
+// Descrição:   Abstrai os detalhes de configuração de uma janela 
 //
 **********************************************************************************/
 
@@ -13,18 +13,18 @@
 #define DXUT_WINDOW_H
 
 // ---------------------------------------------------------------------------------
-// Incluses
+// Inclusões
 
 #define WIN32_LEAN_AND_MEAN
 
 #include "Types.h"       // tipos personalizados da biblioteca
-#include <windows.h>     // inclui funes do windows
-#include <windowsx.h>    // inclui extenses do windows
+#include <windows.h>     // inclui funções do windows
+#include <windowsx.h>    // inclui extensões do windows
 #include <string>        // inclui a classe string
 using std::string;       // permite usar o tipo string sem std::
 
 // ---------------------------------------------------------------------------------
-// Constantes globais e enumeraes
+// Constantes globais e enumerações
 
 enum WindowModes {FULLSCREEN, WINDOWED};
 
@@ -34,18 +34,18 @@ class Window
 {
 private:
     HDC          windowHdc;                                 // contexto do dispositivo
-    RECT         windowRect;                                // rea cliente da janela
+    RECT         windowRect;                                // área cliente da janela
     HWND         windowId;                                  // identificador da janela
     int          windowWidth;                               // largura da janela
     int          windowHeight;                              // altura da janela
-    HICON        windowIcon;                                // cone da janela
+    HICON        windowIcon;                                // ícone da janela
     HCURSOR      windowCursor;                              // cursor da janela
     COLORREF     windowColor;                               // cor de fundo da janela
-    string       windowTitle;                               // nome da barra de ttulo
+    string       windowTitle;                               // nome da barra de título
     DWORD        windowStyle;                               // estilo da janela 
     int          windowMode;                                // modo tela cheia, em janela ou sem borda
-    int          windowPosX;                                // posio inicial da janela no eixo x
-    int          windowPosY;                                // posio inicial da janela no eixo y
+    int          windowPosX;                                // posição inicial da janela no eixo x
+    int          windowPosY;                                // posição inicial da janela no eixo y
     int          windowCenterX;                             // centro da janela no eixo x
     int          windowCenterY;                             // centro da janela no eixo y
 
@@ -62,24 +62,24 @@ public:
     int Mode() const;                                       // retorna o modo atual da janela (FULLSCREEN/WINDOWED)
     int CenterX() const;                                    // retorna o centro da janela no eixo x
     int CenterY() const;                                    // retorna o centro da janela no eixo y
-    string Title() const;                                   // retorna ttulo da janela
+    string Title() const;                                   // retorna título da janela
     COLORREF Color();                                       // retorna a cor de fundo da janela
     float AspectRatio() const;                              // retorna o aspect ratio da janela
 
-    void Icon(const uint icon);                             // define o cone da janela
+    void Icon(const uint icon);                             // define o ícone da janela
     void Cursor(const uint cursor);                         // define o cursor da janela
-    void Title(const string title);                         // define o ttulo da janela 
+    void Title(const string title);                         // define o título da janela 
     void Size(int width, int height);                       // define o tamanho (largura e altura) da janela
     void Mode(int mode);                                    // define o modo da janela (FULLSCREEN/WINDOWED)
     void Color(int r, int g, int b);                        // define a cor de fundo da janela
 
-    void HideCursor(bool hide);                             // habilita ou desabilita a exbio do cursor
+    void HideCursor(bool hide);                             // habilita ou desabilita a exbição do cursor
     void Close();                                           // fecha a janela e sai do jogo
-    void Clear();                                           // limpa a rea cliente
+    void Clear();                                           // limpa a área cliente
     bool Create();                                          // cria a janela com os valores dos atributos
 
-    void InFocus(void(*func)());                            // altera funo executada ao ganhar foco
-    void LostFocus(void(*func)());                          // altera funo executada na perda de foco
+    void InFocus(void(*func)());                            // altera função executada ao ganhar foco
+    void LostFocus(void(*func)());                          // altera função executada na perda de foco
 
     // trata eventos do Windows
     static LRESULT CALLBACK WinProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -87,7 +87,7 @@ public:
 
 // ---------------------------------------------------------------------------------
 
-// Funes Membro Inline
+// Funções Membro Inline
 
 // retorna o identificador da janela do jogo
 inline HWND Window::Id()
@@ -113,7 +113,7 @@ inline int Window::CenterX() const
 inline int Window::CenterY() const
 { return windowCenterY; }
 
-// retorna ttulo da janela
+// retorna título da janela
 inline string Window::Title() const
 { return windowTitle; }
 
@@ -127,7 +127,7 @@ inline float Window::AspectRatio() const
 
 // ----------------------------------------------------------
 
-// define o cone da janela
+// define o ícone da janela
 inline void Window::Icon(const uint icon)    
 { windowIcon = LoadIcon(GetModuleHandle(NULL), MAKEINTRESOURCE(icon)); }
 
@@ -135,7 +135,7 @@ inline void Window::Icon(const uint icon)
 inline void Window::Cursor(const uint cursor)
 { windowCursor = LoadCursor(GetModuleHandle(NULL), MAKEINTRESOURCE(cursor)); }
 
-// define o ttulo da janela 
+// define o título da janela 
 inline void Window::Title(const string title)
 { windowTitle = title; }
 
@@ -145,7 +145,7 @@ inline void Window::Color(int r, int g, int b)
 
 // ----------------------------------------------------------
 
-// habilita ou desabilita a exbio do cursor
+// habilita ou desabilita a exbição do cursor
 inline void Window::HideCursor(bool hide)
 { ShowCursor(!hide); }
 
@@ -153,17 +153,17 @@ inline void Window::HideCursor(bool hide)
 inline void Window::Close()
 { PostMessage(windowId, WM_DESTROY, 0, 0); }
 
-// limpa a rea cliente
+// limpa a área cliente
 inline void Window::Clear()
 { FillRect(windowHdc, &windowRect, CreateSolidBrush(Color())); }
 
 // ----------------------------------------------------------
 
-// altera funo executada no ganho de foco
+// altera função executada no ganho de foco
 inline void Window::InFocus(void(*func)())                
 { inFocus = func; }
 
-// altera funo executada na perda de foco
+// altera função executada na perda de foco
 inline void Window::LostFocus(void(*func)())
 { lostFocus = func; }
 